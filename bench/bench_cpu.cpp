@@ -0,0 +1,229 @@
+// CPU microbenchmarks of the upload packing loops and the graph kernels, no GL context needed:
+// everything packs into host memory. Reports ns/element and heap allocations per call, with scalar and
+// vectorized variants of a kernel side by side.
+//
+//   bench_cpu [--output results.json]
+
+#define BENCH_IMPLEMENT_ALLOCATION_COUNTER
+#include "harness.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <print>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <graph/analytics.hpp>
+#include <graph/force_layout.hpp>
+
+#include <util/edge_import.hpp>
+#include <util/graph.hpp>
+#include <util/graph_generators.hpp>
+#include <util/mesh_prepare.hpp>
+#include <util/thread_pool.hpp>
+#include <util/types.hpp>
+#include <util/vertex_pack.hpp>
+
+using util::VertexFormat;
+
+namespace {
+
+constexpr size_t VERTEX_COUNT = 1 << 20;
+
+std::vector<util::Vertex3D> makeVertices(size_t count) {
+  std::vector<util::Vertex3D> vertices;
+  vertices.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    const float t = static_cast<float>(i % 1024) / 1024.0f;
+    vertices.emplace_back(static_cast<float>(i % 1000), static_cast<float>(i / 1000), t,
+                          util::Color(t, 1.0f - t, 0.5f, 1.0f));
+  }
+  return vertices;
+}
+
+// side x side grid surface, two triangles per cell
+util::Mesh3D makeSurface(uint32_t side) {
+  util::Mesh3D mesh;
+  mesh.vertices = makeVertices(static_cast<size_t>(side) * side);
+  for (uint32_t y = 0; y + 1 < side; ++y) {
+    for (uint32_t x = 0; x + 1 < side; ++x) {
+      const uint32_t v = (y * side) + x;
+      mesh.addFace(v, v + 1, v + side);
+      mesh.addFace(v + 1, v + side + 1, v + side);
+    }
+  }
+  return mesh;
+}
+
+std::string toCsv(const util::Graph& graph) {
+  std::string text;
+  text.reserve(graph.edges.size() * 16);
+  for (const util::Edge& edge : graph.edges) {
+    text += std::to_string(edge.source);
+    text += ',';
+    text += std::to_string(edge.target);
+    text += '\n';
+  }
+  return text;
+}
+
+void benchPacking(bench::Harness& harness) {
+  const std::vector<util::Vertex3D> vertices = makeVertices(VERTEX_COUNT);
+  std::vector<util::Color> colors(vertices.size());
+  for (size_t i = 0; i < vertices.size(); ++i) {
+    colors[i] = vertices[i].color;
+  }
+  std::vector<uint8_t> out(util::vertexBufferSize(VertexFormat::Float32, vertices.size()));
+
+  // uploadMesh: positions block
+  harness.run("packPositions", "float32", vertices.size(), [&] {
+    util::packPositions(VertexFormat::Float32, vertices, out.data());
+    bench::clobberMemory();
+  });
+  harness.run("packPositions", "half", vertices.size(), [&] {
+    util::packPositions(VertexFormat::HalfPosition, vertices, out.data());
+    bench::clobberMemory();
+  });
+
+  // uploadMesh / uploadGraph: colors block
+  auto* packed = reinterpret_cast<uint32_t*>(out.data());
+  harness.run("packColors rgba8", "scalar", colors.size(), [&] {
+    util::packColorsScalar(colors.data(), sizeof(util::Color), colors.size(), packed);
+    bench::clobberMemory();
+  });
+#if defined(__SSE2__)
+  harness.run("packColors rgba8", "sse2", colors.size(), [&] {
+    util::packColorsSSE2(colors.data(), sizeof(util::Color), colors.size(), packed);
+    bench::clobberMemory();
+  });
+#endif
+  harness.run("packColors rgba8 (Vertex3D)", "scalar", vertices.size(), [&] {
+    util::packColorsScalar(&vertices[0].color, sizeof(util::Vertex3D), vertices.size(), packed);
+    bench::clobberMemory();
+  });
+#if defined(__SSE2__)
+  harness.run("packColors rgba8 (Vertex3D)", "sse2", vertices.size(), [&] {
+    util::packColorsSSE2(&vertices[0].color, sizeof(util::Vertex3D), vertices.size(), packed);
+    bench::clobberMemory();
+  });
+#endif
+
+  // drawTriangles / drawLines: interleaved 2D stream vertices
+  std::vector<util::Vertex2D> vertices2D(VERTEX_COUNT);
+  for (size_t i = 0; i < vertices2D.size(); ++i) {
+    vertices2D[i] = util::Vertex2D(vertices[i].position.x, vertices[i].position.y, vertices[i].color);
+  }
+  harness.run("packVertices2D float32", "interleave", vertices2D.size(), [&] {
+    util::packVertices2D(VertexFormat::Float32, vertices2D, out.data());
+    bench::clobberMemory();
+  });
+  // Lower bound: Vertex2D already has the float32 stream layout
+  static_assert(sizeof(util::Vertex2D) == util::vertexSize2D(VertexFormat::Float32));
+  harness.run("packVertices2D float32", "memcpy", vertices2D.size(), [&] {
+    std::memcpy(out.data(), vertices2D.data(), vertices2D.size() * sizeof(util::Vertex2D));
+    bench::clobberMemory();
+  });
+  harness.run("packVertices2D packed", "interleave", vertices2D.size(), [&] {
+    util::packVertices2D(VertexFormat::PackedColor, vertices2D, out.data());
+    bench::clobberMemory();
+  });
+  harness.run("packVertices2D half", "interleave", vertices2D.size(), [&] {
+    util::packVertices2D(VertexFormat::HalfPosition, vertices2D, out.data());
+    bench::clobberMemory();
+  });
+
+  // Whole CPU side of an upload: packing, spatial chunks, index copies
+  const util::Mesh3D surface = makeSurface(1024);
+  harness.run("prepareMesh", "float32", surface.vertices.size(),
+              [&] { bench::doNotOptimize(util::prepareMesh(surface, VertexFormat::Float32)); });
+  harness.run("prepareMesh", "packed", surface.vertices.size(),
+              [&] { bench::doNotOptimize(util::prepareMesh(surface, VertexFormat::PackedColor)); });
+}
+
+void benchGraphKernels(bench::Harness& harness) {
+  util::ThreadPool serial(1);
+  const util::Graph graph = util::randomGraph(1 << 18, 8);
+  const std::vector<util::Edge> edges = graph.edges;
+
+  // CSR build, elements = edges
+  harness.run("Graph::fromEdges", "1 thread", edges.size(), [&] {
+    bench::doNotOptimize(util::Graph::fromEdges(graph.nodeCount(), edges, {}, util::GraphBuildOptions(), serial));
+  });
+  harness.run("Graph::fromEdges", "pool", edges.size(),
+              [&] { bench::doNotOptimize(util::Graph::fromEdges(graph.nodeCount(), edges)); });
+
+  // Text import, elements = edges
+  const std::string csv = toCsv(graph);
+  util::Graph imported;
+  harness.run("importEdgeList csv", "1 thread", edges.size(), [&] {
+    bench::doNotOptimize(util::importEdgeList(csv, imported, util::EdgeImportOptions(), serial));
+  });
+  harness.run("importEdgeList csv", "pool", edges.size(),
+              [&] { bench::doNotOptimize(util::importEdgeList(csv, imported)); });
+
+  // One Barnes-Hut iteration, elements = nodes
+  const util::Graph layoutGraph = util::scaleFreeGraph(1 << 16, 3);
+  graph::ForceLayout serialLayout;
+  graph::ForceLayout layout;
+  serialLayout.initialize(layoutGraph, graph::LayoutParams(), serial);
+  layout.initialize(layoutGraph);
+  harness.run("ForceLayout::step", "1 thread", layoutGraph.nodeCount(), [&] { serialLayout.step(); });
+  harness.run("ForceLayout::step", "pool", layoutGraph.nodeCount(), [&] { layout.step(); });
+}
+
+// Analytics behind the node encodings on a ~10M edge scale-free graph, elements = edges
+void benchAnalytics(bench::Harness& harness) {
+  util::ThreadPool serial(1);
+  const util::Graph graph = util::scaleFreeGraph(1 << 20, 10);
+  graph::PageRankParams pageRankParams;
+  pageRankParams.maxIterations = 20;
+  pageRankParams.tolerance = 0.0f;
+
+  harness.run("degreeCentrality", "pool", graph.edgeCount(),
+              [&] { bench::doNotOptimize(graph::degreeCentrality(graph)); });
+  harness.run("bfsDistances", "1 thread", graph.edgeCount(),
+              [&] { bench::doNotOptimize(graph::bfsDistances(graph, 0, serial)); });
+  harness.run("bfsDistances", "pool", graph.edgeCount(), [&] { bench::doNotOptimize(graph::bfsDistances(graph, 0)); });
+  harness.run("connectedComponents", "1 thread", graph.edgeCount(),
+              [&] { bench::doNotOptimize(graph::connectedComponents(graph, serial)); });
+  harness.run("connectedComponents", "pool", graph.edgeCount(),
+              [&] { bench::doNotOptimize(graph::connectedComponents(graph)); });
+  harness.run("pageRank 20 iterations", "1 thread", graph.edgeCount(),
+              [&] { bench::doNotOptimize(graph::pageRank(graph, pageRankParams, serial)); });
+  harness.run("pageRank 20 iterations", "pool", graph.edgeCount(),
+              [&] { bench::doNotOptimize(graph::pageRank(graph, pageRankParams)); });
+
+  // Full recolor: kernel plus color and size encodings into the graph's attribute arrays
+  util::Graph encoded = graph;
+  harness.run("recolor by BFS distance", "pool", graph.edgeCount(), [&] {
+    graph::colorByDistance(graph::bfsDistances(encoded, 0), encoded.colors);
+    graph::sizeByValue(graph::degreeCentrality(encoded), encoded.sizes, 2.0f, 12.0f);
+  });
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::string output;
+  if (argc == 3 && std::string_view(argv[1]) == "--output") {
+    output = argv[2];
+  } else if (argc != 1) {
+    std::print("Usage: {} [--output results.json]\n", argv[0]);
+    return -1;
+  }
+
+  bench::Harness harness;
+  benchPacking(harness);
+  benchGraphKernels(harness);
+  benchAnalytics(harness);
+
+  if (!output.empty()) {
+    if (!harness.writeJson(output)) {
+      std::print("Failed to write {}\n", output);
+      return -1;
+    }
+    std::print("Results written to {}\n", output);
+  }
+  return 0;
+}
@@ -0,0 +1,455 @@
+// Headless rendering benchmark: synthetic graphs drawn into an offscreen framebuffer of a hidden window
+// with vsync off, every draw path timed separately. Results are written as JSON for comparing releases.
+//
+//   bench_render [--frames N] [--max-nodes N] [--output results.json]
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <print>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gfx/framebuffer_opengl.hpp>
+#include <gfx/renderer.hpp>
+#include <gfx/window.hpp>
+
+#include <util/glm.hpp>
+#include <util/graph.hpp>
+#include <util/graph_generators.hpp>
+#include <util/spatial_index.hpp>
+#include <util/types.hpp>
+#include <util/vertex_pack.hpp>
+
+namespace {
+
+constexpr uint32_t WIDTH = 1920;
+constexpr uint32_t HEIGHT = 1080;
+constexpr uint32_t WARMUP_FRAMES = 10;
+
+// The 2D path re-streams its vertices every frame, larger graphs are cut to this many edges
+constexpr size_t MAX_STREAMED_EDGES = 1'000'000;
+constexpr size_t MAX_HALOS = 100'000;
+constexpr uint32_t TILES_PER_SIDE = 64;
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point begin, Clock::time_point end) {
+  return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+struct Options {
+  uint32_t frames = 120;
+  uint32_t maxNodes = 10'000'000;
+  std::string output = "bench_render.json";
+};
+
+struct Percentiles {
+  double mean = 0.0;
+  double p50 = 0.0;
+  double p90 = 0.0;
+  double p99 = 0.0;
+  double max = 0.0;
+};
+
+Percentiles computePercentiles(std::vector<double> samples) {
+  Percentiles result;
+  if (samples.empty()) {
+    return result;
+  }
+  std::ranges::sort(samples);
+  auto at = [&](double q) { return samples[static_cast<size_t>(q * static_cast<double>(samples.size() - 1))]; };
+  for (const double sample : samples) {
+    result.mean += sample;
+  }
+  result.mean /= static_cast<double>(samples.size());
+  result.p50 = at(0.5);
+  result.p90 = at(0.9);
+  result.p99 = at(0.99);
+  result.max = samples.back();
+  return result;
+}
+
+struct PassResult {
+  std::string name;
+  Percentiles submitMs;  // beginFrame .. endFrame on the CPU
+  Percentiles frameMs;   // Until the GPU finished the frame
+};
+
+struct UploadResult {
+  std::string name;
+  uint64_t bytes = 0;
+  double ms = 0.0;
+};
+
+struct CaseResult {
+  std::string generator;
+  uint32_t nodes = 0;
+  uint32_t edges = 0;
+  std::vector<UploadResult> uploads;
+  std::vector<PassResult> passes;
+};
+
+bool parseOptions(int argc, char** argv, Options& options) {
+  auto parseNumber = [](std::string_view text, uint32_t& value) {
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return error == std::errc() && end == text.data() + text.size();
+  };
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg = argv[i];
+    if (i + 1 >= argc) {
+      return false;
+    }
+    const std::string_view value = argv[++i];
+    if (arg == "--frames") {
+      if (!parseNumber(value, options.frames) || options.frames == 0) {
+        return false;
+      }
+    } else if (arg == "--max-nodes") {
+      if (!parseNumber(value, options.maxNodes)) {
+        return false;
+      }
+    } else if (arg == "--output") {
+      options.output = value;
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Orthographic camera fitting the whole graph
+glm::mat4 fitCamera(const util::Graph& graph) {
+  util::AABB bounds;
+  for (const glm::vec3& p : graph.positions) {
+    bounds.expand(p);
+  }
+  const glm::vec3 center = (bounds.min + bounds.max) * 0.5f;
+  const float aspect = static_cast<float>(WIDTH) / static_cast<float>(HEIGHT);
+  const float halfHeight = std::max(bounds.max.x - bounds.min.x, bounds.max.y - bounds.min.y) * 0.55f;
+  return glm::ortho(center.x - (halfHeight * aspect), center.x + (halfHeight * aspect), center.y - halfHeight,
+                    center.y + halfHeight, -1.0f, 1.0f);
+}
+
+// Two triangles per cell of a width x height grid, for the face path
+util::Mesh3D gridSurface(const util::Graph& grid, uint32_t width, uint32_t height) {
+  util::Mesh3D mesh;
+  mesh.vertices.reserve(grid.nodeCount());
+  for (const glm::vec3& p : grid.positions) {
+    mesh.vertices.emplace_back(p, util::Color(0.4f, 0.6f, 0.9f, 1.0f));
+  }
+  mesh.faces.reserve(static_cast<size_t>(width - 1) * (height - 1) * 6);
+  for (uint32_t y = 0; y + 1 < height; ++y) {
+    for (uint32_t x = 0; x + 1 < width; ++x) {
+      const uint32_t v = (y * width) + x;
+      mesh.addFace(v, v + 1, v + width);
+      mesh.addFace(v + 1, v + width + 1, v + width);
+    }
+  }
+  return mesh;
+}
+
+// Many small static meshes (a grid of 4x4-vertex tiles covering the bounds), for the render queue passes
+std::vector<util::Mesh3D> tileMeshes(const util::Graph& graph, uint32_t tilesPerSide) {
+  util::AABB bounds;
+  for (const glm::vec3& p : graph.positions) {
+    bounds.expand(p);
+  }
+  const glm::vec2 tileSize =
+      glm::vec2(bounds.max.x - bounds.min.x, bounds.max.y - bounds.min.y) / static_cast<float>(tilesPerSide);
+  std::vector<util::Mesh3D> tiles(static_cast<size_t>(tilesPerSide) * tilesPerSide);
+  for (uint32_t t = 0; t < tiles.size(); ++t) {
+    const glm::vec2 origin =
+        glm::vec2(bounds.min.x, bounds.min.y) + (tileSize * glm::vec2(t % tilesPerSide, t / tilesPerSide));
+    const util::Color color(0.3f + (0.4f * static_cast<float>(t % 3) / 2.0f), 0.5f, 0.8f, 1.0f);
+    util::Mesh3D& tile = tiles[t];
+    for (uint32_t v = 0; v < 16; ++v) {
+      const glm::vec2 p = origin + (tileSize * 0.3f * glm::vec2(v % 4, v / 4));
+      tile.vertices.emplace_back(glm::vec3(p, 0.0f), color);
+    }
+    for (uint32_t y = 0; y < 3; ++y) {
+      for (uint32_t x = 0; x < 3; ++x) {
+        const uint32_t v = (y * 4) + x;
+        tile.addFace(v, v + 1, v + 4);
+        tile.addFace(v + 1, v + 5, v + 4);
+      }
+    }
+  }
+  return tiles;
+}
+
+glm::vec2 toPixels(const glm::mat4& mvp, const glm::vec3& position) {
+  const glm::vec4 clip = mvp * glm::vec4(position, 1.0f);
+  return glm::vec2((clip.x * 0.5f + 0.5f) * static_cast<float>(WIDTH),
+                   (clip.y * 0.5f + 0.5f) * static_cast<float>(HEIGHT));
+}
+
+// Graph edges as pixel-space line vertices for the 2D path
+std::vector<util::Vertex2D> streamedLines(const util::Graph& graph, const glm::mat4& mvp) {
+  const size_t count = std::min(graph.edges.size(), MAX_STREAMED_EDGES);
+  std::vector<util::Vertex2D> vertices;
+  vertices.reserve(count * 2);
+  const util::Color color(1.0f, 1.0f, 1.0f, 0.3f);
+  for (size_t e = 0; e < count; ++e) {
+    vertices.emplace_back(toPixels(mvp, graph.positions[graph.edges[e].source]), color);
+    vertices.emplace_back(toPixels(mvp, graph.positions[graph.edges[e].target]), color);
+  }
+  return vertices;
+}
+
+// Pixel-space node centers for the 2D circle paths (node halos)
+std::vector<glm::vec2> haloCenters(const util::Graph& graph, const glm::mat4& mvp) {
+  std::vector<glm::vec2> centers(std::min<size_t>(graph.nodeCount(), MAX_HALOS));
+  for (size_t i = 0; i < centers.size(); ++i) {
+    centers[i] = toPixels(mvp, graph.positions[i]);
+  }
+  return centers;
+}
+
+class Benchmark {
+ public:
+  Benchmark(gfx::Window& window, gfx::Renderer& renderer, gfx::FramebufferOpenGL& target, const Options& options)
+      : m_window(window), m_renderer(renderer), m_target(target), m_options(options) {}
+
+  CaseResult run(const std::string& generator, const util::Graph& graph, const util::Mesh3D* surface) {
+    CaseResult result;
+    result.generator = generator;
+    result.nodes = graph.nodeCount();
+    result.edges = graph.edgeCount();
+
+    const glm::mat4 mvp = fitCamera(graph);
+
+    // Index bytes of the edges plus the shared vertex buffer
+    const uint64_t graphBytes = util::vertexBufferSize(util::VertexFormat::Float32, graph.nodeCount()) +
+                                (graph.edges.size() * sizeof(util::Edge));
+    util::MeshGPU graphGPU;
+    result.uploads.push_back(timeUpload("graph", graphBytes, [&] { graphGPU = m_renderer.uploadGraph(graph); }));
+
+    util::NodesGPU nodesGPU;
+    result.uploads.push_back(timeUpload("nodes", graph.nodeCount() * sizeof(util::NodeInstance),
+                                        [&] { nodesGPU = m_renderer.uploadNodes(graph); }));
+
+    util::MeshGPU surfaceGPU;
+    if (surface != nullptr) {
+      const uint64_t surfaceBytes = util::vertexBufferSize(util::VertexFormat::Float32, surface->vertices.size()) +
+                                    (surface->faces.size() * sizeof(uint32_t));
+      result.uploads.push_back(
+          timeUpload("surface", surfaceBytes, [&] { surfaceGPU = m_renderer.uploadMesh(*surface); }));
+      result.passes.push_back(timePass("drawMesh", [&] { m_renderer.drawMesh(surfaceGPU, mvp); }));
+    }
+
+    result.passes.push_back(timePass("drawMeshEdges", [&] {
+      m_renderer.drawMeshEdges(graphGPU, mvp, util::Color(1.0f, 1.0f, 1.0f, 0.3f));
+    }));
+    util::EdgesGPU edgesGPU;
+    result.uploads.push_back(timeUpload("edges", graph.edges.size() * sizeof(util::EdgeInstance),
+                                        [&] { edgesGPU = m_renderer.uploadEdges(graph, 2.0f); }));
+    result.passes.push_back(timePass("drawEdges", [&] {
+      m_renderer.drawEdges(edgesGPU, graphGPU, mvp, util::Color(1.0f, 1.0f, 1.0f, 0.3f));
+    }));
+    result.passes.push_back(timePass("drawEdgesFromNodes", [&] {
+      m_renderer.drawEdges(edgesGPU, nodesGPU, mvp, util::Color(1.0f, 1.0f, 1.0f, 0.3f));
+    }));
+    result.passes.push_back(timePass("drawMeshPoints", [&] { m_renderer.drawMeshPoints(graphGPU, mvp); }));
+    result.passes.push_back(timePass("drawNodes", [&] { m_renderer.drawNodes(nodesGPU, mvp); }));
+
+    const std::vector<util::Vertex2D> lines = streamedLines(graph, mvp);
+    result.passes.push_back(timePass("drawLines2D", [&] { m_renderer.drawLines(lines); }));
+
+    // Batched halos: tessellated circles from the unit circle tables vs one instanced SDF draw
+    const std::vector<glm::vec2> halos = haloCenters(graph, mvp);
+    const util::Color haloColor(1.0f, 0.8f, 0.2f, 0.5f);
+    m_renderer.setBatching(true);
+    result.passes.push_back(timePass("drawCircle", [&] {
+      for (const glm::vec2& center : halos) {
+        m_renderer.drawCircle(center.x, center.y, 6.0f, haloColor, false);
+      }
+    }));
+    result.passes.push_back(timePass("drawCircleSDF", [&] {
+      for (const glm::vec2& center : halos) {
+        m_renderer.drawCircleSDF(center.x, center.y, 6.0f, haloColor, 1.5f);
+      }
+    }));
+    m_renderer.setBatching(false);
+
+    // Many small meshes: one draw each vs pooled meshes merged by the render queue
+    if (surface != nullptr) {
+      const std::vector<util::Mesh3D> tiles = tileMeshes(graph, TILES_PER_SIDE);
+      std::vector<util::MeshGPU> tilesGPU;
+      std::vector<util::PooledMeshGPU> pooledGPU;
+      for (const util::Mesh3D& tile : tiles) {
+        tilesGPU.push_back(m_renderer.uploadMesh(tile));
+        pooledGPU.push_back(m_renderer.uploadMeshPooled(tile));
+      }
+      result.passes.push_back(timePass("drawMeshTiles", [&] {
+        for (const util::MeshGPU& tileGPU : tilesGPU) {
+          m_renderer.drawMesh(tileGPU, mvp);
+        }
+      }));
+      m_renderer.setQueueing(true);
+      result.passes.push_back(timePass("drawMeshTilesQueued", [&] {
+        for (const util::PooledMeshGPU& tileGPU : pooledGPU) {
+          m_renderer.drawMesh(tileGPU, mvp);
+        }
+      }));
+      m_renderer.setQueueing(false);
+      for (util::MeshGPU& tileGPU : tilesGPU) {
+        m_renderer.freeMesh(tileGPU);
+      }
+      for (util::PooledMeshGPU& tileGPU : pooledGPU) {
+        m_renderer.freeMesh(tileGPU);
+      }
+    }
+
+    m_renderer.freeMesh(graphGPU);
+    m_renderer.freeNodes(nodesGPU);
+    m_renderer.freeEdges(edgesGPU);
+    if (surface != nullptr) {
+      m_renderer.freeMesh(surfaceGPU);
+    }
+    return result;
+  }
+
+ private:
+  gfx::Window& m_window;
+  gfx::Renderer& m_renderer;
+  gfx::FramebufferOpenGL& m_target;
+  const Options& m_options;
+
+  UploadResult timeUpload(const std::string& name, uint64_t bytes, const std::function<void()>& upload) {
+    m_renderer.finish();
+    const Clock::time_point begin = Clock::now();
+    upload();
+    m_renderer.finish();
+    return UploadResult{.name = name, .bytes = bytes, .ms = elapsedMs(begin, Clock::now())};
+  }
+
+  PassResult timePass(const std::string& name, const std::function<void()>& draw) {
+    std::vector<double> submit;
+    std::vector<double> frame;
+    submit.reserve(m_options.frames);
+    frame.reserve(m_options.frames);
+
+    for (uint32_t i = 0; i < WARMUP_FRAMES + m_options.frames; ++i) {
+      m_window.pollEvents();
+      const Clock::time_point begin = Clock::now();
+      m_target.bind();
+      m_renderer.beginFrame();
+      m_renderer.clear(util::Color(0.05f, 0.05f, 0.08f, 1.0f));
+      draw();
+      m_renderer.endFrame();
+      const Clock::time_point submitted = Clock::now();
+      m_renderer.finish();
+      const Clock::time_point finished = Clock::now();
+
+      if (i >= WARMUP_FRAMES) {
+        submit.push_back(elapsedMs(begin, submitted));
+        frame.push_back(elapsedMs(begin, finished));
+      }
+    }
+    gfx::FramebufferOpenGL::unbind();
+    return PassResult{.name = name, .submitMs = computePercentiles(submit), .frameMs = computePercentiles(frame)};
+  }
+};
+
+void writePercentiles(std::ofstream& file, const char* name, const Percentiles& p) {
+  file << '"' << name << "\":{\"mean\":" << p.mean << ",\"p50\":" << p.p50 << ",\"p90\":" << p.p90
+       << ",\"p99\":" << p.p99 << ",\"max\":" << p.max << '}';
+}
+
+bool writeResults(const std::string& path, const Options& options, const std::vector<CaseResult>& results) {
+  std::ofstream file(path, std::ios::trunc);
+  if (!file) {
+    return false;
+  }
+  file.precision(4);
+  file << std::fixed;
+
+  file << "{\"width\":" << WIDTH << ",\"height\":" << HEIGHT << ",\"frames\":" << options.frames
+       << ",\"cases\":[";
+  for (size_t c = 0; c < results.size(); ++c) {
+    const CaseResult& result = results[c];
+    file << (c > 0 ? ",\n" : "\n") << "{\"generator\":\"" << result.generator << "\",\"nodes\":" << result.nodes
+         << ",\"edges\":" << result.edges << ",\"uploads\":[";
+    for (size_t u = 0; u < result.uploads.size(); ++u) {
+      const UploadResult& upload = result.uploads[u];
+      const double throughput = upload.ms > 0.0 ? static_cast<double>(upload.bytes) / (upload.ms * 1e3) : 0.0;
+      file << (u > 0 ? "," : "") << "{\"name\":\"" << upload.name << "\",\"bytes\":" << upload.bytes
+           << ",\"ms\":" << upload.ms << ",\"megabytesPerSecond\":" << throughput << '}';
+    }
+    file << "],\"passes\":[";
+    for (size_t p = 0; p < result.passes.size(); ++p) {
+      const PassResult& pass = result.passes[p];
+      file << (p > 0 ? "," : "") << "{\"name\":\"" << pass.name << "\",";
+      writePercentiles(file, "submitMs", pass.submitMs);
+      file << ',';
+      writePercentiles(file, "frameMs", pass.frameMs);
+      file << '}';
+    }
+    file << "]}";
+  }
+  file << "\n]}\n";
+  return static_cast<bool>(file.flush());
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    std::print("Usage: {} [--frames N] [--max-nodes N] [--output results.json]\n", argv[0]);
+    return -1;
+  }
+
+  gfx::Window window;
+  gfx::Renderer renderer;
+  gfx::FramebufferOpenGL target;
+
+  if (!window.initialize(WIDTH, HEIGHT, "bench_render", false)) {
+    std::print("Failed to initialize GLFW window!\n");
+    return -1;
+  }
+  window.setSwapInterval(0);
+
+  if (!renderer.initialize(window, WIDTH, HEIGHT)) {
+    std::print("Failed to initialize renderer!\n");
+    return -1;
+  }
+
+  if (!target.initialize(WIDTH, HEIGHT)) {
+    std::print("Failed to create the offscreen framebuffer!\n");
+    return -1;
+  }
+
+  Benchmark benchmark(window, renderer, target, options);
+  std::vector<CaseResult> results;
+
+  for (uint32_t nodes = 1'000; nodes <= options.maxNodes && nodes <= 10'000'000; nodes *= 10) {
+    std::print("{} nodes\n", nodes);
+
+    results.push_back(benchmark.run("random", util::randomGraph(nodes, 8), nullptr));
+
+    const auto side = static_cast<uint32_t>(std::sqrt(static_cast<double>(nodes)));
+    const util::Graph grid = util::gridGraph(side, side);
+    const util::Mesh3D surface = gridSurface(grid, side, side);
+    results.push_back(benchmark.run("grid", grid, &surface));
+
+    results.push_back(benchmark.run("scale-free", util::scaleFreeGraph(nodes, 3), nullptr));
+  }
+
+  target.cleanup();
+
+  if (!writeResults(options.output, options, results)) {
+    std::print("Failed to write {}\n", options.output);
+    return -1;
+  }
+  std::print("Results written to {}\n", options.output);
+  return 0;
+}
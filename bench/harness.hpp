@@ -0,0 +1,152 @@
+#pragma once
+
+// Minimal microbenchmark harness for CPU kernels. Define BENCH_IMPLEMENT_ALLOCATION_COUNTER in exactly one
+// translation unit before including this header to replace the global operator new / delete with counting
+// versions, so results can report heap allocations per call.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <new>
+#include <print>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+inline std::atomic<uint64_t> allocationCount{0};
+
+// Keep a result alive so the optimizer cannot drop the computation producing it
+template <typename T>
+inline void doNotOptimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Compiler barrier: memory written before must be treated as observed
+inline void clobberMemory() { asm volatile("" : : : "memory"); }
+
+struct Result {
+  std::string group;
+  std::string name;
+  size_t elements = 0;
+  uint32_t iterations = 0;     // Calls per sample (the minimum sample is reported)
+  double nsPerElement = 0.0;
+  double allocationsPerCall = 0.0;
+};
+
+class Harness {
+ public:
+  // Each sample runs the kernel until it takes at least this long, the fastest of SAMPLES is reported
+  static constexpr uint32_t SAMPLES = 7;
+  static constexpr std::chrono::milliseconds MIN_SAMPLE_TIME{20};
+
+  // Time fn, which processes elements items per call; variants of one kernel share a group
+  const Result& run(const std::string& group, const std::string& name, size_t elements,
+                    const std::function<void()>& fn) {
+    using Clock = std::chrono::steady_clock;
+
+    // Warm-up call, also sizes the sample (caches, first-touch page faults and scratch growth are not measured)
+    Clock::time_point begin = Clock::now();
+    fn();
+    const double once = std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+
+    const double target = std::chrono::duration<double, std::nano>(MIN_SAMPLE_TIME).count();
+    const auto iterations = static_cast<uint32_t>(std::clamp(target / std::max(once, 1.0), 1.0, 1e6));
+
+    // Allocations are counted over all timed calls, so steady per-call allocations show up
+    double best = 0.0;
+    const uint64_t allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+    for (uint32_t sample = 0; sample < SAMPLES; ++sample) {
+      begin = Clock::now();
+      for (uint32_t i = 0; i < iterations; ++i) {
+        fn();
+      }
+      const double ns = std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+      best = sample == 0 ? ns : std::min(best, ns);
+    }
+    const uint64_t allocations = allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+
+    Result result;
+    result.group = group;
+    result.name = name;
+    result.elements = elements;
+    result.iterations = iterations;
+    result.nsPerElement = best / (static_cast<double>(iterations) * static_cast<double>(std::max<size_t>(elements, 1)));
+    result.allocationsPerCall = static_cast<double>(allocations) / (static_cast<double>(iterations) * SAMPLES);
+    m_results.push_back(result);
+
+    std::print("{:<28} {:<22} {:>10.3f} ns/elem {:>8.1f} allocs/call", group, name, result.nsPerElement,
+               result.allocationsPerCall);
+    // Speedup over the first variant of the group
+    const Result& baseline = *std::ranges::find(m_results, group, &Result::group);
+    if (&baseline != &m_results.back() && result.nsPerElement > 0.0) {
+      std::print("   {:.2f}x", baseline.nsPerElement / result.nsPerElement);
+    }
+    std::print("\n");
+    return m_results.back();
+  }
+
+  [[nodiscard]] const std::vector<Result>& getResults() const { return m_results; }
+
+  bool writeJson(const std::string& path) const {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file) {
+      return false;
+    }
+    file.precision(4);
+    file << std::fixed << "{\"results\":[";
+    for (size_t i = 0; i < m_results.size(); ++i) {
+      const Result& result = m_results[i];
+      file << (i > 0 ? ",\n" : "\n") << "{\"group\":\"" << result.group << "\",\"name\":\"" << result.name
+           << "\",\"elements\":" << result.elements << ",\"iterations\":" << result.iterations
+           << ",\"nsPerElement\":" << result.nsPerElement << ",\"allocationsPerCall\":" << result.allocationsPerCall
+           << '}';
+    }
+    file << "\n]}\n";
+    return static_cast<bool>(file.flush());
+  }
+
+ private:
+  std::vector<Result> m_results;
+};
+
+}  // namespace bench
+
+#ifdef BENCH_IMPLEMENT_ALLOCATION_COUNTER
+
+void* operator new(std::size_t size) {
+  bench::allocationCount.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) { return operator new(size); }
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  bench::allocationCount.fetch_add(1, std::memory_order_relaxed);
+  const auto align = static_cast<std::size_t>(alignment);
+  if (void* ptr = std::aligned_alloc(align, ((std::max<std::size_t>(size, 1) + align - 1) / align) * align)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) { return operator new(size, alignment); }
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t /*size*/) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t /*size*/) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t /*alignment*/) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t /*alignment*/) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept { std::free(ptr); }
+
+#endif
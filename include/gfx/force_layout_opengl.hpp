@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gfx/shader_program_opengl.hpp>
+
+#include <graph/layout.hpp>
+
+#include <util/glm.hpp>
+#include <util/graph.hpp>
+#include <util/types.hpp>
+
+namespace gfx {
+
+// GPU-resident force layout. Node positions (xyz + size as w) live in two buffer objects, every
+// iteration runs the force integration in a vertex shader over all nodes and captures the result
+// into the other buffer with transform feedback. All positions and the CSR adjacency are read through
+// texture buffers. Repulsion is exact up to repulsionSamples nodes, above that each node sums a rotating
+// strided sample of the others (scaled to the full count). After step() the result always sits in
+// getPositionBuffer(), so meshes and nodes bound to it once read every new layout without CPU copies.
+// Requires a current GL context (initialize after the renderer); the bound program and VAO are restored
+// afterwards, so the renderer's state cache stays valid.
+class ForceLayoutOpenGL {
+ public:
+  ForceLayoutOpenGL();
+  ~ForceLayoutOpenGL();
+
+  ForceLayoutOpenGL(const ForceLayoutOpenGL&) = delete;
+  ForceLayoutOpenGL(ForceLayoutOpenGL&&) = delete;
+  ForceLayoutOpenGL& operator=(const ForceLayoutOpenGL&) = delete;
+  ForceLayoutOpenGL& operator=(ForceLayoutOpenGL&&) = delete;
+
+  bool initialize(const util::Graph& graph, const graph::LayoutParams& params = graph::LayoutParams());
+  void cleanup();
+
+  void step(uint32_t iterations = 1);
+  void reheat();
+
+  void setParams(const graph::LayoutParams& params);
+  [[nodiscard]] const graph::LayoutParams& getParams() const { return m_params; }
+
+  [[nodiscard]] uint32_t getNodeCount() const { return m_nodeCount; }
+  [[nodiscard]] uint64_t getIteration() const { return m_iteration; }
+  [[nodiscard]] float getTemperature() const { return m_temperature; }
+
+  // vec4 per node (xyz position, w = node size), stable for the lifetime of the layout
+  [[nodiscard]] uint32_t getPositionBuffer() const { return m_positionBuffers[0]; }
+
+  // Synchronous readback (stalls the pipeline, for saving or analysis rather than every frame)
+  void readPositions(std::vector<glm::vec3>& positions) const;
+  void writePositions(util::Graph& graph) const;
+
+  // Point an uploaded mesh / node set at the position buffer (first call only, later calls are no-ops)
+  template <typename RendererType>
+  void present(RendererType& renderer, util::MeshGPU& meshGPU) const {
+    renderer.bindMeshPositions(meshGPU, getPositionBuffer(), 4 * sizeof(float));
+  }
+
+  template <typename RendererType>
+  void present(RendererType& renderer, util::NodesGPU& nodesGPU) const {
+    renderer.bindNodePositions(nodesGPU, getPositionBuffer());
+  }
+
+ private:
+  graph::LayoutParams m_params;
+  uint32_t m_nodeCount;
+  uint64_t m_iteration;
+  float m_temperature;
+
+  ShaderProgramOpenGL m_program;
+
+  // Uniform locations, resolved after linking
+  int m_nodeCountLoc;
+  int m_sampleCountLoc;
+  int m_sampleStrideLoc;
+  int m_sampleOffsetLoc;
+  int m_repulsionLoc;
+  int m_attractionLoc;
+  int m_gravityLoc;
+  int m_temperatureLoc;
+  int m_separationLoc;
+  int m_planarLoc;
+
+  // Ping-pong positions, each readable as vertex attribute (VAO) and texture buffer
+  uint32_t m_positionBuffers[2];
+  uint32_t m_positionTextures[2];
+  uint32_t m_vaos[2];
+
+  // CSR adjacency with per-slot weights
+  uint32_t m_offsetBuffer;
+  uint32_t m_offsetTexture;
+  uint32_t m_neighborBuffer;
+  uint32_t m_neighborTexture;
+  uint32_t m_weightBuffer;
+  uint32_t m_weightTexture;
+
+  bool loadProgram();
+  static uint32_t createTextureBuffer(uint32_t buffer, uint32_t internalFormat);
+};
+
+// GPU layout with the same stepping API as graph::CpuLayout
+using GpuLayout = graph::LayoutTemplate<ForceLayoutOpenGL>;
+
+}  // namespace gfx
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <util/background_worker.hpp>
+#include <util/image.hpp>
+
+namespace gfx {
+
+// Asynchronous readback of rendered frames for recordings and stills. Reads go into a ring of pixel buffer
+// objects with a fence each and are mapped once the fence has signalled, a frame or two later, so the render
+// thread never waits for the GPU. The pixels are then handed to a worker thread that writes PNG files or
+// pipes raw frames into an external encoder. When every slot is in flight or the worker falls behind,
+// recorded frames are dropped (and counted) instead of stalling the frame.
+class FrameCaptureOpenGL {
+ public:
+  static constexpr uint32_t READBACK_SLOTS = 3;
+  static constexpr size_t MAX_QUEUED_FRAMES = 8;  // Frames waiting for the worker before new ones are dropped
+
+  FrameCaptureOpenGL();
+  ~FrameCaptureOpenGL();  // Finishes queued frames
+
+  FrameCaptureOpenGL(const FrameCaptureOpenGL&) = delete;
+  FrameCaptureOpenGL(FrameCaptureOpenGL&&) = delete;
+  FrameCaptureOpenGL& operator=(const FrameCaptureOpenGL&) = delete;
+  FrameCaptureOpenGL& operator=(FrameCaptureOpenGL&&) = delete;
+
+  // Recording into <prefix>000000.png, <prefix>000001.png, ...
+  bool startPngSequence(std::string prefix);
+
+  // Recording as raw RGBA8 frames (top row first) into the standard input of command, e.g.
+  //   ffmpeg -f rawvideo -pix_fmt rgba -s 1280x800 -r 60 -i - out.mp4
+  // All frames must have the same size; frames of another size are dropped. Writes run with SIGPIPE
+  // blocked, so an encoder that exits early ends the recording (hasPipeFailed) instead of the process.
+  bool startPipe(const std::string& command);
+
+  // The encoder stopped accepting frames; recording stops at the next captureFrame (reset by startPipe)
+  [[nodiscard]] bool hasPipeFailed() const { return m_pipeFailed.load(); }
+
+  // Finish in-flight reads and queued frames, then close the sink (waits)
+  void stop();
+
+  [[nodiscard]] bool isRecording() const { return m_sink != Sink::None; }
+
+  // Queue a read of the bound read framebuffer (origin, width x height) for the recording; false = dropped
+  bool captureFrame(uint32_t width, uint32_t height);
+
+  // Still of width x height assembled from tiles: beginStill, then readTile for every tile once it is
+  // rendered (into the bound read framebuffer at the origin). The worker writes the PNG after the last tile.
+  bool beginStill(std::string path, uint32_t width, uint32_t height);
+  void readTile(const util::ImageTile& tile);
+
+  // Hand finished reads to the worker (wait = true blocks until every read has landed)
+  void poll(bool wait = false);
+
+  void cleanup();
+
+  [[nodiscard]] uint64_t getFrameCount() const { return m_frameCount; }
+  [[nodiscard]] uint64_t getDroppedCount() const { return m_droppedCount; }
+  [[nodiscard]] uint64_t getStillCount() const { return m_stillCount.load(); }
+
+ private:
+  enum class Sink : uint8_t { None, PngSequence, Pipe };
+
+  // Image assembled by the worker from its tiles
+  struct Still {
+    std::string path;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint64_t coveredPixels = 0;  // Render thread only
+    std::vector<uint8_t> pixels;  // Bottom-up RGBA8
+  };
+
+  struct Readback {
+    uint32_t pbo = 0;
+    size_t capacity = 0;
+    void* fence = nullptr;
+    uint64_t sequence = 0;  // 0 = slot free
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::function<void(std::vector<uint8_t>)> consume;  // Runs on the worker with the bottom-up pixels
+  };
+
+  std::array<Readback, READBACK_SLOTS> m_readbacks;
+  uint64_t m_nextSequence;
+
+  Sink m_sink;
+  std::string m_prefix;
+  std::FILE* m_pipe;  // Written by the worker only
+  std::atomic<bool> m_pipeFailed;
+  uint32_t m_frameWidth;
+  uint32_t m_frameHeight;
+  uint64_t m_frameCount;
+  uint64_t m_droppedCount;
+
+  std::shared_ptr<Still> m_still;
+  std::atomic<uint64_t> m_stillCount;
+
+  util::BackgroundWorker m_worker;
+
+  Readback* acquireSlot(bool wait);
+  void read(Readback& readback, uint32_t width, uint32_t height);
+  void consumeFrame(uint64_t index, uint32_t width, uint32_t height, std::vector<uint8_t> pixels);
+};
+
+}  // namespace gfx
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+namespace gfx {
+
+// Offscreen render target with an RGBA8 color and a 24-bit depth renderbuffer, for headless rendering
+// (benchmarks, captures) into a hidden window's context
+class FramebufferOpenGL {
+ public:
+  FramebufferOpenGL();
+  ~FramebufferOpenGL();
+
+  FramebufferOpenGL(const FramebufferOpenGL&) = delete;
+  FramebufferOpenGL(FramebufferOpenGL&&) = delete;
+  FramebufferOpenGL& operator=(const FramebufferOpenGL&) = delete;
+  FramebufferOpenGL& operator=(FramebufferOpenGL&&) = delete;
+
+  // False when the attachments are incomplete
+  bool initialize(uint32_t width, uint32_t height);
+  void cleanup();
+
+  // Draw into the framebuffer and set the viewport to its size / return to the default framebuffer
+  void bind() const;
+  static void unbind();
+
+  [[nodiscard]] bool isValid() const { return m_framebuffer != 0; }
+  [[nodiscard]] uint32_t getHandle() const { return m_framebuffer; }
+  [[nodiscard]] uint32_t getWidth() const { return m_width; }
+  [[nodiscard]] uint32_t getHeight() const { return m_height; }
+
+ private:
+  uint32_t m_framebuffer;
+  uint32_t m_colorBuffer;
+  uint32_t m_depthBuffer;
+  uint32_t m_width;
+  uint32_t m_height;
+};
+
+}  // namespace gfx
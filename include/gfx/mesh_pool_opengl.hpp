@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <gfx/state_cache_opengl.hpp>
+#include <util/mesh_prepare.hpp>
+#include <util/range_allocator.hpp>
+#include <util/types.hpp>
+
+namespace gfx {
+
+// Large shared vertex / element buffers that many small meshes are suballocated from. A page holds one
+// vertex format: a positions block and a colors block of its vertex capacity plus an element buffer, behind
+// a single VAO, so draws of different meshes of a page need no rebinding and can share a multi-draw.
+// Meshes larger than a page get a page of their own size; freed ranges are reused first fit.
+class MeshPoolOpenGL {
+ public:
+  static constexpr uint32_t PAGE_VERTICES = 1 << 18;
+  static constexpr uint32_t PAGE_INDICES = 1 << 20;
+
+  MeshPoolOpenGL();
+  ~MeshPoolOpenGL();
+
+  MeshPoolOpenGL(const MeshPoolOpenGL&) = delete;
+  MeshPoolOpenGL(MeshPoolOpenGL&&) = delete;
+  MeshPoolOpenGL& operator=(const MeshPoolOpenGL&) = delete;
+  MeshPoolOpenGL& operator=(MeshPoolOpenGL&&) = delete;
+
+  // Copy a prepared mesh into free ranges of a page of its format and dimension (invalid handle on failure)
+  util::PooledMeshGPU allocate(const util::PreparedMesh& prepared, StateCacheOpenGL& state);
+  void release(util::PooledMeshGPU& mesh);
+  void cleanup(StateCacheOpenGL& state);
+
+  [[nodiscard]] uint32_t getPageCount() const { return static_cast<uint32_t>(m_pages.size()); }
+
+  // Bytes of all page buffers
+  [[nodiscard]] uint64_t getCapacityBytes() const;
+
+ private:
+  struct Page {
+    util::VertexFormat format = util::VertexFormat::Float32;
+    uint32_t dimensions = 3;
+    uint32_t vbo = 0;
+    uint32_t ebo = 0;
+    uint32_t vao = 0;
+    util::RangeAllocator vertices;
+    util::RangeAllocator indices;
+  };
+
+  std::vector<std::unique_ptr<Page>> m_pages;  // Page id = index + 1
+
+  bool createPage(Page& page, util::VertexFormat format, uint32_t dimensions, uint32_t vertexCapacity,
+                  uint32_t indexCapacity, StateCacheOpenGL& state);
+};
+
+}  // namespace gfx
@@ -1,8 +1,21 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
 
+#include <gfx/mesh_pool_opengl.hpp>
+#include <gfx/pick_buffer_opengl.hpp>
 #include <gfx/renderer_opengl.hpp>
+#include <util/background_worker.hpp>
+#include <util/graph.hpp>
+#include <util/mesh_file.hpp>
+#include <util/mesh_prepare.hpp>
 #include <util/types.hpp>
 #include <util/glm.hpp>
 
@@ -20,8 +33,49 @@ class MeshRendererOpenGL : public RendererOpenGL {
   MeshRendererOpenGL& operator=(const MeshRendererOpenGL&) = delete;
   MeshRendererOpenGL& operator=(MeshRendererOpenGL&&) = delete;
 
+  // Initialize the base renderer, then build every mesh, node, edge, picking and queue program up front
+  bool initialize(const Window& window, uint32_t width, uint32_t height);
+
   // Unified mesh rendering API - upload once, draw many times
-  MeshGPU uploadMesh(const Mesh3D& mesh);
+  // Vertices are stored once and shared by the face, edge and point views (indexed drawing)
+  // Compact formats (packed RGBA8 colors, half-float positions) cut vertex memory and bandwidth
+  // Mesh2D uploads two-component positions, no conversion to 3D vertices
+  MeshGPU uploadMesh(const Mesh2D& mesh, VertexFormat format = VertexFormat::Float32);
+  MeshGPU uploadMesh(const Mesh3D& mesh, VertexFormat format = VertexFormat::Float32);
+
+  // Upload a graph directly from its attribute arrays: node positions / colors fill the vertex blocks
+  // and the edge array becomes the edge element buffer (no faces). Positions can then be streamed
+  // with updateMeshPositions(meshGPU, graph.positions) as the layout moves.
+  MeshGPU uploadGraph(const Graph& graph, VertexFormat format = VertexFormat::Float32);
+
+  // Upload pre-packed sections (e.g. a memory-mapped MeshFile): every array goes straight into its
+  // buffer, no packing, validation or chunking happens on this side
+  MeshGPU uploadMesh(const MeshView& view);
+
+  // Asynchronous uploads: packing, index validation and chunking run on a worker thread, then the data
+  // is copied into the new buffers in slices of at most the upload budget per frame (in beginFrame).
+  // A fence after the last slice gates readiness, so neither the worker nor the GPU copy stalls a frame.
+  // The handle turns Ready once the GPU has the data; draws of pending handles are skipped.
+  MeshHandle uploadMeshAsync(Mesh2D mesh, VertexFormat format = VertexFormat::Float32);
+  MeshHandle uploadMeshAsync(Mesh3D mesh, VertexFormat format = VertexFormat::Float32);
+  MeshHandle uploadGraphAsync(Graph graph, VertexFormat format = VertexFormat::Float32);
+
+  // Bytes streamed into pending uploads per frame
+  void setUploadBudget(size_t bytes) { m_uploadBudget = bytes; }
+  [[nodiscard]] size_t getUploadBudget() const { return m_uploadBudget; }
+
+  // Uploads not yet Ready or Failed
+  [[nodiscard]] size_t getPendingUploadCount() const { return m_pendingUploads; }
+
+  // Advance pending uploads, then begin the frame as usual
+  void beginFrame();
+
+  // Submit the render queue, then end the frame as usual
+  void endFrame();
+
+  // Still as in RendererOpenGL, with the render queue submitted before the tiles and after each of them
+  bool captureStill(const std::string& path, uint32_t width, uint32_t height,
+                    const std::function<void(const glm::mat4&)>& draw);
 
   // Draw uploaded mesh with MVP matrix (wireframe uses glPolygonMode)
   void drawMesh(const MeshGPU& meshGPU, const glm::mat4& mvp, const Color& tint = Color(1.0f, 1.0f, 1.0f, 1.0f),
@@ -35,15 +89,270 @@ class MeshRendererOpenGL : public RendererOpenGL {
   void drawMeshPoints(const MeshGPU& meshGPU, const glm::mat4& mvp, const Color& tint = Color(1.0f, 1.0f, 1.0f, 1.0f),
                       float pointSize = 1.0f);
 
-  static void freeMesh(MeshGPU& meshGPU);
+  // Draws of asynchronous uploads, no-ops until the handle is Ready
+  void drawMesh(const MeshHandle& handle, const glm::mat4& mvp, const Color& tint = Color(1.0f, 1.0f, 1.0f, 1.0f),
+                bool wireframe = false);
+  void drawMeshEdges(const MeshHandle& handle, const glm::mat4& mvp,
+                     const Color& tint = Color(1.0f, 1.0f, 1.0f, 1.0f), float lineWidth = 1.0f);
+  void drawMeshPoints(const MeshHandle& handle, const glm::mat4& mvp,
+                      const Color& tint = Color(1.0f, 1.0f, 1.0f, 1.0f), float pointSize = 1.0f);
+
+  // Pooled meshes: vertices and indices are suballocated from large shared buffers (one VAO per pool page and
+  // vertex format), so queued draws of many small meshes merge into a few base-vertex multi-draws.
+  // Pooled meshes are static; culling uses their upload-time chunks.
+  PooledMeshGPU uploadMeshPooled(const Mesh2D& mesh, VertexFormat format = VertexFormat::Float32);
+  PooledMeshGPU uploadMeshPooled(const Mesh3D& mesh, VertexFormat format = VertexFormat::Float32);
+  PooledMeshGPU uploadGraphPooled(const Graph& graph, VertexFormat format = VertexFormat::Float32);
+
+  // Pooled draws always go through the render queue; outside queueing they are submitted right away
+  void drawMesh(const PooledMeshGPU& meshGPU, const glm::mat4& mvp, const Color& tint = Color(1.0f, 1.0f, 1.0f, 1.0f),
+                bool wireframe = false);
+  void drawMeshEdges(const PooledMeshGPU& meshGPU, const glm::mat4& mvp,
+                     const Color& tint = Color(1.0f, 1.0f, 1.0f, 1.0f), float lineWidth = 1.0f);
+  void drawMeshPoints(const PooledMeshGPU& meshGPU, const glm::mat4& mvp,
+                      const Color& tint = Color(1.0f, 1.0f, 1.0f, 1.0f), float pointSize = 1.0f);
+
+  // Render queue: while queueing, mesh draws record commands instead of executing (visible chunks are
+  // selected at record time). flushQueue(), called from endFrame(), sorts them once by a 64-bit key (pass,
+  // program, fixed-function state, VAO, draw data, depth; translucent draws back to front) and submits each
+  // run of compatible commands as one glMultiDrawElementsBaseVertex / glMultiDrawArrays call. Per-draw MVP,
+  // tint and sizes go into one uniform buffer upload per flush, each batch binds its entry.
+  void setQueueing(bool enabled);
+  [[nodiscard]] bool isQueueing() const { return m_queueing; }
+  void flushQueue();
+
+  // Instanced nodes: per-node position, radius, color, shape and outline on a shared quad (single draw call)
+  NodesGPU uploadNodes(const std::vector<NodeInstance>& nodes);
+
+  // Instanced nodes from graph attributes (sizes are radii in pixels)
+  NodesGPU uploadNodes(const Graph& graph, NodeShape shape = NodeShape::Circle, float outlineWidth = 0.0f);
+
+  void drawNodes(const NodesGPU& nodesGPU, const glm::mat4& mvp, const Color& tint = Color(1.0f, 1.0f, 1.0f, 1.0f),
+                 float radiusScale = 1.0f, const Color& outlineColor = Color(0.0f, 0.0f, 0.0f, 1.0f));
+
+  // Instanced thick edges: every edge is expanded into a screen-space quad in the vertex shader, with its own
+  // pixel width and color and an antialiased fringe, all edges in a single instanced call. Endpoints index
+  // the vertices of the mesh passed to drawEdges (its positions block or bound external positions), so the
+  // edges follow position updates without being re-uploaded. drawMeshEdges stays the cheapest 1 px path.
+  EdgesGPU uploadEdges(const std::vector<EdgeInstance>& edges);
+
+  // Instanced edges from the graph edge array, colored with the average of their endpoint colors
+  EdgesGPU uploadEdges(const Graph& graph, float width = 1.0f);
+
+  void drawEdges(const EdgesGPU& edgesGPU, const MeshGPU& vertices, const glm::mat4& mvp,
+                 const Color& tint = Color(1.0f, 1.0f, 1.0f, 1.0f), float widthScale = 1.0f);
+
+  // Endpoints index the nodes instead (their instance buffer or bound external positions): node positions
+  // are stored once, so a layout step only writes N positions and never touches the 2E edge endpoints
+  void drawEdges(const EdgesGPU& edgesGPU, const NodesGPU& nodes, const glm::mat4& mvp,
+                 const Color& tint = Color(1.0f, 1.0f, 1.0f, 1.0f), float widthScale = 1.0f);
+
+  // GPU picking: between beginPicking() and endPicking() the pick draws write node and edge IDs into an
+  // integer target of the viewport size (same views and chunk culling as the regular draws, later draws
+  // win depth ties, so pick edges before nodes). Requests read regions of that target back asynchronously
+  // and their results arrive about one frame later from takePickResults(). No CPU geometry work is done.
+  bool beginPicking();
+  void pickMeshEdges(const MeshGPU& meshGPU, const glm::mat4& mvp, float lineWidth = 1.0f);
+  void pickMeshPoints(const MeshGPU& meshGPU, const glm::mat4& mvp, float pointSize = 1.0f);
+  void pickNodes(const NodesGPU& nodesGPU, const glm::mat4& mvp, float radiusScale = 1.0f);
+  void endPicking();
+
+  // Framebuffer pixels, origin at the bottom left (flip window mouse y); 0 when the request was dropped
+  uint64_t requestPick(uint32_t x, uint32_t y, uint32_t radius = 2);
+  uint64_t requestBoxSelection(uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1);
+
+  // Picks finished since the last call, oldest first (never waits for the GPU)
+  std::vector<PickResult> takePickResults();
+
+  // In-place updates of an uploaded mesh, starting at vertex offset (topology is not touched).
+  // Data is staged through the stream ring and copied on the GPU, so the CPU never waits for draws
+  // that still read the old contents. A position-only update is a single contiguous copy.
+  // Vertices must match the mesh's dimension; vec3 position updates apply to 3D meshes only.
+  void updateMeshVertices(MeshGPU& meshGPU, std::span<const Vertex2D> vertices, size_t offset = 0);
+  void updateMeshVertices(MeshGPU& meshGPU, std::span<const Vertex3D> vertices, size_t offset = 0);
+  void updateMeshPositions(MeshGPU& meshGPU, std::span<const glm::vec3> positions, size_t offset = 0);
+  void updateMeshColors(MeshGPU& meshGPU, std::span<const Color> colors, size_t offset = 0);
+
+  // Read positions from an external buffer of floats (xyz at the start of every stride) instead of
+  // the mesh's own positions block, e.g. the output of a GPU layout. No per-frame copies are made;
+  // the buffer must hold vertexCount entries and outlive the mesh. Position updates are ignored while bound;
+  // when rendering on demand, whoever writes the buffer calls requestRedraw().
+  void bindMeshPositions(MeshGPU& meshGPU, uint32_t buffer, size_t stride = 4 * sizeof(float));
+
+  // Per-instance position + radius from an external vec4 buffer (0 = back to the instance buffer)
+  void bindNodePositions(NodesGPU& nodesGPU, uint32_t buffer);
+
+  // Cull mesh chunks against the draw's MVP frustum (on by default; stale bounds are never culled)
+  void setCulling(bool enabled) {
+    if (enabled != m_cullingEnabled) {
+      requestRedraw();
+    }
+    m_cullingEnabled = enabled;
+  }
+  [[nodiscard]] bool isCulling() const { return m_cullingEnabled; }
+
+  void freeMesh(MeshGPU& meshGPU);
+  void freeMesh(MeshHandle& handle);  // Also cancels a pending upload
+  void freeMesh(PooledMeshGPU& meshGPU);
+  void freeNodes(NodesGPU& nodesGPU);
+  void freeEdges(EdgesGPU& edgesGPU);
 
  private:
-  uint32_t m_meshShaderProgram;
-  uint32_t m_pointShaderProgram;
+  // In-flight asynchronous upload; the worker fills prepared and hands the job back through m_preparedUploads
+  struct UploadJob {
+    std::weak_ptr<AsyncMeshGPU> handle;
+    PreparedMesh prepared;
+    MeshGPU mesh;         // Buffers being filled, moved into the handle when the fence signals
+    uint32_t stage = 0;   // Buffer being copied: vertices, faces, edges, points
+    size_t offset = 0;    // Bytes of the current stage already copied
+    void* fence = nullptr;
+  };
+
+  // std140 layout of the DrawBlock uniform block of the queue shaders
+  struct QueueDrawData {
+    glm::mat4 mvp;
+    Color tint;
+    glm::vec4 params;  // x = point size, y = line width
+  };
+
+  // One range of a queued draw
+  struct QueueCommand {
+    uint64_t key = 0;
+    uint32_t vao = 0;
+    uint32_t mode = 0;   // GL primitive
+    uint32_t first = 0;  // First index (indexed) or vertex
+    uint32_t count = 0;
+    int32_t baseVertex = 0;  // Added to every index
+    uint32_t drawData = 0;   // Entry of m_queueData
+    uint8_t state = 0;       // QUEUE_* bits
+    bool indexed = false;
+  };
+
+  // Fixed-function state of a queued command
+  static constexpr uint8_t QUEUE_BLEND = 1;
+  static constexpr uint8_t QUEUE_CULL_FACE = 2;
+  static constexpr uint8_t QUEUE_WIREFRAME = 4;
+
+  // Distinct draw data entries before the queue flushes early (keeps the uniform upload small)
+  static constexpr size_t MAX_QUEUE_DRAW_DATA = 1024;
+  static constexpr uint32_t DRAW_BLOCK_BINDING = 0;
+
+  ShaderProgramOpenGL m_meshShaderProgram;
+  ShaderProgramOpenGL m_pointShaderProgram;
+  ShaderProgramOpenGL m_nodeShaderProgram;
+  ShaderProgramOpenGL m_edgeShaderProgram;
+  uint32_t m_nodeQuadVBO;
+  uint32_t m_edgeQuadVBO;
+  uint32_t m_edgePositionTexture;  // Buffer texture re-pointed at the vertex positions of every edge draw
+  bool m_cullingEnabled;
+
+  // Visible ranges of the current chunked draw, reused across draws
+  std::vector<int32_t> m_drawFirsts;
+  std::vector<int32_t> m_drawCounts;
+  std::vector<const void*> m_drawOffsets;
+  std::vector<int32_t> m_drawBaseVertices;
+
+  // Shared buffers of pooled meshes
+  MeshPoolOpenGL m_meshPool;
+
+  // Render queue, reused across frames
+  ShaderProgramOpenGL m_queueMeshProgram;
+  ShaderProgramOpenGL m_queuePointProgram;
+  std::vector<QueueCommand> m_queue;
+  std::vector<QueueDrawData> m_queueData;
+  bool m_queueing;
+  size_t m_uniformAlignment;
+
+  // Asynchronous uploads: prepared on the worker, streamed and fenced on the render thread
+  std::mutex m_uploadMutex;
+  std::vector<std::shared_ptr<UploadJob>> m_preparedUploads;  // Guarded by m_uploadMutex
+  std::vector<std::shared_ptr<UploadJob>> m_uploads;          // Render thread only, in submission order
+  size_t m_uploadBudget;
+  size_t m_pendingUploads;
+
+  // Uniform locations beyond the common ones, resolved when the programs are linked
+  int m_pointSizeLocation;
+  int m_nodeViewportLocation;
+  int m_nodeRadiusScaleLocation;
+  int m_nodeOutlineColorLocation;
+  int m_edgeViewportLocation;
+  int m_edgeWidthScaleLocation;
+  int m_edgePositionsLocation;
+  int m_edgePositionStrideLocation;
+
+  // Picking pass
+  PickBufferOpenGL m_pickBuffer;
+  ShaderProgramOpenGL m_pickPointProgram;
+  ShaderProgramOpenGL m_pickEdgeProgram;
+  ShaderProgramOpenGL m_pickNodeProgram;
+  std::vector<PickResult> m_pickResults;
+  bool m_picking;
+  uint32_t m_pickDepthFunc;  // Restored by endPicking()
+  int m_pickPointSizeLocation;
+  int m_pickNodeViewportLocation;
+  int m_pickNodeRadiusScaleLocation;
 
   void cleanup();
-  bool loadMeshShaders();
+
+  // Finish the programs begun in initialize and set up what depends on them
   bool loadPointShaders();
+  bool loadNodeShaders();
+  bool loadEdgeShaders();
+  bool loadPickShaders();
+  bool loadQueueShaders();
+
+  // Shared body of the 2D and 3D uploads / vertex updates
+  template <typename VertexType>
+  MeshGPU uploadVertices(const util::Mesh<VertexType>& mesh, VertexFormat format);
+  template <typename VertexType>
+  void updateVertices(MeshGPU& meshGPU, std::span<const VertexType> vertices, size_t offset);
+
+  // Suballocate a prepared mesh from the pool
+  PooledMeshGPU uploadPrepared(const PreparedMesh& prepared);
+
+  // Point the bound VAO at the mesh's shared position / color blocks
+  static void setupVertexAttributes(const MeshGPU& meshGPU);
+
+  // Point VAO, with a Morton-ordered index buffer when the points span several chunks
+  void setupPointView(MeshGPU& meshGPU, std::span<const glm::vec3> positions);
+
+  // New VAO over the shared vertex blocks of meshGPU with ebo as its element buffer (0 = none)
+  void setupView(const MeshGPU& meshGPU, uint32_t& vao, uint32_t ebo);
+
+  MeshHandle submitUpload(std::function<PreparedMesh()> prepare);
+  void processUploads();
+
+  // Copy up to budget bytes of the job's data into its buffers, false on a mapping failure
+  static bool streamUpload(UploadJob& job, size_t& budget);
+
+  // Whole-view draw, or one multi-draw over the chunks that intersect the MVP frustum
+  void drawChunks(uint32_t mode, std::span<const IndexChunk> chunks, uint32_t count, bool indexed,
+                  const glm::mat4& mvp, bool cull);
+  [[nodiscard]] bool isMeshVisible(const MeshGPU& meshGPU, const glm::mat4& mvp) const;
+
+  // Record the visible ranges of one view (first = first index, or first vertex when not indexed)
+  void queueDraw(uint32_t mode, uint32_t vao, std::span<const IndexChunk> chunks, uint32_t first, uint32_t count,
+                 int32_t baseVertex, bool indexed, const AABB* bounds, const glm::mat4& mvp, const Color& tint,
+                 float size, uint8_t state);
+
+  // One run of compatible commands (same program, state, VAO and draw data) as a single multi-draw
+  void submitQueueBatch(std::span<const QueueCommand> batch, size_t dataOffset);
+
+  // Node VAO with an uninitialized instance buffer for count instances
+  NodesGPU createNodes(size_t count);
+
+  // Edge VAO with an uninitialized instance buffer for count instances
+  EdgesGPU createEdges(size_t count);
+
+  // Instanced edge draw with endpoint positions from the buffer bound to m_edgePositionTexture
+  void drawEdgeInstances(const EdgesGPU& edgesGPU, const glm::mat4& mvp, const Color& tint, float widthScale,
+                         int positionStride);
+
+  // Copy a committed stream allocation into a mesh buffer
+  void copyFromStream(uint32_t buffer, size_t streamOffset, size_t bufferOffset, size_t bytes);
+
+  // Declared last: destroyed first, so no task outlives the members it hands results to
+  util::BackgroundWorker m_uploadWorker;
 };
 
 }  // namespace gfx
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gfx {
+
+enum class PickKind : uint8_t { None, Node, Edge };
+
+// Object under a pixel of the ID buffer. Nodes are mesh vertices or node instances, edges are identified
+// by their endpoints in the order they were uploaded (source, target)
+struct PickHit {
+  PickKind kind = PickKind::None;
+  uint32_t id = 0;     // Node / vertex index, first endpoint of an edge
+  uint32_t other = 0;  // Second endpoint of an edge
+
+  [[nodiscard]] bool isValid() const { return kind != PickKind::None; }
+
+  bool operator==(const PickHit&) const = default;
+};
+
+struct PickResult {
+  uint64_t request = 0;       // Returned by the request that produced it
+  bool box = false;           // Box selection rather than a point pick
+  PickHit nearest;            // Point picks: hit closest to the pick position (nodes win ties with edges)
+  std::vector<PickHit> hits;  // Every distinct hit in the read region, sorted (nodes before edges)
+};
+
+// Integer ID target (RG32UI color + depth) for GPU picking. Each fragment stores (id + 1, other + 1), so 0 marks
+// empty pixels and a zero second channel marks a node. Regions are read back asynchronously into a small ring
+// of pixel buffer objects and decoded once their fence has signalled, about one frame later and without ever
+// stalling on the GPU. Coordinates are framebuffer pixels with the origin at the bottom left.
+class PickBufferOpenGL {
+ public:
+  static constexpr uint32_t READBACK_SLOTS = 4;
+
+  PickBufferOpenGL();
+  ~PickBufferOpenGL();
+
+  PickBufferOpenGL(const PickBufferOpenGL&) = delete;
+  PickBufferOpenGL(PickBufferOpenGL&&) = delete;
+  PickBufferOpenGL& operator=(const PickBufferOpenGL&) = delete;
+  PickBufferOpenGL& operator=(PickBufferOpenGL&&) = delete;
+
+  // (Re)create the target when the size changed, false when the attachments are incomplete
+  bool resize(uint32_t width, uint32_t height);
+  void cleanup();
+
+  // Draw into the ID target (cleared to empty) / return to the default framebuffer
+  void bind() const;
+  static void unbind();
+
+  [[nodiscard]] bool isValid() const { return m_framebuffer != 0; }
+  [[nodiscard]] uint32_t getWidth() const { return m_width; }
+  [[nodiscard]] uint32_t getHeight() const { return m_height; }
+
+  // Queue reads of the current contents, 0 when the region is empty or all readback slots are busy
+  uint64_t requestPoint(uint32_t x, uint32_t y, uint32_t radius);
+  uint64_t requestBox(uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1);
+
+  // Append the results of finished reads, oldest first; never waits for the GPU
+  void poll(std::vector<PickResult>& results);
+
+  [[nodiscard]] uint32_t getPendingCount() const;
+
+ private:
+  struct Readback {
+    uint32_t pbo = 0;
+    size_t capacity = 0;
+    void* fence = nullptr;
+    uint64_t request = 0;  // 0 = slot free
+    bool box = false;
+    int32_t x = 0;  // Read region
+    int32_t y = 0;
+    int32_t width = 0;
+    int32_t height = 0;
+    int32_t centerX = 0;  // Point picks: pick position
+    int32_t centerY = 0;
+  };
+
+  uint32_t m_framebuffer;
+  uint32_t m_idBuffer;
+  uint32_t m_depthBuffer;
+  uint32_t m_width;
+  uint32_t m_height;
+
+  std::array<Readback, READBACK_SLOTS> m_readbacks;
+  uint64_t m_nextRequest;
+
+  uint64_t request(int32_t x0, int32_t y0, int32_t x1, int32_t y1, bool box, int32_t centerX, int32_t centerY);
+  static void decode(const Readback& readback, const uint32_t* pixels, PickResult& result);
+};
+
+}  // namespace gfx
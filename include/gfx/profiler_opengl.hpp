@@ -0,0 +1,179 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace gfx {
+
+// Renderer passes with their own CPU and GPU timers
+enum class ProfilePass : uint8_t {
+  Clear,
+  Faces,
+  Edges,
+  Points,
+  Nodes,
+  Primitives2D,
+  Uploads,
+  ImGui,
+  Count,
+};
+
+[[nodiscard]] const char* getPassName(ProfilePass pass);
+
+struct PassTiming {
+  double cpuMs = 0.0;  // Time spent submitting on the CPU
+  double gpuMs = 0.0;  // Time between the pass's GPU timestamps
+  uint32_t scopes = 0;
+};
+
+// One timed pass instance, times in microseconds since the profiler started (GPU times mapped to the CPU clock)
+struct ProfileEvent {
+  ProfilePass pass = ProfilePass::Count;
+  double cpuBegin = 0.0;
+  double cpuEnd = 0.0;
+  double gpuBegin = 0.0;
+  double gpuEnd = 0.0;
+};
+
+struct FrameProfile {
+  uint64_t frame = 0;
+  double beginUs = 0.0;
+  double intervalMs = 0.0;  // Since the previous beginFrame, includes swap / vsync waits
+  double cpuMs = 0.0;       // beginFrame .. endFrame on the CPU
+  double gpuMs = 0.0;       // First to last GPU timestamp of the frame
+  bool gpuValid = false;    // False when the queries were not ready in time (results are never waited for)
+
+  std::array<PassTiming, static_cast<size_t>(ProfilePass::Count)> passes{};
+  uint32_t drawCalls = 0;
+  uint64_t vertices = 0;
+  uint64_t bytesUploaded = 0;
+
+  std::vector<ProfileEvent> events;
+};
+
+// Per-pass CPU timers and GL_TIMESTAMP query pairs. Queries of a frame are read back FRAME_LATENCY
+// frames later, when the GPU is long past them; a frame whose results are still unavailable then is
+// recorded without GPU times instead of stalling. Timestamps (rather than GL_TIME_ELAPSED) allow nested
+// and interleaved scopes and place the GPU work on the trace timeline.
+class ProfilerOpenGL {
+ public:
+  static constexpr uint32_t FRAME_LATENCY = 4;
+  static constexpr uint32_t HISTORY_SIZE = 240;
+
+  ProfilerOpenGL();
+  ~ProfilerOpenGL();
+
+  ProfilerOpenGL(const ProfilerOpenGL&) = delete;
+  ProfilerOpenGL(ProfilerOpenGL&&) = delete;
+  ProfilerOpenGL& operator=(const ProfilerOpenGL&) = delete;
+  ProfilerOpenGL& operator=(ProfilerOpenGL&&) = delete;
+
+  void cleanup();
+
+  // Off by default; scopes and counters cost a branch while disabled
+  void setEnabled(bool enabled);
+  [[nodiscard]] bool isEnabled() const { return m_enabled; }
+
+  void beginFrame();
+  void endFrame();
+
+  void beginPass(ProfilePass pass);
+  void endPass(ProfilePass pass);
+
+  void countDraw(uint64_t vertices) {
+    if (m_enabled) {
+      ++m_current.drawCalls;
+      m_current.vertices += vertices;
+    }
+  }
+  void countUpload(uint64_t bytes) {
+    if (m_enabled) {
+      m_current.bytesUploaded += bytes;
+    }
+  }
+
+  // Completed frames, oldest first (GPU times arrive FRAME_LATENCY frames late)
+  [[nodiscard]] size_t getFrameCount() const { return m_historyCount; }
+  [[nodiscard]] const FrameProfile& getFrame(size_t index) const;
+  [[nodiscard]] const FrameProfile* getLatestFrame() const;
+
+  // ImGui window with frame-time plots, the per-pass table and the counters
+  void drawPanel();
+
+  // Completed frames as Chrome trace JSON (chrome://tracing, Perfetto): CPU passes on one track, GPU on another
+  bool exportChromeTrace(const std::string& path) const;
+
+ private:
+  struct PendingScope {
+    ProfilePass pass;
+    double cpuBegin;
+    double cpuEnd;
+    uint32_t beginQuery;
+    uint32_t endQuery;
+  };
+
+  // Queries and scopes of a frame in flight
+  struct FrameSlot {
+    FrameProfile profile;
+    std::vector<uint32_t> queries;  // Pool, grown on demand
+    uint32_t usedQueries = 0;
+    std::vector<PendingScope> scopes;
+    uint32_t frameBeginQuery = 0;
+    uint32_t frameEndQuery = 0;
+    bool pending = false;
+  };
+
+  bool m_enabled;
+  bool m_inFrame;
+  uint64_t m_frameIndex;
+  std::chrono::steady_clock::time_point m_start;
+  double m_lastBeginUs;
+  double m_gpuOffsetUs;  // CPU time minus GPU time, measured when queries are first used
+  bool m_gpuOffsetValid;
+
+  FrameProfile m_current;
+  std::array<FrameSlot, FRAME_LATENCY> m_slots;
+  std::vector<PendingScope> m_openScopes;
+
+  std::vector<FrameProfile> m_history;  // Ring of HISTORY_SIZE
+  size_t m_historyStart;
+  size_t m_historyCount;
+
+  // Plot scratch, reused across frames
+  std::vector<float> m_plotValues;
+
+  [[nodiscard]] double nowUs() const;
+  uint32_t acquireQuery(FrameSlot& slot);
+  void resolve(FrameSlot& slot);
+  void record(FrameProfile&& profile);
+};
+
+// Times the enclosing block as one pass instance
+class ProfileScope {
+ public:
+  ProfileScope(ProfilerOpenGL& profiler, ProfilePass pass) : m_profiler(profiler), m_pass(pass) {
+    if (m_profiler.isEnabled()) {
+      m_profiler.beginPass(m_pass);
+    }
+  }
+  ~ProfileScope() {
+    if (m_profiler.isEnabled()) {
+      m_profiler.endPass(m_pass);
+    }
+  }
+
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope(ProfileScope&&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+  ProfileScope& operator=(ProfileScope&&) = delete;
+
+ private:
+  ProfilerOpenGL& m_profiler;
+  ProfilePass m_pass;
+};
+
+}  // namespace gfx
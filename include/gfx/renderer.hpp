@@ -1,10 +1,21 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <span>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include <gfx/frame_capture_opengl.hpp>
+#include <gfx/pick_buffer_opengl.hpp>
+#include <gfx/profiler_opengl.hpp>
+#include <gfx/stream_buffer_opengl.hpp>
 #include <gfx/window.hpp>
+#include <util/graph.hpp>
+#include <util/mesh_file.hpp>
 #include <util/types.hpp>
 #include <util/glm.hpp>
 
@@ -22,6 +33,11 @@ class RendererTemplate {
 
   void setViewport(uint32_t width, uint32_t height) { impl.setViewport(width, height); }
 
+  // Viewport size in framebuffer pixels
+  [[nodiscard]] uint32_t getWidth() const { return impl.getWidth(); }
+
+  [[nodiscard]] uint32_t getHeight() const { return impl.getHeight(); }
+
   void clear(const Color& color = Color(0.0f, 0.0f, 0.0f, 1.0f)) { impl.clear(color); }
 
   void beginFrame() { impl.beginFrame(); }
@@ -30,6 +46,27 @@ class RendererTemplate {
 
   float getFramerate() { return impl.getFramerate(); }
 
+  // Block until the GPU has executed everything submitted so far (benchmarks, captures)
+  void finish() { impl.finish(); }
+
+  // Render on demand: waitForFrame() sleeps in the event loop until input or a change needs a frame
+  void setOnDemand(bool enabled) { impl.setOnDemand(enabled); }
+  [[nodiscard]] bool isOnDemand() const { return impl.isOnDemand(); }
+
+  bool waitForFrame(Window& window) { return impl.waitForFrame(window); }
+
+  void requestRedraw(uint32_t frames = 1) { impl.requestRedraw(frames); }
+  [[nodiscard]] bool needsRedraw() const { return impl.needsRedraw(); }
+
+  void setIdleTimeout(double seconds) { impl.setIdleTimeout(seconds); }
+
+  // Persist linked program binaries so later starts skip compilation (before initialize, empty = off)
+  void setShaderCacheDirectory(std::string directory) { impl.setShaderCacheDirectory(std::move(directory)); }
+  [[nodiscard]] bool isShaderCacheEnabled() const { return impl.isShaderCacheEnabled(); }
+
+  // GL calls are only valid on the thread that initialized the renderer
+  [[nodiscard]] bool isRenderThread() const { return impl.isRenderThread(); }
+
   void drawLine(float x1, float y1, float x2, float y2, const Color& color = Color()) {
     impl.drawLine(x1, y1, x2, y2, color);
   }
@@ -42,6 +79,11 @@ class RendererTemplate {
     impl.drawCircle(centerX, centerY, radius, color, filled);
   }
 
+  void drawCircleSDF(float centerX, float centerY, float radius, const Color& color = Color(),
+                     float ringWidth = 0.0f) {
+    impl.drawCircleSDF(centerX, centerY, radius, color, ringWidth);
+  }
+
   void drawTriangle(float x1, float y1, float x2, float y2, float x3, float y3, const Color& color = Color(),
                     bool filled = true) {
     impl.drawTriangle(x1, y1, x2, y2, x3, y3, color, filled);
@@ -52,7 +94,40 @@ class RendererTemplate {
   void drawLines(const std::vector<Vertex2D>& vertices) { impl.drawLines(vertices); }
 
   // Unified mesh rendering API - upload once, draw many times (works for 2D and 3D)
-  MeshGPU uploadMesh(const Mesh3D& mesh) { return impl.uploadMesh(mesh); }
+  MeshGPU uploadMesh(const Mesh2D& mesh, VertexFormat format = VertexFormat::Float32) {
+    return impl.uploadMesh(mesh, format);
+  }
+
+  MeshGPU uploadMesh(const Mesh3D& mesh, VertexFormat format = VertexFormat::Float32) {
+    return impl.uploadMesh(mesh, format);
+  }
+
+  // Graph nodes and edges straight from the CSR attribute arrays
+  MeshGPU uploadGraph(const Graph& graph, VertexFormat format = VertexFormat::Float32) {
+    return impl.uploadGraph(graph, format);
+  }
+
+  // Zero-copy upload of pre-packed sections (see util::MeshFile)
+  MeshGPU uploadMesh(const MeshView& view) { return impl.uploadMesh(view); }
+
+  // Background packing, uploads streamed over the following frames (see MeshRendererOpenGL::uploadMeshAsync)
+  MeshHandle uploadMeshAsync(Mesh2D mesh, VertexFormat format = VertexFormat::Float32) {
+    return impl.uploadMeshAsync(std::move(mesh), format);
+  }
+
+  MeshHandle uploadMeshAsync(Mesh3D mesh, VertexFormat format = VertexFormat::Float32) {
+    return impl.uploadMeshAsync(std::move(mesh), format);
+  }
+
+  MeshHandle uploadGraphAsync(Graph graph, VertexFormat format = VertexFormat::Float32) {
+    return impl.uploadGraphAsync(std::move(graph), format);
+  }
+
+  void setUploadBudget(size_t bytes) { impl.setUploadBudget(bytes); }
+
+  [[nodiscard]] size_t getUploadBudget() const { return impl.getUploadBudget(); }
+
+  [[nodiscard]] size_t getPendingUploadCount() const { return impl.getPendingUploadCount(); }
 
   void drawMesh(const MeshGPU& meshGPU, const glm::mat4& mvp, const Color& tint = Color(1.0f, 1.0f, 1.0f, 1.0f),
                 bool wireframe = false) {
@@ -69,12 +144,181 @@ class RendererTemplate {
     impl.drawMeshPoints(meshGPU, mvp, tint, pointSize);
   }
 
+  // Pending handles are skipped
+  void drawMesh(const MeshHandle& handle, const glm::mat4& mvp, const Color& tint = Color(1.0f, 1.0f, 1.0f, 1.0f),
+                bool wireframe = false) {
+    impl.drawMesh(handle, mvp, tint, wireframe);
+  }
+
+  void drawMeshEdges(const MeshHandle& handle, const glm::mat4& mvp,
+                     const Color& tint = Color(1.0f, 1.0f, 1.0f, 1.0f), float lineWidth = 1.0f) {
+    impl.drawMeshEdges(handle, mvp, tint, lineWidth);
+  }
+
+  void drawMeshPoints(const MeshHandle& handle, const glm::mat4& mvp,
+                      const Color& tint = Color(1.0f, 1.0f, 1.0f, 1.0f), float pointSize = 1.0f) {
+    impl.drawMeshPoints(handle, mvp, tint, pointSize);
+  }
+
+  // Meshes suballocated from shared pool buffers, so queued draws merge into multi-draws
+  PooledMeshGPU uploadMeshPooled(const Mesh2D& mesh, VertexFormat format = VertexFormat::Float32) {
+    return impl.uploadMeshPooled(mesh, format);
+  }
+
+  PooledMeshGPU uploadMeshPooled(const Mesh3D& mesh, VertexFormat format = VertexFormat::Float32) {
+    return impl.uploadMeshPooled(mesh, format);
+  }
+
+  PooledMeshGPU uploadGraphPooled(const Graph& graph, VertexFormat format = VertexFormat::Float32) {
+    return impl.uploadGraphPooled(graph, format);
+  }
+
+  void drawMesh(const PooledMeshGPU& meshGPU, const glm::mat4& mvp, const Color& tint = Color(1.0f, 1.0f, 1.0f, 1.0f),
+                bool wireframe = false) {
+    impl.drawMesh(meshGPU, mvp, tint, wireframe);
+  }
+
+  void drawMeshEdges(const PooledMeshGPU& meshGPU, const glm::mat4& mvp,
+                     const Color& tint = Color(1.0f, 1.0f, 1.0f, 1.0f), float lineWidth = 1.0f) {
+    impl.drawMeshEdges(meshGPU, mvp, tint, lineWidth);
+  }
+
+  void drawMeshPoints(const PooledMeshGPU& meshGPU, const glm::mat4& mvp,
+                      const Color& tint = Color(1.0f, 1.0f, 1.0f, 1.0f), float pointSize = 1.0f) {
+    impl.drawMeshPoints(meshGPU, mvp, tint, pointSize);
+  }
+
+  // Sorted render queue for mesh draws (submitted in endFrame)
+  void setQueueing(bool enabled) { impl.setQueueing(enabled); }
+
+  [[nodiscard]] bool isQueueing() const { return impl.isQueueing(); }
+
+  void flushQueue() { impl.flushQueue(); }
+
+  // Instanced node rendering - one draw call for all nodes, per-node radius / shape / outline
+  NodesGPU uploadNodes(const std::vector<NodeInstance>& nodes) { return impl.uploadNodes(nodes); }
+
+  NodesGPU uploadNodes(const Graph& graph, NodeShape shape = NodeShape::Circle, float outlineWidth = 0.0f) {
+    return impl.uploadNodes(graph, shape, outlineWidth);
+  }
+
+  void drawNodes(const NodesGPU& nodesGPU, const glm::mat4& mvp, const Color& tint = Color(1.0f, 1.0f, 1.0f, 1.0f),
+                 float radiusScale = 1.0f, const Color& outlineColor = Color(0.0f, 0.0f, 0.0f, 1.0f)) {
+    impl.drawNodes(nodesGPU, mvp, tint, radiusScale, outlineColor);
+  }
+
+  // Instanced thick edges - screen-space quads with per-edge pixel width and color, antialiased,
+  // endpoints index the vertices of the mesh they are drawn with
+  EdgesGPU uploadEdges(const std::vector<EdgeInstance>& edges) { return impl.uploadEdges(edges); }
+
+  EdgesGPU uploadEdges(const Graph& graph, float width = 1.0f) { return impl.uploadEdges(graph, width); }
+
+  void drawEdges(const EdgesGPU& edgesGPU, const MeshGPU& vertices, const glm::mat4& mvp,
+                 const Color& tint = Color(1.0f, 1.0f, 1.0f, 1.0f), float widthScale = 1.0f) {
+    impl.drawEdges(edgesGPU, vertices, mvp, tint, widthScale);
+  }
+
+  void drawEdges(const EdgesGPU& edgesGPU, const NodesGPU& nodes, const glm::mat4& mvp,
+                 const Color& tint = Color(1.0f, 1.0f, 1.0f, 1.0f), float widthScale = 1.0f) {
+    impl.drawEdges(edgesGPU, nodes, mvp, tint, widthScale);
+  }
+
+  // GPU picking into an integer ID target, read back asynchronously (see MeshRendererOpenGL::beginPicking)
+  bool beginPicking() { return impl.beginPicking(); }
+
+  void pickMeshEdges(const MeshGPU& meshGPU, const glm::mat4& mvp, float lineWidth = 1.0f) {
+    impl.pickMeshEdges(meshGPU, mvp, lineWidth);
+  }
+
+  void pickMeshPoints(const MeshGPU& meshGPU, const glm::mat4& mvp, float pointSize = 1.0f) {
+    impl.pickMeshPoints(meshGPU, mvp, pointSize);
+  }
+
+  void pickNodes(const NodesGPU& nodesGPU, const glm::mat4& mvp, float radiusScale = 1.0f) {
+    impl.pickNodes(nodesGPU, mvp, radiusScale);
+  }
+
+  void endPicking() { impl.endPicking(); }
+
+  uint64_t requestPick(uint32_t x, uint32_t y, uint32_t radius = 2) { return impl.requestPick(x, y, radius); }
+
+  uint64_t requestBoxSelection(uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1) {
+    return impl.requestBoxSelection(x0, y0, x1, y1);
+  }
+
+  std::vector<PickResult> takePickResults() { return impl.takePickResults(); }
+
+  // In-place partial updates of uploaded meshes (no re-upload, topology unchanged)
+  void updateMeshVertices(MeshGPU& meshGPU, std::span<const Vertex2D> vertices, size_t offset = 0) {
+    impl.updateMeshVertices(meshGPU, vertices, offset);
+  }
+
+  void updateMeshVertices(MeshGPU& meshGPU, std::span<const Vertex3D> vertices, size_t offset = 0) {
+    impl.updateMeshVertices(meshGPU, vertices, offset);
+  }
+
+  void updateMeshPositions(MeshGPU& meshGPU, std::span<const glm::vec3> positions, size_t offset = 0) {
+    impl.updateMeshPositions(meshGPU, positions, offset);
+  }
+
+  void updateMeshColors(MeshGPU& meshGPU, std::span<const Color> colors, size_t offset = 0) {
+    impl.updateMeshColors(meshGPU, colors, offset);
+  }
+
+  // Source positions from a GPU-resident buffer (e.g. gfx::GpuLayout) instead of the mesh's own
+  void bindMeshPositions(MeshGPU& meshGPU, uint32_t buffer, size_t stride = 4 * sizeof(float)) {
+    impl.bindMeshPositions(meshGPU, buffer, stride);
+  }
+
+  void bindNodePositions(NodesGPU& nodesGPU, uint32_t buffer) { impl.bindNodePositions(nodesGPU, buffer); }
+
+  // Frustum culling of mesh chunks (spatial index built at upload)
+  void setCulling(bool enabled) { impl.setCulling(enabled); }
+
+  [[nodiscard]] bool isCulling() const { return impl.isCulling(); }
+
   void freeMesh(MeshGPU& meshGPU) { impl.freeMesh(meshGPU); }
 
+  void freeMesh(MeshHandle& handle) { impl.freeMesh(handle); }
+
+  void freeMesh(PooledMeshGPU& meshGPU) { impl.freeMesh(meshGPU); }
+
+  void freeNodes(NodesGPU& nodesGPU) { impl.freeNodes(nodesGPU); }
+  void freeEdges(EdgesGPU& edgesGPU) { impl.freeEdges(edgesGPU); }
+
   void setColor(const Color& color) { impl.setColor(color); }
 
   void setBlending(bool enabled) { impl.setBlending(enabled); }
 
+  // Deferred draw-list mode for 2D primitives (flushed automatically in endFrame)
+  void setBatching(bool enabled) { impl.setBatching(enabled); }
+
+  [[nodiscard]] bool isBatching() const { return impl.isBatching(); }
+
+  void flushBatches() { impl.flushBatches(); }
+
+  void setVertexFormat(VertexFormat format) { impl.setVertexFormat(format); }
+
+  [[nodiscard]] VertexFormat getVertexFormat() const { return impl.getVertexFormat(); }
+
+  [[nodiscard]] const StreamStats& getStreamStats() const { return impl.getStreamStats(); }
+
+  // Pass timings, counters, ImGui panel and Chrome trace export
+  [[nodiscard]] ProfilerOpenGL& getProfiler() { return impl.getProfiler(); }
+
+  [[nodiscard]] const ProfilerOpenGL& getProfiler() const { return impl.getProfiler(); }
+
+  // Recording of every frame into a PNG sequence or an encoder pipe, frames read back asynchronously
+  [[nodiscard]] FrameCaptureOpenGL& getFrameCapture() { return impl.getFrameCapture(); }
+
+  [[nodiscard]] const FrameCaptureOpenGL& getFrameCapture() const { return impl.getFrameCapture(); }
+
+  // Tiled still of any size; draw renders the scene with the tile transform in front of its projections
+  bool captureStill(const std::string& path, uint32_t width, uint32_t height,
+                    const std::function<void(const glm::mat4&)>& draw) {
+    return impl.captureStill(path, width, height, draw);
+  }
+
  private:
   ImplType impl;
 };
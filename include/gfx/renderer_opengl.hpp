@@ -1,11 +1,26 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <span>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
+#include <util/circle_geometry.hpp>
+#include <util/glm.hpp>
 #include <util/types.hpp>
-
+#include <util/vertex_layout.hpp>
+
+#include <gfx/frame_capture_opengl.hpp>
+#include <gfx/profiler_opengl.hpp>
+#include <gfx/shader_cache_opengl.hpp>
+#include <gfx/shader_program_opengl.hpp>
+#include <gfx/state_cache_opengl.hpp>
+#include <gfx/stream_buffer_opengl.hpp>
 #include <gfx/window.hpp>
 
 namespace gfx {
@@ -24,64 +39,191 @@ class RendererOpenGL {
 
   bool initialize(const Window& window, uint32_t width, uint32_t height);
   void setViewport(uint32_t width, uint32_t height);
-  static void clear(const Color& color);
-  static void beginFrame();
-  static void endFrame();
+  void clear(const Color& color);
+  void beginFrame();
+  void endFrame();
 
   static float getFramerate();
 
+  // Block until the GPU has executed everything submitted so far
+  static void finish();
+
+  // Render on demand: instead of redrawing every frame, waitForFrame() sleeps in the window's event loop
+  // until input arrives or something marks the frame dirty (uploads, buffer updates, renderer state
+  // changes, requestRedraw). Off by default; the loop becomes
+  //   while (!window.shouldClose()) { if (!renderer.waitForFrame(window)) continue; ... }
+  void setOnDemand(bool enabled);
+  [[nodiscard]] bool isOnDemand() const { return m_onDemand; }
+
+  // Poll events and report whether a frame should be drawn (always true when rendering continuously)
+  bool waitForFrame(Window& window);
+
+  // Draw at least the next frames frames, e.g. while the application animates
+  void requestRedraw(uint32_t frames = 1);
+  [[nodiscard]] bool needsRedraw() const { return m_redrawFrames > 0; }
+
+  // Longest sleep in waitForFrame() while nothing is dirty
+  void setIdleTimeout(double seconds) { m_idleTimeout = seconds; }
+
+  // Persist linked program binaries under directory so later starts skip shader compilation (set before
+  // initialize; empty = off, the default). Ignored when the driver cannot return program binaries.
+  void setShaderCacheDirectory(std::string directory) { m_shaderCacheDirectory = std::move(directory); }
+  [[nodiscard]] bool isShaderCacheEnabled() const { return m_shaderCache.isEnabled(); }
+
+  // The GL context is confined to the thread that initialized the renderer; other threads hand their
+  // results over (e.g. util::SnapshotProducer) instead of calling into it
+  [[nodiscard]] bool isRenderThread() const { return std::this_thread::get_id() == m_renderThread; }
+
   // Viewport accessors
   [[nodiscard]] uint32_t getWidth() const { return m_width; }
   [[nodiscard]] uint32_t getHeight() const { return m_height; }
 
   void drawLine(float x1, float y1, float x2, float y2, const Color& color);
   void drawRectangle(float x, float y, float width, float height, const Color& color, bool filled);
+  // Polygon from the precomputed unit circle of the radius' tessellation level (no per-call trig)
   void drawCircle(float centerX, float centerY, float radius, const Color& color, bool filled);
+
+  // Analytic antialiased circle on a single quad; ringWidth > 0 draws a ring of that many pixels
+  // inside the radius. Batched SDF circles are submitted in one instanced draw.
+  void drawCircleSDF(float centerX, float centerY, float radius, const Color& color, float ringWidth = 0.0f);
   void drawTriangle(float x1, float y1, float x2, float y2, float x3, float y3, const Color& color, bool filled);
   void drawTriangles(const std::vector<Vertex2D>& vertices);
   void drawLines(const std::vector<Vertex2D>& vertices);
 
   void setColor(const Color& color);
   void setBlending(bool enabled);
+  [[nodiscard]] bool isBlending() const { return m_blendingEnabled; }
+
+  // Deferred draw-list mode: 2D primitives are appended to per-frame vertex arrays
+  // and submitted in a few large draws by flushBatches() (called from endFrame())
+  void setBatching(bool enabled);
+  [[nodiscard]] bool isBatching() const { return m_batchingEnabled; }
+  void flushBatches();
+
+  // Vertex layout of the dynamic 2D paths (compact formats cut stream bandwidth 2-3x)
+  void setVertexFormat(VertexFormat format);
+  [[nodiscard]] VertexFormat getVertexFormat() const { return m_vertexFormat; }
+
+  // Streaming statistics of the last completed frame
+  [[nodiscard]] const StreamStats& getStreamStats() const { return m_streamBuffer.getStats(); }
+
+  // Per-pass CPU / GPU timers and counters (disabled until enabled on the profiler)
+  [[nodiscard]] ProfilerOpenGL& getProfiler() { return m_profiler; }
+  [[nodiscard]] const ProfilerOpenGL& getProfiler() const { return m_profiler; }
+
+  // Recording: while the capture records, endFrame() reads each frame before the UI is drawn (see
+  // FrameCaptureOpenGL for the sinks). Reads are asynchronous; frames are dropped rather than stall.
+  [[nodiscard]] FrameCaptureOpenGL& getFrameCapture() { return m_capture; }
+  [[nodiscard]] const FrameCaptureOpenGL& getFrameCapture() const { return m_capture; }
+
+  // Still of width x height pixels, also beyond the largest framebuffer: draw renders the scene once per
+  // tile of an offscreen target, with the pixel-space projection and the viewport set to the tile. draw
+  // receives the tile transform to put in front of its own projections (tileTransform * mvp). The tiles
+  // render within this call, their readback and the PNG encoding run in the background.
+  bool captureStill(const std::string& path, uint32_t width, uint32_t height,
+                    const std::function<void(const glm::mat4&)>& draw);
 
  private:
   // OpenGL state
   uint32_t m_width;
   uint32_t m_height;
   bool m_initialized;
+  std::thread::id m_renderThread;
   Color m_currentColor;
   bool m_blendingEnabled;
 
-  // Shader program handles
-  uint32_t m_basicShaderProgram;
-  uint32_t m_lineShaderProgram;
-
-  // VAO/VBO handles for different primitives
-  uint32_t m_quadVAO;
-  uint32_t m_quadVBO;
-  uint32_t m_lineVAO;
-  uint32_t m_lineVBO;
-  uint32_t m_triangleVAO;
-  uint32_t m_triangleVBO;
-  uint32_t m_circleVAO;
+  // Per-instance data of an SDF circle, streamed like the 2D vertices
+  struct CircleInstance {
+    glm::vec2 center;
+    float radius;
+    float ringWidth;  // 0 = filled
+    Color color;
+  };
+
+  // Center, radius and ring width read as one vec4 (location 1), color at location 2
+  static constexpr std::array<VertexAttribute, 2> CIRCLE_INSTANCE_ATTRIBUTES = {
+      attribute(1, offsetof(CircleInstance, center), 4, AttributeType::Float32),
+      attribute<Color>(2, offsetof(CircleInstance, color)),
+  };
+
+  // Shader programs, created up front in initialize
+  std::string m_shaderCacheDirectory;
+  ShaderCacheOpenGL m_shaderCache;
+  ShaderProgramOpenGL m_basicShaderProgram;
+  ShaderProgramOpenGL m_lineShaderProgram;
+  ShaderProgramOpenGL m_circleShaderProgram;
+  ShaderProgramOpenGL m_sdfCircleShaderProgram;
+  int m_circleLocation;
+
+  // Unit circles of every tessellation level in one static buffer: a center vertex followed by the
+  // closed ring of each level, so fans and loops draw straight from it
   uint32_t m_circleVBO;
+  uint32_t m_circleVAO;
+  std::array<int32_t, CIRCLE_LEVEL_COUNT> m_circleFirsts;
+
+  // Quad corners for SDF circles, instances come from the stream ring
+  uint32_t m_sdfQuadVBO;
+  uint32_t m_sdfCircleVAO;
+
+  // Shadow of the GL state, shared with derived renderers
+  StateCacheOpenGL m_state;
+
+  // Pixel-space projection, the version is bumped whenever the viewport changes
+  glm::mat4 m_projection;
+  uint64_t m_projectionVersion;
+
+  // Streaming ring shared by all dynamic 2D paths (interleaved position, color)
+  static constexpr size_t STREAM_REGION_SIZE = 4 * 1024 * 1024;
+  StreamBufferOpenGL m_streamBuffer;
+  uint32_t m_streamVAO;
+  uint32_t m_streamGeneration;
+  VertexFormat m_vertexFormat;
+
+  ProfilerOpenGL m_profiler;
+
+  // Recording and stills; tiles of a still are at most this large on either side
+  static constexpr uint32_t MAX_STILL_TILE_SIZE = 4096;
+  FrameCaptureOpenGL m_capture;
+
+  // On-demand rendering; ImGui needs a frame to react to input and one to settle
+  static constexpr uint32_t INPUT_REDRAW_FRAMES = 2;
+  bool m_onDemand;
+  uint32_t m_redrawFrames;
+  double m_idleTimeout;
+
+  // Draw-list state, reused across frames
+  bool m_batchingEnabled;
+  std::vector<Vertex2D> m_batchTriangles;
+  std::vector<Vertex2D> m_batchLines;
+  std::vector<CircleInstance> m_batchCircles;
 
   void cleanup();
 
   bool loadShaders();
-  static bool compileShader(const std::string& source, uint32_t type, uint32_t& shader);
+  void updateProjection();
 
-  void setupQuadGeometry();
-  void setupLineGeometry();
-  void setupTriangleGeometry();
+  void setupStreamGeometry();
   void setupCircleGeometry();
+  void submitBatch(ShaderProgramOpenGL& program, uint32_t mode, const std::vector<Vertex2D>& vertices);
+  void drawStreamed(uint32_t mode, std::span<const Vertex2D> vertices);
+  void drawCirclesStreamed(std::span<const CircleInstance> circles);
 
  protected:
-  static void useShader(uint32_t program);
-  static bool createShaderProgram(const std::string& vertexSource, const std::string& fragmentSource,
-                                  uint32_t& program);
-  static void setUniformColor(uint32_t program, const Color& color);
-  void updateProjectionMatrix(uint32_t program) const;
+  void useShader(const ShaderProgramOpenGL& program);
+  static void setUniformColor(ShaderProgramOpenGL& program, const Color& color);
+  void updateProjectionMatrix(ShaderProgramOpenGL& program) const;
+
+  // GL state changes of derived renderers go through the same cache
+  StateCacheOpenGL& getState() { return m_state; }
+
+  // Program binaries of derived renderers go through the same cache
+  [[nodiscard]] const ShaderCacheOpenGL& getShaderCache() const { return m_shaderCache; }
+
+  // Re-apply the user blending setting after paths that force blending on
+  void applyBlending() { setBlending(m_blendingEnabled); }
+
+  // Streaming ring for derived renderers (staging of buffer updates)
+  StreamBufferOpenGL& getStreamBuffer() { return m_streamBuffer; }
 };
 
 }  // namespace gfx
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <gfx/shader_program_opengl.hpp>
+
+namespace gfx {
+
+// On-disk cache of linked program binaries (ARB_get_program_binary). Entries are keyed by a hash of the
+// driver identity (vendor, renderer, version string) and the program sources, so a driver update or an
+// edited shader simply misses and the program is compiled and stored again. Without binary support, or
+// without a directory, the cache stays disabled and every program is compiled from source.
+//
+// File per program: ShaderCacheHeader followed by the binary, named after the key in hex.
+class ShaderCacheOpenGL {
+ public:
+  ShaderCacheOpenGL();
+  ~ShaderCacheOpenGL() = default;
+
+  ShaderCacheOpenGL(const ShaderCacheOpenGL&) = delete;
+  ShaderCacheOpenGL(ShaderCacheOpenGL&&) = delete;
+  ShaderCacheOpenGL& operator=(const ShaderCacheOpenGL&) = delete;
+  ShaderCacheOpenGL& operator=(ShaderCacheOpenGL&&) = delete;
+
+  // Needs a current context; the directory is created on the first store. False = cache disabled
+  bool initialize(const std::string& directory);
+
+  [[nodiscard]] bool isEnabled() const { return m_enabled; }
+
+  [[nodiscard]] uint64_t getKey(const ShaderSources& sources) const;
+
+  // Load the stored binary into program (linked on success); false when missing or rejected
+  bool load(uint64_t key, uint32_t program) const;
+
+  // Store the binary of a linked program, created with GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+  void store(uint64_t key, uint32_t program) const;
+
+ private:
+  std::string m_directory;
+  std::string m_driver;
+  bool m_enabled;
+
+  [[nodiscard]] std::string getPath(uint64_t key) const;
+};
+
+}  // namespace gfx
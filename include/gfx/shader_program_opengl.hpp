@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <util/glm.hpp>
+#include <util/types.hpp>
+
+namespace gfx {
+
+class ShaderCacheOpenGL;
+
+// Stage sources of a program; an empty fragment source gives a vertex-only program (transform feedback)
+struct ShaderSources {
+  std::string_view vertex{};
+  std::string_view fragment{};
+  std::string_view geometry{};  // Empty = no geometry stage
+  std::span<const char* const> feedbackVaryings{};
+};
+
+// GLSL for the vertex shaders that expand antialiased shapes (nodes, thick edges, SDF circles) into quads,
+// inserted after #version: quads reach AA_FRINGE pixels past the shape so its antialiased fringe is not clipped
+inline const std::string AA_FRINGE_GLSL = "const float AA_FRINGE = 1.0;\n";
+
+// Linked GL program with its uniform locations resolved once at link time.
+// The common uniforms (uTint, uMVP, uProjection) also remember their last value,
+// so repeated draws with the same tint / matrices skip the upload.
+class ShaderProgramOpenGL {
+ public:
+  ShaderProgramOpenGL();
+  ~ShaderProgramOpenGL();
+
+  ShaderProgramOpenGL(const ShaderProgramOpenGL&) = delete;
+  ShaderProgramOpenGL(ShaderProgramOpenGL&&) = delete;
+  ShaderProgramOpenGL& operator=(const ShaderProgramOpenGL&) = delete;
+  ShaderProgramOpenGL& operator=(ShaderProgramOpenGL&&) = delete;
+
+  // Compile and link; an empty fragment source gives a vertex-only program (transform feedback)
+  bool create(const std::string& vertexSource, const std::string& fragmentSource,
+              std::span<const char* const> feedbackVaryings = {});
+
+  // Compile and link with a geometry stage between the vertex and fragment stages
+  bool create(const std::string& vertexSource, const std::string& geometrySource, const std::string& fragmentSource);
+
+  // Two-phase creation: beginCreate loads the linked binary from the cache or issues compile and link
+  // without waiting, so the driver builds every begun program concurrently (KHR_parallel_shader_compile).
+  // finishCreate waits for the result, stores new binaries in the cache and resolves the uniforms.
+  void beginCreate(const ShaderSources& sources, const ShaderCacheOpenGL* cache = nullptr);
+  [[nodiscard]] bool isCreateComplete() const;  // Never blocks, true once finishCreate would not wait
+  bool finishCreate();
+
+  void destroy();
+
+  [[nodiscard]] uint32_t getId() const { return m_program; }
+  [[nodiscard]] bool isValid() const { return m_program != 0; }
+
+  // Location from the link-time table (-1 if the uniform is not active), no GL call
+  [[nodiscard]] int getUniformLocation(std::string_view name) const;
+
+  // Uniform uploads for the current program, -1 locations are ignored
+  static void setUniform(int location, int value);
+  static void setUniform(int location, uint32_t value);
+  static void setUniform(int location, float value);
+  static void setUniform(int location, const glm::vec2& value);
+  static void setUniform(int location, const glm::vec4& value);
+  static void setUniform(int location, const glm::mat4& value);
+
+  // Common uniforms, uploaded only when the value changed (program must be current)
+  void setTint(const util::Color& color);
+  void setMVP(const glm::mat4& mvp);
+  void setProjection(const glm::mat4& projection, uint64_t version);
+
+ private:
+  uint32_t m_program;
+  std::vector<std::pair<std::string, int>> m_uniforms;
+
+  int m_tintLocation;
+  int m_mvpLocation;
+  int m_projectionLocation;
+
+  // Last uploaded values
+  util::Color m_tint;
+  glm::mat4 m_mvp;
+  bool m_tintValid;
+  bool m_mvpValid;
+  uint64_t m_projectionVersion;  // 0 = never uploaded
+
+  // Creation between beginCreate and finishCreate
+  const ShaderCacheOpenGL* m_cache;
+  uint64_t m_cacheKey;
+  bool m_pending;
+  bool m_cached;  // Loaded from the cache, nothing to store
+
+  static uint32_t compileShader(std::string_view source, uint32_t type);
+  void resolveUniforms();
+};
+
+}  // namespace gfx
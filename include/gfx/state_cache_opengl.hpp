@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace gfx {
+
+// Capabilities toggled by the renderers
+enum class Capability : uint8_t { Blend, DepthTest, CullFace, ProgramPointSize, Count };
+
+// Shadow copy of the GL state the renderers touch, redundant binds and toggles are skipped.
+// Every change of this state has to go through the cache (or be followed by invalidate()),
+// otherwise the shadow copy and the context disagree.
+class StateCacheOpenGL {
+ public:
+  StateCacheOpenGL();
+
+  StateCacheOpenGL(const StateCacheOpenGL&) = delete;
+  StateCacheOpenGL(StateCacheOpenGL&&) = delete;
+  StateCacheOpenGL& operator=(const StateCacheOpenGL&) = delete;
+  StateCacheOpenGL& operator=(StateCacheOpenGL&&) = delete;
+
+  void useProgram(uint32_t program);
+  void bindVertexArray(uint32_t vao);
+
+  // Deleting the bound object resets the binding to 0 in GL, mirror that
+  void forgetProgram(uint32_t program);
+  void forgetVertexArray(uint32_t vao);
+
+  void setEnabled(Capability capability, bool enabled);
+  void setBlendFunc(uint32_t source, uint32_t destination);
+  void setPolygonMode(uint32_t mode);
+  void setLineWidth(float width);
+  void setDepthFunc(uint32_t func);
+
+  // Current depth function, queried from the context once when unknown (used to restore it)
+  [[nodiscard]] uint32_t getDepthFunc();
+
+  // Forget everything, e.g. after code that changes state behind the cache (ImGui)
+  void invalidate();
+
+  // Number of GL calls issued vs. skipped since the last resetStats()
+  [[nodiscard]] uint32_t getIssuedCount() const { return m_issued; }
+  [[nodiscard]] uint32_t getSkippedCount() const { return m_skipped; }
+  void resetStats() { m_issued = m_skipped = 0; }
+
+ private:
+  // Unknown values never compare equal to a requested one
+  static constexpr uint32_t UNKNOWN = 0xFFFFFFFFu;
+
+  uint32_t m_program;
+  uint32_t m_vao;
+  std::array<int8_t, static_cast<size_t>(Capability::Count)> m_enabled;  // -1 = unknown
+  uint32_t m_blendSource;
+  uint32_t m_blendDestination;
+  uint32_t m_polygonMode;
+  float m_lineWidth;  // < 0 = unknown
+  uint32_t m_depthFunc;
+
+  uint32_t m_issued;
+  uint32_t m_skipped;
+
+  bool skip(bool redundant);
+};
+
+}  // namespace gfx
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace gfx {
+
+// Per-frame streaming statistics
+struct StreamStats {
+  size_t bytesStreamed = 0;  // Bytes written into the ring
+  uint32_t allocations = 0;  // Number of allocate() calls
+  uint32_t fenceWaits = 0;   // Times the CPU had to block on a GPU fence
+};
+
+// CPU-writable range of the stream buffer; offset is relative to the start of the GL buffer
+struct StreamAllocation {
+  void* data = nullptr;
+  size_t offset = 0;
+
+  [[nodiscard]] bool isValid() const { return data != nullptr; }
+};
+
+// Triple-buffered ring for dynamic vertex data. Each frame writes into its own region which is
+// fenced in endFrame(), so CPU writes overlap with GPU reads of the previous two frames instead of
+// orphaning driver storage. Uses a persistent coherent mapping when ARB_buffer_storage is available,
+// otherwise unsynchronized glMapBufferRange on the fenced region.
+class StreamBufferOpenGL {
+ public:
+  static constexpr uint32_t REGION_COUNT = 3;
+
+  StreamBufferOpenGL();
+  ~StreamBufferOpenGL();
+
+  StreamBufferOpenGL(const StreamBufferOpenGL&) = delete;
+  StreamBufferOpenGL(StreamBufferOpenGL&&) = delete;
+  StreamBufferOpenGL& operator=(const StreamBufferOpenGL&) = delete;
+  StreamBufferOpenGL& operator=(StreamBufferOpenGL&&) = delete;
+
+  bool initialize(size_t regionSize);
+  void cleanup();
+
+  // Wait for the GPU to release this frame's region / fence it and move to the next one
+  void beginFrame();
+  void endFrame();
+
+  // Reserve bytes aligned to a multiple of alignment (e.g. the vertex stride); commit() before drawing
+  StreamAllocation allocate(size_t bytes, size_t alignment);
+  void commit();
+
+  // Convenience: allocate + memcpy + commit, returns the byte offset or SIZE_MAX on failure
+  size_t write(const void* data, size_t bytes, size_t alignment);
+
+  [[nodiscard]] uint32_t getBuffer() const { return m_buffer; }
+  [[nodiscard]] bool isPersistent() const { return m_persistentData != nullptr; }
+
+  // Incremented whenever the GL buffer is recreated; VAOs referencing it must be re-specified
+  [[nodiscard]] uint32_t getGeneration() const { return m_generation; }
+
+  // Stats of the last completed frame
+  [[nodiscard]] const StreamStats& getStats() const { return m_lastStats; }
+
+ private:
+  uint32_t m_buffer;
+  uint32_t m_generation;
+  size_t m_regionSize;
+  uint32_t m_region;
+  size_t m_head;  // Write offset inside the current region
+  bool m_mapped;
+  void* m_persistentData;
+  std::array<void*, REGION_COUNT> m_fences;
+
+  StreamStats m_stats;
+  StreamStats m_lastStats;
+
+  bool createBuffer(size_t regionSize);
+  void destroyBuffer();
+  void fenceRegion();
+  void waitRegion(uint32_t region);
+};
+
+}  // namespace gfx
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <util/vertex_layout.hpp>
+
+namespace gfx {
+
+// Point the attributes of the bound VAO at the bound GL_ARRAY_BUFFER, offsets relative to baseOffset.
+// Attributes with stride 0 use elementStride. Enabling and divisors are VAO state and set separately,
+// so per-draw re-pointing (e.g. at a stream ring allocation) stays a pointer update.
+void pointVertexAttributes(std::span<const util::VertexAttribute> attributes, size_t elementStride,
+                           size_t baseOffset = 0);
+
+// Enable the attributes with their divisor (0 = per vertex, 1 = per instance)
+void enableVertexAttributes(std::span<const util::VertexAttribute> attributes, uint32_t divisor = 0);
+
+// Bind an interleaved layout: point and enable every attribute of VertexLayout<T>
+template <util::HasVertexLayout T>
+void applyVertexLayout(size_t baseOffset = 0, uint32_t divisor = 0) {
+  pointVertexAttributes(util::VertexLayout<T>::ATTRIBUTES, sizeof(T), baseOffset);
+  enableVertexAttributes(util::VertexLayout<T>::ATTRIBUTES, divisor);
+}
+
+// Bind a split or runtime layout (every attribute carries its own stride)
+inline void applyVertexLayout(std::span<const util::VertexAttribute> attributes, uint32_t divisor = 0) {
+  pointVertexAttributes(attributes, 0);
+  enableVertexAttributes(attributes, divisor);
+}
+
+}  // namespace gfx
@@ -21,6 +21,15 @@ class WindowTemplate {
 
   void pollEvents() { impl.pollEvents(); }
 
+  // Sleep until an event arrives or timeoutSeconds pass (on-demand rendering)
+  void waitEvents(double timeoutSeconds) { impl.waitEvents(timeoutSeconds); }
+
+  // Wake a thread blocked in waitEvents(), callable from any thread
+  static void postEmptyEvent() { ImplType::postEmptyEvent(); }
+
+  // True once after input, resize, focus or expose events arrived since the last call
+  bool takeInput() { return impl.takeInput(); }
+
   void swapBuffers() { impl.swapBuffers(); }
 
   [[nodiscard]] uint32_t getWidth() const { return impl.getWidth(); }
@@ -33,6 +42,13 @@ class WindowTemplate {
 
   void setFullscreen(bool fullscreen) { impl.setFullscreen(fullscreen); }
 
+  // 0 = no vsync (benchmarks), n = sync to every n-th vertical blank, -1 = adaptive (late frames tear
+  // instead of waiting for the next blank). Can be set before initialize(); false when adaptive is not
+  // supported and plain vsync is used instead.
+  bool setSwapInterval(int interval) { return impl.setSwapInterval(interval); }
+
+  [[nodiscard]] int getSwapInterval() const { return impl.getSwapInterval(); }
+
   [[nodiscard]] GLFWwindow* getNativeWindow() const { return impl.getNativeWindow(); }
 
  private:
@@ -20,12 +20,17 @@ class WindowGLFW {
   bool initialize(uint32_t width, uint32_t height, const std::string& title, bool visible = true);
   [[nodiscard]] bool shouldClose() const;
   void pollEvents();
+  void waitEvents(double timeoutSeconds);
+  static void postEmptyEvent();
+  bool takeInput();
   void swapBuffers();
   [[nodiscard]] uint32_t getWidth() const;
   [[nodiscard]] uint32_t getHeight() const;
   void setTitle(const std::string& title);
   void setResizable(bool resizable);
   void setFullscreen(bool fullscreen);
+  bool setSwapInterval(int interval);
+  [[nodiscard]] int getSwapInterval() const;
   [[nodiscard]] GLFWwindow* getNativeWindow() const;
 
  private:
@@ -34,8 +39,13 @@ class WindowGLFW {
   uint32_t m_height;
   bool m_fullscreen;
   bool m_initialized;
+  int m_swapInterval;
+  bool m_inputPending;
 
   void cleanup();
+  void installCallbacks();
+  static void markInput(GLFWwindow* window);
+  bool applySwapInterval();
 };
 
 }  // namespace gfx
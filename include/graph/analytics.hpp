@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <util/graph.hpp>
+#include <util/thread_pool.hpp>
+#include <util/types.hpp>
+
+namespace graph {
+
+// BFS distance of nodes that cannot be reached from the source
+inline constexpr uint32_t UNREACHED = UINT32_MAX;
+
+// Node degree (out-degree of directed graphs) divided by the largest degree, so values lie in [0, 1]
+std::vector<float> degreeCentrality(const util::Graph& graph, util::ThreadPool& pool = util::ThreadPool::global());
+
+// Hop distances from source, UNREACHED elsewhere. Direction-optimizing: small frontiers expand top-down,
+// large ones switch to bottom-up, where each unvisited node scans its neighbors for a parent and stops at
+// the first hit. Directed graphs follow out-edges (bottom-up steps then use a transposed adjacency).
+std::vector<uint32_t> bfsDistances(const util::Graph& graph, uint32_t source,
+                                   util::ThreadPool& pool = util::ThreadPool::global());
+
+struct Components {
+  std::vector<uint32_t> labels;  // Component of every node, numbered by their smallest node
+  uint32_t count = 0;
+};
+
+// Weakly connected components by concurrent union-find over the edge array (lock-free linking of the
+// larger root under the smaller one, path halving on every find)
+Components connectedComponents(const util::Graph& graph, util::ThreadPool& pool = util::ThreadPool::global());
+
+struct PageRankParams {
+  float damping = 0.85f;
+  uint32_t maxIterations = 100;
+  float tolerance = 1e-6f;  // Stop once the L1 change of an iteration drops below this
+};
+
+// Unweighted PageRank by pull iterations (ranks sum to 1, dangling nodes spread their rank evenly).
+// Undirected edges count in both directions.
+std::vector<float> pageRank(const util::Graph& graph, const PageRankParams& params = PageRankParams(),
+                            util::ThreadPool& pool = util::ThreadPool::global());
+
+// Visual encodings: write analytics results into per-node attribute arrays (graph.colors / graph.sizes or a
+// mesh's colors) that go straight to the in-place updates (MeshRenderer::updateMeshColors). Values are
+// rescaled to their own [min, max] range first.
+void colorByValue(std::span<const float> values, std::span<util::Color> colors,
+                  util::ThreadPool& pool = util::ThreadPool::global());
+void colorByDistance(std::span<const uint32_t> distances, std::span<util::Color> colors,
+                     const util::Color& unreached = util::Color(0.3f, 0.3f, 0.3f, 1.0f),
+                     util::ThreadPool& pool = util::ThreadPool::global());
+void colorByCategory(std::span<const uint32_t> labels, std::span<util::Color> colors,
+                     util::ThreadPool& pool = util::ThreadPool::global());
+void sizeByValue(std::span<const float> values, std::span<float> sizes, float minSize, float maxSize,
+                 util::ThreadPool& pool = util::ThreadPool::global());
+
+// Color of t in [0, 1] on a perceptually ordered dark blue -> teal -> yellow ramp
+util::Color rampColor(float t);
+
+// Distinct, stable color of a category index
+util::Color categoryColor(uint32_t category);
+
+}  // namespace graph
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <util/glm.hpp>
+#include <util/graph.hpp>
+#include <util/spatial_index.hpp>
+
+namespace graph {
+
+struct ClusterParams {
+  uint32_t maxLevels = 16;      // Coarse levels above the input graph
+  uint32_t minNodes = 64;       // Stop once a level has at most this many super-nodes
+  float minReduction = 0.1f;    // Stop when a level removes less than this fraction of the nodes
+  uint32_t seed = 1;            // Visit order of the matching
+};
+
+// Level selection from the projected screen density
+struct LodParams {
+  float maxEdgesPerPixel = 0.25f;  // Edges per pixel of the projected graph bounds
+  uint64_t edgeBudget = 500'000;   // Edges expected inside the viewport
+};
+
+// One coarse level: super-nodes with aggregated attributes (member-weighted centroid and color,
+// area-preserving size) and bundled super-edges whose weight is the summed weight of the edges they stand for
+struct ClusterLevel {
+  util::Graph graph;
+  std::vector<uint32_t> parents;       // Node of the next finer level -> super-node of this level
+  std::vector<uint32_t> memberCounts;  // Input nodes per super-node
+};
+
+// Multilevel cluster hierarchy for level-of-detail rendering. Each level contracts the previous one by
+// heavy-edge matching (edge weight normalized by cluster sizes, so tightly connected small clusters merge
+// first); nodes left unmatched join the cluster of their strongest neighbor. Level 0 is the input graph.
+// Levels can be built in the background and become visible one at a time as they finish.
+class ClusterHierarchy {
+ public:
+  ClusterHierarchy();
+  ~ClusterHierarchy();
+
+  ClusterHierarchy(const ClusterHierarchy&) = delete;
+  ClusterHierarchy(ClusterHierarchy&&) = delete;
+  ClusterHierarchy& operator=(const ClusterHierarchy&) = delete;
+  ClusterHierarchy& operator=(ClusterHierarchy&&) = delete;
+
+  // Build all levels before returning (the graph is copied, it need not outlive the hierarchy)
+  void build(const util::Graph& graph, const ClusterParams& params = ClusterParams());
+
+  // Build on a background thread, getLevelCount() grows as levels are published
+  void buildAsync(const util::Graph& graph, const ClusterParams& params = ClusterParams());
+
+  // Stop a background build after the current level and wait for it
+  void cancel();
+
+  [[nodiscard]] bool isBuilding() const { return m_building.load(std::memory_order_acquire); }
+
+  // Published coarse levels; valid level indices are 0 (input) .. getLevelCount()
+  [[nodiscard]] uint32_t getLevelCount() const { return m_readyLevels.load(std::memory_order_acquire); }
+
+  // level >= 1; references stay valid until the next build
+  [[nodiscard]] const ClusterLevel& getLevel(uint32_t level) const { return *m_levels[level - 1]; }
+
+  // Node, edge count of a level including level 0
+  [[nodiscard]] uint32_t getNodeCount(uint32_t level) const;
+  [[nodiscard]] uint32_t getEdgeCount(uint32_t level) const;
+
+  // Re-aggregate the super-node positions of all published levels after the input moved (e.g. a layout)
+  void updatePositions(std::span<const glm::vec3> positions);
+
+  // Finest published level whose edges fit the density and budget limits under the given camera
+  [[nodiscard]] uint32_t selectLevel(const glm::mat4& mvp, const glm::vec2& viewport,
+                                     const LodParams& params = LodParams()) const;
+
+ private:
+  util::Graph m_base;
+  util::AABB m_bounds;
+  std::vector<std::unique_ptr<ClusterLevel>> m_levels;  // Sized to maxLevels before a build starts
+
+  std::thread m_thread;
+  std::mutex m_positionMutex;  // Positions of published levels (builder reads, updatePositions writes)
+  std::atomic<uint32_t> m_readyLevels;
+  std::atomic<bool> m_building;
+  std::atomic<bool> m_cancel;
+
+  void start(const util::Graph& graph, const ClusterParams& params);
+  void buildLevels(ClusterParams params);
+
+  // Contract one level, nullptr when it would not reduce enough
+  std::unique_ptr<ClusterLevel> coarsen(const util::Graph& fine, std::span<const uint32_t> fineMembers,
+                                        const ClusterParams& params, uint32_t level);
+};
+
+}  // namespace graph
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <util/glm.hpp>
+#include <util/graph.hpp>
+#include <util/thread_pool.hpp>
+
+namespace graph {
+
+// Fruchterman-Reingold style forces: repulsion k^2 / d between all node pairs,
+// attraction weight * d^2 / k along edges, plus a weak pull towards the origin
+struct LayoutParams {
+  uint32_t dimensions = 2;      // 2 (quadtree, z stays 0) or 3 (octree)
+  float springLength = 1.0f;    // Ideal edge length k
+  float repulsion = 1.0f;       // Scales the repulsive force
+  float attraction = 1.0f;      // Scales the spring force
+  float gravity = 0.05f;        // Pull towards the origin, keeps components together
+  float theta = 0.9f;           // Barnes-Hut opening angle (0 = exact O(n^2))
+  float cooling = 0.99f;        // Temperature factor per iteration
+  float minTemperature = 0.01f; // Relative to springLength, keeps the layout responsive
+  uint32_t repulsionSamples = 2048;  // GPU backend: repulsion partners per node and iteration
+};
+
+// Start positions shared by the layout backends: the graph's own positions, or a seeded random
+// placement inside a cube scaled to the node count when they are all zero
+std::vector<glm::vec3> initialPositions(const util::Graph& graph, const LayoutParams& params);
+
+// Maximum displacement of the first iteration
+float initialTemperature(const LayoutParams& params, uint32_t nodeCount);
+
+// CPU force-directed layout with Barnes-Hut repulsion, O(n log n) per iteration.
+// Positions are kept as SoA float arrays, work is split across nodes on the thread pool
+// and each step() runs a fixed number of iterations so it can be called once per frame.
+class ForceLayout {
+ public:
+  ForceLayout();
+  ~ForceLayout() = default;
+
+  ForceLayout(const ForceLayout&) = delete;
+  ForceLayout(ForceLayout&&) = delete;
+  ForceLayout& operator=(const ForceLayout&) = delete;
+  ForceLayout& operator=(ForceLayout&&) = delete;
+
+  // Take over the graph's topology and positions (the graph must outlive the layout).
+  // All-zero positions are replaced by a random start inside a cube scaled to the node count.
+  bool initialize(const util::Graph& graph, const LayoutParams& params = LayoutParams(),
+                  util::ThreadPool& pool = util::ThreadPool::global());
+
+  // Run iterations and refresh getPositions()
+  void step(uint32_t iterations = 1);
+
+  // Restart cooling (e.g. after parameters changed or nodes were dragged)
+  void reheat();
+
+  void setParams(const LayoutParams& params) { m_params = params; }
+  [[nodiscard]] const LayoutParams& getParams() const { return m_params; }
+
+  // Interleaved copy for updateMeshPositions() / uploading, valid after initialize() and step()
+  [[nodiscard]] const std::vector<glm::vec3>& getPositions() const { return m_positions; }
+
+  // Copy the current positions back into a graph's node attributes
+  void writePositions(util::Graph& graph) const;
+
+  // Stream the positions into an uploaded mesh (renderer: MeshRendererOpenGL or its wrapper)
+  template <typename RendererType>
+  void present(RendererType& renderer, util::MeshGPU& meshGPU) const {
+    renderer.updateMeshPositions(meshGPU, m_positions);
+  }
+
+  [[nodiscard]] uint32_t getNodeCount() const { return static_cast<uint32_t>(m_x.size()); }
+  [[nodiscard]] uint64_t getIteration() const { return m_iteration; }
+  [[nodiscard]] float getTemperature() const { return m_temperature; }
+
+ private:
+  static constexpr uint32_t LEAF_SIZE = 16;
+  static constexpr uint32_t MAX_DEPTH = 24;
+
+  // Tree node, children are stored contiguously; points of a leaf are [begin, end) of the sorted arrays
+  struct Cell {
+    float comX = 0.0f;
+    float comY = 0.0f;
+    float comZ = 0.0f;
+    float mass = 0.0f;
+    float size = 0.0f;  // Edge length of the cell
+    uint32_t firstChild = 0;
+    uint32_t childCount = 0;
+    uint32_t begin = 0;
+    uint32_t end = 0;
+  };
+
+  const util::Graph* m_graph;
+  util::Graph m_undirected;  // Symmetric adjacency when the input graph is directed
+  util::ThreadPool* m_pool;
+  LayoutParams m_params;
+
+  // SoA positions and accumulated displacements
+  std::vector<float> m_x;
+  std::vector<float> m_y;
+  std::vector<float> m_z;
+  std::vector<float> m_dx;
+  std::vector<float> m_dy;
+  std::vector<float> m_dz;
+
+  // Barnes-Hut tree over positions copied into tree order
+  std::vector<Cell> m_cells;
+  std::vector<uint32_t> m_order;
+  std::vector<uint32_t> m_scratch;
+  std::vector<float> m_sortedX;
+  std::vector<float> m_sortedY;
+  std::vector<float> m_sortedZ;
+
+  std::vector<glm::vec3> m_positions;
+  uint64_t m_iteration;
+  float m_temperature;
+
+  [[nodiscard]] const util::Graph& adjacency() const;
+
+  void iterate();
+  void buildTree();
+  void buildCell(uint32_t cellIndex, float cx, float cy, float cz, float halfSize, uint32_t depth);
+  void accumulateRepulsion(size_t begin, size_t end);
+  void accumulateAttraction(size_t begin, size_t end);
+  void integrate(size_t begin, size_t end);
+};
+
+}  // namespace graph
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include <util/graph.hpp>
+#include <util/types.hpp>
+
+namespace graph {
+
+struct LayoutParams;
+
+// Template wrapper for compile-time polymorphism over layout backends
+// (CPU Barnes-Hut or GPU transform feedback), all stepped the same way
+template <typename ImplType>
+class LayoutTemplate {
+ public:
+  bool initialize(const util::Graph& graph, const LayoutParams& params) { return impl.initialize(graph, params); }
+
+  void step(uint32_t iterations = 1) { impl.step(iterations); }
+
+  void reheat() { impl.reheat(); }
+
+  void setParams(const LayoutParams& params) { impl.setParams(params); }
+
+  [[nodiscard]] const LayoutParams& getParams() const { return impl.getParams(); }
+
+  [[nodiscard]] uint32_t getNodeCount() const { return impl.getNodeCount(); }
+
+  [[nodiscard]] uint64_t getIteration() const { return impl.getIteration(); }
+
+  [[nodiscard]] float getTemperature() const { return impl.getTemperature(); }
+
+  // Copy the current positions into the graph (GPU backends read back, not meant for every frame)
+  void writePositions(util::Graph& graph) const { impl.writePositions(graph); }
+
+  // Make the current positions visible to an uploaded mesh (or node set, GPU backends only)
+  template <typename RendererType>
+  void present(RendererType& renderer, util::MeshGPU& meshGPU) {
+    impl.present(renderer, meshGPU);
+  }
+
+  template <typename RendererType>
+  void present(RendererType& renderer, util::NodesGPU& nodesGPU) {
+    impl.present(renderer, nodesGPU);
+  }
+
+  // Backend specific access (e.g. the GPU position buffer)
+  ImplType& getImpl() { return impl; }
+  const ImplType& getImpl() const { return impl; }
+
+ private:
+  ImplType impl;
+};
+
+// Forward declaration
+class ForceLayout;
+
+// Type aliases
+using CpuLayout = LayoutTemplate<ForceLayout>;
+using CpuLayoutPtr = std::unique_ptr<LayoutTemplate<ForceLayout>>;
+
+}  // namespace graph
+
+// Include the implementation after the template definition
+#include "force_layout.hpp"
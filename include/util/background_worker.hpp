@@ -0,0 +1,44 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace util {
+
+// Single background thread running submitted tasks in order. Unlike ThreadPool::parallelFor the
+// caller does not wait, so long CPU work (mesh packing, hierarchy builds) stays off the frame.
+class BackgroundWorker {
+ public:
+  BackgroundWorker();
+  ~BackgroundWorker();  // Finishes queued tasks
+
+  BackgroundWorker(const BackgroundWorker&) = delete;
+  BackgroundWorker(BackgroundWorker&&) = delete;
+  BackgroundWorker& operator=(const BackgroundWorker&) = delete;
+  BackgroundWorker& operator=(BackgroundWorker&&) = delete;
+
+  void submit(std::function<void()> task);
+
+  // Block until every submitted task has run
+  void waitIdle();
+
+  // Queued plus running tasks
+  [[nodiscard]] size_t getPendingCount() const;
+
+ private:
+  std::thread m_thread;
+  mutable std::mutex m_mutex;
+  std::condition_variable m_wake;
+  std::condition_variable m_idle;
+  std::deque<std::function<void()>> m_tasks;
+  size_t m_running;
+  bool m_stop;
+
+  void run();
+};
+
+}  // namespace util
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include <util/glm.hpp>
+
+namespace util {
+
+// Unit circles at a few tessellation levels, computed once per process so circle draws only scale and
+// offset precomputed points. Level l has 8 << l segments.
+inline constexpr uint32_t CIRCLE_LEVEL_COUNT = 6;
+
+// Largest chord to arc distance in pixels the level choice allows
+inline constexpr float CIRCLE_MAX_ERROR = 0.25f;
+
+[[nodiscard]] constexpr uint32_t circleSegments(uint32_t level) { return 8u << level; }
+
+// Coarsest level whose chord error at this on-screen radius stays within CIRCLE_MAX_ERROR (the finest
+// level for larger radii); a table lookup, no trigonometry
+[[nodiscard]] uint32_t circleLevel(float radiusPixels);
+
+// circleSegments(level) + 1 counter-clockwise points starting at (1, 0), the last repeats the first
+[[nodiscard]] std::span<const glm::vec2> unitCircle(uint32_t level);
+
+}  // namespace util
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <util/graph.hpp>
+#include <util/thread_pool.hpp>
+
+namespace util {
+
+enum class EdgeFileFormat : uint8_t {
+  Auto,          // %%MatrixMarket banner, else commas in the first data line (CSV), else SNAP
+  Csv,           // source,target[,weight] with an optional header row; 0-based ids
+  Snap,          // source<ws>target[<ws>weight] with '#' comments; 0-based ids
+  MatrixMarket,  // Coordinate format, 1-based; "symmetric" files are read as undirected
+};
+
+struct EdgeImportOptions {
+  EdgeFileFormat format = EdgeFileFormat::Auto;
+  GraphBuildOptions build;         // directed is taken from the banner for Matrix Market files
+  size_t chunkBytes = 8u << 20;    // Parse chunk size, split at line boundaries
+};
+
+// Parse a text edge list into a Graph. The input is scanned twice in parallel chunks (count, then parse
+// straight into the final edge array), so besides the input text only the graph itself is allocated.
+// Blank and comment lines ('#', '%') are skipped anywhere; any other malformed line fails the import.
+// The node count is the size line for Matrix Market and the largest id + 1 otherwise.
+bool importEdgeList(std::string_view text, Graph& graph, const EdgeImportOptions& options = EdgeImportOptions(),
+                    ThreadPool& pool = ThreadPool::global());
+
+// Same from a file, which is memory-mapped rather than read into memory
+bool importEdgeListFile(const std::string& path, Graph& graph,
+                        const EdgeImportOptions& options = EdgeImportOptions(),
+                        ThreadPool& pool = ThreadPool::global());
+
+}  // namespace util
@@ -19,6 +19,7 @@
 #include <glm/ext/vector_float3.hpp>      // IWYU pragma: export (glm::vec3)
 #include <glm/ext/vector_float4.hpp>      // IWYU pragma: export (glm::vec4)
 #include <glm/gtc/matrix_transform.hpp>   // IWYU pragma: export (additional transform functions)
+#include <glm/gtc/packing.hpp>            // IWYU pragma: export (glm::packUnorm4x8, glm::packHalf1x16)
 #include <glm/gtc/type_ptr.hpp>           // IWYU pragma: export (glm::value_ptr)
 #include <glm/trigonometric.hpp>          // IWYU pragma: export (glm::radians, glm::sin, glm::cos)
 #include <glm/geometric.hpp>              // IWYU pragma: export (glm::length)
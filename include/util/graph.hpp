@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <util/glm.hpp>
+#include <util/thread_pool.hpp>
+#include <util/types.hpp>
+
+namespace util {
+
+// Edge between two node indices
+struct Edge {
+  uint32_t source = 0;
+  uint32_t target = 0;
+
+  Edge() = default;
+
+  Edge(uint32_t s, uint32_t t) : source(s), target(t) {}
+};
+
+// An edge is a GL_LINES index pair, so the edge array uploads as an element buffer as-is
+static_assert(sizeof(Edge) == 2 * sizeof(uint32_t));
+
+struct GraphBuildOptions {
+  bool directed = false;        // Undirected edges appear in the neighbor lists of both endpoints
+  bool removeSelfLoops = true;  // Drop edges with source == target
+  bool sortNeighbors = true;    // Ascending neighbor order (deterministic regardless of thread count)
+};
+
+// Graph in compressed sparse row (CSR) form with struct-of-arrays attributes.
+// The neighbors of node v are neighbors[offsets[v] .. offsets[v + 1]), edgeIds maps each of those
+// adjacency slots back to its edge so edge attributes can be read while traversing.
+// Node attribute arrays have one entry per node and are laid out like the renderer's vertex blocks,
+// edge attribute arrays have one entry per edge (undirected edges are stored once).
+struct Graph {
+  // CSR adjacency
+  std::vector<uint32_t> offsets;    // nodeCount + 1 entries
+  std::vector<uint32_t> neighbors;  // One entry per adjacency slot
+  std::vector<uint32_t> edgeIds;    // Edge id of each adjacency slot
+  bool directed = false;
+
+  // Node attributes
+  std::vector<glm::vec3> positions;
+  std::vector<Color> colors;
+  std::vector<float> sizes;
+
+  // Edge attributes
+  std::vector<Edge> edges;
+  std::vector<float> weights;
+
+  Graph() = default;
+
+  // Build from an edge list in parallel. Edges with an endpoint outside [0, nodeCount) are dropped,
+  // weights (optional) must match edges in size. Positions start at the origin, colors white, sizes 1.
+  static Graph fromEdges(uint32_t nodeCount, std::span<const Edge> edgeList, std::span<const float> edgeWeights = {},
+                         const GraphBuildOptions& options = GraphBuildOptions(),
+                         ThreadPool& pool = ThreadPool::global());
+
+  // Build around an edge list that is already valid (endpoints < nodeCount, no self loops when they are
+  // removed), taking ownership so the CSR is built in place without copying the edges. Empty weights = 1.
+  static Graph fromValidEdges(uint32_t nodeCount, std::vector<Edge> edgeList, std::vector<float> edgeWeights = {},
+                              const GraphBuildOptions& options = GraphBuildOptions(),
+                              ThreadPool& pool = ThreadPool::global());
+
+  [[nodiscard]] uint32_t nodeCount() const {
+    return offsets.empty() ? 0 : static_cast<uint32_t>(offsets.size() - 1);
+  }
+  [[nodiscard]] uint32_t edgeCount() const { return static_cast<uint32_t>(edges.size()); }
+  [[nodiscard]] uint32_t degree(uint32_t node) const { return offsets[node + 1] - offsets[node]; }
+
+  [[nodiscard]] std::span<const uint32_t> neighborsOf(uint32_t node) const {
+    return std::span<const uint32_t>(neighbors).subspan(offsets[node], degree(node));
+  }
+  [[nodiscard]] std::span<const uint32_t> edgeIdsOf(uint32_t node) const {
+    return std::span<const uint32_t>(edgeIds).subspan(offsets[node], degree(node));
+  }
+
+  [[nodiscard]] bool empty() const { return nodeCount() == 0; }
+
+ private:
+  // Default node attributes plus the CSR arrays of the final edge list (parallel counting sort)
+  void buildAdjacency(uint32_t nodeCount, const GraphBuildOptions& options, ThreadPool& pool);
+};
+
+}  // namespace util
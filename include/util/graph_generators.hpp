@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+#include <util/graph.hpp>
+
+namespace util {
+
+// Synthetic graphs for benchmarks and tests. Nodes are placed in the plane (z = 0) over a square of
+// about sqrt(nodeCount) units per side, so all generators cover a similar area at the same node count.
+// Results depend only on the arguments (fixed-seed mt19937), not on the thread count.
+
+// Uniform random endpoints (Erdos-Renyi style, duplicate edges possible), randomly placed nodes
+[[nodiscard]] Graph randomGraph(uint32_t nodeCount, uint32_t averageDegree, uint32_t seed = 1);
+
+// width x height lattice with 4-neighborhood edges and unit spacing
+[[nodiscard]] Graph gridGraph(uint32_t width, uint32_t height);
+
+// Barabasi-Albert preferential attachment: each new node links to edgesPerNode existing nodes picked
+// proportionally to their degree, giving a power-law degree distribution with a few large hubs
+[[nodiscard]] Graph scaleFreeGraph(uint32_t nodeCount, uint32_t edgesPerNode, uint32_t seed = 1);
+
+}  // namespace util
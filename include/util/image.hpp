@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <util/glm.hpp>
+
+namespace util {
+
+// RGBA8 images of captured frames and stills: PNG output, row order fix-up and the tiling of stills
+// larger than one render target.
+
+// PNG of a top-down RGBA8 image. Rows go unfiltered into stored (uncompressed) deflate blocks, so encoding
+// is a copy plus checksums and a capture worker keeps up with recording; recompress offline if size matters.
+[[nodiscard]] std::vector<uint8_t> encodePng(uint32_t width, uint32_t height, std::span<const uint8_t> rgba);
+
+bool writePng(const std::string& path, uint32_t width, uint32_t height, std::span<const uint8_t> rgba);
+
+// Reverse the row order in place (GL readbacks are bottom-up, image files top-down)
+void flipRows(std::span<uint8_t> pixels, size_t rowBytes);
+
+// Region of an image in pixels, origin at the bottom left like GL
+struct ImageTile {
+  uint32_t x = 0;
+  uint32_t y = 0;
+  uint32_t width = 0;
+  uint32_t height = 0;
+};
+
+// Row-major tiles of at most maxTileSize pixels per side covering the image, bottom row first
+[[nodiscard]] std::vector<ImageTile> tileImage(uint32_t width, uint32_t height, uint32_t maxTileSize);
+
+// Clip-space transform applied in front of a full-image projection (tileTransform * mvp), so the tile's part
+// of the image fills the tile's own viewport. Pixel sizes stay pixels of the full image.
+[[nodiscard]] glm::mat4 tileTransform(uint32_t width, uint32_t height, const ImageTile& tile);
+
+// Copy the tightly packed RGBA8 pixels of a tile into a bottom-up image of imageWidth pixels per row
+void copyTile(std::span<uint8_t> image, uint32_t imageWidth, std::span<const uint8_t> pixels, const ImageTile& tile);
+
+}  // namespace util
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+
+namespace util {
+
+// Read-only memory mapping of a whole file. Pages are faulted in on first access, so opening is
+// constant time and reading a section costs only the disk (or page cache) bandwidth it needs.
+class MappedFile {
+ public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile(MappedFile&&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile& operator=(MappedFile&&) = delete;
+
+  bool open(const std::string& path);
+  void close();
+
+  [[nodiscard]] bool isOpen() const { return m_data != nullptr; }
+  [[nodiscard]] const std::byte* data() const { return m_data; }
+  [[nodiscard]] size_t size() const { return m_size; }
+  [[nodiscard]] std::span<const std::byte> bytes() const { return {m_data, m_size}; }
+
+ private:
+  const std::byte* m_data = nullptr;
+  size_t m_size = 0;
+};
+
+}  // namespace util
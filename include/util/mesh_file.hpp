@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+#include <util/graph.hpp>
+#include <util/mapped_file.hpp>
+#include <util/mesh_prepare.hpp>
+#include <util/spatial_index.hpp>
+#include <util/types.hpp>
+
+namespace util {
+
+// Binary mesh / graph container. Every array is stored exactly as the renderer consumes it: the vertex
+// section is the packed positions + colors blocks of the mesh vertex buffer, the index sections are
+// chunk-ordered element buffers with their chunk tables. Loading maps the file and points a MeshView at
+// the sections, so there is no parse step and uploads read straight from the page cache.
+//
+// Layout (little endian): MeshFileHeader, sectionCount MeshFileSection entries, then the section
+// payloads, each starting at a multiple of MESH_FILE_ALIGNMENT.
+
+constexpr uint32_t MESH_FILE_VERSION = 1;
+constexpr size_t MESH_FILE_ALIGNMENT = 64;
+
+enum class SectionType : uint32_t {
+  Vertices = 1,  // Packed vertex buffer (vertexBufferSize(format, vertexCount) bytes)
+  Faces,         // uint32 triangle indices, chunk order
+  Edges,         // uint32 line indices, chunk order
+  Points,        // uint32 point indices, chunk order (absent when the points form one chunk)
+  FaceChunks,    // IndexChunk tables of the three views
+  EdgeChunks,
+  PointChunks,
+  Offsets,       // Graph CSR: nodeCount + 1 offsets, neighbors and edge ids per adjacency slot
+  Neighbors,
+  EdgeIds,
+  EdgeList,      // Graph edges in edge id order (EdgeIds and Weights refer to it)
+  Sizes,         // Per-node sizes
+  Weights,       // Per-edge weights
+};
+
+struct MeshFileHeader {
+  char magic[8];  // "GLABMESH"
+  uint32_t version;
+  uint32_t sectionCount;
+  uint32_t vertexFormat;  // VertexFormat of the Vertices section
+  uint32_t vertexCount;
+  uint32_t flags;  // MESH_FILE_DIRECTED
+  uint32_t reserved;
+  AABB bounds;
+};
+
+struct MeshFileSection {
+  uint32_t type;         // SectionType
+  uint32_t elementSize;  // Bytes per element, checked against the type on load
+  uint64_t offset;       // From the start of the file
+  uint64_t count;        // Elements
+};
+
+constexpr uint32_t MESH_FILE_DIRECTED = 1;
+
+// Non-owning view of a renderable mesh and, optionally, the graph it came from.
+// Built from a PreparedMesh for writing, or from a mapped MeshFile section table.
+struct MeshView {
+  VertexFormat format = VertexFormat::Float32;
+  uint32_t dimensions = 3;  // Position components; the file format stores three-component positions only
+  uint32_t vertexCount = 0;
+  std::span<const std::byte> vertexData;
+  std::span<const uint32_t> faces;
+  std::span<const uint32_t> edges;
+  std::span<const uint32_t> points;
+
+  AABB bounds;
+  std::span<const IndexChunk> faceChunks;
+  std::span<const IndexChunk> edgeChunks;
+  std::span<const IndexChunk> pointChunks;
+
+  // Graph sections, empty for plain meshes
+  std::span<const uint32_t> offsets;
+  std::span<const uint32_t> neighbors;
+  std::span<const uint32_t> edgeIds;
+  std::span<const Edge> edgeList;
+  std::span<const float> sizes;
+  std::span<const float> weights;
+  bool directed = false;
+
+  [[nodiscard]] bool isValid() const { return vertexCount > 0; }
+  [[nodiscard]] bool hasGraph() const { return !offsets.empty(); }
+};
+
+[[nodiscard]] MeshView makeMeshView(const PreparedMesh& prepared);
+
+// Mesh sections from prepared (e.g. prepareGraph(graph)) plus the graph's CSR and attribute arrays
+[[nodiscard]] MeshView makeMeshView(const PreparedMesh& prepared, const Graph& graph);
+
+// Fails for flat (dimensions 2) views until the header records the position dimensions
+bool writeMeshFile(const std::string& path, const MeshView& view);
+
+// Memory-mapped container. The view stays valid while the file is open; index contents are trusted
+// (written by writeMeshFile), only the header and section table are validated.
+class MeshFile {
+ public:
+  MeshFile() = default;
+  ~MeshFile() = default;
+
+  MeshFile(const MeshFile&) = delete;
+  MeshFile(MeshFile&&) = delete;
+  MeshFile& operator=(const MeshFile&) = delete;
+  MeshFile& operator=(MeshFile&&) = delete;
+
+  bool open(const std::string& path);
+  void close();
+
+  [[nodiscard]] bool isOpen() const { return m_file.isOpen(); }
+  [[nodiscard]] const MeshView& getView() const { return m_view; }
+
+ private:
+  MappedFile m_file;
+  MeshView m_view;
+};
+
+}  // namespace util
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <util/graph.hpp>
+#include <util/spatial_index.hpp>
+#include <util/types.hpp>
+
+namespace util {
+
+// Everything uploadMesh / uploadGraph compute on the CPU, produced off the render thread so the
+// GL side is left with plain buffer copies. Index arrays are already in spatial chunk order.
+struct PreparedMesh {
+  VertexFormat format = VertexFormat::Float32;
+  uint32_t dimensions = 3;  // Components of the packed positions
+  uint32_t vertexCount = 0;
+  std::vector<uint8_t> vertexData;  // Positions block followed by colors block (vertexBufferSize bytes)
+  std::vector<uint32_t> faces;
+  std::vector<uint32_t> edges;
+  std::vector<uint32_t> points;  // Empty when the points form a single chunk (drawn in vertex order)
+
+  AABB bounds;
+  std::vector<IndexChunk> faceChunks;
+  std::vector<IndexChunk> edgeChunks;
+  std::vector<IndexChunk> pointChunks;
+
+  [[nodiscard]] bool isValid() const { return vertexCount > 0; }
+};
+
+// Whole primitives of primitiveSize indices whose vertices all exist (a trailing partial primitive is dropped)
+[[nodiscard]] std::vector<uint32_t> collectPrimitives(std::span<const uint32_t> indices, size_t vertexCount,
+                                                      uint32_t primitiveSize);
+
+[[nodiscard]] PreparedMesh prepareMesh(const Mesh2D& mesh, VertexFormat format = VertexFormat::Float32);
+[[nodiscard]] PreparedMesh prepareMesh(const Mesh3D& mesh, VertexFormat format = VertexFormat::Float32);
+[[nodiscard]] PreparedMesh prepareGraph(const Graph& graph, VertexFormat format = VertexFormat::Float32);
+
+}  // namespace util
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+
+namespace util {
+
+// First-fit allocator of element ranges inside a fixed-capacity buffer (vertices or indices of a shared
+// GPU buffer). Free ranges are kept by offset and coalesced with their neighbors on release, so many small
+// allocations and frees fragment little and live ranges never move.
+class RangeAllocator {
+ public:
+  static constexpr uint32_t INVALID_OFFSET = UINT32_MAX;
+
+  explicit RangeAllocator(uint32_t capacity = 0);
+
+  // Offset of count contiguous elements, INVALID_OFFSET when no free range is large enough (count = 0 too)
+  uint32_t allocate(uint32_t count);
+
+  // Return a range handed out by allocate()
+  void release(uint32_t offset, uint32_t count);
+
+  // Forget every allocation
+  void reset(uint32_t capacity);
+
+  [[nodiscard]] uint32_t getCapacity() const { return m_capacity; }
+  [[nodiscard]] uint32_t getUsed() const { return m_used; }
+  [[nodiscard]] uint32_t getLargestFree() const;
+  [[nodiscard]] uint32_t getFreeRangeCount() const { return static_cast<uint32_t>(m_free.size()); }
+
+ private:
+  uint32_t m_capacity;
+  uint32_t m_used;
+  std::map<uint32_t, uint32_t> m_free;  // Offset -> element count
+};
+
+}  // namespace util
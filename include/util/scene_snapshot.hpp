@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include <util/glm.hpp>
+#include <util/triple_buffer.hpp>
+#include <util/types.hpp>
+
+namespace util {
+
+// Immutable per-node scene state handed from a simulation thread to the render thread
+struct SceneSnapshot {
+  uint64_t sequence = 0;             // Increases with every publish, 0 = nothing published yet
+  std::vector<glm::vec3> positions;  // Per node
+  std::vector<Color> colors;         // Empty = colors unchanged
+  std::vector<uint8_t> visible;      // Per node 0 / 1, empty = all visible
+};
+
+// Runs a step function on its own thread and publishes every snapshot it fills through a triple buffer.
+// The render thread picks up the latest complete snapshot with acquire() and never blocks; the producer
+// never touches GL, which stays on the thread that owns the renderer. Each producer (layout, analytics,
+// ingest) gets its own instance, the buffer is single-producer.
+class SnapshotProducer {
+ public:
+  // Fill the snapshot in place and return true to publish it. The snapshot is a recycled buffer holding
+  // older data: assigning into its vectors reuses their storage, so steady-state steps do not allocate.
+  using StepFunction = std::function<bool(SceneSnapshot&)>;
+
+  SnapshotProducer();
+  ~SnapshotProducer();  // Stops the thread
+
+  SnapshotProducer(const SnapshotProducer&) = delete;
+  SnapshotProducer(SnapshotProducer&&) = delete;
+  SnapshotProducer& operator=(const SnapshotProducer&) = delete;
+  SnapshotProducer& operator=(SnapshotProducer&&) = delete;
+
+  // False when already running
+  bool start(StepFunction step);
+
+  // Finish the current step and join the thread
+  void stop();
+
+  [[nodiscard]] bool isRunning() const { return m_thread.joinable(); }
+
+  // A paused producer sleeps between steps instead of spinning
+  void setPaused(bool paused);
+  [[nodiscard]] bool isPaused() const { return m_paused.load(std::memory_order_relaxed); }
+
+  // Render thread: the newest snapshot when one was published since the last call, otherwise nullptr
+  [[nodiscard]] const SceneSnapshot* acquire();
+
+  // Render thread: snapshot of the last successful acquire()
+  [[nodiscard]] const SceneSnapshot& latest() const { return m_buffer.read(); }
+
+  // Snapshots published so far (dropped ones included)
+  [[nodiscard]] uint64_t getPublishedCount() const { return m_published.load(std::memory_order_relaxed); }
+
+ private:
+  TripleBuffer<SceneSnapshot> m_buffer;
+  std::thread m_thread;
+  std::atomic<bool> m_stop;
+  std::atomic<bool> m_paused;
+  std::atomic<uint64_t> m_published;
+
+  void run(const StepFunction& step);
+};
+
+}  // namespace util
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include <util/glm.hpp>
+
+namespace util {
+
+// Axis-aligned bounding box, empty (inverted) by default
+struct AABB {
+  glm::vec3 min{std::numeric_limits<float>::max()};
+  glm::vec3 max{std::numeric_limits<float>::lowest()};
+
+  void expand(const glm::vec3& point) {
+    min = glm::min(min, point);
+    max = glm::max(max, point);
+  }
+
+  void expand(const AABB& other) {
+    min = glm::min(min, other.min);
+    max = glm::max(max, other.max);
+  }
+
+  [[nodiscard]] bool isValid() const { return min.x <= max.x && min.y <= max.y && min.z <= max.z; }
+  [[nodiscard]] glm::vec3 center() const { return 0.5f * (min + max); }
+  [[nodiscard]] glm::vec3 extent() const { return max - min; }
+};
+
+AABB computeBounds(std::span<const glm::vec3> positions);
+
+// Clip-space frustum of an MVP matrix (planes point inwards). Works for perspective and
+// orthographic (2D viewport) projections alike.
+struct Frustum {
+  std::array<glm::vec4, 6> planes;
+
+  static Frustum fromMatrix(const glm::mat4& mvp);
+
+  // Conservative: boxes straddling a plane count as visible
+  [[nodiscard]] bool intersects(const AABB& box) const;
+};
+
+// Contiguous range of an index buffer with the bounds of the vertices it references
+struct IndexChunk {
+  uint32_t firstIndex = 0;
+  uint32_t indexCount = 0;
+  AABB bounds;
+};
+
+constexpr uint32_t DEFAULT_CHUNK_PRIMITIVES = 4096;
+
+// Reorder the primitives (primitiveSize consecutive indices each: 1 = points, 2 = lines, 3 = triangles)
+// along a Morton curve of their centroids and split them into spatially coherent chunks of
+// primitivesPerChunk. Primitives stay intact, so winding is preserved. Indices must be in range.
+std::vector<IndexChunk> buildIndexChunks(std::span<const glm::vec3> positions, std::vector<uint32_t>& indices,
+                                         uint32_t primitiveSize,
+                                         uint32_t primitivesPerChunk = DEFAULT_CHUNK_PRIMITIVES);
+
+}  // namespace util
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace util {
+
+// Fixed-size worker pool for data-parallel loops. The calling thread takes part in every loop.
+// Work stealing: each thread starts on its own contiguous share of the chunks (good locality, no shared
+// counter) and, once that runs dry, steals the back half of the largest remaining share, so uneven work
+// such as BFS frontiers or power-law degree distributions balances itself.
+class ThreadPool {
+ public:
+  // threadCount = total threads including the caller (0 = hardware concurrency)
+  explicit ThreadPool(uint32_t threadCount = 0);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool(ThreadPool&&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ThreadPool& operator=(ThreadPool&&) = delete;
+
+  [[nodiscard]] uint32_t getThreadCount() const { return static_cast<uint32_t>(m_workers.size()) + 1; }
+
+  // Call body(chunkBegin, chunkEnd) for chunks of about grainSize covering [begin, end), blocks until done.
+  // Nested calls from inside a body run serially on the calling thread.
+  void parallelFor(size_t begin, size_t end, size_t grainSize, const std::function<void(size_t, size_t)>& body);
+
+  // Process-wide pool sized to the hardware
+  static ThreadPool& global();
+
+ private:
+  std::vector<std::thread> m_workers;
+
+  std::mutex m_submitMutex;  // One loop at a time
+  std::mutex m_mutex;
+  std::condition_variable m_wake;
+  std::condition_variable m_done;
+  uint64_t m_generation;
+  uint32_t m_activeWorkers;
+  bool m_stop;
+
+  // Unclaimed chunks [begin, end) of one thread packed as (end << 32) | begin, on its own cache line
+  struct alignas(64) ChunkRange {
+    std::atomic<uint64_t> bounds{0};
+  };
+
+  // Current loop
+  const std::function<void(size_t, size_t)>* m_body;
+  size_t m_begin;
+  size_t m_end;
+  size_t m_grainSize;
+  size_t m_chunkCount;
+  std::unique_ptr<ChunkRange[]> m_ranges;  // One per thread, slot 0 is the caller
+  std::atomic<size_t> m_completedChunks;
+
+  void workerLoop(uint32_t slot);
+  void runChunks(uint32_t slot);
+  bool popChunk(uint32_t slot, uint32_t& chunk);
+  bool stealChunk(uint32_t slot, uint32_t& chunk);
+};
+
+}  // namespace util
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace util {
+
+// Lock-free single-producer / single-consumer handoff of whole values. The producer fills its back slot
+// and publishes it; the consumer swaps the newest published slot to its front. Neither side ever waits,
+// the consumer always sees a complete value and intermediate ones are dropped when it is slower. The three
+// slots are reused forever, so values that keep their storage (vectors) stop allocating once warmed up.
+template <typename T>
+class TripleBuffer {
+ public:
+  TripleBuffer() : m_middle(1), m_back(0), m_front(2) {}
+
+  TripleBuffer(const TripleBuffer&) = delete;
+  TripleBuffer(TripleBuffer&&) = delete;
+  TripleBuffer& operator=(const TripleBuffer&) = delete;
+  TripleBuffer& operator=(TripleBuffer&&) = delete;
+
+  // Producer: slot to fill, it holds an older value that must be overwritten where it matters
+  [[nodiscard]] T& write() { return m_slots[m_back]; }
+
+  // Producer: hand the filled slot over, write() then returns a free one
+  void publish() {
+    const uint8_t previous = m_middle.exchange(m_back | FRESH, std::memory_order_acq_rel);
+    m_back = previous & INDEX_MASK;
+  }
+
+  // Consumer: move to the newest published value, false when nothing was published since the last call
+  bool update() {
+    if ((m_middle.load(std::memory_order_relaxed) & FRESH) == 0) {
+      return false;
+    }
+    const uint8_t previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+    m_front = previous & INDEX_MASK;
+    return true;
+  }
+
+  // Consumer: value taken by the last successful update() (default-constructed before the first)
+  [[nodiscard]] const T& read() const { return m_slots[m_front]; }
+
+ private:
+  static constexpr uint8_t INDEX_MASK = 0x3;
+  static constexpr uint8_t FRESH = 0x4;  // Middle slot holds a value the consumer has not taken yet
+
+  static_assert(std::atomic<uint8_t>::is_always_lock_free);
+
+  std::array<T, 3> m_slots;
+
+  // Shared index plus flag; the other two indices are private to their side and kept off its cache line
+  alignas(64) std::atomic<uint8_t> m_middle;
+  alignas(64) uint8_t m_back;
+  alignas(64) uint8_t m_front;
+};
+
+}  // namespace util
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 #include <util/glm.hpp>
+#include <util/spatial_index.hpp>
 
 namespace util {
 
@@ -11,6 +13,8 @@ namespace util {
 using Color = glm::vec4;
 
 struct Vertex2D {
+  static constexpr uint32_t DIMENSIONS = 2;
+
   glm::vec2 position{0.0f, 0.0f};
   Color color{0.0f, 0.0f, 0.0f, 1.0f};
 
@@ -22,6 +26,8 @@ struct Vertex2D {
 };
 
 struct Vertex3D {
+  static constexpr uint32_t DIMENSIONS = 3;
+
   glm::vec3 position{0.0f, 0.0f, 0.0f};
   Color color{0.0f, 0.0f, 0.0f, 1.0f};
 
@@ -33,13 +39,15 @@ struct Vertex3D {
   Vertex3D(const glm::vec3& pos, const Color& col = Color(0.0f, 0.0f, 0.0f, 1.0f)) : position(pos), color(col) {}
 };
 
-// Simple mesh structure for 2D rendering
-struct Mesh2D {
-  std::vector<Vertex2D> vertices;
+// Indexed mesh over 2D or 3D vertices. Both upload natively: Mesh2D fills two-component positions
+// (z is 0 in the shaders), Mesh3D three-component ones.
+template <typename VertexType>
+struct Mesh {
+  std::vector<VertexType> vertices;
   std::vector<uint32_t> faces;  // Triplets of vertex indices (triangle = 3 indices)
   std::vector<uint32_t> edges;  // Pairs of vertex indices (line = 2 indices)
 
-  Mesh2D() = default;
+  Mesh() = default;
 
   // Helper to add a triangular face
   void addFace(uint32_t v1, uint32_t v2, uint32_t v3) {
@@ -55,48 +63,161 @@ struct Mesh2D {
   }
 };
 
-// Simple mesh structure for 3D rendering
-struct Mesh3D {
-  std::vector<Vertex3D> vertices;
-  std::vector<uint32_t> faces;  // Triplets of vertex indices (triangle = 3 indices)
-  std::vector<uint32_t> edges;  // Pairs of vertex indices (line = 2 indices)
+using Mesh2D = Mesh<Vertex2D>;
+using Mesh3D = Mesh<Vertex3D>;
 
-  Mesh3D() = default;
-
-  // Helper to add a triangular face
-  void addFace(uint32_t v1, uint32_t v2, uint32_t v3) {
-    faces.push_back(v1);
-    faces.push_back(v2);
-    faces.push_back(v3);
-  }
-
-  // Helper to add a line edge
-  void addEdge(uint32_t v1, uint32_t v2) {
-    edges.push_back(v1);
-    edges.push_back(v2);
-  }
+// Vertex storage format, selectable per mesh upload and for the dynamic 2D paths
+enum class VertexFormat : uint8_t {
+  Float32,       // float positions, float RGBA colors (mesh 28 B, 2D 24 B per vertex)
+  PackedColor,   // float positions, normalized RGBA8 colors (mesh 16 B, 2D 12 B per vertex)
+  HalfPosition,  // half-float positions, normalized RGBA8 colors (mesh 12 B, 2D 8 B per vertex)
 };
 
-// GPU mesh handle - holds VAO/VBO for a mesh that's been uploaded to GPU
+// GPU mesh handle - one shared vertex buffer plus element buffers for faces and edges
 // This allows us to upload once and draw many times efficiently
 struct MeshGPU {
-  uint32_t vao = 0;
+  // Shared vertex buffer (positions block followed by colors block)
   uint32_t vbo = 0;
   uint32_t vertexCount = 0;
+  VertexFormat format = VertexFormat::Float32;
+  uint32_t dimensions = 3;  // Components of the stored positions (2 = flat mesh, z = 0)
+
+  // Faces (triangles) indexed into the shared vertices
+  uint32_t vao = 0;
+  uint32_t ebo = 0;
+  uint32_t indexCount = 0;
 
-  // Separate VAO/VBO for edges (lines)
+  // Edges (lines) indexed into the shared vertices
   uint32_t edgeVao = 0;
-  uint32_t edgeVbo = 0;
-  uint32_t edgeVertexCount = 0;
+  uint32_t edgeEbo = 0;
+  uint32_t edgeIndexCount = 0;
 
-  // Separate VAO/VBO for points (vertices)
+  // Points (all shared vertices, through a Morton-ordered index buffer when chunked)
   uint32_t pointVao = 0;
-  uint32_t pointVbo = 0;
-  uint32_t pointVertexCount = 0;
+  uint32_t pointEbo = 0;
+
+  // External float position source (e.g. a GPU layout), 0 = the positions block of vbo
+  uint32_t positionBuffer = 0;
+  uint32_t positionStride = 0;
+
+  // Spatial index built at upload: overall bounds plus spatially coherent chunks of every view,
+  // culled against the MVP at draw time. Position updates after upload make it stale (boundsValid
+  // is cleared and every view is drawn whole) until the mesh is uploaded again.
+  AABB bounds;
+  std::vector<IndexChunk> faceChunks;
+  std::vector<IndexChunk> edgeChunks;
+  std::vector<IndexChunk> pointChunks;
+  bool boundsValid = false;
 
   [[nodiscard]] bool isValid() const { return vao != 0; }
-  [[nodiscard]] bool hasEdges() const { return edgeVao != 0 && edgeVertexCount > 0; }
-  [[nodiscard]] bool hasPoints() const { return pointVao != 0 && pointVertexCount > 0; }
+  [[nodiscard]] bool hasEdges() const { return edgeVao != 0 && edgeIndexCount > 0; }
+  [[nodiscard]] bool hasPoints() const { return pointVao != 0 && vertexCount > 0; }
+};
+
+// Mesh suballocated from the shared buffers of a mesh pool page. Vertices start at baseVertex of the page,
+// the face, edge and point indices form one range of the page's element buffer (mesh-local values, drawn
+// with the base vertex). Pooled meshes of one page share its VAO, so their queued draws merge into multi-draws.
+// They are static: there are no in-place updates or external position sources.
+struct PooledMeshGPU {
+  uint32_t page = 0;  // Page id in the pool, 0 = not allocated
+  uint32_t vao = 0;   // Shared VAO of the page
+  VertexFormat format = VertexFormat::Float32;
+  uint32_t dimensions = 3;
+
+  uint32_t baseVertex = 0;
+  uint32_t vertexCount = 0;
+
+  uint32_t firstIndex = 0;  // Start of the index range: faces, then edges, then points
+  uint32_t indexCount = 0;
+  uint32_t faceCount = 0;
+  uint32_t edgeCount = 0;
+  uint32_t pointCount = 0;  // 0 = points drawn in vertex order (single chunk)
+
+  AABB bounds;
+  std::vector<IndexChunk> faceChunks;
+  std::vector<IndexChunk> edgeChunks;
+  std::vector<IndexChunk> pointChunks;
+
+  [[nodiscard]] bool isValid() const { return page != 0; }
+  [[nodiscard]] bool hasFaces() const { return page != 0 && faceCount > 0; }
+  [[nodiscard]] bool hasEdges() const { return page != 0 && edgeCount > 0; }
+  [[nodiscard]] bool hasPoints() const { return page != 0 && vertexCount > 0; }
+};
+
+// Progress of an asynchronous mesh upload
+enum class UploadState : uint8_t {
+  Pending,  // Packing on the worker thread or streaming into the GPU buffers
+  Ready,    // mesh is complete and drawable
+  Failed,   // Nothing to upload (empty mesh, missing shaders, mapping failure)
+};
+
+// Future-like result of uploadMeshAsync. Only the render thread writes it (in beginFrame), so it can be
+// polled every frame without locking; pending handles are skipped by the draw calls.
+struct AsyncMeshGPU {
+  MeshGPU mesh;
+  UploadState state = UploadState::Pending;
+
+  [[nodiscard]] bool isReady() const { return state == UploadState::Ready; }
+  [[nodiscard]] bool isPending() const { return state == UploadState::Pending; }
+};
+
+// Dropping the last reference to a pending handle cancels its upload
+using MeshHandle = std::shared_ptr<AsyncMeshGPU>;
+
+// Marker shape of an instanced node
+enum class NodeShape : uint32_t {
+  Circle = 0,
+  Square = 1,
+};
+
+// Per-node attributes for instanced node rendering (one entry per node in a single instance buffer)
+struct NodeInstance {
+  glm::vec3 position{0.0f, 0.0f, 0.0f};
+  float radius = 4.0f;  // Screen-space radius in pixels
+  Color color{1.0f, 1.0f, 1.0f, 1.0f};
+  NodeShape shape = NodeShape::Circle;
+  float outlineWidth = 0.0f;  // Outline width in pixels (0 = no outline)
+
+  NodeInstance() = default;
+
+  NodeInstance(const glm::vec3& pos, float r, const Color& col = Color(1.0f, 1.0f, 1.0f, 1.0f),
+               NodeShape s = NodeShape::Circle, float outline = 0.0f)
+      : position(pos), radius(r), color(col), shape(s), outlineWidth(outline) {}
+};
+
+// GPU handle for instanced nodes - a shared unit quad plus one instance buffer
+struct NodesGPU {
+  uint32_t vao = 0;
+  uint32_t instanceVbo = 0;
+  uint32_t instanceCount = 0;
+
+  // External vec4 position + radius source (e.g. a GPU layout), 0 = instanceVbo
+  uint32_t positionBuffer = 0;
+
+  [[nodiscard]] bool isValid() const { return vao != 0 && instanceCount > 0; }
+};
+
+// Per-edge attributes for instanced thick edges: endpoints index the vertices of a mesh, whose positions
+// the vertex shader fetches, so edges follow position updates without being re-uploaded
+struct EdgeInstance {
+  uint32_t source = 0;
+  uint32_t target = 0;
+  float width = 1.0f;    // Screen-space width in pixels
+  uint32_t color = ~0u;  // Normalized RGBA8, red in the lowest byte
+
+  EdgeInstance() = default;
+
+  EdgeInstance(uint32_t s, uint32_t t, float w = 1.0f, const Color& col = Color(1.0f, 1.0f, 1.0f, 1.0f))
+      : source(s), target(t), width(w), color(glm::packUnorm4x8(col)) {}
+};
+
+// GPU handle for instanced edges - a shared unit quad plus one instance buffer
+struct EdgesGPU {
+  uint32_t vao = 0;
+  uint32_t instanceVbo = 0;
+  uint32_t instanceCount = 0;
+
+  [[nodiscard]] bool isValid() const { return vao != 0 && instanceCount > 0; }
 };
 
 }  // namespace util
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <util/glm.hpp>
+#include <util/types.hpp>
+#include <util/vertex_pack.hpp>
+
+namespace util {
+
+// Compile-time vertex layout descriptors: attribute formats, offsets and strides derived from C++ types, so a
+// buffer filled straight from a vertex / instance array (one memcpy or mapped write) can be bound without
+// hand-written attribute setup. Interleaved (AoS) layouts come from a VertexLayout<T> specialization,
+// split (SoA) layouts of tightly packed blocks from blockLayout. gfx::applyVertexLayout binds them.
+
+// Component type of an attribute in the buffer
+enum class AttributeType : uint8_t {
+  Float32,  // float components
+  Float16,  // half-float components, read as float
+  UNorm8,   // normalized bytes, read as float in [0, 1]
+  UInt32,   // integer components, read as uint / uvecN
+};
+
+[[nodiscard]] constexpr uint32_t attributeTypeSize(AttributeType type) {
+  switch (type) {
+    case AttributeType::Float16:
+      return 2;
+    case AttributeType::UNorm8:
+      return 1;
+    default:
+      return 4;
+  }
+}
+
+struct VertexAttribute {
+  uint32_t location = 0;
+  uint32_t components = 0;
+  AttributeType type = AttributeType::Float32;
+  uint32_t offset = 0;  // Byte offset inside an element (interleaved) or of the block (split)
+  uint32_t stride = 0;  // Bytes between elements, 0 = the element size of the layout
+
+  [[nodiscard]] constexpr uint32_t size() const { return components * attributeTypeSize(type); }
+  [[nodiscard]] constexpr bool isInteger() const { return type == AttributeType::UInt32; }
+};
+
+// Attribute format of a C++ member type (enums take the format of their underlying type)
+template <typename T>
+struct AttributeFormat;
+
+template <typename T>
+  requires std::is_enum_v<T>
+struct AttributeFormat<T> : AttributeFormat<std::underlying_type_t<T>> {};
+
+template <>
+struct AttributeFormat<float> {
+  static constexpr uint32_t COMPONENTS = 1;
+  static constexpr AttributeType TYPE = AttributeType::Float32;
+};
+
+template <>
+struct AttributeFormat<glm::vec2> {
+  static constexpr uint32_t COMPONENTS = 2;
+  static constexpr AttributeType TYPE = AttributeType::Float32;
+};
+
+template <>
+struct AttributeFormat<glm::vec3> {
+  static constexpr uint32_t COMPONENTS = 3;
+  static constexpr AttributeType TYPE = AttributeType::Float32;
+};
+
+template <>
+struct AttributeFormat<glm::vec4> {
+  static constexpr uint32_t COMPONENTS = 4;
+  static constexpr AttributeType TYPE = AttributeType::Float32;
+};
+
+template <>
+struct AttributeFormat<uint32_t> {
+  static constexpr uint32_t COMPONENTS = 1;
+  static constexpr AttributeType TYPE = AttributeType::UInt32;
+};
+
+template <>
+struct AttributeFormat<glm::uvec2> {
+  static constexpr uint32_t COMPONENTS = 2;
+  static constexpr AttributeType TYPE = AttributeType::UInt32;
+};
+
+// Attribute of a member of type Member at offset (offsetof), format derived from the type
+template <typename Member>
+[[nodiscard]] constexpr VertexAttribute attribute(uint32_t location, size_t offset) {
+  return VertexAttribute{location, AttributeFormat<Member>::COMPONENTS, AttributeFormat<Member>::TYPE,
+                         static_cast<uint32_t>(offset), 0};
+}
+
+// Explicit format, for members read differently than declared (packed colors, adjacent members as one vector)
+[[nodiscard]] constexpr VertexAttribute attribute(uint32_t location, size_t offset, uint32_t components,
+                                                  AttributeType type) {
+  return VertexAttribute{location, components, type, static_cast<uint32_t>(offset), 0};
+}
+
+// Interleaved layout of a vertex or instance struct: specializations list ATTRIBUTES (std::array of
+// VertexAttribute), the element size is sizeof(T). Custom per-vertex / per-node structs (ids, weights, ...)
+// opt in the same way.
+template <typename T>
+struct VertexLayout;
+
+template <typename T>
+concept HasVertexLayout = requires { VertexLayout<T>::ATTRIBUTES.size(); };
+
+// Every attribute lies inside the element (checked in a static_assert next to each specialization)
+template <HasVertexLayout T>
+[[nodiscard]] constexpr bool layoutFits() {
+  for (const VertexAttribute& attribute : VertexLayout<T>::ATTRIBUTES) {
+    if (attribute.components == 0 || attribute.components > 4 || attribute.offset + attribute.size() > sizeof(T)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Split layout for count elements: one tightly packed block per type, back to back in argument order (each
+// block starts 4-byte aligned), locations counting up from firstLocation
+template <typename... Blocks>
+[[nodiscard]] constexpr std::array<VertexAttribute, sizeof...(Blocks)> blockLayout(size_t count,
+                                                                                   uint32_t firstLocation = 0) {
+  std::array<VertexAttribute, sizeof...(Blocks)> attributes{};
+  size_t offset = 0;
+  uint32_t index = 0;
+  auto add = [&]<typename Block>() {
+    attributes[index] = attribute<Block>(firstLocation + index, offset);
+    attributes[index].stride = sizeof(Block);
+    offset = ((offset + (count * sizeof(Block))) + 3) & ~size_t{3};
+    ++index;
+  };
+  (add.template operator()<Blocks>(), ...);
+  return attributes;
+}
+
+// Total bytes of a split layout for count elements
+template <typename... Blocks>
+[[nodiscard]] constexpr size_t blockLayoutSize(size_t count) {
+  size_t offset = 0;
+  ((offset = ((offset + (count * sizeof(Blocks))) + 3) & ~size_t{3}), ...);
+  return offset;
+}
+
+// Layouts of the renderer's own element types (locations match its shaders)
+
+// Float32 dynamic 2D vertices, streamed as they are
+template <>
+struct VertexLayout<Vertex2D> {
+  static constexpr std::array ATTRIBUTES = {
+      attribute<glm::vec2>(0, offsetof(Vertex2D, position)),
+      attribute<Color>(1, offsetof(Vertex2D, color)),
+  };
+};
+static_assert(layoutFits<Vertex2D>());
+
+// Instanced nodes: location 0 is the quad corner, position and radius are read as one vec4
+template <>
+struct VertexLayout<NodeInstance> {
+  static constexpr std::array ATTRIBUTES = {
+      attribute(1, offsetof(NodeInstance, position), 4, AttributeType::Float32),
+      attribute<Color>(2, offsetof(NodeInstance, color)),
+      attribute<NodeShape>(3, offsetof(NodeInstance, shape)),
+      attribute<float>(4, offsetof(NodeInstance, outlineWidth)),
+  };
+};
+static_assert(layoutFits<NodeInstance>());
+static_assert(offsetof(NodeInstance, radius) == offsetof(NodeInstance, position) + sizeof(glm::vec3));
+
+// Instanced edges: endpoints as one uvec2, color as normalized RGBA8
+template <>
+struct VertexLayout<EdgeInstance> {
+  static constexpr std::array ATTRIBUTES = {
+      attribute(1, offsetof(EdgeInstance, source), 2, AttributeType::UInt32),
+      attribute<float>(2, offsetof(EdgeInstance, width)),
+      attribute(3, offsetof(EdgeInstance, color), 4, AttributeType::UNorm8),
+  };
+};
+static_assert(layoutFits<EdgeInstance>());
+static_assert(offsetof(EdgeInstance, target) == offsetof(EdgeInstance, source) + sizeof(uint32_t));
+
+// Mesh vertex buffer of a runtime format: positions block (location 0) followed by colors block (location 1)
+[[nodiscard]] constexpr std::array<VertexAttribute, 2> meshLayout(VertexFormat format, size_t vertexCount,
+                                                                  uint32_t dimensions = 3) {
+  const bool half = format == VertexFormat::HalfPosition;
+  const bool floatColors = format == VertexFormat::Float32;
+  return {
+      VertexAttribute{0, dimensions, half ? AttributeType::Float16 : AttributeType::Float32, 0,
+                      static_cast<uint32_t>(positionSize(format, dimensions))},
+      VertexAttribute{1, 4, floatColors ? AttributeType::Float32 : AttributeType::UNorm8,
+                      static_cast<uint32_t>(colorBlockOffset(format, vertexCount, dimensions)),
+                      static_cast<uint32_t>(colorSize(format))},
+  };
+}
+
+// Interleaved dynamic 2D vertices of a runtime format (position, color; vertexSize2D bytes each)
+[[nodiscard]] constexpr std::array<VertexAttribute, 2> streamLayout2D(VertexFormat format) {
+  const bool half = format == VertexFormat::HalfPosition;
+  const bool floatColors = format == VertexFormat::Float32;
+  const AttributeType positionType = half ? AttributeType::Float16 : AttributeType::Float32;
+  const auto stride = static_cast<uint32_t>(vertexSize2D(format));
+  return {
+      VertexAttribute{0, 2, positionType, 0, stride},
+      VertexAttribute{1, 4, floatColors ? AttributeType::Float32 : AttributeType::UNorm8,
+                      2 * attributeTypeSize(positionType), stride},
+  };
+}
+
+}  // namespace util
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <util/glm.hpp>
+#include <util/types.hpp>
+
+namespace util {
+
+// CPU-side packing of vertices into the GPU vertex buffer layouts.
+// The shared mesh vertex buffer is split in two blocks: all positions followed by all colors,
+// so positions and colors can be rewritten independently with one contiguous copy each.
+// Dynamic 2D vertices are interleaved (position, color) in the stream buffer.
+
+// Byte size of one packed position in the mesh positions block. Three half components are padded to four,
+// flat (two-component) positions are stored as they are.
+[[nodiscard]] constexpr size_t positionSize(VertexFormat format, uint32_t dimensions = 3) {
+  if (format == VertexFormat::HalfPosition) {
+    return (dimensions == 2 ? 2 : 4) * sizeof(uint16_t);
+  }
+  return dimensions * sizeof(float);
+}
+
+// Byte size of one packed color
+[[nodiscard]] constexpr size_t colorSize(VertexFormat format) {
+  return format == VertexFormat::Float32 ? 4 * sizeof(float) : 4 * sizeof(uint8_t);
+}
+
+// Byte size of one interleaved 2D vertex (position followed by color)
+[[nodiscard]] constexpr size_t vertexSize2D(VertexFormat format) {
+  return (format == VertexFormat::HalfPosition ? 2 * sizeof(uint16_t) : 2 * sizeof(float)) + colorSize(format);
+}
+
+// Offset of the color block inside a mesh vertex buffer holding vertexCount vertices
+[[nodiscard]] constexpr size_t colorBlockOffset(VertexFormat format, size_t vertexCount, uint32_t dimensions = 3) {
+  return vertexCount * positionSize(format, dimensions);
+}
+
+// Total mesh vertex buffer size for vertexCount vertices
+[[nodiscard]] constexpr size_t vertexBufferSize(VertexFormat format, size_t vertexCount, uint32_t dimensions = 3) {
+  return vertexCount * (positionSize(format, dimensions) + colorSize(format));
+}
+
+// Normalized RGBA8, red in the lowest byte (matches GL_UNSIGNED_BYTE x4 in memory order)
+[[nodiscard]] inline uint32_t packColor(const Color& color) { return glm::packUnorm4x8(color); }
+
+[[nodiscard]] inline uint16_t packHalf(float value) { return glm::packHalf1x16(value); }
+
+// RGBA8 packing of count colors read every stride bytes (a Color array or the colors of a vertex array)
+inline void packColorsScalar(const Color* colors, size_t stride, size_t count, uint32_t* out) {
+  const auto* src = reinterpret_cast<const uint8_t*>(colors);
+  for (size_t i = 0; i < count; ++i) {
+    out[i] = packColor(*reinterpret_cast<const Color*>(src + (i * stride)));
+  }
+}
+
+#if defined(__SSE2__)
+// Four colors per iteration: clamp, scale, round half up, then saturate down to bytes (same results as scalar)
+inline void packColorsSSE2(const Color* colors, size_t stride, size_t count, uint32_t* out) {
+  const auto* src = reinterpret_cast<const uint8_t*>(colors);
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 scale = _mm_set1_ps(255.0f);
+  const __m128 half = _mm_set1_ps(0.5f);
+  auto toInt = [&](size_t i) {
+    const __m128 c = _mm_loadu_ps(reinterpret_cast<const float*>(src + (i * stride)));
+    const __m128 clamped = _mm_min_ps(_mm_max_ps(c, zero), one);
+    return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(clamped, scale), half));
+  };
+
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m128i lo = _mm_packs_epi32(toInt(i), toInt(i + 1));
+    const __m128i hi = _mm_packs_epi32(toInt(i + 2), toInt(i + 3));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(lo, hi));
+  }
+  packColorsScalar(reinterpret_cast<const Color*>(src + (i * stride)), stride, count - i, out + i);
+}
+#endif
+
+// Fastest available RGBA8 packing
+inline void packColorsRGBA8(const Color* colors, size_t stride, size_t count, uint32_t* out) {
+#if defined(__SSE2__)
+  packColorsSSE2(colors, stride, count, out);
+#else
+  packColorsScalar(colors, stride, count, out);
+#endif
+}
+
+// Write positions into the mesh positions block
+inline void packPositions(VertexFormat format, std::span<const glm::vec3> positions, void* out) {
+  if (format == VertexFormat::HalfPosition) {
+    auto* dst = static_cast<uint16_t*>(out);
+    for (const auto& p : positions) {
+      dst[0] = packHalf(p.x);
+      dst[1] = packHalf(p.y);
+      dst[2] = packHalf(p.z);
+      dst[3] = 0;
+      dst += 4;
+    }
+    return;
+  }
+
+  auto* dst = static_cast<float*>(out);
+  for (const auto& p : positions) {
+    dst[0] = p.x;
+    dst[1] = p.y;
+    dst[2] = p.z;
+    dst += 3;
+  }
+}
+
+inline void packPositions(VertexFormat format, std::span<const Vertex3D> vertices, void* out) {
+  if (format == VertexFormat::HalfPosition) {
+    auto* dst = static_cast<uint16_t*>(out);
+    for (const auto& v : vertices) {
+      dst[0] = packHalf(v.position.x);
+      dst[1] = packHalf(v.position.y);
+      dst[2] = packHalf(v.position.z);
+      dst[3] = 0;
+      dst += 4;
+    }
+    return;
+  }
+
+  auto* dst = static_cast<float*>(out);
+  for (const auto& v : vertices) {
+    dst[0] = v.position.x;
+    dst[1] = v.position.y;
+    dst[2] = v.position.z;
+    dst += 3;
+  }
+}
+
+inline void packPositions(VertexFormat format, std::span<const Vertex2D> vertices, void* out) {
+  if (format == VertexFormat::HalfPosition) {
+    auto* dst = static_cast<uint16_t*>(out);
+    for (const auto& v : vertices) {
+      dst[0] = packHalf(v.position.x);
+      dst[1] = packHalf(v.position.y);
+      dst += 2;
+    }
+    return;
+  }
+
+  auto* dst = static_cast<float*>(out);
+  for (const auto& v : vertices) {
+    dst[0] = v.position.x;
+    dst[1] = v.position.y;
+    dst += 2;
+  }
+}
+
+// Write colors into the mesh colors block
+inline void packColors(VertexFormat format, std::span<const Color> colors, void* out) {
+  if (format == VertexFormat::Float32) {
+    std::memcpy(out, colors.data(), colors.size_bytes());
+    return;
+  }
+
+  packColorsRGBA8(colors.data(), sizeof(Color), colors.size(), static_cast<uint32_t*>(out));
+}
+
+// Colors of a vertex array (Vertex2D or Vertex3D)
+template <typename VertexType>
+inline void packVertexColors(VertexFormat format, std::span<const VertexType> vertices, void* out) {
+  if (format == VertexFormat::Float32) {
+    auto* dst = static_cast<float*>(out);
+    for (const auto& v : vertices) {
+      dst[0] = v.color.r;
+      dst[1] = v.color.g;
+      dst[2] = v.color.b;
+      dst[3] = v.color.a;
+      dst += 4;
+    }
+    return;
+  }
+
+  if (!vertices.empty()) {
+    packColorsRGBA8(&vertices[0].color, sizeof(VertexType), vertices.size(), static_cast<uint32_t*>(out));
+  }
+}
+
+inline void packColors(VertexFormat format, std::span<const Vertex3D> vertices, void* out) {
+  packVertexColors(format, vertices, out);
+}
+
+inline void packColors(VertexFormat format, std::span<const Vertex2D> vertices, void* out) {
+  packVertexColors(format, vertices, out);
+}
+
+// Write interleaved 2D vertices (position, color) for the dynamic paths
+inline void packVertices2D(VertexFormat format, std::span<const Vertex2D> vertices, void* out) {
+  auto* dst = static_cast<uint8_t*>(out);
+
+  switch (format) {
+    case VertexFormat::Float32:
+      // Vertex2D is the Float32 layout itself (see VertexLayout<Vertex2D>)
+      static_assert(sizeof(Vertex2D) == vertexSize2D(VertexFormat::Float32));
+      static_assert(offsetof(Vertex2D, color) == 2 * sizeof(float));
+      if (!vertices.empty()) {
+        std::memcpy(dst, vertices.data(), vertices.size_bytes());
+      }
+      break;
+    case VertexFormat::PackedColor:
+      for (const auto& v : vertices) {
+        const uint32_t color = packColor(v.color);
+        std::memcpy(dst, &v.position.x, sizeof(float));
+        std::memcpy(dst + 4, &v.position.y, sizeof(float));
+        std::memcpy(dst + 8, &color, sizeof(color));
+        dst += 12;
+      }
+      break;
+    case VertexFormat::HalfPosition:
+      for (const auto& v : vertices) {
+        const uint16_t position[2] = {packHalf(v.position.x), packHalf(v.position.y)};
+        const uint32_t color = packColor(v.color);
+        std::memcpy(dst, position, sizeof(position));
+        std::memcpy(dst + 4, &color, sizeof(color));
+        dst += 8;
+      }
+      break;
+  }
+}
+
+// True if every index refers to an existing vertex
+[[nodiscard]] inline bool indicesInRange(std::span<const uint32_t> indices, size_t vertexCount) {
+  for (uint32_t idx : indices) {
+    if (idx >= vertexCount) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace util
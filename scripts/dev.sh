@@ -58,10 +58,10 @@ debug() {
         cmake --build "$BUILD_DIR" --parallel
     else
         # Verify target exists
-        if [ ! -f "src/apps/$TARGET.cpp" ]; then
+        if [ ! -f "src/apps/$TARGET.cpp" ] && [ ! -f "bench/$TARGET.cpp" ]; then
             echo -e "${RED}Error: Target '$TARGET' not found${NC}"
             echo "Available targets:"
-            find src/apps -name "*.cpp" -exec basename {} .cpp \; | sort
+            find src/apps bench -name "*.cpp" -exec basename {} .cpp \; 2>/dev/null | sort
             return 1
         fi
         cmake --build "$BUILD_DIR" --target "$TARGET" --parallel
@@ -93,10 +93,10 @@ release() {
         cmake --build "$BUILD_DIR" --parallel
     else
         # Verify target exists
-        if [ ! -f "src/apps/$TARGET.cpp" ]; then
+        if [ ! -f "src/apps/$TARGET.cpp" ] && [ ! -f "bench/$TARGET.cpp" ]; then
             echo -e "${RED}Error: Target '$TARGET' not found${NC}"
             echo "Available targets:"
-            find src/apps -name "*.cpp" -exec basename {} .cpp \; | sort
+            find src/apps bench -name "*.cpp" -exec basename {} .cpp \; 2>/dev/null | sort
             return 1
         fi
         cmake --build "$BUILD_DIR" --target "$TARGET" --parallel
@@ -127,7 +127,7 @@ format() {
     case "$TARGET" in
         "all")
             echo "Formatting all source files..."
-            FILES=($(find src include tests -type f \( -name "*.cpp" -o -name "*.h" -o -name "*.hpp" \) 2>/dev/null))
+            FILES=($(find src include tests bench -type f \( -name "*.cpp" -o -name "*.h" -o -name "*.hpp" \) 2>/dev/null))
             ;;
         "src")
             echo "Formatting src/ files..."
@@ -11,16 +11,6 @@
 #include <util/glm.hpp>
 #include <util/types.hpp>
 
-// Helper to convert Mesh2D to Mesh3D (z=0) for GPU upload
-util::Mesh3D toMesh3D(const util::Mesh2D& mesh2D) {
-  util::Mesh3D mesh3D;
-  for (const auto& v : mesh2D.vertices) {
-    mesh3D.vertices.emplace_back(v.position.x, v.position.y, 0.0f, v.color);
-  }
-  mesh3D.faces = mesh2D.faces;
-  return mesh3D;
-}
-
 int main() {
   gfx::Window window;
   gfx::Renderer renderer;
@@ -30,6 +20,8 @@ int main() {
     return -1;
   }
 
+  // Linked programs are reused across runs, only the first start compiles
+  renderer.setShaderCacheDirectory("shader_cache");
   if (!renderer.initialize(window, 800, 600)) {
     std::print("Failed to initialize renderer!\n");
     return -1;
@@ -43,6 +35,7 @@ int main() {
   float houseRotation = 0.0f;
   float starScale = 1.0f;
   float starRotation = 0.0f;
+  bool showOutlines = true;
 
   // Create a simple custom mesh by hand: a colorful house shape
   util::Mesh2D houseMesh;
@@ -74,6 +67,17 @@ int main() {
   houseMesh.addFace(5, 6, 7);  // Door triangle 1
   houseMesh.addFace(5, 7, 8);  // Door triangle 2
 
+  // Outline edges: walls, roof and door frame
+  houseMesh.addEdge(0, 1);
+  houseMesh.addEdge(1, 2);
+  houseMesh.addEdge(2, 3);
+  houseMesh.addEdge(3, 0);
+  houseMesh.addEdge(3, 4);
+  houseMesh.addEdge(4, 2);
+  houseMesh.addEdge(5, 8);
+  houseMesh.addEdge(8, 7);
+  houseMesh.addEdge(7, 6);
+
   // Create a second mesh: a simple star
   util::Mesh2D starMesh;
 
@@ -101,28 +105,39 @@ int main() {
   // Star faces (triangles from center)
   for (uint32_t i = 0; i < 10; ++i) {
     starMesh.addFace(10, i, (i + 1) % 10);
+    starMesh.addEdge(i, (i + 1) % 10);
   }
 
-  // Upload meshes to GPU once (efficient!)
-  util::MeshGPU houseGPU = renderer.uploadMesh(toMesh3D(houseMesh));
-  util::MeshGPU starGPU = renderer.uploadMesh(toMesh3D(starMesh));
+  // Upload meshes to GPU once (efficient!), straight from the 2D vertices with their edges
+  util::MeshGPU houseGPU = renderer.uploadMesh(houseMesh);
+  util::MeshGPU starGPU = renderer.uploadMesh(starMesh);
 
   // Orthographic projection for 2D (matches screen coordinates)
   glm::mat4 projection = glm::ortho(0.0f, 800.0f, 0.0f, 600.0f, -1.0f, 1.0f);
 
+  // Nothing animates: only redraw when the controls change or the window needs repainting
+  bool onDemand = true;
+  renderer.setOnDemand(onDemand);
+
   // Simple rendering loop
   while (!window.shouldClose()) {
-    window.pollEvents();
+    if (!renderer.waitForFrame(window)) {
+      continue;
+    }
 
     renderer.beginFrame();
 
     // Create ImGui control panel
     ImGui::Begin("Mesh Renderer Controls");
     ImGui::Text("Application: %.1f FPS", renderer.getFramerate());
+    if (ImGui::Checkbox("Render on demand", &onDemand)) {
+      renderer.setOnDemand(onDemand);
+    }
     ImGui::Separator();
 
     ImGui::Text("Background");
     ImGui::ColorEdit3("BG Color", bgColor);
+    ImGui::Checkbox("Outlines", &showOutlines);
     ImGui::Separator();
 
     ImGui::Text("House Mesh");
@@ -148,7 +163,11 @@ int main() {
     houseModel = glm::scale(houseModel, glm::vec3(houseScale, houseScale, 1.0f));
     houseModel = glm::translate(houseModel, glm::vec3(-200.0f, -300.0f, 0.0f));
 
+    // Outlines first: edges and faces share z = 0, so the depth test keeps the earlier lines on top
     glm::mat4 houseMVP = projection * houseModel;
+    if (showOutlines) {
+      renderer.drawMeshEdges(houseGPU, houseMVP, util::Color(0.0f, 0.0f, 0.0f, 1.0f));
+    }
     renderer.drawMesh(houseGPU, houseMVP, util::Color(houseTint[0], houseTint[1], houseTint[2], houseTint[3]));
 
     // Draw star with GPU-side transformations (efficient!)
@@ -159,6 +178,9 @@ int main() {
     starModel = glm::translate(starModel, glm::vec3(-centerX, -centerY, 0.0f));
 
     glm::mat4 starMVP = projection * starModel;
+    if (showOutlines) {
+      renderer.drawMeshEdges(starGPU, starMVP, util::Color(0.0f, 0.0f, 0.0f, 1.0f));
+    }
     renderer.drawMesh(starGPU, starMVP, util::Color(starTint[0], starTint[1], starTint[2], starTint[3]));
 
     // Draw some additional test shapes
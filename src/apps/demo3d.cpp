@@ -100,6 +100,8 @@ int main() {
     return -1;
   }
 
+  // Linked programs are reused across runs, only the first start compiles
+  renderer.setShaderCacheDirectory("shader_cache");
   if (!renderer.initialize(window, 800, 600)) {
     std::print("Failed to initialize renderer!\n");
     return -1;
@@ -132,15 +134,34 @@ int main() {
   util::MeshGPU cubeGPU = renderer.uploadMesh(cubeMesh);
   util::MeshGPU pyramidGPU = renderer.uploadMesh(pyramidMesh);
 
+  // Frames are only drawn on input or while auto-rotating
+  bool onDemand = true;
+  int swapInterval = window.getSwapInterval();
+  renderer.setOnDemand(onDemand);
+
   // Rendering loop
   while (!window.shouldClose()) {
-    window.pollEvents();
+    if (!renderer.waitForFrame(window)) {
+      continue;
+    }
 
     renderer.beginFrame();
 
     // Create ImGui control panel
     ImGui::Begin("3D Demo Controls");
     ImGui::Text("FPS: %.1f", renderer.getFramerate());
+    if (ImGui::Checkbox("Render on demand", &onDemand)) {
+      renderer.setOnDemand(onDemand);
+    }
+    ImGui::Text("Swap interval");
+    bool swapChanged = ImGui::RadioButton("Off", &swapInterval, 0);
+    ImGui::SameLine();
+    swapChanged |= ImGui::RadioButton("VSync", &swapInterval, 1);
+    ImGui::SameLine();
+    swapChanged |= ImGui::RadioButton("Adaptive", &swapInterval, -1);
+    if (swapChanged && !window.setSwapInterval(swapInterval)) {
+      swapInterval = window.getSwapInterval();
+    }
     ImGui::Separator();
 
     ImGui::Text("Camera");
@@ -176,6 +197,7 @@ int main() {
       float deltaTime = 1.0f / 60.0f;  // Approximate
       cubeRotationY += deltaTime * autoRotateSpeed;
       pyramidRotationY += deltaTime * autoRotateSpeed;
+      renderer.requestRedraw();
     }
 
     // Clear screen
@@ -0,0 +1,348 @@
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <print>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include <imgui.h>
+
+#include <gfx/force_layout_opengl.hpp>
+#include <gfx/renderer.hpp>
+#include <gfx/window.hpp>
+
+#include <graph/analytics.hpp>
+#include <graph/force_layout.hpp>
+#include <graph/layout.hpp>
+
+#include <util/glm.hpp>
+#include <util/graph.hpp>
+#include <util/scene_snapshot.hpp>
+#include <util/types.hpp>
+
+// Random tree plus a few extra edges per node, colored by attachment order
+util::Graph createRandomGraph(uint32_t nodeCount, uint32_t extraEdgesPerNode) {
+  std::mt19937 rng(42);
+  std::vector<util::Edge> edges;
+  edges.reserve(static_cast<size_t>(nodeCount) * (1 + extraEdgesPerNode));
+
+  for (uint32_t i = 1; i < nodeCount; ++i) {
+    edges.emplace_back(i, static_cast<uint32_t>(rng() % i));
+    for (uint32_t e = 0; e < extraEdgesPerNode; ++e) {
+      edges.emplace_back(i, static_cast<uint32_t>(rng() % nodeCount));
+    }
+  }
+
+  util::Graph graph = util::Graph::fromEdges(nodeCount, edges);
+  for (uint32_t i = 0; i < nodeCount; ++i) {
+    const float t = static_cast<float>(i) / static_cast<float>(nodeCount);
+    graph.colors[i] = util::Color(1.0f - t, 0.4f + (0.6f * t), 0.2f + (0.8f * t), 1.0f);
+  }
+  return graph;
+}
+
+enum class ColorBy : uint8_t { Attachment, Degree, Component, PageRank, Distance };
+
+// Node colors from the analytics kernels (source = BFS root), returns the time taken in milliseconds
+double encodeColors(const util::Graph& graph, ColorBy mode, uint32_t source, std::vector<util::Color>& colors) {
+  const auto start = std::chrono::steady_clock::now();
+  switch (mode) {
+    case ColorBy::Attachment:
+      colors = graph.colors;
+      break;
+    case ColorBy::Degree:
+      graph::colorByValue(graph::degreeCentrality(graph), colors);
+      break;
+    case ColorBy::Component:
+      graph::colorByCategory(graph::connectedComponents(graph).labels, colors);
+      break;
+    case ColorBy::PageRank:
+      graph::colorByValue(graph::pageRank(graph), colors);
+      break;
+    case ColorBy::Distance:
+      graph::colorByDistance(graph::bfsDistances(graph, source), colors);
+      break;
+  }
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Follow the window's framebuffer (resizes, HiDPI scaling); call after beginFrame() updated ImGui's display
+void syncViewport(gfx::Renderer& renderer) {
+  const ImGuiIO& io = ImGui::GetIO();
+  const auto width = static_cast<uint32_t>((io.DisplaySize.x * io.DisplayFramebufferScale.x) + 0.5f);
+  const auto height = static_cast<uint32_t>((io.DisplaySize.y * io.DisplayFramebufferScale.y) + 0.5f);
+  if (width > 0 && height > 0 && (width != renderer.getWidth() || height != renderer.getHeight())) {
+    renderer.setViewport(width, height);
+  }
+}
+
+// Projection of the layout extent onto the current viewport
+glm::mat4 layoutProjection(const gfx::Renderer& renderer, float extent, float zoom) {
+  const float aspect = static_cast<float>(renderer.getWidth()) / static_cast<float>(renderer.getHeight());
+  const float halfHeight = extent / zoom;
+  return glm::ortho(-halfHeight * aspect, halfHeight * aspect, -halfHeight, halfHeight, -1.0f, 1.0f);
+}
+
+// Same loop for both backends, only the way positions reach the mesh differs
+template <typename LayoutType>
+void run(gfx::Window& window, gfx::Renderer& renderer, const util::Graph& graph, const char* backend) {
+  LayoutType layout;
+  if (!layout.initialize(graph, graph::LayoutParams())) {
+    std::print("Failed to initialize layout!\n");
+    return;
+  }
+
+  // Topology and colors are uploaded once, only positions change per frame
+  util::MeshGPU graphGPU = renderer.uploadGraph(graph);
+  util::EdgesGPU edgesGPU = renderer.uploadEdges(graph);
+
+  int iterationsPerFrame = 1;
+  bool running = true;
+  float edgeAlpha = 0.25f;
+  bool thickEdges = false;
+  float edgeWidth = 2.0f;
+  float zoom = 1.0f;
+  gfx::PickHit hovered;
+  const float extent = 0.6f * std::sqrt(static_cast<float>(graph.nodeCount()));
+
+  // Encodings are recomputed only when the selection changes and written into the mesh in place
+  int colorBy = static_cast<int>(ColorBy::Attachment);
+  int shownColorBy = colorBy;
+  uint32_t bfsSource = 0;
+  double analyticsTime = 0.0;
+  std::vector<util::Color> colors = graph.colors;
+
+  while (!window.shouldClose()) {
+    window.pollEvents();
+
+    renderer.beginFrame();
+    syncViewport(renderer);
+
+    // Hover results of an earlier frame's pick pass
+    for (const gfx::PickResult& result : renderer.takePickResults()) {
+      hovered = result.nearest;
+    }
+
+    // Clicking a node makes it the BFS root
+    bool recolor = false;
+    if (hovered.kind == gfx::PickKind::Node && ImGui::IsMouseClicked(0) && !ImGui::GetIO().WantCaptureMouse) {
+      bfsSource = hovered.id;
+      colorBy = static_cast<int>(ColorBy::Distance);
+      recolor = true;
+    }
+
+    ImGui::Begin("Layout");
+    ImGui::Text("Backend: %s", backend);
+    ImGui::Text("FPS: %.1f", renderer.getFramerate());
+    ImGui::Text("Nodes: %u  Edges: %u", graph.nodeCount(), graph.edgeCount());
+    ImGui::Text("Iteration: %llu  Temperature: %.3f", static_cast<unsigned long long>(layout.getIteration()),
+                layout.getTemperature());
+    ImGui::Checkbox("Running", &running);
+    ImGui::SliderInt("Iterations / frame", &iterationsPerFrame, 1, 10);
+    ImGui::SliderFloat("Edge alpha", &edgeAlpha, 0.0f, 1.0f);
+    ImGui::Checkbox("Thick edges", &thickEdges);
+    if (thickEdges) {
+      ImGui::SliderFloat("Edge width", &edgeWidth, 0.25f, 8.0f);
+    }
+    ImGui::SliderFloat("Zoom", &zoom, 0.1f, 10.0f);
+    if (ImGui::Button("Reheat")) {
+      layout.reheat();
+    }
+
+    // Frames go to layout_000000.png, ... without the UI; the still is larger than most framebuffers allow
+    gfx::FrameCaptureOpenGL& capture = renderer.getFrameCapture();
+    bool recording = capture.isRecording();
+    if (ImGui::Checkbox("Record", &recording)) {
+      if (recording) {
+        capture.startPngSequence("layout_");
+      } else {
+        capture.stop();
+      }
+    }
+    ImGui::SameLine();
+    const bool saveStill = ImGui::Button("Save 4x still");
+    ImGui::Text("Recorded: %llu  Dropped: %llu  Stills: %llu", static_cast<unsigned long long>(capture.getFrameCount()),
+                static_cast<unsigned long long>(capture.getDroppedCount()),
+                static_cast<unsigned long long>(capture.getStillCount()));
+    ImGui::Text("Color by:");
+    ImGui::RadioButton("Order", &colorBy, static_cast<int>(ColorBy::Attachment));
+    ImGui::SameLine();
+    ImGui::RadioButton("Degree", &colorBy, static_cast<int>(ColorBy::Degree));
+    ImGui::SameLine();
+    ImGui::RadioButton("Component", &colorBy, static_cast<int>(ColorBy::Component));
+    ImGui::SameLine();
+    ImGui::RadioButton("PageRank", &colorBy, static_cast<int>(ColorBy::PageRank));
+    ImGui::SameLine();
+    ImGui::RadioButton("BFS", &colorBy, static_cast<int>(ColorBy::Distance));
+    ImGui::Text("BFS root: node %u (click a node)  Last recolor: %.1f ms", bfsSource, analyticsTime);
+    if (hovered.kind == gfx::PickKind::Node) {
+      ImGui::Text("Hovered: node %u (degree %u)", hovered.id, graph.degree(hovered.id));
+    } else if (hovered.kind == gfx::PickKind::Edge) {
+      ImGui::Text("Hovered: edge %u - %u", hovered.id, hovered.other);
+    } else {
+      ImGui::Text("Hovered: -");
+    }
+    ImGui::End();
+
+    if (recolor || colorBy != shownColorBy) {
+      analyticsTime = encodeColors(graph, static_cast<ColorBy>(colorBy), bfsSource, colors);
+      renderer.updateMeshColors(graphGPU, colors);
+      shownColorBy = colorBy;
+    }
+
+    if (running) {
+      layout.step(static_cast<uint32_t>(iterationsPerFrame));
+      layout.present(renderer, graphGPU);
+    }
+
+    const glm::mat4 mvp = layoutProjection(renderer, extent, zoom);
+
+    const auto drawScene = [&](const glm::mat4& sceneMvp) {
+      if (thickEdges) {
+        renderer.drawEdges(edgesGPU, graphGPU, sceneMvp, util::Color(1.0f, 1.0f, 1.0f, edgeAlpha), edgeWidth);
+      } else {
+        renderer.drawMeshEdges(graphGPU, sceneMvp, util::Color(1.0f, 1.0f, 1.0f, edgeAlpha));
+      }
+      renderer.drawMeshPoints(graphGPU, sceneMvp, util::Color(1.0f, 1.0f, 1.0f, 1.0f), 3.0f);
+    };
+
+    renderer.clear(util::Color(0.05f, 0.05f, 0.08f, 1.0f));
+    drawScene(mvp);
+    if (saveStill) {
+      renderer.captureStill("layout_still.png", 4 * renderer.getWidth(), 4 * renderer.getHeight(),
+                            [&](const glm::mat4& tileTransform) { drawScene(tileTransform * mvp); });
+    }
+
+    // IDs under the mouse, slightly wider than drawn so thin edges and small points are easy to hit
+    if (renderer.beginPicking()) {
+      renderer.pickMeshEdges(graphGPU, mvp, 3.0f);
+      renderer.pickMeshPoints(graphGPU, mvp, 6.0f);
+      renderer.endPicking();
+      // Cursor in framebuffer pixels, y flipped to GL's bottom-left origin
+      const ImGuiIO& io = ImGui::GetIO();
+      const float mouseX = io.MousePos.x * io.DisplayFramebufferScale.x;
+      const float mouseY = io.MousePos.y * io.DisplayFramebufferScale.y;
+      if (mouseX >= 0.0f && mouseY >= 0.0f && mouseX < static_cast<float>(renderer.getWidth()) &&
+          mouseY < static_cast<float>(renderer.getHeight())) {
+        renderer.requestPick(static_cast<uint32_t>(mouseX), renderer.getHeight() - 1 - static_cast<uint32_t>(mouseY),
+                             4);
+      }
+    }
+
+    renderer.endFrame();
+    window.swapBuffers();
+  }
+
+  renderer.freeEdges(edgesGPU);
+  renderer.freeMesh(graphGPU);
+}
+
+// CPU layout on a simulation thread: the render loop only uploads the newest published positions, so
+// slow layout steps lower the layout rate but never the frame rate
+void runThreaded(gfx::Window& window, gfx::Renderer& renderer, const util::Graph& graph) {
+  graph::ForceLayout layout;
+  if (!layout.initialize(graph)) {
+    std::print("Failed to initialize layout!\n");
+    return;
+  }
+
+  util::MeshGPU graphGPU = renderer.uploadGraph(graph);
+
+  // Shared with the producer thread; everything else stays on its own side
+  std::atomic<uint32_t> iterationsPerFrame{1};
+  std::atomic<bool> reheat{false};
+
+  util::SnapshotProducer producer;
+  producer.start([&](util::SceneSnapshot& snapshot) {
+    if (reheat.exchange(false)) {
+      layout.reheat();
+    }
+    layout.step(iterationsPerFrame.load());
+    snapshot.positions.assign(layout.getPositions().begin(), layout.getPositions().end());
+    return true;
+  });
+
+  int iterations = 1;
+  bool running = true;
+  float edgeAlpha = 0.25f;
+  float zoom = 1.0f;
+  uint64_t shownSequence = 0;
+  const float extent = 0.6f * std::sqrt(static_cast<float>(graph.nodeCount()));
+
+  while (!window.shouldClose()) {
+    window.pollEvents();
+
+    renderer.beginFrame();
+    syncViewport(renderer);
+
+    // Never blocks: either a complete new snapshot or the one already on the GPU
+    if (const util::SceneSnapshot* snapshot = producer.acquire()) {
+      renderer.updateMeshPositions(graphGPU, snapshot->positions);
+      shownSequence = snapshot->sequence;
+    }
+
+    ImGui::Begin("Layout");
+    ImGui::Text("Backend: CPU (Barnes-Hut) on a simulation thread");
+    ImGui::Text("FPS: %.1f", renderer.getFramerate());
+    ImGui::Text("Nodes: %u  Edges: %u", graph.nodeCount(), graph.edgeCount());
+    ImGui::Text("Snapshot: %llu of %llu published", static_cast<unsigned long long>(shownSequence),
+                static_cast<unsigned long long>(producer.getPublishedCount()));
+    if (ImGui::Checkbox("Running", &running)) {
+      producer.setPaused(!running);
+    }
+    if (ImGui::SliderInt("Iterations / step", &iterations, 1, 10)) {
+      iterationsPerFrame.store(static_cast<uint32_t>(iterations));
+    }
+    ImGui::SliderFloat("Edge alpha", &edgeAlpha, 0.0f, 1.0f);
+    ImGui::SliderFloat("Zoom", &zoom, 0.1f, 10.0f);
+    if (ImGui::Button("Reheat")) {
+      reheat.store(true);
+    }
+    ImGui::End();
+
+    const glm::mat4 mvp = layoutProjection(renderer, extent, zoom);
+
+    renderer.clear(util::Color(0.05f, 0.05f, 0.08f, 1.0f));
+    renderer.drawMeshEdges(graphGPU, mvp, util::Color(1.0f, 1.0f, 1.0f, edgeAlpha));
+    renderer.drawMeshPoints(graphGPU, mvp, util::Color(1.0f, 1.0f, 1.0f, 1.0f), 3.0f);
+
+    renderer.endFrame();
+    window.swapBuffers();
+  }
+
+  // The layout and graph outlive the producer thread
+  producer.stop();
+  renderer.freeMesh(graphGPU);
+}
+
+int main(int argc, char** argv) {
+  const std::string_view mode = argc > 1 ? std::string_view(argv[1]) : std::string_view();
+  const bool gpu = mode == "--gpu";
+
+  gfx::Window window;
+  gfx::Renderer renderer;
+
+  if (!window.initialize(1280, 800, "Graph Layout Demo")) {
+    std::print("Failed to initialize GLFW window!\n");
+    return -1;
+  }
+
+  // Linked programs are reused across runs, only the first start compiles
+  renderer.setShaderCacheDirectory("shader_cache");
+  if (!renderer.initialize(window, 1280, 800)) {
+    std::print("Failed to initialize renderer!\n");
+    return -1;
+  }
+
+  util::Graph graph = createRandomGraph(20'000, 1);
+
+  if (gpu) {
+    run<gfx::GpuLayout>(window, renderer, graph, "GPU (transform feedback)");
+  } else if (mode == "--threaded") {
+    runThreaded(window, renderer, graph);
+  } else {
+    run<graph::CpuLayout>(window, renderer, graph, "CPU (Barnes-Hut)");
+  }
+}
@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <print>
+#include <random>
+#include <vector>
+
+#include <imgui.h>
+
+#include <gfx/renderer.hpp>
+#include <gfx/window.hpp>
+
+#include <graph/cluster_hierarchy.hpp>
+
+#include <util/glm.hpp>
+#include <util/graph.hpp>
+#include <util/types.hpp>
+
+// Communities scattered over the plane, dense inside and sparse between neighboring communities
+util::Graph createCommunityGraph(uint32_t communityCount, uint32_t communitySize) {
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+  const uint32_t nodeCount = communityCount * communitySize;
+  const auto side = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(communityCount))));
+
+  std::vector<util::Edge> edges;
+  edges.reserve(static_cast<size_t>(nodeCount) * 4);
+  for (uint32_t v = 0; v < nodeCount; ++v) {
+    const uint32_t community = v / communitySize;
+    const uint32_t first = community * communitySize;
+    for (int e = 0; e < 3; ++e) {
+      edges.emplace_back(v, first + static_cast<uint32_t>(rng() % communitySize));
+    }
+    // Occasional link to the next community in the row
+    if (rng() % 16 == 0) {
+      const uint32_t other = (community + 1) % communityCount;
+      edges.emplace_back(v, (other * communitySize) + static_cast<uint32_t>(rng() % communitySize));
+    }
+  }
+
+  util::Graph graph = util::Graph::fromEdges(nodeCount, edges);
+  for (uint32_t v = 0; v < nodeCount; ++v) {
+    const uint32_t community = v / communitySize;
+    const float cx = static_cast<float>(community % side) * 10.0f;
+    const float cy = static_cast<float>(community / side) * 10.0f;
+    const float angle = 2.0f * std::numbers::pi_v<float> * unit(rng);
+    const float radius = 3.0f * std::sqrt(unit(rng));
+    graph.positions[v] = glm::vec3(cx + (radius * std::cos(angle)), cy + (radius * std::sin(angle)), 0.0f);
+
+    const float t = static_cast<float>(community) / static_cast<float>(communityCount);
+    graph.colors[v] = util::Color(0.3f + (0.7f * t), 0.8f - (0.5f * t), 1.0f - t, 1.0f);
+  }
+  return graph;
+}
+
+int main() {
+  gfx::Window window;
+  gfx::Renderer renderer;
+
+  if (!window.initialize(1280, 800, "Graph LOD Demo")) {
+    std::print("Failed to initialize GLFW window!\n");
+    return -1;
+  }
+
+  // Linked programs are reused across runs, only the first start compiles
+  renderer.setShaderCacheDirectory("shader_cache");
+  if (!renderer.initialize(window, 1280, 800)) {
+    std::print("Failed to initialize renderer!\n");
+    return -1;
+  }
+
+  const util::Graph graph = createCommunityGraph(4096, 128);
+
+  // Coarse levels appear while the full graph is already on screen
+  graph::ClusterHierarchy hierarchy;
+  hierarchy.buildAsync(graph);
+
+  // Levels are packed and streamed in the background, the closest finer level stands in until ready
+  std::vector<util::MeshHandle> levelMeshes;
+  levelMeshes.push_back(renderer.uploadGraphAsync(graph));
+
+  graph::LodParams lodParams;
+  bool automatic = true;
+  int manualLevel = 0;
+  float zoom = 1.0f;
+  float edgeAlpha = 0.3f;
+  glm::vec2 center(320.0f, 320.0f);
+
+  while (!window.shouldClose()) {
+    window.pollEvents();
+
+    // Upload levels as the background build publishes them
+    while (levelMeshes.size() <= hierarchy.getLevelCount()) {
+      levelMeshes.push_back(
+          renderer.uploadGraphAsync(hierarchy.getLevel(static_cast<uint32_t>(levelMeshes.size())).graph));
+    }
+
+    const float aspect = 1280.0f / 800.0f;
+    const float halfHeight = 360.0f / zoom;
+    const glm::mat4 mvp = glm::ortho(center.x - (halfHeight * aspect), center.x + (halfHeight * aspect),
+                                     center.y - halfHeight, center.y + halfHeight, -1.0f, 1.0f);
+
+    const uint32_t maxLevel = static_cast<uint32_t>(levelMeshes.size()) - 1;
+    uint32_t level = automatic ? hierarchy.selectLevel(mvp, glm::vec2(1280.0f, 800.0f), lodParams)
+                               : std::min(static_cast<uint32_t>(manualLevel), maxLevel);
+    while (level > 0 && !levelMeshes[level]->isReady()) {
+      --level;
+    }
+
+    renderer.beginFrame();
+
+    ImGui::Begin("Level of detail");
+    ImGui::Text("FPS: %.1f", renderer.getFramerate());
+    ImGui::Text("Levels: %u%s", maxLevel, hierarchy.isBuilding() ? " (building)" : "");
+    ImGui::Text("Pending uploads: %zu", renderer.getPendingUploadCount());
+    ImGui::Text("Drawing level %u: %u nodes, %u edges", level, hierarchy.getNodeCount(level),
+                hierarchy.getEdgeCount(level));
+    ImGui::Checkbox("Automatic", &automatic);
+    ImGui::SliderInt("Level", &manualLevel, 0, static_cast<int>(maxLevel));
+    ImGui::SliderFloat("Edges / pixel", &lodParams.maxEdgesPerPixel, 0.01f, 2.0f);
+    ImGui::SliderFloat("Zoom", &zoom, 0.25f, 64.0f, "%.2f", ImGuiSliderFlags_Logarithmic);
+    ImGui::SliderFloat("Center x", &center.x, 0.0f, 640.0f);
+    ImGui::SliderFloat("Center y", &center.y, 0.0f, 640.0f);
+    ImGui::SliderFloat("Edge alpha", &edgeAlpha, 0.0f, 1.0f);
+    ImGui::End();
+
+    renderer.getProfiler().drawPanel();
+
+    renderer.clear(util::Color(0.05f, 0.05f, 0.08f, 1.0f));
+    renderer.drawMeshEdges(levelMeshes[level], mvp, util::Color(1.0f, 1.0f, 1.0f, edgeAlpha));
+    renderer.drawMeshPoints(levelMeshes[level], mvp, util::Color(1.0f, 1.0f, 1.0f, 1.0f), level == 0 ? 2.0f : 4.0f);
+
+    renderer.endFrame();
+    window.swapBuffers();
+  }
+
+  for (util::MeshHandle& mesh : levelMeshes) {
+    renderer.freeMesh(mesh);
+  }
+}
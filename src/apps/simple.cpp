@@ -67,6 +67,7 @@ int main() {
     renderer.drawMeshPoints(graphGPU, mvp, util::Color(1.0f, 1.0f, 1.0f, 1.0f), 8.0f);
 
     renderer.drawCircle(100, 200, 20, util::Color(1.0, 1.0, 1.0, 1.0), true);
+    renderer.drawCircleSDF(160, 200, 20, util::Color(1.0, 0.8, 0.2, 1.0), 3.0f);
 
     renderer.endFrame();
     window.swapBuffers();
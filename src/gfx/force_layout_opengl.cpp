@@ -0,0 +1,410 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <gfx/force_layout_opengl.hpp>
+#include <gfx/vertex_layout_opengl.hpp>
+
+#include <graph/force_layout.hpp>
+
+#include <util/glm.hpp>
+#include <util/graph.hpp>
+#include <util/vertex_layout.hpp>
+
+namespace gfx {
+
+// One invocation per node: forces from the previous positions, displacement capped by the temperature
+const std::string LAYOUT_VERTEX_SHADER = R"(
+#version 330 core
+layout (location = 0) in vec4 aPosition;
+
+uniform samplerBuffer uPositions;
+uniform usamplerBuffer uOffsets;
+uniform usamplerBuffer uNeighbors;
+uniform samplerBuffer uWeights;
+
+uniform uint uNodeCount;
+uniform uint uSampleCount;
+uniform uint uSampleStride;
+uniform uint uSampleOffset;
+uniform float uRepulsion;
+uniform float uAttraction;
+uniform float uGravity;
+uniform float uTemperature;
+uniform float uSeparation;
+uniform bool uPlanar;
+
+out vec4 vPosition;
+
+void main() {
+    uint self = uint(gl_VertexID);
+    vec3 p = aPosition.xyz;
+    vec3 force = -uGravity * p;
+
+    // Repulsion from all nodes, or a strided sample of them
+    vec3 repulsion = vec3(0.0);
+    for (uint s = 0u; s < uSampleCount; ++s) {
+        uint j = (self + uSampleOffset + s * uSampleStride) % uNodeCount;
+        if (j == self) {
+            continue;
+        }
+        vec3 d = p - texelFetch(uPositions, int(j)).xyz;
+        float d2 = dot(d, d);
+        if (d2 < 1e-12) {
+            d = vec3(self < j ? -uSeparation : uSeparation, 0.0, 0.0);
+            d2 = uSeparation * uSeparation;
+        }
+        repulsion += d / d2;
+    }
+    force += uRepulsion * repulsion;
+
+    // Springs along the CSR adjacency
+    uint first = texelFetch(uOffsets, int(self)).r;
+    uint last = texelFetch(uOffsets, int(self) + 1).r;
+    for (uint slot = first; slot < last; ++slot) {
+        uint j = texelFetch(uNeighbors, int(slot)).r;
+        vec3 d = texelFetch(uPositions, int(j)).xyz - p;
+        force += d * (uAttraction * length(d) * texelFetch(uWeights, int(slot)).r);
+    }
+
+    if (uPlanar) {
+        force.z = 0.0;
+    }
+
+    float len = length(force);
+    if (len > uTemperature) {
+        force *= uTemperature / len;
+    }
+
+    vPosition = vec4(p + force, aPosition.w);
+}
+)";
+
+namespace {
+
+// The renderers track the bound program and VAO, put back whatever was bound before
+class ScopedProgramBinding {
+ public:
+  ScopedProgramBinding() {
+    glGetIntegerv(GL_CURRENT_PROGRAM, &m_program);
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &m_vao);
+  }
+  ~ScopedProgramBinding() {
+    glUseProgram(static_cast<GLuint>(m_program));
+    glBindVertexArray(static_cast<GLuint>(m_vao));
+  }
+
+  ScopedProgramBinding(const ScopedProgramBinding&) = delete;
+  ScopedProgramBinding(ScopedProgramBinding&&) = delete;
+  ScopedProgramBinding& operator=(const ScopedProgramBinding&) = delete;
+  ScopedProgramBinding& operator=(ScopedProgramBinding&&) = delete;
+
+ private:
+  GLint m_program = 0;
+  GLint m_vao = 0;
+};
+
+}  // namespace
+
+ForceLayoutOpenGL::ForceLayoutOpenGL()
+    : m_nodeCount(0),
+      m_iteration(0),
+      m_temperature(0.0f),
+      m_nodeCountLoc(-1),
+      m_sampleCountLoc(-1),
+      m_sampleStrideLoc(-1),
+      m_sampleOffsetLoc(-1),
+      m_repulsionLoc(-1),
+      m_attractionLoc(-1),
+      m_gravityLoc(-1),
+      m_temperatureLoc(-1),
+      m_separationLoc(-1),
+      m_planarLoc(-1),
+      m_positionBuffers{},
+      m_positionTextures{},
+      m_vaos{},
+      m_offsetBuffer(0),
+      m_offsetTexture(0),
+      m_neighborBuffer(0),
+      m_neighborTexture(0),
+      m_weightBuffer(0),
+      m_weightTexture(0) {}
+
+ForceLayoutOpenGL::~ForceLayoutOpenGL() { cleanup(); }
+
+void ForceLayoutOpenGL::cleanup() {
+  m_program.destroy();
+  for (uint32_t i = 0; i < 2; ++i) {
+    if (m_vaos[i]) {
+      glDeleteVertexArrays(1, &m_vaos[i]);
+      m_vaos[i] = 0;
+    }
+    if (m_positionTextures[i]) {
+      glDeleteTextures(1, &m_positionTextures[i]);
+      m_positionTextures[i] = 0;
+    }
+    if (m_positionBuffers[i]) {
+      glDeleteBuffers(1, &m_positionBuffers[i]);
+      m_positionBuffers[i] = 0;
+    }
+  }
+  for (uint32_t* texture : {&m_offsetTexture, &m_neighborTexture, &m_weightTexture}) {
+    if (*texture) {
+      glDeleteTextures(1, texture);
+      *texture = 0;
+    }
+  }
+  for (uint32_t* buffer : {&m_offsetBuffer, &m_neighborBuffer, &m_weightBuffer}) {
+    if (*buffer) {
+      glDeleteBuffers(1, buffer);
+      *buffer = 0;
+    }
+  }
+  m_nodeCount = 0;
+}
+
+bool ForceLayoutOpenGL::loadProgram() {
+  // Vertex-only program, the new position is captured instead of rasterized
+  const char* varyings[] = {"vPosition"};
+  if (!m_program.create(LAYOUT_VERTEX_SHADER, std::string(), varyings)) {
+    return false;
+  }
+
+  m_nodeCountLoc = m_program.getUniformLocation("uNodeCount");
+  m_sampleCountLoc = m_program.getUniformLocation("uSampleCount");
+  m_sampleStrideLoc = m_program.getUniformLocation("uSampleStride");
+  m_sampleOffsetLoc = m_program.getUniformLocation("uSampleOffset");
+  m_repulsionLoc = m_program.getUniformLocation("uRepulsion");
+  m_attractionLoc = m_program.getUniformLocation("uAttraction");
+  m_gravityLoc = m_program.getUniformLocation("uGravity");
+  m_temperatureLoc = m_program.getUniformLocation("uTemperature");
+  m_separationLoc = m_program.getUniformLocation("uSeparation");
+  m_planarLoc = m_program.getUniformLocation("uPlanar");
+
+  // Fixed texture units for the buffer textures
+  ScopedProgramBinding binding;
+  glUseProgram(m_program.getId());
+  ShaderProgramOpenGL::setUniform(m_program.getUniformLocation("uPositions"), 0);
+  ShaderProgramOpenGL::setUniform(m_program.getUniformLocation("uOffsets"), 1);
+  ShaderProgramOpenGL::setUniform(m_program.getUniformLocation("uNeighbors"), 2);
+  ShaderProgramOpenGL::setUniform(m_program.getUniformLocation("uWeights"), 3);
+
+  return true;
+}
+
+uint32_t ForceLayoutOpenGL::createTextureBuffer(uint32_t buffer, uint32_t internalFormat) {
+  uint32_t texture = 0;
+  glGenTextures(1, &texture);
+  glBindTexture(GL_TEXTURE_BUFFER, texture);
+  glTexBuffer(GL_TEXTURE_BUFFER, internalFormat, buffer);
+  glBindTexture(GL_TEXTURE_BUFFER, 0);
+  return texture;
+}
+
+bool ForceLayoutOpenGL::initialize(const util::Graph& graph, const graph::LayoutParams& params) {
+  cleanup();
+
+  const uint32_t nodeCount = graph.nodeCount();
+  if (nodeCount == 0) {
+    return false;
+  }
+
+  // The shader needs the reverse slots of directed edges as well
+  util::Graph undirected;
+  if (graph.directed) {
+    util::GraphBuildOptions options;
+    options.directed = false;
+    undirected = util::Graph::fromEdges(nodeCount, graph.edges, graph.weights, options);
+  }
+  const util::Graph& adjacency = graph.directed ? undirected : graph;
+  const size_t slotCount = adjacency.neighbors.size();
+
+  int maxTexels = 0;
+  glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTexels);
+  if (static_cast<size_t>(maxTexels) < std::max<size_t>(nodeCount + 1, slotCount)) {
+    return false;
+  }
+
+  if (!loadProgram()) {
+    return false;
+  }
+
+  setParams(params);
+  m_nodeCount = nodeCount;
+
+  // Positions with the node size in w (read directly as node instance position + radius)
+  const std::vector<glm::vec3> start = graph::initialPositions(graph, m_params);
+  std::vector<glm::vec4> positions(nodeCount);
+  for (uint32_t i = 0; i < nodeCount; ++i) {
+    const float size = graph.sizes.size() == nodeCount ? graph.sizes[i] : 1.0f;
+    positions[i] = glm::vec4(start[i].x, start[i].y, start[i].z, size);
+  }
+
+  const auto positionBytes = static_cast<GLsizeiptr>(positions.size() * sizeof(glm::vec4));
+  ScopedProgramBinding binding;
+  glGenBuffers(2, m_positionBuffers);
+  glGenVertexArrays(2, m_vaos);
+  for (uint32_t i = 0; i < 2; ++i) {
+    glBindBuffer(GL_ARRAY_BUFFER, m_positionBuffers[i]);
+    glBufferData(GL_ARRAY_BUFFER, positionBytes, i == 0 ? positions.data() : nullptr, GL_DYNAMIC_COPY);
+
+    glBindVertexArray(m_vaos[i]);
+    applyVertexLayout(util::blockLayout<glm::vec4>(nodeCount));
+
+    m_positionTextures[i] = createTextureBuffer(m_positionBuffers[i], GL_RGBA32F);
+  }
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  // CSR adjacency, weights resolved per slot; at least one texel so the textures are complete
+  std::vector<float> slotWeights(std::max<size_t>(slotCount, 1), 1.0f);
+  if (adjacency.weights.size() == adjacency.edges.size()) {
+    for (size_t slot = 0; slot < slotCount; ++slot) {
+      slotWeights[slot] = adjacency.weights[adjacency.edgeIds[slot]];
+    }
+  }
+  std::vector<uint32_t> neighbors = adjacency.neighbors;
+  neighbors.resize(std::max<size_t>(slotCount, 1), 0);
+
+  glGenBuffers(1, &m_offsetBuffer);
+  glBindBuffer(GL_TEXTURE_BUFFER, m_offsetBuffer);
+  glBufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(adjacency.offsets.size() * sizeof(uint32_t)),
+               adjacency.offsets.data(), GL_STATIC_DRAW);
+
+  glGenBuffers(1, &m_neighborBuffer);
+  glBindBuffer(GL_TEXTURE_BUFFER, m_neighborBuffer);
+  glBufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(neighbors.size() * sizeof(uint32_t)), neighbors.data(),
+               GL_STATIC_DRAW);
+
+  glGenBuffers(1, &m_weightBuffer);
+  glBindBuffer(GL_TEXTURE_BUFFER, m_weightBuffer);
+  glBufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(slotWeights.size() * sizeof(float)), slotWeights.data(),
+               GL_STATIC_DRAW);
+  glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+  m_offsetTexture = createTextureBuffer(m_offsetBuffer, GL_R32UI);
+  m_neighborTexture = createTextureBuffer(m_neighborBuffer, GL_R32UI);
+  m_weightTexture = createTextureBuffer(m_weightBuffer, GL_R32F);
+
+  m_iteration = 0;
+  reheat();
+  return true;
+}
+
+void ForceLayoutOpenGL::setParams(const graph::LayoutParams& params) {
+  m_params = params;
+  m_params.dimensions = params.dimensions == 3 ? 3 : 2;
+  m_params.repulsionSamples = std::max(params.repulsionSamples, 1u);
+}
+
+void ForceLayoutOpenGL::reheat() { m_temperature = graph::initialTemperature(m_params, m_nodeCount); }
+
+void ForceLayoutOpenGL::step(uint32_t iterations) {
+  if (!m_program.isValid() || m_nodeCount == 0 || iterations == 0) {
+    return;
+  }
+
+  const float k = m_params.springLength;
+  const bool sampled = m_nodeCount > m_params.repulsionSamples;
+  const uint32_t sampleCount = sampled ? m_params.repulsionSamples : m_nodeCount;
+  const uint32_t sampleStride = sampled ? m_nodeCount / sampleCount : 1;
+
+  // A sample stands in for (n - 1) / samples nodes
+  const float sampleScale =
+      sampled ? static_cast<float>(m_nodeCount - 1) / static_cast<float>(sampleCount) : 1.0f;
+
+  ScopedProgramBinding binding;
+  glUseProgram(m_program.getId());
+  glUniform1ui(m_nodeCountLoc, m_nodeCount);
+  glUniform1ui(m_sampleCountLoc, sampleCount);
+  glUniform1ui(m_sampleStrideLoc, sampleStride);
+  glUniform1f(m_repulsionLoc, m_params.repulsion * k * k * sampleScale);
+  glUniform1f(m_attractionLoc, m_params.attraction / k);
+  glUniform1f(m_gravityLoc, m_params.gravity);
+  glUniform1f(m_separationLoc, 1e-3f * k);
+  glUniform1i(m_planarLoc, m_params.dimensions != 3 ? 1 : 0);
+
+  glActiveTexture(GL_TEXTURE1);
+  glBindTexture(GL_TEXTURE_BUFFER, m_offsetTexture);
+  glActiveTexture(GL_TEXTURE2);
+  glBindTexture(GL_TEXTURE_BUFFER, m_neighborTexture);
+  glActiveTexture(GL_TEXTURE3);
+  glBindTexture(GL_TEXTURE_BUFFER, m_weightTexture);
+  glActiveTexture(GL_TEXTURE0);
+
+  // No fragments, only the captured positions
+  glEnable(GL_RASTERIZER_DISCARD);
+
+  uint32_t current = 0;
+  for (uint32_t i = 0; i < iterations; ++i) {
+    const uint32_t next = 1 - current;
+
+    // Rotate the sample so every pair is visited over a few iterations
+    const auto sampleOffset = sampled ? static_cast<uint32_t>((m_iteration * 2654435761ull) % m_nodeCount) : 0u;
+    glUniform1ui(m_sampleOffsetLoc, sampleOffset);
+    glUniform1f(m_temperatureLoc, m_temperature);
+
+    glBindTexture(GL_TEXTURE_BUFFER, m_positionTextures[current]);
+    glBindVertexArray(m_vaos[current]);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, m_positionBuffers[next]);
+
+    glBeginTransformFeedback(GL_POINTS);
+    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(m_nodeCount));
+    glEndTransformFeedback();
+
+    current = next;
+    m_temperature = std::max(m_temperature * m_params.cooling, m_params.minTemperature * k);
+    ++m_iteration;
+  }
+
+  glDisable(GL_RASTERIZER_DISCARD);
+  glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+
+  // Keep the result in the buffer the renderers are bound to
+  if (current != 0) {
+    glBindBuffer(GL_COPY_READ_BUFFER, m_positionBuffers[1]);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_positionBuffers[0]);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0,
+                        static_cast<GLsizeiptr>(m_nodeCount * sizeof(glm::vec4)));
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+  }
+
+  // Reset state
+  for (GLenum unit : {GL_TEXTURE3, GL_TEXTURE2, GL_TEXTURE1, GL_TEXTURE0}) {
+    glActiveTexture(unit);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+  }
+}
+
+void ForceLayoutOpenGL::readPositions(std::vector<glm::vec3>& positions) const {
+  positions.clear();
+  if (m_nodeCount == 0) {
+    return;
+  }
+
+  std::vector<glm::vec4> data(m_nodeCount);
+  glBindBuffer(GL_COPY_READ_BUFFER, m_positionBuffers[0]);
+  glGetBufferSubData(GL_COPY_READ_BUFFER, 0, static_cast<GLsizeiptr>(data.size() * sizeof(glm::vec4)), data.data());
+  glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+  positions.reserve(m_nodeCount);
+  for (const auto& p : data) {
+    positions.emplace_back(p.x, p.y, p.z);
+  }
+}
+
+void ForceLayoutOpenGL::writePositions(util::Graph& graph) const {
+  if (graph.positions.size() != m_nodeCount) {
+    return;
+  }
+  std::vector<glm::vec3> positions;
+  readPositions(positions);
+  std::copy(positions.begin(), positions.end(), graph.positions.begin());
+}
+
+}  // namespace gfx
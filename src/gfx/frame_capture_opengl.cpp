@@ -0,0 +1,308 @@
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <pthread.h>
+
+#include <glad/glad.h>
+
+#include <gfx/frame_capture_opengl.hpp>
+
+#include <util/image.hpp>
+
+namespace gfx {
+
+namespace {
+
+constexpr uint64_t WAIT_TIMEOUT_NS = 1'000'000'000;
+
+// <prefix>000042.png
+std::string framePath(const std::string& prefix, uint64_t index) {
+  std::string number = std::to_string(index);
+  if (number.size() < 6) {
+    number.insert(0, 6 - number.size(), '0');
+  }
+  return prefix + number + ".png";
+}
+
+// Run a pipe operation with SIGPIPE blocked on the calling thread: writing to a closed pipe then fails with
+// EPIPE instead of killing the process. A SIGPIPE raised meanwhile is consumed before the mask is restored.
+template <typename Operation>
+bool withPipeSignalBlocked(Operation&& operation) {
+  sigset_t pipeSignal;
+  sigemptyset(&pipeSignal);
+  sigaddset(&pipeSignal, SIGPIPE);
+  sigset_t previous;
+  pthread_sigmask(SIG_BLOCK, &pipeSignal, &previous);
+
+  errno = 0;
+  const bool succeeded = operation();
+  if (!succeeded && errno == EPIPE) {
+    const timespec noWait{};
+    sigtimedwait(&pipeSignal, nullptr, &noWait);
+  }
+
+  pthread_sigmask(SIG_SETMASK, &previous, nullptr);
+  return succeeded;
+}
+
+}  // namespace
+
+FrameCaptureOpenGL::FrameCaptureOpenGL()
+    : m_nextSequence(1),
+      m_sink(Sink::None),
+      m_pipe(nullptr),
+      m_pipeFailed(false),
+      m_frameWidth(0),
+      m_frameHeight(0),
+      m_frameCount(0),
+      m_droppedCount(0),
+      m_stillCount(0) {}
+
+FrameCaptureOpenGL::~FrameCaptureOpenGL() { cleanup(); }
+
+bool FrameCaptureOpenGL::startPngSequence(std::string prefix) {
+  if (isRecording()) {
+    return false;
+  }
+  m_prefix = std::move(prefix);
+  m_sink = Sink::PngSequence;
+  m_frameCount = 0;
+  m_droppedCount = 0;
+  return true;
+}
+
+bool FrameCaptureOpenGL::startPipe(const std::string& command) {
+  if (isRecording()) {
+    return false;
+  }
+  m_pipe = ::popen(command.c_str(), "w");
+  if (m_pipe == nullptr) {
+    return false;
+  }
+  m_sink = Sink::Pipe;
+  m_pipeFailed = false;
+  m_frameWidth = 0;
+  m_frameHeight = 0;
+  m_frameCount = 0;
+  m_droppedCount = 0;
+  return true;
+}
+
+void FrameCaptureOpenGL::stop() {
+  if (!isRecording()) {
+    return;
+  }
+  poll(true);
+  m_worker.waitIdle();
+
+  // Closing flushes the stream, so it may hit a closed pipe as well
+  if (m_pipe != nullptr) {
+    std::FILE* pipe = m_pipe;
+    withPipeSignalBlocked([pipe] { return ::pclose(pipe) != -1; });
+    m_pipe = nullptr;
+  }
+  m_sink = Sink::None;
+}
+
+bool FrameCaptureOpenGL::captureFrame(uint32_t width, uint32_t height) {
+  if (!isRecording() || width == 0 || height == 0) {
+    return false;
+  }
+
+  // The encoder went away: end the recording, hasPipeFailed() tells why
+  if (m_pipeFailed) {
+    stop();
+    ++m_droppedCount;
+    return false;
+  }
+
+  // Encoders expect one frame size; the first frame fixes it
+  if (m_sink == Sink::Pipe && m_frameWidth == 0) {
+    m_frameWidth = width;
+    m_frameHeight = height;
+  }
+  Readback* slot = nullptr;
+  if ((m_sink != Sink::Pipe || (width == m_frameWidth && height == m_frameHeight)) &&
+      m_worker.getPendingCount() < MAX_QUEUED_FRAMES) {
+    slot = acquireSlot(false);
+  }
+  if (slot == nullptr) {
+    ++m_droppedCount;
+    return false;
+  }
+
+  const uint64_t index = m_frameCount++;
+  slot->consume = [this, index, width, height](std::vector<uint8_t> pixels) {
+    consumeFrame(index, width, height, std::move(pixels));
+  };
+  read(*slot, width, height);
+  return true;
+}
+
+bool FrameCaptureOpenGL::beginStill(std::string path, uint32_t width, uint32_t height) {
+  if (m_still != nullptr || width == 0 || height == 0) {
+    return false;
+  }
+  m_still = std::make_shared<Still>();
+  m_still->path = std::move(path);
+  m_still->width = width;
+  m_still->height = height;
+  return true;
+}
+
+void FrameCaptureOpenGL::readTile(const util::ImageTile& tile) {
+  if (m_still == nullptr || tile.width == 0 || tile.height == 0) {
+    return;
+  }
+
+  // Tiles of one still are rendered back to back, so a full ring waits for the oldest read
+  Readback* slot = acquireSlot(true);
+  if (slot == nullptr) {
+    return;
+  }
+
+  // Render-side coverage decides which tile completes the still
+  const uint64_t area = static_cast<uint64_t>(m_still->width) * m_still->height;
+  m_still->coveredPixels += static_cast<uint64_t>(tile.width) * tile.height;
+  const bool last = m_still->coveredPixels >= area;
+
+  slot->consume = [this, still = m_still, tile, last](std::vector<uint8_t> pixels) {
+    // The image is allocated on the worker, so even huge stills never stall the render thread
+    if (still->pixels.empty()) {
+      still->pixels.resize(static_cast<size_t>(still->width) * still->height * 4);
+    }
+    util::copyTile(still->pixels, still->width, pixels, tile);
+    if (last) {
+      util::flipRows(still->pixels, static_cast<size_t>(still->width) * 4);
+      util::writePng(still->path, still->width, still->height, still->pixels);
+      still->pixels = {};
+      ++m_stillCount;
+    }
+  };
+  read(*slot, tile.width, tile.height);
+  if (last) {
+    m_still.reset();
+  }
+}
+
+void FrameCaptureOpenGL::poll(bool wait) {
+  // Fences signal in submission order, so stop at the first read that is still in flight
+  while (true) {
+    Readback* oldest = nullptr;
+    for (Readback& readback : m_readbacks) {
+      if (readback.sequence != 0 && (oldest == nullptr || readback.sequence < oldest->sequence)) {
+        oldest = &readback;
+      }
+    }
+    if (oldest == nullptr) {
+      return;
+    }
+
+    const auto fence = static_cast<GLsync>(oldest->fence);
+    GLenum status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    while (wait && status == GL_TIMEOUT_EXPIRED) {
+      status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, WAIT_TIMEOUT_NS);
+    }
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED && status != GL_WAIT_FAILED) {
+      return;
+    }
+    glDeleteSync(fence);
+    oldest->fence = nullptr;
+
+    // One copy out of the mapping, everything else happens on the worker
+    const size_t bytes = static_cast<size_t>(oldest->width) * oldest->height * 4;
+    std::vector<uint8_t> pixels;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, oldest->pbo);
+    const void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(bytes), GL_MAP_READ_BIT);
+    if (mapped != nullptr) {
+      pixels.resize(bytes);
+      std::memcpy(pixels.data(), mapped, bytes);
+      glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    if (!pixels.empty()) {
+      m_worker.submit([consume = std::move(oldest->consume), pixels = std::move(pixels)]() mutable {
+        consume(std::move(pixels));
+      });
+    }
+    oldest->consume = nullptr;
+    oldest->sequence = 0;
+  }
+}
+
+void FrameCaptureOpenGL::cleanup() {
+  stop();
+  poll(true);
+  m_worker.waitIdle();
+  m_still.reset();
+  for (Readback& readback : m_readbacks) {
+    if (readback.pbo != 0) {
+      glDeleteBuffers(1, &readback.pbo);
+    }
+    readback = Readback();
+  }
+}
+
+FrameCaptureOpenGL::Readback* FrameCaptureOpenGL::acquireSlot(bool wait) {
+  auto slot = std::ranges::find(m_readbacks, uint64_t{0}, &Readback::sequence);
+  if (slot == m_readbacks.end() && wait) {
+    poll(true);
+    slot = std::ranges::find(m_readbacks, uint64_t{0}, &Readback::sequence);
+  }
+  return slot != m_readbacks.end() ? &*slot : nullptr;
+}
+
+void FrameCaptureOpenGL::read(Readback& readback, uint32_t width, uint32_t height) {
+  readback.sequence = m_nextSequence++;
+  readback.width = width;
+  readback.height = height;
+
+  // RGBA8 rows are 4-byte aligned whatever the width; buffers only grow
+  const size_t bytes = static_cast<size_t>(width) * height * 4;
+  if (readback.pbo == 0) {
+    glGenBuffers(1, &readback.pbo);
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+  if (readback.capacity < bytes) {
+    glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_READ);
+    readback.capacity = bytes;
+  }
+
+  // The copy runs on the GPU timeline into the PBO, the fence tells when it has landed
+  glPixelStorei(GL_PACK_ALIGNMENT, 4);
+  glReadPixels(0, 0, static_cast<GLsizei>(width), static_cast<GLsizei>(height), GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void FrameCaptureOpenGL::consumeFrame(uint64_t index, uint32_t width, uint32_t height, std::vector<uint8_t> pixels) {
+  // Runs on the worker; the sink is only changed by stop() after the worker went idle
+  util::flipRows(pixels, static_cast<size_t>(width) * 4);
+  if (m_sink == Sink::PngSequence) {
+    util::writePng(framePath(m_prefix, index), width, height, pixels);
+  } else if (m_pipe != nullptr && !m_pipeFailed) {
+    // Flushed per frame so a closed pipe is noticed here and nothing is left buffered for pclose
+    std::FILE* pipe = m_pipe;
+    const bool written = withPipeSignalBlocked([&] {
+      return std::fwrite(pixels.data(), 1, pixels.size(), pipe) == pixels.size() && std::fflush(pipe) == 0;
+    });
+    if (!written) {
+      m_pipeFailed = true;
+    }
+  }
+}
+
+}  // namespace gfx
@@ -0,0 +1,69 @@
+#include <cstdint>
+
+#include <glad/glad.h>
+
+#include <gfx/framebuffer_opengl.hpp>
+
+namespace gfx {
+
+FramebufferOpenGL::FramebufferOpenGL()
+    : m_framebuffer(0), m_colorBuffer(0), m_depthBuffer(0), m_width(0), m_height(0) {}
+
+FramebufferOpenGL::~FramebufferOpenGL() { cleanup(); }
+
+bool FramebufferOpenGL::initialize(uint32_t width, uint32_t height) {
+  if (m_framebuffer != 0 || width == 0 || height == 0) {
+    return false;
+  }
+
+  glGenRenderbuffers(1, &m_colorBuffer);
+  glBindRenderbuffer(GL_RENDERBUFFER, m_colorBuffer);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, static_cast<GLsizei>(width), static_cast<GLsizei>(height));
+
+  glGenRenderbuffers(1, &m_depthBuffer);
+  glBindRenderbuffer(GL_RENDERBUFFER, m_depthBuffer);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, static_cast<GLsizei>(width),
+                        static_cast<GLsizei>(height));
+  glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+  glGenFramebuffers(1, &m_framebuffer);
+  glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorBuffer);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_depthBuffer);
+  const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+  m_width = width;
+  m_height = height;
+  if (!complete) {
+    cleanup();
+    return false;
+  }
+  return true;
+}
+
+void FramebufferOpenGL::cleanup() {
+  if (m_framebuffer != 0) {
+    glDeleteFramebuffers(1, &m_framebuffer);
+    m_framebuffer = 0;
+  }
+  if (m_colorBuffer != 0) {
+    glDeleteRenderbuffers(1, &m_colorBuffer);
+    m_colorBuffer = 0;
+  }
+  if (m_depthBuffer != 0) {
+    glDeleteRenderbuffers(1, &m_depthBuffer);
+    m_depthBuffer = 0;
+  }
+  m_width = 0;
+  m_height = 0;
+}
+
+void FramebufferOpenGL::bind() const {
+  glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+  glViewport(0, 0, static_cast<GLsizei>(m_width), static_cast<GLsizei>(m_height));
+}
+
+void FramebufferOpenGL::unbind() { glBindFramebuffer(GL_FRAMEBUFFER, 0); }
+
+}  // namespace gfx
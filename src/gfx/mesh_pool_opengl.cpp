@@ -0,0 +1,184 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <gfx/mesh_pool_opengl.hpp>
+#include <gfx/vertex_layout_opengl.hpp>
+#include <util/vertex_layout.hpp>
+#include <util/vertex_pack.hpp>
+
+namespace gfx {
+
+using util::PooledMeshGPU;
+using util::RangeAllocator;
+using util::VertexFormat;
+
+MeshPoolOpenGL::MeshPoolOpenGL() = default;
+
+MeshPoolOpenGL::~MeshPoolOpenGL() {
+  // Without the renderer's state cache only the GL objects can go; cleanup() is the regular path
+  for (const std::unique_ptr<Page>& page : m_pages) {
+    glDeleteVertexArrays(1, &page->vao);
+    glDeleteBuffers(1, &page->vbo);
+    glDeleteBuffers(1, &page->ebo);
+  }
+}
+
+PooledMeshGPU MeshPoolOpenGL::allocate(const util::PreparedMesh& prepared, StateCacheOpenGL& state) {
+  PooledMeshGPU mesh;
+  if (!prepared.isValid()) {
+    return mesh;
+  }
+
+  const uint32_t vertexCount = prepared.vertexCount;
+  const auto indexCount = static_cast<uint32_t>(prepared.faces.size() + prepared.edges.size() +
+                                                prepared.points.size());
+
+  // Both ranges from the same page, first fit over the pages of this format
+  auto tryPage = [&](Page& page) {
+    const uint32_t baseVertex = page.vertices.allocate(vertexCount);
+    if (baseVertex == RangeAllocator::INVALID_OFFSET) {
+      return false;
+    }
+    const uint32_t firstIndex = indexCount > 0 ? page.indices.allocate(indexCount) : 0;
+    if (firstIndex == RangeAllocator::INVALID_OFFSET) {
+      page.vertices.release(baseVertex, vertexCount);
+      return false;
+    }
+    mesh.baseVertex = baseVertex;
+    mesh.firstIndex = firstIndex;
+    return true;
+  };
+
+  Page* target = nullptr;
+  for (size_t i = 0; i < m_pages.size() && target == nullptr; ++i) {
+    if (m_pages[i]->format == prepared.format && m_pages[i]->dimensions == prepared.dimensions &&
+        tryPage(*m_pages[i])) {
+      target = m_pages[i].get();
+      mesh.page = static_cast<uint32_t>(i + 1);
+    }
+  }
+  if (target == nullptr) {
+    auto page = std::make_unique<Page>();
+    if (!createPage(*page, prepared.format, prepared.dimensions, std::max(PAGE_VERTICES, vertexCount),
+                    std::max(PAGE_INDICES, indexCount), state) ||
+        !tryPage(*page)) {
+      return PooledMeshGPU();
+    }
+    target = page.get();
+    m_pages.push_back(std::move(page));
+    mesh.page = static_cast<uint32_t>(m_pages.size());
+  }
+
+  // Vertex blocks go to the mesh's slots in the page's positions and colors blocks
+  const VertexFormat format = prepared.format;
+  const uint32_t dimensions = prepared.dimensions;
+  const size_t capacity = target->vertices.getCapacity();
+  glBindBuffer(GL_COPY_WRITE_BUFFER, target->vbo);
+  glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(mesh.baseVertex * positionSize(format, dimensions)),
+                  static_cast<GLsizeiptr>(vertexCount * positionSize(format, dimensions)),
+                  prepared.vertexData.data());
+  glBufferSubData(GL_COPY_WRITE_BUFFER,
+                  static_cast<GLintptr>(colorBlockOffset(format, capacity, dimensions) +
+                                        (mesh.baseVertex * colorSize(format))),
+                  static_cast<GLsizeiptr>(vertexCount * colorSize(format)),
+                  prepared.vertexData.data() + colorBlockOffset(format, vertexCount, dimensions));
+
+  // Faces, edges and points back to back; indices stay mesh-local, draws add the base vertex
+  glBindBuffer(GL_COPY_WRITE_BUFFER, target->ebo);
+  size_t offset = mesh.firstIndex;
+  for (const std::vector<uint32_t>* indices : {&prepared.faces, &prepared.edges, &prepared.points}) {
+    if (!indices->empty()) {
+      glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(offset * sizeof(uint32_t)),
+                      static_cast<GLsizeiptr>(indices->size() * sizeof(uint32_t)), indices->data());
+      offset += indices->size();
+    }
+  }
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+  mesh.vao = target->vao;
+  mesh.format = format;
+  mesh.dimensions = dimensions;
+  mesh.vertexCount = vertexCount;
+  mesh.indexCount = indexCount;
+  mesh.faceCount = static_cast<uint32_t>(prepared.faces.size());
+  mesh.edgeCount = static_cast<uint32_t>(prepared.edges.size());
+  mesh.pointCount = static_cast<uint32_t>(prepared.points.size());
+  mesh.bounds = prepared.bounds;
+  mesh.faceChunks = prepared.faceChunks;
+  mesh.edgeChunks = prepared.edgeChunks;
+  mesh.pointChunks = prepared.pointChunks;
+  return mesh;
+}
+
+void MeshPoolOpenGL::release(PooledMeshGPU& mesh) {
+  if (mesh.isValid() && mesh.page <= m_pages.size()) {
+    // Empty pages are kept for the next meshes
+    Page& page = *m_pages[mesh.page - 1];
+    page.vertices.release(mesh.baseVertex, mesh.vertexCount);
+    page.indices.release(mesh.firstIndex, mesh.indexCount);
+  }
+  mesh = PooledMeshGPU();
+}
+
+void MeshPoolOpenGL::cleanup(StateCacheOpenGL& state) {
+  for (const std::unique_ptr<Page>& page : m_pages) {
+    state.forgetVertexArray(page->vao);
+    glDeleteVertexArrays(1, &page->vao);
+    glDeleteBuffers(1, &page->vbo);
+    glDeleteBuffers(1, &page->ebo);
+  }
+  m_pages.clear();
+}
+
+uint64_t MeshPoolOpenGL::getCapacityBytes() const {
+  uint64_t bytes = 0;
+  for (const std::unique_ptr<Page>& page : m_pages) {
+    bytes += vertexBufferSize(page->format, page->vertices.getCapacity(), page->dimensions) +
+             (static_cast<uint64_t>(page->indices.getCapacity()) * sizeof(uint32_t));
+  }
+  return bytes;
+}
+
+bool MeshPoolOpenGL::createPage(Page& page, VertexFormat format, uint32_t dimensions, uint32_t vertexCapacity,
+                                uint32_t indexCapacity, StateCacheOpenGL& state) {
+  page.format = format;
+  page.dimensions = dimensions;
+  page.vertices.reset(vertexCapacity);
+  page.indices.reset(indexCapacity);
+
+  glGenBuffers(1, &page.vbo);
+  glGenBuffers(1, &page.ebo);
+  glGenVertexArrays(1, &page.vao);
+  if (page.vbo == 0 || page.ebo == 0 || page.vao == 0) {
+    glDeleteVertexArrays(1, &page.vao);
+    glDeleteBuffers(1, &page.vbo);
+    glDeleteBuffers(1, &page.ebo);
+    return false;
+  }
+
+  state.bindVertexArray(page.vao);
+
+  // Same attribute layout as a mesh's own buffer, with the blocks sized for the whole page
+  glBindBuffer(GL_ARRAY_BUFFER, page.vbo);
+  glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertexBufferSize(format, vertexCapacity, dimensions)),
+               nullptr, GL_STATIC_DRAW);
+  applyVertexLayout(util::meshLayout(format, vertexCapacity, dimensions));
+
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, page.ebo);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(static_cast<size_t>(indexCapacity) * sizeof(uint32_t)),
+               nullptr, GL_STATIC_DRAW);
+
+  // Unbind the VAO first so it keeps its element buffer
+  state.bindVertexArray(0);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  return true;
+}
+
+}  // namespace gfx
@@ -1,14 +1,31 @@
+#include <algorithm>
+#include <cstring>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <span>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <glad/glad.h>
 
 #include <gfx/mesh_renderer_opengl.hpp>
+#include <gfx/shader_program_opengl.hpp>
+#include <gfx/vertex_layout_opengl.hpp>
 
 #include <util/glm.hpp>
+#include <util/graph.hpp>
+#include <util/mesh_file.hpp>
+#include <util/mesh_prepare.hpp>
+#include <util/spatial_index.hpp>
 #include <util/types.hpp>
+#include <util/vertex_layout.hpp>
+#include <util/vertex_pack.hpp>
 
 namespace gfx {
 
@@ -47,11 +64,13 @@ layout (location = 0) in vec3 aPosition;
 layout (location = 1) in vec4 aColor;
 
 uniform mat4 uMVP;
+uniform float uPointSize;
 
 out vec4 vertexColor;
 
 void main() {
     gl_Position = uMVP * vec4(aPosition, 1.0);
+    gl_PointSize = uPointSize;
     vertexColor = aColor;
 }
 )";
@@ -81,290 +100,1974 @@ void main() {
 }
 )";
 
-MeshRendererOpenGL::MeshRendererOpenGL() : m_meshShaderProgram(0), m_pointShaderProgram(0) {}
+// Instanced node shader: expands a unit quad around each node center in screen space
+const std::string NODE_VERTEX_SHADER = R"(
+#version 330 core
+)" + AA_FRINGE_GLSL + R"(
+layout (location = 0) in vec2 aCorner;
+layout (location = 1) in vec4 aPositionRadius;
+layout (location = 2) in vec4 aColor;
+layout (location = 3) in uint aShape;
+layout (location = 4) in float aOutlineWidth;
+
+uniform mat4 uMVP;
+uniform vec2 uViewport;
+uniform float uRadiusScale;
+
+out vec2 localPos;
+out vec4 vertexColor;
+out float radius;
+out float outlineWidth;
+flat out uint shape;
+
+void main() {
+    radius = aPositionRadius.w * uRadiusScale;
+
+    float extent = radius + AA_FRINGE;
+    vec4 clipPos = uMVP * vec4(aPositionRadius.xyz, 1.0);
+    clipPos.xy += aCorner * extent * 2.0 / uViewport * clipPos.w;
+    gl_Position = clipPos;
+
+    localPos = aCorner * extent;
+    vertexColor = aColor;
+    outlineWidth = aOutlineWidth;
+    shape = aShape;
+}
+)";
+
+const std::string NODE_FRAGMENT_SHADER = R"(
+#version 330 core
+in vec2 localPos;
+in vec4 vertexColor;
+in float radius;
+in float outlineWidth;
+flat in uint shape;
+out vec4 FragColor;
+
+uniform vec4 uTint;
+uniform vec4 uOutlineColor;
+
+void main() {
+    // Signed distance to the shape boundary in pixels
+    float dist;
+    if (shape == 1u) {
+        vec2 q = abs(localPos) - vec2(radius);
+        dist = length(max(q, 0.0)) + min(max(q.x, q.y), 0.0);
+    } else {
+        dist = length(localPos) - radius;
+    }
+
+    float alpha = clamp(0.5 - dist, 0.0, 1.0);
+    if (alpha <= 0.0) {
+        discard;
+    }
+
+    vec4 color = vertexColor * uTint;
+    if (outlineWidth > 0.0) {
+        float outline = clamp(dist + outlineWidth + 0.5, 0.0, 1.0);
+        color = mix(color, uOutlineColor, outline);
+    }
+
+    FragColor = vec4(color.rgb, color.a * alpha);
+}
+)";
+
+// Instanced edge shader: fetches both endpoints from the vertex positions and expands a quad across the
+// projected segment, widths are in pixels regardless of the projection
+const std::string EDGE_VERTEX_SHADER = R"(
+#version 330 core
+)" + AA_FRINGE_GLSL + R"(
+layout (location = 0) in vec2 aCorner;
+layout (location = 1) in uvec2 aEndpoints;
+layout (location = 2) in float aWidth;
+layout (location = 3) in vec4 aColor;
+
+uniform mat4 uMVP;
+uniform vec2 uViewport;
+uniform float uWidthScale;
+uniform samplerBuffer uPositions;
+uniform int uPositionStride;
+
+out vec4 vertexColor;
+noperspective out float across;
+flat out float halfWidth;
+
+// Floats per vertex in the buffer, 0 = one vector texel per vertex (half or vec4 positions); flat meshes have 2
+vec3 fetchPosition(uint index) {
+    if (uPositionStride == 0) {
+        return texelFetch(uPositions, int(index)).xyz;
+    }
+    int base = int(index) * uPositionStride;
+    float z = uPositionStride > 2 ? texelFetch(uPositions, base + 2).x : 0.0;
+    return vec3(texelFetch(uPositions, base).x, texelFetch(uPositions, base + 1).x, z);
+}
+
+void main() {
+    vec4 clip0 = uMVP * vec4(fetchPosition(aEndpoints.x), 1.0);
+    vec4 clip1 = uMVP * vec4(fetchPosition(aEndpoints.y), 1.0);
+
+    // Clip the segment against the camera plane so the screen-space direction stays valid
+    const float nearW = 1e-4;
+    if (clip0.w < nearW && clip1.w < nearW) {
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+        return;
+    }
+    if (clip0.w < nearW) {
+        clip0 = mix(clip0, clip1, (nearW - clip0.w) / (clip1.w - clip0.w));
+    } else if (clip1.w < nearW) {
+        clip1 = mix(clip1, clip0, (nearW - clip1.w) / (clip0.w - clip1.w));
+    }
+
+    vec2 screen0 = clip0.xy / clip0.w * uViewport;
+    vec2 screen1 = clip1.xy / clip1.w * uViewport;
+    vec2 direction = screen1 - screen0;
+    float len = length(direction);
+    direction = len > 1e-6 ? direction / len : vec2(1.0, 0.0);
+    vec2 normal = vec2(-direction.y, direction.x);
+
+    // Lines thinner than a pixel are drawn one pixel wide with proportionally less coverage
+    float width = aWidth * uWidthScale;
+    vertexColor = aColor;
+    vertexColor.a *= clamp(width, 0.0, 1.0);
+    halfWidth = 0.5 * max(width, 1.0);
+
+    float extent = halfWidth + AA_FRINGE;
+    vec4 clipPos = mix(clip0, clip1, aCorner.x);
+    clipPos.xy += normal * (aCorner.y * extent) * 2.0 / uViewport * clipPos.w;
+    gl_Position = clipPos;
+
+    across = aCorner.y * extent;
+}
+)";
+
+const std::string EDGE_FRAGMENT_SHADER = R"(
+#version 330 core
+in vec4 vertexColor;
+noperspective in float across;
+flat in float halfWidth;
+out vec4 FragColor;
+
+uniform vec4 uTint;
+
+void main() {
+    // Coverage of the pixel by the line from its distance to the center line
+    float alpha = clamp(halfWidth - abs(across) + 0.5, 0.0, 1.0);
+    if (alpha <= 0.0) {
+        discard;
+    }
+
+    FragColor = vertexColor * uTint;
+    FragColor.a *= alpha;
+}
+)";
+
+// Picking shaders: same geometry as the draws above, the output is (id + 1, other + 1) into the RG32UI target
+const std::string PICK_POINT_VERTEX_SHADER = R"(
+#version 330 core
+layout (location = 0) in vec3 aPosition;
+
+uniform mat4 uMVP;
+uniform float uPointSize;
+
+flat out uint vertexId;
+
+void main() {
+    gl_Position = uMVP * vec4(aPosition, 1.0);
+    gl_PointSize = uPointSize;
+    vertexId = uint(gl_VertexID);
+}
+)";
+
+const std::string PICK_POINT_FRAGMENT_SHADER = R"(
+#version 330 core
+flat in uint vertexId;
+out uvec2 PickId;
+
+void main() {
+    if (length(gl_PointCoord - vec2(0.5)) > 0.5) {
+        discard;
+    }
+    PickId = uvec2(vertexId + 1u, 0u);
+}
+)";
+
+// Indexed draws see the vertex index in gl_VertexID, the geometry stage hands both endpoints to the fragments
+const std::string PICK_EDGE_VERTEX_SHADER = R"(
+#version 330 core
+layout (location = 0) in vec3 aPosition;
+
+uniform mat4 uMVP;
+
+flat out uint vertexId;
+
+void main() {
+    gl_Position = uMVP * vec4(aPosition, 1.0);
+    vertexId = uint(gl_VertexID);
+}
+)";
+
+const std::string PICK_EDGE_GEOMETRY_SHADER = R"(
+#version 330 core
+layout (lines) in;
+layout (line_strip, max_vertices = 2) out;
+
+flat in uint vertexId[];
+flat out uvec2 endpoints;
+
+void main() {
+    for (int i = 0; i < 2; ++i) {
+        gl_Position = gl_in[i].gl_Position;
+        endpoints = uvec2(vertexId[0], vertexId[1]);
+        EmitVertex();
+    }
+    EndPrimitive();
+}
+)";
+
+const std::string PICK_EDGE_FRAGMENT_SHADER = R"(
+#version 330 core
+flat in uvec2 endpoints;
+out uvec2 PickId;
+
+void main() {
+    PickId = endpoints + 1u;
+}
+)";
+
+const std::string PICK_NODE_VERTEX_SHADER = R"(
+#version 330 core
+layout (location = 0) in vec2 aCorner;
+layout (location = 1) in vec4 aPositionRadius;
+layout (location = 3) in uint aShape;
+
+uniform mat4 uMVP;
+uniform vec2 uViewport;
+uniform float uRadiusScale;
+
+out vec2 localPos;
+out float radius;
+flat out uint shape;
+flat out uint nodeId;
+
+void main() {
+    radius = aPositionRadius.w * uRadiusScale;
+
+    vec4 clipPos = uMVP * vec4(aPositionRadius.xyz, 1.0);
+    clipPos.xy += aCorner * radius * 2.0 / uViewport * clipPos.w;
+    gl_Position = clipPos;
+
+    localPos = aCorner * radius;
+    shape = aShape;
+    nodeId = uint(gl_InstanceID);
+}
+)";
+
+const std::string PICK_NODE_FRAGMENT_SHADER = R"(
+#version 330 core
+in vec2 localPos;
+in float radius;
+flat in uint shape;
+flat in uint nodeId;
+out uvec2 PickId;
+
+void main() {
+    // Same shapes as the node shader, without the antialiased fringe
+    if (shape == 1u) {
+        if (max(abs(localPos.x), abs(localPos.y)) > radius) {
+            discard;
+        }
+    } else if (length(localPos) > radius) {
+        discard;
+    }
+    PickId = uvec2(nodeId + 1u, 0u);
+}
+)";
+
+// Render queue shaders: MVP, tint and sizes come from the uniform block entry bound for each batch
+const std::string QUEUE_MESH_VERTEX_SHADER = R"(
+#version 330 core
+layout (location = 0) in vec3 aPosition;
+layout (location = 1) in vec4 aColor;
+
+layout (std140) uniform DrawBlock {
+    mat4 uDrawMVP;
+    vec4 uDrawTint;
+    vec4 uDrawParams;  // x = point size, y = line width
+};
+
+out vec4 vertexColor;
+
+void main() {
+    gl_Position = uDrawMVP * vec4(aPosition, 1.0);
+    gl_PointSize = uDrawParams.x;
+    vertexColor = aColor * uDrawTint;
+}
+)";
+
+const std::string QUEUE_MESH_FRAGMENT_SHADER = R"(
+#version 330 core
+in vec4 vertexColor;
+out vec4 FragColor;
+
+void main() {
+    FragColor = vertexColor;
+}
+)";
+
+// Same smooth circular points as the immediate point shader
+const std::string QUEUE_POINT_FRAGMENT_SHADER = R"(
+#version 330 core
+in vec4 vertexColor;
+out vec4 FragColor;
+
+void main() {
+    float dist = length(gl_PointCoord - vec2(0.5));
+    if (dist > 0.5) {
+        discard;
+    }
+    FragColor = vertexColor;
+    FragColor.a *= 1.0 - smoothstep(0.4, 0.5, dist);
+}
+)";
+
+MeshRendererOpenGL::MeshRendererOpenGL()
+    : m_nodeQuadVBO(0),
+      m_edgeQuadVBO(0),
+      m_edgePositionTexture(0),
+      m_cullingEnabled(true),
+      m_queueing(false),
+      m_uniformAlignment(256),
+      m_uploadBudget(16 * 1024 * 1024),
+      m_pendingUploads(0),
+      m_pointSizeLocation(-1),
+      m_nodeViewportLocation(-1),
+      m_nodeRadiusScaleLocation(-1),
+      m_nodeOutlineColorLocation(-1),
+      m_edgeViewportLocation(-1),
+      m_edgeWidthScaleLocation(-1),
+      m_edgePositionsLocation(-1),
+      m_edgePositionStrideLocation(-1),
+      m_picking(false),
+      m_pickDepthFunc(GL_LESS),
+      m_pickPointSizeLocation(-1),
+      m_pickNodeViewportLocation(-1),
+      m_pickNodeRadiusScaleLocation(-1) {}
+
+MeshRendererOpenGL::~MeshRendererOpenGL() { cleanup(); }
+
+void MeshRendererOpenGL::cleanup() {
+  // Let the worker finish, then release the buffers of uploads still in flight
+  m_uploadWorker.waitIdle();
+  m_uploads.insert(m_uploads.end(), m_preparedUploads.begin(), m_preparedUploads.end());
+  m_preparedUploads.clear();
+  for (const std::shared_ptr<UploadJob>& job : m_uploads) {
+    if (job->fence != nullptr) {
+      glDeleteSync(static_cast<GLsync>(job->fence));
+    }
+    freeMesh(job->mesh);
+    if (const MeshHandle handle = job->handle.lock()) {
+      handle->state = UploadState::Failed;
+    }
+  }
+  m_uploads.clear();
+  m_pendingUploads = 0;
+
+  m_pickBuffer.cleanup();
+  m_pickResults.clear();
+
+  m_queue.clear();
+  m_queueData.clear();
+  m_meshPool.cleanup(getState());
+
+  for (ShaderProgramOpenGL* program :
+       {&m_meshShaderProgram, &m_pointShaderProgram, &m_nodeShaderProgram, &m_edgeShaderProgram, &m_pickPointProgram,
+        &m_pickEdgeProgram, &m_pickNodeProgram, &m_queueMeshProgram, &m_queuePointProgram}) {
+    getState().forgetProgram(program->getId());
+    program->destroy();
+  }
+  if (m_nodeQuadVBO) {
+    glDeleteBuffers(1, &m_nodeQuadVBO);
+    m_nodeQuadVBO = 0;
+  }
+  if (m_edgeQuadVBO) {
+    glDeleteBuffers(1, &m_edgeQuadVBO);
+    m_edgeQuadVBO = 0;
+  }
+  if (m_edgePositionTexture) {
+    glDeleteTextures(1, &m_edgePositionTexture);
+    m_edgePositionTexture = 0;
+  }
+}
+
+bool MeshRendererOpenGL::initialize(const Window& window, uint32_t width, uint32_t height) {
+  if (!RendererOpenGL::initialize(window, width, height)) {
+    return false;
+  }
+
+  // Every program is begun before the first one is waited for, so the driver compiles them concurrently
+  // and no draw or upload compiles on first use. A failed program only disables the paths that need it.
+  const ShaderCacheOpenGL& cache = getShaderCache();
+  m_meshShaderProgram.beginCreate({MESH_VERTEX_SHADER, MESH_FRAGMENT_SHADER}, &cache);
+  m_pointShaderProgram.beginCreate({POINT_VERTEX_SHADER, POINT_FRAGMENT_SHADER}, &cache);
+  m_nodeShaderProgram.beginCreate({NODE_VERTEX_SHADER, NODE_FRAGMENT_SHADER}, &cache);
+  m_edgeShaderProgram.beginCreate({EDGE_VERTEX_SHADER, EDGE_FRAGMENT_SHADER}, &cache);
+  m_pickPointProgram.beginCreate({PICK_POINT_VERTEX_SHADER, PICK_POINT_FRAGMENT_SHADER}, &cache);
+  m_pickEdgeProgram.beginCreate({PICK_EDGE_VERTEX_SHADER, PICK_EDGE_FRAGMENT_SHADER, PICK_EDGE_GEOMETRY_SHADER},
+                                &cache);
+  m_pickNodeProgram.beginCreate({PICK_NODE_VERTEX_SHADER, PICK_NODE_FRAGMENT_SHADER}, &cache);
+  m_queueMeshProgram.beginCreate({QUEUE_MESH_VERTEX_SHADER, QUEUE_MESH_FRAGMENT_SHADER}, &cache);
+  m_queuePointProgram.beginCreate({QUEUE_MESH_VERTEX_SHADER, QUEUE_POINT_FRAGMENT_SHADER}, &cache);
+
+  m_meshShaderProgram.finishCreate();
+  loadPointShaders();
+  loadNodeShaders();
+  loadEdgeShaders();
+  loadPickShaders();
+  loadQueueShaders();
+  return true;
+}
+
+bool MeshRendererOpenGL::loadPointShaders() {
+  if (!m_pointShaderProgram.finishCreate()) {
+    return false;
+  }
+  m_pointSizeLocation = m_pointShaderProgram.getUniformLocation("uPointSize");
+  return true;
+}
+
+bool MeshRendererOpenGL::loadNodeShaders() {
+  if (!m_nodeShaderProgram.finishCreate()) {
+    return false;
+  }
+  m_nodeViewportLocation = m_nodeShaderProgram.getUniformLocation("uViewport");
+  m_nodeRadiusScaleLocation = m_nodeShaderProgram.getUniformLocation("uRadiusScale");
+  m_nodeOutlineColorLocation = m_nodeShaderProgram.getUniformLocation("uOutlineColor");
+
+  // Unit quad shared by all node instance buffers (triangle strip)
+  const float corners[] = {-1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f};
+  glGenBuffers(1, &m_nodeQuadVBO);
+  glBindBuffer(GL_ARRAY_BUFFER, m_nodeQuadVBO);
+  glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  return true;
+}
+
+bool MeshRendererOpenGL::loadEdgeShaders() {
+  if (!m_edgeShaderProgram.finishCreate()) {
+    return false;
+  }
+  m_edgeViewportLocation = m_edgeShaderProgram.getUniformLocation("uViewport");
+  m_edgeWidthScaleLocation = m_edgeShaderProgram.getUniformLocation("uWidthScale");
+  m_edgePositionsLocation = m_edgeShaderProgram.getUniformLocation("uPositions");
+  m_edgePositionStrideLocation = m_edgeShaderProgram.getUniformLocation("uPositionStride");
+
+  // Unit quad shared by all edge instance buffers (triangle strip): x runs from source (0) to target (1),
+  // y across the line
+  const float corners[] = {0.0f, -1.0f, 0.0f, 1.0f, 1.0f, -1.0f, 1.0f, 1.0f};
+  glGenBuffers(1, &m_edgeQuadVBO);
+  glBindBuffer(GL_ARRAY_BUFFER, m_edgeQuadVBO);
+  glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  glGenTextures(1, &m_edgePositionTexture);
+
+  return true;
+}
+
+bool MeshRendererOpenGL::loadPickShaders() {
+  // Picking needs all three programs (beginPicking checks the node program)
+  bool success = true;
+  for (ShaderProgramOpenGL* program : {&m_pickPointProgram, &m_pickEdgeProgram, &m_pickNodeProgram}) {
+    success = program->finishCreate() && success;
+  }
+  if (!success) {
+    m_pickNodeProgram.destroy();
+    return false;
+  }
+  m_pickPointSizeLocation = m_pickPointProgram.getUniformLocation("uPointSize");
+  m_pickNodeViewportLocation = m_pickNodeProgram.getUniformLocation("uViewport");
+  m_pickNodeRadiusScaleLocation = m_pickNodeProgram.getUniformLocation("uRadiusScale");
+  return true;
+}
+
+bool MeshRendererOpenGL::loadQueueShaders() {
+  const bool pointProgram = m_queuePointProgram.finishCreate();
+  if (!m_queueMeshProgram.finishCreate() || !pointProgram) {
+    m_queueMeshProgram.destroy();
+    return false;
+  }
+  for (const ShaderProgramOpenGL* program : {&m_queueMeshProgram, &m_queuePointProgram}) {
+    glUniformBlockBinding(program->getId(), glGetUniformBlockIndex(program->getId(), "DrawBlock"),
+                          DRAW_BLOCK_BINDING);
+  }
+
+  // Draw data entries are bound at offsets of this alignment
+  GLint alignment = 256;
+  glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+  m_uniformAlignment = static_cast<size_t>(std::max(alignment, GLint{16}));
+  return true;
+}
+
+namespace {
+
+// Sort key of a queued command, most significant bits first.
+// Opaque:      pass | primitive | state | VAO | draw data | depth front to back
+// Translucent: pass | depth back to front | primitive | state | VAO | draw data
+uint64_t queueKey(bool translucent, uint32_t mode, uint8_t state, uint32_t vao, uint32_t drawData, float depth) {
+  const uint64_t primitive = mode == GL_TRIANGLES ? 0 : (mode == GL_LINES ? 1 : 2);
+  const auto quantized = static_cast<uint64_t>(std::clamp((depth * 0.5f) + 0.5f, 0.0f, 1.0f) * 65535.0f);
+  const uint64_t vaoBits = vao & 0xFFFF;
+  const uint64_t dataBits = drawData & 0xFFFFF;
+  if (!translucent) {
+    return (primitive << 60) | (uint64_t{state} << 52) | (vaoBits << 36) | (dataBits << 16) | quantized;
+  }
+  return (uint64_t{1} << 62) | ((0xFFFF - quantized) << 46) | (primitive << 44) | (uint64_t{state} << 36) |
+         (vaoBits << 20) | dataBits;
+}
+
+// Bytes held by the vertex and element buffers of a mesh
+uint64_t getBufferBytes(const MeshGPU& meshGPU) {
+  const uint64_t indices = static_cast<uint64_t>(meshGPU.indexCount) + meshGPU.edgeIndexCount +
+                           (meshGPU.pointEbo != 0 ? meshGPU.vertexCount : 0);
+  return vertexBufferSize(meshGPU.format, meshGPU.vertexCount, meshGPU.dimensions) + (indices * sizeof(uint32_t));
+}
+
+}  // namespace
+
+MeshGPU MeshRendererOpenGL::uploadMesh(const Mesh2D& mesh, VertexFormat format) { return uploadVertices(mesh, format); }
+
+MeshGPU MeshRendererOpenGL::uploadMesh(const Mesh3D& mesh, VertexFormat format) { return uploadVertices(mesh, format); }
+
+template <typename VertexType>
+MeshGPU MeshRendererOpenGL::uploadVertices(const util::Mesh<VertexType>& mesh, VertexFormat format) {
+  MeshGPU meshGPU;
+
+  if (!m_meshShaderProgram.isValid()) {
+    return meshGPU;
+  }
+
+  if (mesh.vertices.empty()) {
+    return meshGPU;
+  }
+
+  const size_t vertexCount = mesh.vertices.size();
+  const uint32_t dimensions = VertexType::DIMENSIONS;
+  const size_t bufferSize = vertexBufferSize(format, vertexCount, dimensions);
+  meshGPU.format = format;
+  meshGPU.dimensions = dimensions;
+
+  // Shared vertex buffer: positions block followed by colors block, referenced by every view
+  glGenBuffers(1, &meshGPU.vbo);
+  glBindBuffer(GL_ARRAY_BUFFER, meshGPU.vbo);
+  glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(bufferSize), nullptr, GL_STATIC_DRAW);
+
+  // Pack straight into driver memory, no intermediate float vector
+  void* mapped = glMapBufferRange(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(bufferSize),
+                                  GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+  if (mapped == nullptr) {
+    glDeleteBuffers(1, &meshGPU.vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    meshGPU.vbo = 0;
+    return meshGPU;
+  }
+  packPositions(format, std::span<const VertexType>(mesh.vertices), mapped);
+  packColors(format, std::span<const VertexType>(mesh.vertices),
+             static_cast<uint8_t*>(mapped) + colorBlockOffset(format, vertexCount, dimensions));
+  glUnmapBuffer(GL_ARRAY_BUFFER);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  meshGPU.vertexCount = static_cast<uint32_t>(vertexCount);
+
+  // Positions for the spatial index (flat meshes lie in z = 0)
+  std::vector<glm::vec3> positions(vertexCount);
+  std::transform(mesh.vertices.begin(), mesh.vertices.end(), positions.begin(), [](const VertexType& vertex) {
+    if constexpr (VertexType::DIMENSIONS == 2) {
+      return glm::vec3(vertex.position.x, vertex.position.y, 0.0f);
+    } else {
+      return vertex.position;
+    }
+  });
+  meshGPU.bounds = computeBounds(positions);
+  meshGPU.boundsValid = true;
+
+  // Faces (triangles) as indices into the shared vertices, Morton-ordered so nearby triangles share a chunk
+  std::vector<uint32_t> faceIndices = collectPrimitives(mesh.faces, vertexCount, 3);
+  if (!faceIndices.empty()) {
+    meshGPU.faceChunks = buildIndexChunks(positions, faceIndices, 3);
+
+    glGenBuffers(1, &meshGPU.ebo);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, meshGPU.ebo);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(faceIndices.size() * sizeof(uint32_t)),
+                 faceIndices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    setupView(meshGPU, meshGPU.vao, meshGPU.ebo);
+    meshGPU.indexCount = static_cast<uint32_t>(faceIndices.size());
+  }
+
+  // Edges (lines) as indices into the shared vertices
+  std::vector<uint32_t> edgeIndices = collectPrimitives(mesh.edges, vertexCount, 2);
+  if (!edgeIndices.empty()) {
+    meshGPU.edgeChunks = buildIndexChunks(positions, edgeIndices, 2);
+
+    glGenBuffers(1, &meshGPU.edgeEbo);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, meshGPU.edgeEbo);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(edgeIndices.size() * sizeof(uint32_t)),
+                 edgeIndices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    setupView(meshGPU, meshGPU.edgeVao, meshGPU.edgeEbo);
+    meshGPU.edgeIndexCount = static_cast<uint32_t>(edgeIndices.size());
+  }
+
+  setupPointView(meshGPU, positions);
+  getProfiler().countUpload(getBufferBytes(meshGPU));
+  requestRedraw();
+
+  return meshGPU;
+}
+
+MeshGPU MeshRendererOpenGL::uploadGraph(const Graph& graph, VertexFormat format) {
+  MeshGPU meshGPU;
+
+  if (!m_meshShaderProgram.isValid()) {
+    return meshGPU;
+  }
+
+  const size_t vertexCount = graph.nodeCount();
+  if (vertexCount == 0 || graph.positions.size() != vertexCount || graph.colors.size() != vertexCount) {
+    return meshGPU;
+  }
+
+  const size_t bufferSize = vertexBufferSize(format, vertexCount);
+  meshGPU.format = format;
+
+  glGenBuffers(1, &meshGPU.vbo);
+  glBindBuffer(GL_ARRAY_BUFFER, meshGPU.vbo);
+  glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(bufferSize), nullptr, GL_STATIC_DRAW);
+
+  // The SoA node attributes already match the positions / colors blocks
+  void* mapped = glMapBufferRange(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(bufferSize),
+                                  GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+  if (mapped == nullptr) {
+    glDeleteBuffers(1, &meshGPU.vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    meshGPU.vbo = 0;
+    return meshGPU;
+  }
+  packPositions(format, std::span<const glm::vec3>(graph.positions), mapped);
+  packColors(format, std::span<const Color>(graph.colors),
+             static_cast<uint8_t*>(mapped) + colorBlockOffset(format, vertexCount));
+  glUnmapBuffer(GL_ARRAY_BUFFER);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  meshGPU.vertexCount = static_cast<uint32_t>(vertexCount);
+  meshGPU.bounds = computeBounds(graph.positions);
+  meshGPU.boundsValid = true;
+
+  // Edge endpoints are validated when the graph is built, only reordered into spatial chunks here
+  if (!graph.edges.empty()) {
+    std::vector<uint32_t> edgeIndices(graph.edges.size() * 2);
+    std::memcpy(edgeIndices.data(), graph.edges.data(), graph.edges.size() * sizeof(Edge));
+    meshGPU.edgeChunks = buildIndexChunks(graph.positions, edgeIndices, 2);
+
+    glGenBuffers(1, &meshGPU.edgeEbo);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, meshGPU.edgeEbo);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(edgeIndices.size() * sizeof(uint32_t)),
+                 edgeIndices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    setupView(meshGPU, meshGPU.edgeVao, meshGPU.edgeEbo);
+    meshGPU.edgeIndexCount = static_cast<uint32_t>(graph.edges.size() * 2);
+  }
+
+  setupPointView(meshGPU, graph.positions);
+  getProfiler().countUpload(getBufferBytes(meshGPU));
+  requestRedraw();
+
+  return meshGPU;
+}
+
+MeshGPU MeshRendererOpenGL::uploadMesh(const MeshView& view) {
+  MeshGPU meshGPU;
+
+  if (!m_meshShaderProgram.isValid()) {
+    return meshGPU;
+  }
+  // Views carry three-component positions (see writeMeshFile)
+  if (!view.isValid() || view.dimensions != 3 ||
+      view.vertexData.size() != vertexBufferSize(view.format, view.vertexCount)) {
+    return meshGPU;
+  }
+
+  // Sections are already in buffer layout: hand them to the driver as they are (a mapped file is paged
+  // in as the driver copies it)
+  auto createBuffer = [](uint32_t& buffer, std::span<const std::byte> data) {
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(data.size()), data.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+  };
+
+  meshGPU.format = view.format;
+  meshGPU.vertexCount = view.vertexCount;
+  createBuffer(meshGPU.vbo, view.vertexData);
+
+  // Chunk tables are small, the mesh keeps its own copy
+  meshGPU.bounds = view.bounds;
+  meshGPU.boundsValid = view.bounds.isValid();
+  meshGPU.faceChunks.assign(view.faceChunks.begin(), view.faceChunks.end());
+  meshGPU.edgeChunks.assign(view.edgeChunks.begin(), view.edgeChunks.end());
+  meshGPU.pointChunks.assign(view.pointChunks.begin(), view.pointChunks.end());
+
+  if (!view.faces.empty()) {
+    createBuffer(meshGPU.ebo, std::as_bytes(view.faces));
+    setupView(meshGPU, meshGPU.vao, meshGPU.ebo);
+    meshGPU.indexCount = static_cast<uint32_t>(view.faces.size());
+  }
+  if (!view.edges.empty()) {
+    createBuffer(meshGPU.edgeEbo, std::as_bytes(view.edges));
+    setupView(meshGPU, meshGPU.edgeVao, meshGPU.edgeEbo);
+    meshGPU.edgeIndexCount = static_cast<uint32_t>(view.edges.size());
+  }
+  if (!view.points.empty()) {
+    createBuffer(meshGPU.pointEbo, std::as_bytes(view.points));
+  }
+  setupView(meshGPU, meshGPU.pointVao, meshGPU.pointEbo);
+  getProfiler().countUpload(getBufferBytes(meshGPU));
+  requestRedraw();
+
+  return meshGPU;
+}
+
+MeshHandle MeshRendererOpenGL::uploadMeshAsync(Mesh2D mesh, VertexFormat format) {
+  return submitUpload([mesh = std::move(mesh), format] { return prepareMesh(mesh, format); });
+}
+
+MeshHandle MeshRendererOpenGL::uploadMeshAsync(Mesh3D mesh, VertexFormat format) {
+  // The mesh is moved into the task, the caller's copy can go away immediately
+  return submitUpload([mesh = std::move(mesh), format] { return prepareMesh(mesh, format); });
+}
+
+MeshHandle MeshRendererOpenGL::uploadGraphAsync(Graph graph, VertexFormat format) {
+  return submitUpload([graph = std::move(graph), format] { return prepareGraph(graph, format); });
+}
+
+MeshHandle MeshRendererOpenGL::submitUpload(std::function<PreparedMesh()> prepare) {
+  auto handle = std::make_shared<AsyncMeshGPU>();
+  if (!m_meshShaderProgram.isValid()) {
+    handle->state = UploadState::Failed;
+    return handle;
+  }
+
+  auto job = std::make_shared<UploadJob>();
+  job->handle = handle;
+  ++m_pendingUploads;
+
+  m_uploadWorker.submit([this, job, prepare = std::move(prepare)] {
+    // Cancelled before it started
+    if (job->handle.expired()) {
+      job->prepared = PreparedMesh();
+    } else {
+      job->prepared = prepare();
+    }
+    std::lock_guard<std::mutex> lock(m_uploadMutex);
+    m_preparedUploads.push_back(job);
+  });
+  return handle;
+}
+
+void MeshRendererOpenGL::beginFrame() {
+  RendererOpenGL::beginFrame();
+  processUploads();
+
+  // Keep drawing on demand while uploads stream in or picks wait for their readback
+  if (m_pendingUploads > 0 || m_pickBuffer.getPendingCount() > 0) {
+    requestRedraw();
+  }
+}
+
+void MeshRendererOpenGL::processUploads() {
+  {
+    std::lock_guard<std::mutex> lock(m_uploadMutex);
+    m_uploads.insert(m_uploads.end(), m_preparedUploads.begin(), m_preparedUploads.end());
+    m_preparedUploads.clear();
+  }
+  if (m_uploads.empty()) {
+    return;
+  }
+  ProfileScope scope(getProfiler(), ProfilePass::Uploads);
+
+  size_t budget = m_uploadBudget;
+  std::erase_if(m_uploads, [&](const std::shared_ptr<UploadJob>& job) {
+    const MeshHandle handle = job->handle.lock();
+    UploadState state = UploadState::Pending;
+
+    if (!handle) {
+      // Abandoned, nobody will free the buffers
+      state = UploadState::Failed;
+    } else if (job->fence != nullptr) {
+      // The data is on the GPU once the fence after the last copy signals; never wait for it here
+      const GLenum result = glClientWaitSync(static_cast<GLsync>(job->fence), 0, 0);
+      if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED) {
+        state = UploadState::Ready;
+      } else if (result == GL_WAIT_FAILED) {
+        state = UploadState::Failed;
+      }
+    } else if (!job->prepared.isValid()) {
+      state = UploadState::Failed;
+    } else if (budget > 0) {
+      if (!streamUpload(*job, budget)) {
+        state = UploadState::Failed;
+      } else if (job->stage == 4) {
+        // All data copied: build the views and fence the copies
+        const PreparedMesh& prepared = job->prepared;
+        MeshGPU& mesh = job->mesh;
+        if (!prepared.faces.empty()) {
+          setupView(mesh, mesh.vao, mesh.ebo);
+        }
+        if (!prepared.edges.empty()) {
+          setupView(mesh, mesh.edgeVao, mesh.edgeEbo);
+        }
+        setupView(mesh, mesh.pointVao, mesh.pointEbo);
+        job->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+      }
+    }
+
+    if (state == UploadState::Pending) {
+      return false;
+    }
+
+    if (job->fence != nullptr) {
+      glDeleteSync(static_cast<GLsync>(job->fence));
+      job->fence = nullptr;
+    }
+    if (state == UploadState::Ready) {
+      handle->mesh = std::move(job->mesh);
+    } else {
+      freeMesh(job->mesh);
+    }
+    if (handle) {
+      handle->state = state;
+    }
+    --m_pendingUploads;
+    return true;
+  });
+  getProfiler().countUpload(m_uploadBudget - budget);
+}
+
+bool MeshRendererOpenGL::streamUpload(UploadJob& job, size_t& budget) {
+  const PreparedMesh& prepared = job.prepared;
+  MeshGPU& mesh = job.mesh;
+
+  // Create every buffer up front (contents undefined until streamed)
+  if (mesh.vbo == 0) {
+    mesh.format = prepared.format;
+    mesh.dimensions = prepared.dimensions;
+    mesh.vertexCount = prepared.vertexCount;
+    mesh.indexCount = static_cast<uint32_t>(prepared.faces.size());
+    mesh.edgeIndexCount = static_cast<uint32_t>(prepared.edges.size());
+    mesh.bounds = prepared.bounds;
+    mesh.faceChunks = prepared.faceChunks;
+    mesh.edgeChunks = prepared.edgeChunks;
+    mesh.pointChunks = prepared.pointChunks;
+    mesh.boundsValid = true;
+
+    auto create = [](uint32_t& buffer, size_t bytes) {
+      if (bytes == 0) {
+        return;
+      }
+      glGenBuffers(1, &buffer);
+      glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+      glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STATIC_DRAW);
+    };
+    create(mesh.vbo, prepared.vertexData.size());
+    create(mesh.ebo, prepared.faces.size() * sizeof(uint32_t));
+    create(mesh.edgeEbo, prepared.edges.size() * sizeof(uint32_t));
+    create(mesh.pointEbo, prepared.points.size() * sizeof(uint32_t));
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+  }
+
+  const std::span<const std::byte> sources[] = {
+      std::as_bytes(std::span(prepared.vertexData)),
+      std::as_bytes(std::span(prepared.faces)),
+      std::as_bytes(std::span(prepared.edges)),
+      std::as_bytes(std::span(prepared.points)),
+  };
+  const uint32_t buffers[] = {mesh.vbo, mesh.ebo, mesh.edgeEbo, mesh.pointEbo};
+
+  bool mapped = true;
+  while (job.stage < 4 && budget > 0 && mapped) {
+    const std::span<const std::byte> source = sources[job.stage];
+    if (job.offset >= source.size()) {
+      ++job.stage;
+      job.offset = 0;
+      continue;
+    }
+
+    // The buffers are new and not yet referenced by any draw, so unsynchronized writes are safe
+    const size_t bytes = std::min(budget, source.size() - job.offset);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffers[job.stage]);
+    void* dst = glMapBufferRange(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(job.offset),
+                                 static_cast<GLsizeiptr>(bytes),
+                                 GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    if (dst != nullptr) {
+      std::memcpy(dst, source.data() + job.offset, bytes);
+      mapped = glUnmapBuffer(GL_COPY_WRITE_BUFFER) == GL_TRUE;
+    } else {
+      mapped = false;
+    }
+    job.offset += bytes;
+    budget -= bytes;
+  }
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+  // Skip past empty trailing stages so a finished job is recognized without spending budget
+  while (job.stage < 4 && job.offset >= sources[job.stage].size()) {
+    ++job.stage;
+    job.offset = 0;
+  }
+  return mapped;
+}
+
+void MeshRendererOpenGL::setupPointView(MeshGPU& meshGPU, std::span<const glm::vec3> positions) {
+  std::vector<uint32_t> pointIndices(meshGPU.vertexCount);
+  std::iota(pointIndices.begin(), pointIndices.end(), 0u);
+  meshGPU.pointChunks = buildIndexChunks(positions, pointIndices, 1);
+
+  // A single chunk is the identity order, draw the shared vertices directly
+  if (meshGPU.pointChunks.size() > 1) {
+    glGenBuffers(1, &meshGPU.pointEbo);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, meshGPU.pointEbo);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(pointIndices.size() * sizeof(uint32_t)),
+                 pointIndices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+  }
+
+  setupView(meshGPU, meshGPU.pointVao, meshGPU.pointEbo);
+}
+
+void MeshRendererOpenGL::setupView(const MeshGPU& meshGPU, uint32_t& vao, uint32_t ebo) {
+  glGenVertexArrays(1, &vao);
+  getState().bindVertexArray(vao);
+  setupVertexAttributes(meshGPU);
+  if (ebo != 0) {
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+  }
+
+  // Unbind the VAO first so it keeps its element buffer
+  getState().bindVertexArray(0);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+void MeshRendererOpenGL::drawChunks(uint32_t mode, std::span<const IndexChunk> chunks, uint32_t count, bool indexed,
+                                    const glm::mat4& mvp, bool cull) {
+  if (!cull || chunks.size() <= 1) {
+    if (indexed) {
+      glDrawElements(mode, static_cast<GLsizei>(count), GL_UNSIGNED_INT, nullptr);
+    } else {
+      glDrawArrays(mode, 0, static_cast<GLsizei>(count));
+    }
+    getProfiler().countDraw(count);
+    return;
+  }
+
+  // Visible ranges, adjacent chunks merged (their indices are contiguous)
+  const Frustum frustum = Frustum::fromMatrix(mvp);
+  m_drawFirsts.clear();
+  m_drawCounts.clear();
+  for (const IndexChunk& chunk : chunks) {
+    if (!frustum.intersects(chunk.bounds)) {
+      continue;
+    }
+    const auto first = static_cast<int32_t>(chunk.firstIndex);
+    if (!m_drawFirsts.empty() && m_drawFirsts.back() + m_drawCounts.back() == first) {
+      m_drawCounts.back() += static_cast<int32_t>(chunk.indexCount);
+    } else {
+      m_drawFirsts.push_back(first);
+      m_drawCounts.push_back(static_cast<int32_t>(chunk.indexCount));
+    }
+  }
+  if (m_drawFirsts.empty()) {
+    return;
+  }
+
+  const auto drawCount = static_cast<GLsizei>(m_drawFirsts.size());
+  getProfiler().countDraw(static_cast<uint64_t>(std::accumulate(m_drawCounts.begin(), m_drawCounts.end(), int64_t{0})));
+  if (!indexed) {
+    glMultiDrawArrays(mode, m_drawFirsts.data(), m_drawCounts.data(), drawCount);
+    return;
+  }
+
+  m_drawOffsets.resize(m_drawFirsts.size());
+  for (size_t i = 0; i < m_drawFirsts.size(); ++i) {
+    m_drawOffsets[i] = reinterpret_cast<const void*>(static_cast<size_t>(m_drawFirsts[i]) * sizeof(uint32_t));
+  }
+  glMultiDrawElements(mode, m_drawCounts.data(), GL_UNSIGNED_INT, m_drawOffsets.data(), drawCount);
+}
+
+bool MeshRendererOpenGL::isMeshVisible(const MeshGPU& meshGPU, const glm::mat4& mvp) const {
+  return !m_cullingEnabled || !meshGPU.boundsValid || Frustum::fromMatrix(mvp).intersects(meshGPU.bounds);
+}
+
+void MeshRendererOpenGL::setupVertexAttributes(const MeshGPU& meshGPU) {
+  // Positions block (flat positions get z = 0) and colors block, RGBA8 is normalized to [0, 1]
+  glBindBuffer(GL_ARRAY_BUFFER, meshGPU.vbo);
+  applyVertexLayout(meshLayout(meshGPU.format, meshGPU.vertexCount, meshGPU.dimensions));
 
-MeshRendererOpenGL::~MeshRendererOpenGL() { cleanup(); }
+  // An external float buffer replaces the positions block (vec3 at the start of every stride)
+  if (meshGPU.positionBuffer != 0) {
+    glBindBuffer(GL_ARRAY_BUFFER, meshGPU.positionBuffer);
+    const VertexAttribute external = attribute<glm::vec3>(0, 0);
+    pointVertexAttributes(std::span(&external, 1), meshGPU.positionStride);
+  }
 
-void MeshRendererOpenGL::cleanup() {
-  if (m_meshShaderProgram) {
-    glDeleteProgram(m_meshShaderProgram);
-    m_meshShaderProgram = 0;
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void MeshRendererOpenGL::updateMeshVertices(MeshGPU& meshGPU, std::span<const Vertex2D> vertices, size_t offset) {
+  updateVertices(meshGPU, vertices, offset);
+}
+
+void MeshRendererOpenGL::updateMeshVertices(MeshGPU& meshGPU, std::span<const Vertex3D> vertices, size_t offset) {
+  updateVertices(meshGPU, vertices, offset);
+}
+
+template <typename VertexType>
+void MeshRendererOpenGL::updateVertices(MeshGPU& meshGPU, std::span<const VertexType> vertices, size_t offset) {
+  // The positions block only takes vertices of the dimension it was uploaded with
+  if (meshGPU.vbo == 0 || meshGPU.dimensions != VertexType::DIMENSIONS || offset >= meshGPU.vertexCount) {
+    return;
+  }
+  vertices = vertices.first(std::min(vertices.size(), meshGPU.vertexCount - offset));
+  if (vertices.empty()) {
+    return;
   }
-  if (m_pointShaderProgram) {
-    glDeleteProgram(m_pointShaderProgram);
-    m_pointShaderProgram = 0;
+
+  // Chunk bounds no longer match the vertices
+  meshGPU.boundsValid = false;
+
+  const VertexFormat format = meshGPU.format;
+  const uint32_t dimensions = VertexType::DIMENSIONS;
+  const size_t positionBytes = vertices.size() * positionSize(format, dimensions);
+  const size_t colorBytes = vertices.size() * colorSize(format);
+
+  // Both blocks in one staging allocation, then one copy per block
+  StreamAllocation allocation = getStreamBuffer().allocate(positionBytes + colorBytes, 16);
+  if (!allocation.isValid()) {
+    return;
   }
+  packPositions(format, vertices, allocation.data);
+  packColors(format, vertices, static_cast<uint8_t*>(allocation.data) + positionBytes);
+  getStreamBuffer().commit();
+
+  copyFromStream(meshGPU.vbo, allocation.offset, offset * positionSize(format, dimensions), positionBytes);
+  copyFromStream(meshGPU.vbo, allocation.offset + positionBytes,
+                 colorBlockOffset(format, meshGPU.vertexCount, dimensions) + (offset * colorSize(format)),
+                 colorBytes);
 }
 
-bool MeshRendererOpenGL::loadMeshShaders() {
-  return createShaderProgram(MESH_VERTEX_SHADER, MESH_FRAGMENT_SHADER, m_meshShaderProgram);
+void MeshRendererOpenGL::updateMeshPositions(MeshGPU& meshGPU, std::span<const glm::vec3> positions, size_t offset) {
+  if (meshGPU.vbo == 0 || meshGPU.positionBuffer != 0 || meshGPU.dimensions != 3 || offset >= meshGPU.vertexCount) {
+    return;
+  }
+  positions = positions.first(std::min(positions.size(), meshGPU.vertexCount - offset));
+  if (positions.empty()) {
+    return;
+  }
+
+  meshGPU.boundsValid = false;
+
+  const VertexFormat format = meshGPU.format;
+  const size_t bytes = positions.size() * positionSize(format);
+
+  StreamAllocation allocation = getStreamBuffer().allocate(bytes, 16);
+  if (!allocation.isValid()) {
+    return;
+  }
+  packPositions(format, positions, allocation.data);
+  getStreamBuffer().commit();
+
+  copyFromStream(meshGPU.vbo, allocation.offset, offset * positionSize(format), bytes);
 }
 
-bool MeshRendererOpenGL::loadPointShaders() {
-  return createShaderProgram(POINT_VERTEX_SHADER, POINT_FRAGMENT_SHADER, m_pointShaderProgram);
+void MeshRendererOpenGL::updateMeshColors(MeshGPU& meshGPU, std::span<const Color> colors, size_t offset) {
+  if (meshGPU.vbo == 0 || offset >= meshGPU.vertexCount) {
+    return;
+  }
+  colors = colors.first(std::min(colors.size(), meshGPU.vertexCount - offset));
+  if (colors.empty()) {
+    return;
+  }
+
+  const VertexFormat format = meshGPU.format;
+  const size_t bytes = colors.size() * colorSize(format);
+
+  StreamAllocation allocation = getStreamBuffer().allocate(bytes, 16);
+  if (!allocation.isValid()) {
+    return;
+  }
+  packColors(format, colors, allocation.data);
+  getStreamBuffer().commit();
+
+  copyFromStream(meshGPU.vbo, allocation.offset,
+                 colorBlockOffset(format, meshGPU.vertexCount, meshGPU.dimensions) + (offset * colorSize(format)),
+                 bytes);
 }
 
-MeshGPU MeshRendererOpenGL::uploadMesh(const Mesh3D& mesh) {
-  MeshGPU meshGPU;
+void MeshRendererOpenGL::copyFromStream(uint32_t buffer, size_t streamOffset, size_t bufferOffset, size_t bytes) {
+  ProfileScope scope(getProfiler(), ProfilePass::Uploads);
+  getProfiler().countUpload(bytes);
+  requestRedraw();
+  glBindBuffer(GL_COPY_READ_BUFFER, getStreamBuffer().getBuffer());
+  glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+  glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(streamOffset),
+                      static_cast<GLintptr>(bufferOffset), static_cast<GLsizeiptr>(bytes));
+  glBindBuffer(GL_COPY_READ_BUFFER, 0);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
 
-  if (m_meshShaderProgram == 0 && !loadMeshShaders()) {
-    return meshGPU;
+void MeshRendererOpenGL::drawMesh(const MeshGPU& meshGPU, const glm::mat4& mvp, const Color& tint, bool wireframe) {
+  if (!meshGPU.isValid() || !m_meshShaderProgram.isValid()) {
+    return;
+  }
+  if (m_queueing) {
+    const auto state = static_cast<uint8_t>(QUEUE_CULL_FACE | (wireframe ? QUEUE_WIREFRAME : 0) |
+                                            (isBlending() ? QUEUE_BLEND : 0));
+    queueDraw(GL_TRIANGLES, meshGPU.vao, meshGPU.faceChunks, 0, meshGPU.indexCount, 0, true,
+              meshGPU.boundsValid ? &meshGPU.bounds : nullptr, mvp, tint, 1.0f, state);
+    return;
+  }
+  if (!isMeshVisible(meshGPU, mvp)) {
+    return;
   }
+  ProfileScope scope(getProfiler(), ProfilePass::Faces);
 
-  if (mesh.vertices.empty()) {
-    return meshGPU;
+  useShader(m_meshShaderProgram);
+  m_meshShaderProgram.setMVP(mvp);
+  setUniformColor(m_meshShaderProgram, tint);
+
+  // Depth testing and backface culling (cull face BACK and CCW winding are the GL defaults),
+  // wireframe mode if requested
+  StateCacheOpenGL& state = getState();
+  state.setEnabled(Capability::DepthTest, true);
+  state.setEnabled(Capability::CullFace, true);
+  state.setPolygonMode(wireframe ? GL_LINE : GL_FILL);
+  applyBlending();
+
+  // Draw the visible chunks of the mesh
+  state.bindVertexArray(meshGPU.vao);
+  drawChunks(GL_TRIANGLES, meshGPU.faceChunks, meshGPU.indexCount, true, mvp, m_cullingEnabled && meshGPU.boundsValid);
+}
+
+void MeshRendererOpenGL::drawMeshEdges(const MeshGPU& meshGPU, const glm::mat4& mvp, const Color& tint,
+                                       float lineWidth) {
+  if (!meshGPU.hasEdges() || !m_meshShaderProgram.isValid()) {
+    return;
+  }
+  if (m_queueing) {
+    queueDraw(GL_LINES, meshGPU.edgeVao, meshGPU.edgeChunks, 0, meshGPU.edgeIndexCount, 0, true,
+              meshGPU.boundsValid ? &meshGPU.bounds : nullptr, mvp, tint, lineWidth, isBlending() ? QUEUE_BLEND : 0);
+    return;
+  }
+  if (!isMeshVisible(meshGPU, mvp)) {
+    return;
   }
+  ProfileScope scope(getProfiler(), ProfilePass::Edges);
 
-  // Build vertex data from faces
-  if (!mesh.faces.empty()) {
-    std::vector<float> vertexData;
-    for (size_t i = 0; i + 2 < mesh.faces.size(); i += 3) {
-      uint32_t idx1 = mesh.faces[i];
-      uint32_t idx2 = mesh.faces[i + 1];
-      uint32_t idx3 = mesh.faces[i + 2];
+  useShader(m_meshShaderProgram);
+  m_meshShaderProgram.setMVP(mvp);
+  setUniformColor(m_meshShaderProgram, tint);
 
-      if (idx1 < mesh.vertices.size() && idx2 < mesh.vertices.size() && idx3 < mesh.vertices.size()) {
-        for (auto idx : {idx1, idx2, idx3}) {
-          const auto& v = mesh.vertices[idx];
-          vertexData.insert(vertexData.end(),
-                            {v.position.x, v.position.y, v.position.z, v.color.r, v.color.g, v.color.b, v.color.a});
-        }
-      }
-    }
+  // Depth testing for proper 3D rendering
+  StateCacheOpenGL& state = getState();
+  state.setEnabled(Capability::DepthTest, true);
+  state.setLineWidth(lineWidth);
+  applyBlending();
 
-    if (!vertexData.empty()) {
-      // Upload face data to GPU
-      glGenVertexArrays(1, &meshGPU.vao);
-      glGenBuffers(1, &meshGPU.vbo);
-      glBindVertexArray(meshGPU.vao);
-      glBindBuffer(GL_ARRAY_BUFFER, meshGPU.vbo);
-      glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertexData.size() * sizeof(float)), vertexData.data(),
-                   GL_STATIC_DRAW);
+  // Draw the visible chunks of the edges
+  state.bindVertexArray(meshGPU.edgeVao);
+  drawChunks(GL_LINES, meshGPU.edgeChunks, meshGPU.edgeIndexCount, true, mvp,
+             m_cullingEnabled && meshGPU.boundsValid);
+}
+
+void MeshRendererOpenGL::drawMeshPoints(const MeshGPU& meshGPU, const glm::mat4& mvp, const Color& tint,
+                                        float pointSize) {
+  if (!meshGPU.hasPoints() || !m_pointShaderProgram.isValid()) {
+    return;
+  }
+  if (m_queueing) {
+    queueDraw(GL_POINTS, meshGPU.pointVao, meshGPU.pointChunks, 0, meshGPU.vertexCount, 0, meshGPU.pointEbo != 0,
+              meshGPU.boundsValid ? &meshGPU.bounds : nullptr, mvp, tint, pointSize, QUEUE_BLEND);
+    return;
+  }
+  if (!isMeshVisible(meshGPU, mvp)) {
+    return;
+  }
+  ProfileScope scope(getProfiler(), ProfilePass::Points);
 
-      // Position attribute (vec3)
-      glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 7 * sizeof(float), nullptr);
-      glEnableVertexAttribArray(0);
+  useShader(m_pointShaderProgram);
+  m_pointShaderProgram.setMVP(mvp);
+  ShaderProgramOpenGL::setUniform(m_pointSizeLocation, pointSize);
+  setUniformColor(m_pointShaderProgram, tint);
 
-      // Color attribute (vec4)
-      glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, 7 * sizeof(float), reinterpret_cast<void*>(3 * sizeof(float)));
-      glEnableVertexAttribArray(1);
+  // Depth testing, blending for smooth antialiased circles, size from the shader
+  StateCacheOpenGL& state = getState();
+  state.setEnabled(Capability::DepthTest, true);
+  state.setEnabled(Capability::Blend, true);
+  state.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  state.setEnabled(Capability::ProgramPointSize, true);
+
+  // Draw the visible chunks of the points (a few pixels of point size may poke out of a culled chunk)
+  state.bindVertexArray(meshGPU.pointVao);
+  drawChunks(GL_POINTS, meshGPU.pointChunks, meshGPU.vertexCount, meshGPU.pointEbo != 0, mvp,
+             m_cullingEnabled && meshGPU.boundsValid);
+}
 
-      glBindVertexArray(0);
+void MeshRendererOpenGL::drawMesh(const MeshHandle& handle, const glm::mat4& mvp, const Color& tint, bool wireframe) {
+  if (handle && handle->isReady()) {
+    drawMesh(handle->mesh, mvp, tint, wireframe);
+  }
+}
 
-      meshGPU.vertexCount = static_cast<uint32_t>(vertexData.size() / 7);
-    }
+void MeshRendererOpenGL::drawMeshEdges(const MeshHandle& handle, const glm::mat4& mvp, const Color& tint,
+                                       float lineWidth) {
+  if (handle && handle->isReady()) {
+    drawMeshEdges(handle->mesh, mvp, tint, lineWidth);
   }
+}
 
-  // Build vertex data from edges
-  if (!mesh.edges.empty()) {
-    std::vector<float> edgeData;
-    for (size_t i = 0; i + 1 < mesh.edges.size(); i += 2) {
-      uint32_t idx1 = mesh.edges[i];
-      uint32_t idx2 = mesh.edges[i + 1];
+void MeshRendererOpenGL::drawMeshPoints(const MeshHandle& handle, const glm::mat4& mvp, const Color& tint,
+                                        float pointSize) {
+  if (handle && handle->isReady()) {
+    drawMeshPoints(handle->mesh, mvp, tint, pointSize);
+  }
+}
 
-      if (idx1 < mesh.vertices.size() && idx2 < mesh.vertices.size()) {
-        for (auto idx : {idx1, idx2}) {
-          const auto& v = mesh.vertices[idx];
-          edgeData.insert(edgeData.end(),
-                          {v.position.x, v.position.y, v.position.z, v.color.r, v.color.g, v.color.b, v.color.a});
-        }
-      }
-    }
+void MeshRendererOpenGL::endFrame() {
+  flushQueue();
+  RendererOpenGL::endFrame();
+}
+
+bool MeshRendererOpenGL::captureStill(const std::string& path, uint32_t width, uint32_t height,
+                                      const std::function<void(const glm::mat4&)>& draw) {
+  flushQueue();
+  return RendererOpenGL::captureStill(path, width, height, [&](const glm::mat4& transform) {
+    draw(transform);
+    flushQueue();
+  });
+}
+
+PooledMeshGPU MeshRendererOpenGL::uploadMeshPooled(const Mesh2D& mesh, VertexFormat format) {
+  return uploadPrepared(prepareMesh(mesh, format));
+}
+
+PooledMeshGPU MeshRendererOpenGL::uploadMeshPooled(const Mesh3D& mesh, VertexFormat format) {
+  return uploadPrepared(prepareMesh(mesh, format));
+}
+
+PooledMeshGPU MeshRendererOpenGL::uploadGraphPooled(const Graph& graph, VertexFormat format) {
+  return uploadPrepared(prepareGraph(graph, format));
+}
+
+PooledMeshGPU MeshRendererOpenGL::uploadPrepared(const PreparedMesh& prepared) {
+  PooledMeshGPU meshGPU = m_meshPool.allocate(prepared, getState());
+  if (meshGPU.isValid()) {
+    getProfiler().countUpload(prepared.vertexData.size() +
+                              (static_cast<uint64_t>(meshGPU.indexCount) * sizeof(uint32_t)));
+    requestRedraw();
+  }
+  return meshGPU;
+}
+
+void MeshRendererOpenGL::drawMesh(const PooledMeshGPU& meshGPU, const glm::mat4& mvp, const Color& tint,
+                                  bool wireframe) {
+  if (!meshGPU.hasFaces()) {
+    return;
+  }
+  const auto state = static_cast<uint8_t>(QUEUE_CULL_FACE | (wireframe ? QUEUE_WIREFRAME : 0) |
+                                          (isBlending() ? QUEUE_BLEND : 0));
+  queueDraw(GL_TRIANGLES, meshGPU.vao, meshGPU.faceChunks, meshGPU.firstIndex, meshGPU.faceCount,
+            static_cast<int32_t>(meshGPU.baseVertex), true, &meshGPU.bounds, mvp, tint, 1.0f, state);
+  if (!m_queueing) {
+    flushQueue();
+  }
+}
+
+void MeshRendererOpenGL::drawMeshEdges(const PooledMeshGPU& meshGPU, const glm::mat4& mvp, const Color& tint,
+                                       float lineWidth) {
+  if (!meshGPU.hasEdges()) {
+    return;
+  }
+  queueDraw(GL_LINES, meshGPU.vao, meshGPU.edgeChunks, meshGPU.firstIndex + meshGPU.faceCount, meshGPU.edgeCount,
+            static_cast<int32_t>(meshGPU.baseVertex), true, &meshGPU.bounds, mvp, tint, lineWidth,
+            isBlending() ? QUEUE_BLEND : 0);
+  if (!m_queueing) {
+    flushQueue();
+  }
+}
 
-    if (!edgeData.empty()) {
-      // Upload edge data to GPU
-      glGenVertexArrays(1, &meshGPU.edgeVao);
-      glGenBuffers(1, &meshGPU.edgeVbo);
-      glBindVertexArray(meshGPU.edgeVao);
-      glBindBuffer(GL_ARRAY_BUFFER, meshGPU.edgeVbo);
-      glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(edgeData.size() * sizeof(float)), edgeData.data(),
-                   GL_STATIC_DRAW);
+void MeshRendererOpenGL::drawMeshPoints(const PooledMeshGPU& meshGPU, const glm::mat4& mvp, const Color& tint,
+                                        float pointSize) {
+  if (!meshGPU.hasPoints()) {
+    return;
+  }
+  // Points in vertex order are drawn as a vertex range starting at the base vertex
+  const bool indexed = meshGPU.pointCount > 0;
+  const uint32_t first = indexed ? meshGPU.firstIndex + meshGPU.faceCount + meshGPU.edgeCount : meshGPU.baseVertex;
+  queueDraw(GL_POINTS, meshGPU.vao, meshGPU.pointChunks, first, meshGPU.vertexCount,
+            static_cast<int32_t>(meshGPU.baseVertex), indexed, &meshGPU.bounds, mvp, tint, pointSize, QUEUE_BLEND);
+  if (!m_queueing) {
+    flushQueue();
+  }
+}
 
-      // Position attribute (vec3)
-      glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 7 * sizeof(float), nullptr);
-      glEnableVertexAttribArray(0);
+void MeshRendererOpenGL::freeMesh(PooledMeshGPU& meshGPU) { m_meshPool.release(meshGPU); }
 
-      // Color attribute (vec4)
-      glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, 7 * sizeof(float), reinterpret_cast<void*>(3 * sizeof(float)));
-      glEnableVertexAttribArray(1);
+void MeshRendererOpenGL::setQueueing(bool enabled) {
+  if (m_queueing && !enabled) {
+    flushQueue();
+  }
+  m_queueing = enabled;
+}
 
-      glBindVertexArray(0);
+void MeshRendererOpenGL::queueDraw(uint32_t mode, uint32_t vao, std::span<const IndexChunk> chunks, uint32_t first,
+                                   uint32_t count, int32_t baseVertex, bool indexed, const AABB* bounds,
+                                   const glm::mat4& mvp, const Color& tint, float size, uint8_t state) {
+  if (count == 0) {
+    return;
+  }
+  const bool cull = m_cullingEnabled && bounds != nullptr;
+  const Frustum frustum = Frustum::fromMatrix(mvp);
+  if (cull && !frustum.intersects(*bounds)) {
+    return;
+  }
 
-      meshGPU.edgeVertexCount = static_cast<uint32_t>(edgeData.size() / 7);
+  // Consecutive draws usually share their data, only a change adds an entry
+  const QueueDrawData data{mvp, tint, glm::vec4(size, size, 0.0f, 0.0f)};
+  if (m_queueData.empty() || m_queueData.back().mvp != data.mvp || m_queueData.back().tint != data.tint ||
+      m_queueData.back().params != data.params) {
+    if (m_queueData.size() == MAX_QUEUE_DRAW_DATA) {
+      flushQueue();
     }
+    m_queueData.push_back(data);
+  }
+  const auto drawData = static_cast<uint32_t>(m_queueData.size() - 1);
+
+  // Depth of the bounds center orders the commands within their pass
+  float depth = 0.0f;
+  if (bounds != nullptr && bounds->isValid()) {
+    const glm::vec4 clip = mvp * glm::vec4(bounds->center(), 1.0f);
+    depth = clip.w > 0.0f ? clip.z / clip.w : 1.0f;
+  }
+  const uint64_t key = queueKey((state & QUEUE_BLEND) != 0 && mode != GL_POINTS, mode, state, vao, drawData, depth);
+
+  auto push = [&](uint32_t rangeFirst, uint32_t rangeCount) {
+    m_queue.push_back(QueueCommand{key, vao, mode, rangeFirst, rangeCount, baseVertex, drawData, state, indexed});
+  };
+
+  if (!cull || chunks.size() <= 1) {
+    push(first, count);
+    return;
   }
 
-  // Build vertex data for points (all vertices)
-  if (!mesh.vertices.empty()) {
-    std::vector<float> pointData;
-    for (const auto& v : mesh.vertices) {
-      pointData.insert(pointData.end(),
-                       {v.position.x, v.position.y, v.position.z, v.color.r, v.color.g, v.color.b, v.color.a});
+  // Visible chunks, adjacent ones merged (their indices are contiguous)
+  const size_t queued = m_queue.size();
+  for (const IndexChunk& chunk : chunks) {
+    if (!frustum.intersects(chunk.bounds)) {
+      continue;
+    }
+    QueueCommand* last = m_queue.size() > queued ? &m_queue.back() : nullptr;
+    if (last != nullptr && last->first + last->count == first + chunk.firstIndex) {
+      last->count += chunk.indexCount;
+    } else {
+      push(first + chunk.firstIndex, chunk.indexCount);
     }
+  }
+}
 
-    if (!pointData.empty()) {
-      // Upload point data to GPU
-      glGenVertexArrays(1, &meshGPU.pointVao);
-      glGenBuffers(1, &meshGPU.pointVbo);
-      glBindVertexArray(meshGPU.pointVao);
-      glBindBuffer(GL_ARRAY_BUFFER, meshGPU.pointVbo);
-      glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(pointData.size() * sizeof(float)), pointData.data(),
-                   GL_STATIC_DRAW);
+void MeshRendererOpenGL::flushQueue() {
+  if (m_queue.empty() || !m_queueMeshProgram.isValid()) {
+    m_queue.clear();
+    m_queueData.clear();
+    return;
+  }
 
-      // Position attribute (vec3)
-      glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 7 * sizeof(float), nullptr);
-      glEnableVertexAttribArray(0);
+  // Every draw data entry at a bindable offset of one stream allocation
+  const size_t stride = (sizeof(QueueDrawData) + m_uniformAlignment - 1) / m_uniformAlignment * m_uniformAlignment;
+  StreamAllocation allocation = getStreamBuffer().allocate(stride * m_queueData.size(), m_uniformAlignment);
+  if (allocation.isValid()) {
+    for (size_t i = 0; i < m_queueData.size(); ++i) {
+      std::memcpy(static_cast<uint8_t*>(allocation.data) + (i * stride), &m_queueData[i], sizeof(QueueDrawData));
+    }
+    getStreamBuffer().commit();
+
+    // Stable, so ranges of one view stay in order and can merge again
+    std::ranges::stable_sort(m_queue, {}, &QueueCommand::key);
+
+    auto compatible = [](const QueueCommand& a, const QueueCommand& b) {
+      return a.vao == b.vao && a.mode == b.mode && a.drawData == b.drawData && a.state == b.state &&
+             a.indexed == b.indexed;
+    };
+    for (size_t begin = 0; begin < m_queue.size();) {
+      size_t end = begin + 1;
+      while (end < m_queue.size() && compatible(m_queue[begin], m_queue[end])) {
+        ++end;
+      }
+      submitQueueBatch(std::span<const QueueCommand>(m_queue).subspan(begin, end - begin),
+                       allocation.offset + (m_queue[begin].drawData * stride));
+      begin = end;
+    }
 
-      // Color attribute (vec4)
-      glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, 7 * sizeof(float), reinterpret_cast<void*>(3 * sizeof(float)));
-      glEnableVertexAttribArray(1);
+    glBindBufferBase(GL_UNIFORM_BUFFER, DRAW_BLOCK_BINDING, 0);
+    applyBlending();
+  }
 
-      glBindVertexArray(0);
+  m_queue.clear();
+  m_queueData.clear();
+}
 
-      meshGPU.pointVertexCount = static_cast<uint32_t>(pointData.size() / 7);
+void MeshRendererOpenGL::submitQueueBatch(std::span<const QueueCommand> batch, size_t dataOffset) {
+  const QueueCommand& command = batch.front();
+  const bool points = command.mode == GL_POINTS;
+  ProfileScope scope(getProfiler(), command.mode == GL_TRIANGLES ? ProfilePass::Faces
+                                    : points                     ? ProfilePass::Points
+                                                                 : ProfilePass::Edges);
+
+  useShader(points ? m_queuePointProgram : m_queueMeshProgram);
+  glBindBufferRange(GL_UNIFORM_BUFFER, DRAW_BLOCK_BINDING, getStreamBuffer().getBuffer(),
+                    static_cast<GLintptr>(dataOffset), sizeof(QueueDrawData));
+
+  StateCacheOpenGL& state = getState();
+  const bool blend = (command.state & QUEUE_BLEND) != 0;
+  state.setEnabled(Capability::DepthTest, true);
+  state.setEnabled(Capability::CullFace, (command.state & QUEUE_CULL_FACE) != 0);
+  state.setPolygonMode((command.state & QUEUE_WIREFRAME) != 0 ? GL_LINE : GL_FILL);
+  state.setEnabled(Capability::Blend, blend);
+  if (blend) {
+    state.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  }
+  if (points) {
+    state.setEnabled(Capability::ProgramPointSize, true);
+  } else if (command.mode == GL_LINES) {
+    state.setLineWidth(m_queueData[command.drawData].params.y);
+  }
+  state.bindVertexArray(command.vao);
+
+  // Ranges of the batch, contiguous ones with the same base vertex joined
+  m_drawFirsts.clear();
+  m_drawCounts.clear();
+  m_drawBaseVertices.clear();
+  uint64_t elements = 0;
+  for (const QueueCommand& range : batch) {
+    elements += range.count;
+    if (!m_drawFirsts.empty() && m_drawBaseVertices.back() == range.baseVertex &&
+        m_drawFirsts.back() + m_drawCounts.back() == static_cast<int32_t>(range.first)) {
+      m_drawCounts.back() += static_cast<int32_t>(range.count);
+      continue;
     }
+    m_drawFirsts.push_back(static_cast<int32_t>(range.first));
+    m_drawCounts.push_back(static_cast<int32_t>(range.count));
+    m_drawBaseVertices.push_back(range.baseVertex);
   }
+  getProfiler().countDraw(elements);
 
-  return meshGPU;
+  const auto drawCount = static_cast<GLsizei>(m_drawFirsts.size());
+  if (!command.indexed) {
+    glMultiDrawArrays(command.mode, m_drawFirsts.data(), m_drawCounts.data(), drawCount);
+    return;
+  }
+
+  m_drawOffsets.resize(m_drawFirsts.size());
+  for (size_t i = 0; i < m_drawFirsts.size(); ++i) {
+    m_drawOffsets[i] = reinterpret_cast<const void*>(static_cast<size_t>(m_drawFirsts[i]) * sizeof(uint32_t));
+  }
+  glMultiDrawElementsBaseVertex(command.mode, m_drawCounts.data(), GL_UNSIGNED_INT, m_drawOffsets.data(), drawCount,
+                                m_drawBaseVertices.data());
 }
 
-void MeshRendererOpenGL::drawMesh(const MeshGPU& meshGPU, const glm::mat4& mvp, const Color& tint, bool wireframe) {
-  if (!meshGPU.isValid() || (m_meshShaderProgram == 0 && !const_cast<MeshRendererOpenGL*>(this)->loadMeshShaders())) {
+NodesGPU MeshRendererOpenGL::uploadNodes(const std::vector<NodeInstance>& nodes) {
+  if (!m_nodeShaderProgram.isValid()) {
+    return NodesGPU();
+  }
+
+  NodesGPU nodesGPU = createNodes(nodes.size());
+  if (nodesGPU.vao == 0) {
+    return nodesGPU;
+  }
+
+  // Instance data is uploaded as-is, NodeInstance is the GPU layout
+  glBindBuffer(GL_ARRAY_BUFFER, nodesGPU.instanceVbo);
+  glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(nodes.size() * sizeof(NodeInstance)), nodes.data());
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  getProfiler().countUpload(nodes.size() * sizeof(NodeInstance));
+  requestRedraw();
+
+  return nodesGPU;
+}
+
+NodesGPU MeshRendererOpenGL::uploadNodes(const Graph& graph, NodeShape shape, float outlineWidth) {
+  if (!m_nodeShaderProgram.isValid()) {
+    return NodesGPU();
+  }
+
+  const size_t count = graph.nodeCount();
+  if (graph.positions.size() != count || graph.colors.size() != count || graph.sizes.size() != count) {
+    return NodesGPU();
+  }
+
+  NodesGPU nodesGPU = createNodes(count);
+  if (nodesGPU.vao == 0) {
+    return nodesGPU;
+  }
+
+  // Interleave the SoA node attributes straight into the instance buffer
+  glBindBuffer(GL_ARRAY_BUFFER, nodesGPU.instanceVbo);
+  auto* mapped = static_cast<NodeInstance*>(
+      glMapBufferRange(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(count * sizeof(NodeInstance)),
+                       GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+  if (mapped == nullptr) {
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    freeNodes(nodesGPU);
+    return nodesGPU;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    mapped[i] = NodeInstance(graph.positions[i], graph.sizes[i], graph.colors[i], shape, outlineWidth);
+  }
+  glUnmapBuffer(GL_ARRAY_BUFFER);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  getProfiler().countUpload(count * sizeof(NodeInstance));
+  requestRedraw();
+
+  return nodesGPU;
+}
+
+NodesGPU MeshRendererOpenGL::createNodes(size_t count) {
+  NodesGPU nodesGPU;
+  if (count == 0) {
+    return nodesGPU;
+  }
+
+  glGenVertexArrays(1, &nodesGPU.vao);
+  glGenBuffers(1, &nodesGPU.instanceVbo);
+  getState().bindVertexArray(nodesGPU.vao);
+
+  // Quad corner attribute (vec2, per vertex)
+  glBindBuffer(GL_ARRAY_BUFFER, m_nodeQuadVBO);
+  applyVertexLayout(blockLayout<glm::vec2>(4));
+
+  // Position + radius, color, shape id and outline width (per instance, see VertexLayout<NodeInstance>)
+  glBindBuffer(GL_ARRAY_BUFFER, nodesGPU.instanceVbo);
+  glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(count * sizeof(NodeInstance)), nullptr, GL_STATIC_DRAW);
+  applyVertexLayout<NodeInstance>(0, 1);
+
+  getState().bindVertexArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  nodesGPU.instanceCount = static_cast<uint32_t>(count);
+  return nodesGPU;
+}
+
+void MeshRendererOpenGL::drawNodes(const NodesGPU& nodesGPU, const glm::mat4& mvp, const Color& tint,
+                                   float radiusScale, const Color& outlineColor) {
+  if (!nodesGPU.isValid() || !m_nodeShaderProgram.isValid()) {
     return;
   }
 
-  useShader(m_meshShaderProgram);
+  ProfileScope scope(getProfiler(), ProfilePass::Nodes);
+
+  useShader(m_nodeShaderProgram);
+  m_nodeShaderProgram.setMVP(mvp);
+
+  // Viewport size converts pixel radii to clip space
+  ShaderProgramOpenGL::setUniform(m_nodeViewportLocation,
+                                  glm::vec2(static_cast<float>(getWidth()), static_cast<float>(getHeight())));
+  ShaderProgramOpenGL::setUniform(m_nodeRadiusScaleLocation, radiusScale);
+  ShaderProgramOpenGL::setUniform(m_nodeOutlineColorLocation, outlineColor);
+  setUniformColor(m_nodeShaderProgram, tint);
+
+  // Depth testing for proper 3D rendering, blending for the antialiased SDF edge
+  StateCacheOpenGL& state = getState();
+  state.setEnabled(Capability::DepthTest, true);
+  state.setEnabled(Capability::CullFace, false);
+  state.setEnabled(Capability::Blend, true);
+  state.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  state.setPolygonMode(GL_FILL);
+
+  // Draw all nodes in a single instanced call
+  state.bindVertexArray(nodesGPU.vao);
+  glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(nodesGPU.instanceCount));
+  getProfiler().countDraw(4 * static_cast<uint64_t>(nodesGPU.instanceCount));
+}
 
-  // Set MVP matrix
-  int mvpLoc = glGetUniformLocation(m_meshShaderProgram, "uMVP");
-  if (mvpLoc != -1) {
-    glUniformMatrix4fv(mvpLoc, 1, GL_FALSE, glm::value_ptr(mvp));
+EdgesGPU MeshRendererOpenGL::uploadEdges(const std::vector<EdgeInstance>& edges) {
+  if (!m_edgeShaderProgram.isValid()) {
+    return EdgesGPU();
   }
 
-  // Set tint color
-  setUniformColor(m_meshShaderProgram, tint);
+  EdgesGPU edgesGPU = createEdges(edges.size());
+  if (edgesGPU.vao == 0) {
+    return edgesGPU;
+  }
+
+  // Instance data is uploaded as-is, EdgeInstance is the GPU layout
+  glBindBuffer(GL_ARRAY_BUFFER, edgesGPU.instanceVbo);
+  glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(edges.size() * sizeof(EdgeInstance)), edges.data());
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  getProfiler().countUpload(edges.size() * sizeof(EdgeInstance));
+  requestRedraw();
 
-  // Enable depth testing and backface culling
-  glEnable(GL_DEPTH_TEST);
-  glEnable(GL_CULL_FACE);
-  glCullFace(GL_BACK);
-  glFrontFace(GL_CCW);
+  return edgesGPU;
+}
 
-  // Wireframe mode if requested
-  if (wireframe) {
-    glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+EdgesGPU MeshRendererOpenGL::uploadEdges(const Graph& graph, float width) {
+  if (!m_edgeShaderProgram.isValid()) {
+    return EdgesGPU();
+  }
+  if (graph.colors.size() != graph.nodeCount()) {
+    return EdgesGPU();
   }
 
-  // Draw the mesh
-  glBindVertexArray(meshGPU.vao);
-  glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(meshGPU.vertexCount));
-  glBindVertexArray(0);
+  const size_t count = graph.edges.size();
+  EdgesGPU edgesGPU = createEdges(count);
+  if (edgesGPU.vao == 0) {
+    return edgesGPU;
+  }
 
-  // Reset state
-  if (wireframe) {
-    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+  // Endpoints are validated when the graph is built, write the instances straight into the buffer
+  glBindBuffer(GL_ARRAY_BUFFER, edgesGPU.instanceVbo);
+  auto* mapped = static_cast<EdgeInstance*>(
+      glMapBufferRange(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(count * sizeof(EdgeInstance)),
+                       GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+  if (mapped == nullptr) {
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    freeEdges(edgesGPU);
+    return edgesGPU;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    const Edge& edge = graph.edges[i];
+    mapped[i] = EdgeInstance(edge.source, edge.target, width,
+                             0.5f * (graph.colors[edge.source] + graph.colors[edge.target]));
   }
-  glDisable(GL_CULL_FACE);
-  glDisable(GL_DEPTH_TEST);
+  glUnmapBuffer(GL_ARRAY_BUFFER);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  getProfiler().countUpload(count * sizeof(EdgeInstance));
+  requestRedraw();
+
+  return edgesGPU;
 }
 
-void MeshRendererOpenGL::drawMeshEdges(const MeshGPU& meshGPU, const glm::mat4& mvp, const Color& tint,
-                                       float lineWidth) {
-  if (!meshGPU.hasEdges() || (m_meshShaderProgram == 0 && !const_cast<MeshRendererOpenGL*>(this)->loadMeshShaders())) {
+EdgesGPU MeshRendererOpenGL::createEdges(size_t count) {
+  EdgesGPU edgesGPU;
+  if (count == 0) {
+    return edgesGPU;
+  }
+
+  glGenVertexArrays(1, &edgesGPU.vao);
+  glGenBuffers(1, &edgesGPU.instanceVbo);
+  getState().bindVertexArray(edgesGPU.vao);
+
+  // Quad corner attribute (vec2, per vertex)
+  glBindBuffer(GL_ARRAY_BUFFER, m_edgeQuadVBO);
+  applyVertexLayout(blockLayout<glm::vec2>(4));
+
+  // Endpoint indices, width and RGBA8 color (per instance, see VertexLayout<EdgeInstance>)
+  glBindBuffer(GL_ARRAY_BUFFER, edgesGPU.instanceVbo);
+  glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(count * sizeof(EdgeInstance)), nullptr, GL_STATIC_DRAW);
+  applyVertexLayout<EdgeInstance>(0, 1);
+
+  getState().bindVertexArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  edgesGPU.instanceCount = static_cast<uint32_t>(count);
+  return edgesGPU;
+}
+
+void MeshRendererOpenGL::drawEdges(const EdgesGPU& edgesGPU, const MeshGPU& vertices, const glm::mat4& mvp,
+                                   const Color& tint, float widthScale) {
+  if (!edgesGPU.isValid() || vertices.vbo == 0 || !m_edgeShaderProgram.isValid()) {
+    return;
+  }
+  if (!isMeshVisible(vertices, mvp)) {
     return;
   }
+  ProfileScope scope(getProfiler(), ProfilePass::Edges);
+
+  // GL 3.3 buffer textures have no three-component float format: float positions are fetched one component
+  // at a time, half positions are padded to four halves and come in one texel
+  int positionStride = 0;
+  glActiveTexture(GL_TEXTURE0);
+  glBindTexture(GL_TEXTURE_BUFFER, m_edgePositionTexture);
+  if (vertices.positionBuffer != 0) {
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_R32F, vertices.positionBuffer);
+    positionStride = static_cast<int>(vertices.positionStride / sizeof(float));
+  } else if (vertices.format == VertexFormat::HalfPosition) {
+    glTexBuffer(GL_TEXTURE_BUFFER, vertices.dimensions == 2 ? GL_RG16F : GL_RGBA16F, vertices.vbo);
+  } else {
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_R32F, vertices.vbo);
+    positionStride = static_cast<int>(vertices.dimensions);
+  }
 
-  useShader(m_meshShaderProgram);
+  drawEdgeInstances(edgesGPU, mvp, tint, widthScale, positionStride);
+}
 
-  // Set MVP matrix
-  int mvpLoc = glGetUniformLocation(m_meshShaderProgram, "uMVP");
-  if (mvpLoc != -1) {
-    glUniformMatrix4fv(mvpLoc, 1, GL_FALSE, glm::value_ptr(mvp));
+void MeshRendererOpenGL::drawEdges(const EdgesGPU& edgesGPU, const NodesGPU& nodes, const glm::mat4& mvp,
+                                   const Color& tint, float widthScale) {
+  if (!edgesGPU.isValid() || !nodes.isValid() || !m_edgeShaderProgram.isValid()) {
+    return;
+  }
+  ProfileScope scope(getProfiler(), ProfilePass::Edges);
+
+  // External vec4 positions come in one texel per node; the instance buffer is fetched one float at a time
+  static_assert(offsetof(NodeInstance, position) == 0 && sizeof(NodeInstance) % sizeof(float) == 0);
+  int positionStride = 0;
+  glActiveTexture(GL_TEXTURE0);
+  glBindTexture(GL_TEXTURE_BUFFER, m_edgePositionTexture);
+  if (nodes.positionBuffer != 0) {
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, nodes.positionBuffer);
+  } else {
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_R32F, nodes.instanceVbo);
+    positionStride = static_cast<int>(sizeof(NodeInstance) / sizeof(float));
   }
 
-  // Set tint color
-  setUniformColor(m_meshShaderProgram, tint);
+  drawEdgeInstances(edgesGPU, mvp, tint, widthScale, positionStride);
+}
+
+void MeshRendererOpenGL::drawEdgeInstances(const EdgesGPU& edgesGPU, const glm::mat4& mvp, const Color& tint,
+                                           float widthScale, int positionStride) {
+  useShader(m_edgeShaderProgram);
+  m_edgeShaderProgram.setMVP(mvp);
+
+  // Viewport size converts pixel widths to clip space
+  ShaderProgramOpenGL::setUniform(m_edgeViewportLocation,
+                                  glm::vec2(static_cast<float>(getWidth()), static_cast<float>(getHeight())));
+  ShaderProgramOpenGL::setUniform(m_edgeWidthScaleLocation, widthScale);
+  ShaderProgramOpenGL::setUniform(m_edgePositionsLocation, 0);
+  ShaderProgramOpenGL::setUniform(m_edgePositionStrideLocation, positionStride);
+  setUniformColor(m_edgeShaderProgram, tint);
+
+  // Depth testing for proper 3D rendering, blending for the antialiased fringe
+  StateCacheOpenGL& state = getState();
+  state.setEnabled(Capability::DepthTest, true);
+  state.setEnabled(Capability::CullFace, false);
+  state.setEnabled(Capability::Blend, true);
+  state.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  state.setPolygonMode(GL_FILL);
+
+  // Draw all edges in a single instanced call
+  state.bindVertexArray(edgesGPU.vao);
+  glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(edgesGPU.instanceCount));
+  getProfiler().countDraw(4 * static_cast<uint64_t>(edgesGPU.instanceCount));
+
+  glBindTexture(GL_TEXTURE_BUFFER, 0);
+}
 
-  // Enable depth testing for proper 3D rendering
-  glEnable(GL_DEPTH_TEST);
+bool MeshRendererOpenGL::beginPicking() {
+  if (m_picking || !m_pickNodeProgram.isValid() || !m_pickBuffer.resize(getWidth(), getHeight())) {
+    return false;
+  }
+  m_picking = true;
+  m_pickBuffer.bind();
+
+  // Integer targets are never blended; later draws win depth ties so nodes drawn after edges stay on top
+  StateCacheOpenGL& state = getState();
+  state.setEnabled(Capability::Blend, false);
+  state.setEnabled(Capability::DepthTest, true);
+  state.setEnabled(Capability::CullFace, false);
+  state.setPolygonMode(GL_FILL);
+  m_pickDepthFunc = state.getDepthFunc();
+  state.setDepthFunc(GL_LEQUAL);
+  return true;
+}
+
+void MeshRendererOpenGL::endPicking() {
+  if (!m_picking) {
+    return;
+  }
+  m_picking = false;
+  getState().setDepthFunc(m_pickDepthFunc);
+  PickBufferOpenGL::unbind();
+  glViewport(0, 0, static_cast<int>(getWidth()), static_cast<int>(getHeight()));
+  applyBlending();
+}
 
-  // Set line width
-  glLineWidth(lineWidth);
+void MeshRendererOpenGL::pickMeshEdges(const MeshGPU& meshGPU, const glm::mat4& mvp, float lineWidth) {
+  if (!m_picking || !meshGPU.hasEdges() || !isMeshVisible(meshGPU, mvp)) {
+    return;
+  }
 
-  // Draw the edges
-  glBindVertexArray(meshGPU.edgeVao);
-  glDrawArrays(GL_LINES, 0, static_cast<GLsizei>(meshGPU.edgeVertexCount));
-  glBindVertexArray(0);
+  useShader(m_pickEdgeProgram);
+  m_pickEdgeProgram.setMVP(mvp);
+  getState().setLineWidth(lineWidth);
 
-  // Reset state
-  glLineWidth(1.0f);
-  glDisable(GL_DEPTH_TEST);
+  getState().bindVertexArray(meshGPU.edgeVao);
+  drawChunks(GL_LINES, meshGPU.edgeChunks, meshGPU.edgeIndexCount, true, mvp,
+             m_cullingEnabled && meshGPU.boundsValid);
 }
 
-void MeshRendererOpenGL::drawMeshPoints(const MeshGPU& meshGPU, const glm::mat4& mvp, const Color& tint,
-                                        float pointSize) {
-  if (!meshGPU.hasPoints() ||
-      (m_pointShaderProgram == 0 && !const_cast<MeshRendererOpenGL*>(this)->loadPointShaders())) {
+void MeshRendererOpenGL::pickMeshPoints(const MeshGPU& meshGPU, const glm::mat4& mvp, float pointSize) {
+  if (!m_picking || !meshGPU.hasPoints() || !isMeshVisible(meshGPU, mvp)) {
     return;
   }
 
-  useShader(m_pointShaderProgram);
+  useShader(m_pickPointProgram);
+  m_pickPointProgram.setMVP(mvp);
+  ShaderProgramOpenGL::setUniform(m_pickPointSizeLocation, pointSize);
+  getState().setEnabled(Capability::ProgramPointSize, true);
+
+  getState().bindVertexArray(meshGPU.pointVao);
+  drawChunks(GL_POINTS, meshGPU.pointChunks, meshGPU.vertexCount, meshGPU.pointEbo != 0, mvp,
+             m_cullingEnabled && meshGPU.boundsValid);
+}
 
-  // Set MVP matrix
-  int mvpLoc = glGetUniformLocation(m_pointShaderProgram, "uMVP");
-  if (mvpLoc != -1) {
-    glUniformMatrix4fv(mvpLoc, 1, GL_FALSE, glm::value_ptr(mvp));
+void MeshRendererOpenGL::pickNodes(const NodesGPU& nodesGPU, const glm::mat4& mvp, float radiusScale) {
+  if (!m_picking || !nodesGPU.isValid()) {
+    return;
   }
 
-  // Set tint color
-  setUniformColor(m_pointShaderProgram, tint);
+  useShader(m_pickNodeProgram);
+  m_pickNodeProgram.setMVP(mvp);
+  ShaderProgramOpenGL::setUniform(m_pickNodeViewportLocation,
+                                  glm::vec2(static_cast<float>(getWidth()), static_cast<float>(getHeight())));
+  ShaderProgramOpenGL::setUniform(m_pickNodeRadiusScaleLocation, radiusScale);
+
+  getState().bindVertexArray(nodesGPU.vao);
+  glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(nodesGPU.instanceCount));
+  getProfiler().countDraw(4 * static_cast<uint64_t>(nodesGPU.instanceCount));
+}
+
+uint64_t MeshRendererOpenGL::requestPick(uint32_t x, uint32_t y, uint32_t radius) {
+  return m_pickBuffer.requestPoint(x, y, radius);
+}
+
+uint64_t MeshRendererOpenGL::requestBoxSelection(uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1) {
+  return m_pickBuffer.requestBox(x0, y0, x1, y1);
+}
+
+std::vector<PickResult> MeshRendererOpenGL::takePickResults() {
+  m_pickBuffer.poll(m_pickResults);
+  return std::exchange(m_pickResults, {});
+}
 
-  // Enable depth testing for proper 3D rendering
-  glEnable(GL_DEPTH_TEST);
+void MeshRendererOpenGL::bindMeshPositions(MeshGPU& meshGPU, uint32_t buffer, size_t stride) {
+  if (meshGPU.vbo == 0 || (meshGPU.positionBuffer == buffer && meshGPU.positionStride == stride)) {
+    return;
+  }
 
-  // Enable blending for smooth antialiased circles
-  glEnable(GL_BLEND);
-  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  meshGPU.positionBuffer = buffer;
+  meshGPU.positionStride = buffer != 0 ? static_cast<uint32_t>(stride) : 0;
+  meshGPU.boundsValid = false;
 
-  // Enable point sprite mode for gl_PointCoord
-  glEnable(GL_PROGRAM_POINT_SIZE);
+  // Re-point every view once, draws then read the external buffer directly
+  for (uint32_t vao : {meshGPU.vao, meshGPU.edgeVao, meshGPU.pointVao}) {
+    if (vao != 0) {
+      getState().bindVertexArray(vao);
+      setupVertexAttributes(meshGPU);
+    }
+  }
+  getState().bindVertexArray(0);
+  requestRedraw();
+}
 
-  // Set point size
-  glPointSize(pointSize);
+void MeshRendererOpenGL::bindNodePositions(NodesGPU& nodesGPU, uint32_t buffer) {
+  if (nodesGPU.vao == 0 || nodesGPU.positionBuffer == buffer) {
+    return;
+  }
 
-  // Draw the points
-  glBindVertexArray(meshGPU.pointVao);
-  glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(meshGPU.pointVertexCount));
-  glBindVertexArray(0);
+  nodesGPU.positionBuffer = buffer;
 
-  // Reset state
-  glPointSize(1.0f);
-  glDisable(GL_PROGRAM_POINT_SIZE);
-  glDisable(GL_BLEND);
-  glDisable(GL_DEPTH_TEST);
+  getState().bindVertexArray(nodesGPU.vao);
+  if (buffer != 0) {
+    // Position + radius attribute (vec4, per instance) from the tightly packed external buffer
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    pointVertexAttributes(blockLayout<glm::vec4>(nodesGPU.instanceCount, 1), 0);
+  } else {
+    glBindBuffer(GL_ARRAY_BUFFER, nodesGPU.instanceVbo);
+    pointVertexAttributes(std::span(VertexLayout<NodeInstance>::ATTRIBUTES).first(1), sizeof(NodeInstance));
+  }
+  getState().bindVertexArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  requestRedraw();
 }
 
 void MeshRendererOpenGL::freeMesh(MeshGPU& meshGPU) {
+  StateCacheOpenGL& state = getState();
+  for (uint32_t vao : {meshGPU.vao, meshGPU.edgeVao, meshGPU.pointVao}) {
+    state.forgetVertexArray(vao);
+  }
+
+  // Element buffers are deleted on their own, a cancelled async upload has them without a VAO
   if (meshGPU.vao) {
     glDeleteVertexArrays(1, &meshGPU.vao);
-    glDeleteBuffers(1, &meshGPU.vbo);
     meshGPU.vao = 0;
-    meshGPU.vbo = 0;
-    meshGPU.vertexCount = 0;
   }
+  if (meshGPU.ebo) {
+    glDeleteBuffers(1, &meshGPU.ebo);
+    meshGPU.ebo = 0;
+  }
+  meshGPU.indexCount = 0;
   if (meshGPU.edgeVao) {
     glDeleteVertexArrays(1, &meshGPU.edgeVao);
-    glDeleteBuffers(1, &meshGPU.edgeVbo);
     meshGPU.edgeVao = 0;
-    meshGPU.edgeVbo = 0;
-    meshGPU.edgeVertexCount = 0;
   }
+  if (meshGPU.edgeEbo) {
+    glDeleteBuffers(1, &meshGPU.edgeEbo);
+    meshGPU.edgeEbo = 0;
+  }
+  meshGPU.edgeIndexCount = 0;
   if (meshGPU.pointVao) {
     glDeleteVertexArrays(1, &meshGPU.pointVao);
-    glDeleteBuffers(1, &meshGPU.pointVbo);
     meshGPU.pointVao = 0;
-    meshGPU.pointVbo = 0;
-    meshGPU.pointVertexCount = 0;
+  }
+  if (meshGPU.pointEbo) {
+    glDeleteBuffers(1, &meshGPU.pointEbo);
+    meshGPU.pointEbo = 0;
+  }
+  if (meshGPU.vbo) {
+    glDeleteBuffers(1, &meshGPU.vbo);
+    meshGPU.vbo = 0;
+    meshGPU.vertexCount = 0;
+  }
+  // External position buffers are owned by their producer
+  meshGPU.positionBuffer = 0;
+  meshGPU.positionStride = 0;
+
+  meshGPU.bounds = AABB();
+  meshGPU.faceChunks.clear();
+  meshGPU.edgeChunks.clear();
+  meshGPU.pointChunks.clear();
+  meshGPU.boundsValid = false;
+}
+
+void MeshRendererOpenGL::freeMesh(MeshHandle& handle) {
+  if (handle && handle->isReady()) {
+    freeMesh(handle->mesh);
+  }
+  // A pending job sees the expired handle and releases its buffers in the next beginFrame
+  handle.reset();
+}
+
+void MeshRendererOpenGL::freeNodes(NodesGPU& nodesGPU) {
+  if (nodesGPU.vao) {
+    getState().forgetVertexArray(nodesGPU.vao);
+    glDeleteVertexArrays(1, &nodesGPU.vao);
+    glDeleteBuffers(1, &nodesGPU.instanceVbo);
+    nodesGPU.vao = 0;
+    nodesGPU.instanceVbo = 0;
+    nodesGPU.instanceCount = 0;
+  }
+  nodesGPU.positionBuffer = 0;
+}
+
+void MeshRendererOpenGL::freeEdges(EdgesGPU& edgesGPU) {
+  if (edgesGPU.vao) {
+    getState().forgetVertexArray(edgesGPU.vao);
+    glDeleteVertexArrays(1, &edgesGPU.vao);
+    glDeleteBuffers(1, &edgesGPU.instanceVbo);
+    edgesGPU.vao = 0;
+    edgesGPU.instanceVbo = 0;
+    edgesGPU.instanceCount = 0;
   }
 }
 
@@ -0,0 +1,245 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <gfx/pick_buffer_opengl.hpp>
+
+namespace gfx {
+
+namespace {
+
+auto sortKey(const PickHit& hit) { return std::tie(hit.kind, hit.id, hit.other); }
+
+}  // namespace
+
+PickBufferOpenGL::PickBufferOpenGL()
+    : m_framebuffer(0), m_idBuffer(0), m_depthBuffer(0), m_width(0), m_height(0), m_readbacks{}, m_nextRequest(1) {}
+
+PickBufferOpenGL::~PickBufferOpenGL() { cleanup(); }
+
+bool PickBufferOpenGL::resize(uint32_t width, uint32_t height) {
+  if (m_framebuffer != 0 && width == m_width && height == m_height) {
+    return true;
+  }
+  if (width == 0 || height == 0) {
+    return false;
+  }
+
+  // Reads still in flight refer to the old contents, they complete from their own buffers
+  if (m_framebuffer == 0) {
+    glGenFramebuffers(1, &m_framebuffer);
+    glGenRenderbuffers(1, &m_idBuffer);
+    glGenRenderbuffers(1, &m_depthBuffer);
+  }
+
+  glBindRenderbuffer(GL_RENDERBUFFER, m_idBuffer);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_RG32UI, static_cast<GLsizei>(width), static_cast<GLsizei>(height));
+  glBindRenderbuffer(GL_RENDERBUFFER, m_depthBuffer);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, static_cast<GLsizei>(width),
+                        static_cast<GLsizei>(height));
+  glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+  glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_idBuffer);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_depthBuffer);
+  const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+  m_width = width;
+  m_height = height;
+  if (!complete) {
+    cleanup();
+    return false;
+  }
+  return true;
+}
+
+void PickBufferOpenGL::cleanup() {
+  for (Readback& readback : m_readbacks) {
+    if (readback.fence != nullptr) {
+      glDeleteSync(static_cast<GLsync>(readback.fence));
+    }
+    if (readback.pbo != 0) {
+      glDeleteBuffers(1, &readback.pbo);
+    }
+    readback = Readback();
+  }
+  if (m_framebuffer != 0) {
+    glDeleteFramebuffers(1, &m_framebuffer);
+    glDeleteRenderbuffers(1, &m_idBuffer);
+    glDeleteRenderbuffers(1, &m_depthBuffer);
+    m_framebuffer = 0;
+    m_idBuffer = 0;
+    m_depthBuffer = 0;
+  }
+  m_width = 0;
+  m_height = 0;
+}
+
+void PickBufferOpenGL::bind() const {
+  glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+  glViewport(0, 0, static_cast<GLsizei>(m_width), static_cast<GLsizei>(m_height));
+
+  const GLuint empty[4] = {0, 0, 0, 0};
+  const GLfloat far = 1.0f;
+  glClearBufferuiv(GL_COLOR, 0, empty);
+  glClearBufferfv(GL_DEPTH, 0, &far);
+}
+
+void PickBufferOpenGL::unbind() { glBindFramebuffer(GL_FRAMEBUFFER, 0); }
+
+uint64_t PickBufferOpenGL::requestPoint(uint32_t x, uint32_t y, uint32_t radius) {
+  const auto cx = static_cast<int32_t>(x);
+  const auto cy = static_cast<int32_t>(y);
+  const auto r = static_cast<int32_t>(radius);
+  return request(cx - r, cy - r, cx + r + 1, cy + r + 1, false, cx, cy);
+}
+
+uint64_t PickBufferOpenGL::requestBox(uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1) {
+  // Inclusive corners in any order
+  return request(static_cast<int32_t>(std::min(x0, x1)), static_cast<int32_t>(std::min(y0, y1)),
+                 static_cast<int32_t>(std::max(x0, x1)) + 1, static_cast<int32_t>(std::max(y0, y1)) + 1, true, 0, 0);
+}
+
+uint64_t PickBufferOpenGL::request(int32_t x0, int32_t y0, int32_t x1, int32_t y1, bool box, int32_t centerX,
+                                   int32_t centerY) {
+  if (m_framebuffer == 0) {
+    return 0;
+  }
+
+  // Clip to the target
+  x0 = std::max(x0, 0);
+  y0 = std::max(y0, 0);
+  x1 = std::min(x1, static_cast<int32_t>(m_width));
+  y1 = std::min(y1, static_cast<int32_t>(m_height));
+  if (x0 >= x1 || y0 >= y1) {
+    return 0;
+  }
+
+  auto slot = std::ranges::find(m_readbacks, uint64_t{0}, &Readback::request);
+  if (slot == m_readbacks.end()) {
+    return 0;
+  }
+
+  Readback& readback = *slot;
+  readback.request = m_nextRequest++;
+  readback.box = box;
+  readback.x = x0;
+  readback.y = y0;
+  readback.width = x1 - x0;
+  readback.height = y1 - y0;
+  readback.centerX = centerX;
+  readback.centerY = centerY;
+
+  // Two uint32 per pixel; buffers only grow
+  const size_t bytes = static_cast<size_t>(readback.width) * static_cast<size_t>(readback.height) * 2 *
+                       sizeof(uint32_t);
+  if (readback.pbo == 0) {
+    glGenBuffers(1, &readback.pbo);
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+  if (readback.capacity < bytes) {
+    glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_READ);
+    readback.capacity = bytes;
+  }
+
+  // The copy runs on the GPU timeline into the PBO, the fence tells when it has landed
+  GLint previousRead = 0;
+  glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousRead);
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, m_framebuffer);
+  glReadPixels(x0, y0, readback.width, readback.height, GL_RG_INTEGER, GL_UNSIGNED_INT, nullptr);
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(previousRead));
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  return readback.request;
+}
+
+void PickBufferOpenGL::poll(std::vector<PickResult>& results) {
+  // Fences signal in submission order, so stop at the first read that is still in flight
+  while (true) {
+    Readback* oldest = nullptr;
+    for (Readback& readback : m_readbacks) {
+      if (readback.request != 0 && (oldest == nullptr || readback.request < oldest->request)) {
+        oldest = &readback;
+      }
+    }
+    if (oldest == nullptr) {
+      return;
+    }
+
+    const GLenum status = glClientWaitSync(static_cast<GLsync>(oldest->fence), GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+      return;
+    }
+    glDeleteSync(static_cast<GLsync>(oldest->fence));
+    oldest->fence = nullptr;
+
+    PickResult& result = results.emplace_back();
+    result.request = oldest->request;
+    result.box = oldest->box;
+
+    const size_t bytes = static_cast<size_t>(oldest->width) * static_cast<size_t>(oldest->height) * 2 *
+                         sizeof(uint32_t);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, oldest->pbo);
+    const void* pixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(bytes), GL_MAP_READ_BIT);
+    if (pixels != nullptr) {
+      decode(*oldest, static_cast<const uint32_t*>(pixels), result);
+      glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    oldest->request = 0;
+  }
+}
+
+uint32_t PickBufferOpenGL::getPendingCount() const {
+  return static_cast<uint32_t>(
+      std::ranges::count_if(m_readbacks, [](const Readback& readback) { return readback.request != 0; }));
+}
+
+void PickBufferOpenGL::decode(const Readback& readback, const uint32_t* pixels, PickResult& result) {
+  int64_t nearestDistance = INT64_MAX;
+  PickHit previous;
+
+  for (int32_t row = 0; row < readback.height; ++row) {
+    for (int32_t column = 0; column < readback.width; ++column) {
+      const uint32_t* pixel = pixels + ((static_cast<size_t>(row) * readback.width + column) * 2);
+      if (pixel[0] == 0) {
+        continue;
+      }
+
+      PickHit hit;
+      hit.kind = pixel[1] == 0 ? PickKind::Node : PickKind::Edge;
+      hit.id = pixel[0] - 1;
+      hit.other = pixel[1] == 0 ? 0 : pixel[1] - 1;
+
+      // Runs of the same object are common, skip them before the final sort
+      if (hit != previous) {
+        result.hits.push_back(hit);
+        previous = hit;
+      }
+
+      if (!readback.box) {
+        const int64_t dx = readback.x + column - readback.centerX;
+        const int64_t dy = readback.y + row - readback.centerY;
+        const int64_t distance = (dx * dx) + (dy * dy);
+        if (distance < nearestDistance ||
+            (distance == nearestDistance && hit.kind == PickKind::Node && result.nearest.kind != PickKind::Node)) {
+          nearestDistance = distance;
+          result.nearest = hit;
+        }
+      }
+    }
+  }
+
+  std::ranges::sort(result.hits, [](const PickHit& a, const PickHit& b) { return sortKey(a) < sortKey(b); });
+  const auto duplicates = std::ranges::unique(result.hits);
+  result.hits.erase(duplicates.begin(), duplicates.end());
+}
+
+}  // namespace gfx
@@ -0,0 +1,353 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <imgui.h>
+
+#include <gfx/profiler_opengl.hpp>
+
+namespace gfx {
+
+namespace {
+
+constexpr std::array<const char*, static_cast<size_t>(ProfilePass::Count)> PASS_NAMES = {
+    "Clear", "Faces", "Edges", "Points", "Nodes", "2D primitives", "Uploads", "ImGui",
+};
+
+// Fraction of the frame interval a side must fill to count as the bottleneck
+constexpr double BOUND_THRESHOLD = 0.85;
+
+// Clear a profile for reuse, keeping the event storage
+void resetProfile(FrameProfile& profile) {
+  std::vector<ProfileEvent> events = std::move(profile.events);
+  events.clear();
+  profile = FrameProfile();
+  profile.events = std::move(events);
+}
+
+double gpuBusyMs(const FrameProfile& profile) {
+  double busy = 0.0;
+  for (const PassTiming& pass : profile.passes) {
+    busy += pass.gpuMs;
+  }
+  return busy;
+}
+
+}  // namespace
+
+const char* getPassName(ProfilePass pass) {
+  return pass < ProfilePass::Count ? PASS_NAMES[static_cast<size_t>(pass)] : "Unknown";
+}
+
+ProfilerOpenGL::ProfilerOpenGL()
+    : m_enabled(false),
+      m_inFrame(false),
+      m_frameIndex(0),
+      m_start(std::chrono::steady_clock::now()),
+      m_lastBeginUs(0.0),
+      m_gpuOffsetUs(0.0),
+      m_gpuOffsetValid(false),
+      m_history(HISTORY_SIZE),
+      m_historyStart(0),
+      m_historyCount(0) {}
+
+ProfilerOpenGL::~ProfilerOpenGL() { cleanup(); }
+
+void ProfilerOpenGL::cleanup() {
+  for (FrameSlot& slot : m_slots) {
+    if (!slot.queries.empty()) {
+      glDeleteQueries(static_cast<GLsizei>(slot.queries.size()), slot.queries.data());
+      slot.queries.clear();
+    }
+    slot.usedQueries = 0;
+    slot.scopes.clear();
+    slot.pending = false;
+  }
+  m_openScopes.clear();
+  m_inFrame = false;
+}
+
+void ProfilerOpenGL::setEnabled(bool enabled) {
+  if (!enabled && m_inFrame) {
+    endFrame();
+  }
+  m_enabled = enabled;
+}
+
+double ProfilerOpenGL::nowUs() const {
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - m_start).count();
+}
+
+uint32_t ProfilerOpenGL::acquireQuery(FrameSlot& slot) {
+  if (slot.usedQueries == slot.queries.size()) {
+    // Grow the pool of this slot, no per-frame allocations once it covers the busiest frame
+    const size_t grow = std::max<size_t>(32, slot.queries.size());
+    slot.queries.resize(slot.queries.size() + grow);
+    glGenQueries(static_cast<GLsizei>(grow), slot.queries.data() + slot.usedQueries);
+  }
+  const uint32_t query = slot.queries[slot.usedQueries++];
+  glQueryCounter(query, GL_TIMESTAMP);
+  return query;
+}
+
+void ProfilerOpenGL::beginFrame() {
+  if (!m_enabled) {
+    return;
+  }
+  if (m_inFrame) {
+    endFrame();
+  }
+
+  // The slot's previous frame was submitted FRAME_LATENCY frames ago
+  FrameSlot& slot = m_slots[m_frameIndex % FRAME_LATENCY];
+  if (slot.pending) {
+    resolve(slot);
+  }
+
+  if (!m_gpuOffsetValid) {
+    GLint64 gpuTime = 0;
+    glGetInteger64v(GL_TIMESTAMP, &gpuTime);
+    m_gpuOffsetUs = nowUs() - (static_cast<double>(gpuTime) / 1000.0);
+    m_gpuOffsetValid = true;
+  }
+
+  const double now = nowUs();
+  resetProfile(m_current);
+  m_current.frame = m_frameIndex;
+  m_current.beginUs = now;
+  m_current.intervalMs = m_lastBeginUs > 0.0 ? (now - m_lastBeginUs) / 1000.0 : 0.0;
+  m_lastBeginUs = now;
+
+  slot.usedQueries = 0;
+  slot.scopes.clear();
+  slot.frameBeginQuery = acquireQuery(slot);
+  m_inFrame = true;
+}
+
+void ProfilerOpenGL::endFrame() {
+  if (!m_inFrame) {
+    return;
+  }
+
+  // Scopes left open are closed at the end of the frame
+  while (!m_openScopes.empty()) {
+    endPass(m_openScopes.back().pass);
+  }
+
+  FrameSlot& slot = m_slots[m_frameIndex % FRAME_LATENCY];
+  slot.frameEndQuery = acquireQuery(slot);
+  m_current.cpuMs = (nowUs() - m_current.beginUs) / 1000.0;
+  for (const PendingScope& scope : slot.scopes) {
+    PassTiming& timing = m_current.passes[static_cast<size_t>(scope.pass)];
+    timing.cpuMs += (scope.cpuEnd - scope.cpuBegin) / 1000.0;
+    ++timing.scopes;
+  }
+
+  std::swap(slot.profile, m_current);
+  slot.pending = true;
+  m_inFrame = false;
+  ++m_frameIndex;
+}
+
+void ProfilerOpenGL::beginPass(ProfilePass pass) {
+  if (!m_inFrame) {
+    return;
+  }
+  FrameSlot& slot = m_slots[m_frameIndex % FRAME_LATENCY];
+  const double now = nowUs();
+  m_openScopes.push_back(PendingScope{pass, now, now, acquireQuery(slot), 0});
+}
+
+void ProfilerOpenGL::endPass(ProfilePass pass) {
+  if (!m_inFrame) {
+    return;
+  }
+
+  // Innermost open scope of this pass (scopes opened before enabling have none)
+  auto open = std::find_if(m_openScopes.rbegin(), m_openScopes.rend(),
+                           [pass](const PendingScope& scope) { return scope.pass == pass; });
+  if (open == m_openScopes.rend()) {
+    return;
+  }
+
+  FrameSlot& slot = m_slots[m_frameIndex % FRAME_LATENCY];
+  PendingScope scope = *open;
+  m_openScopes.erase(std::next(open).base());
+  scope.endQuery = acquireQuery(slot);
+  scope.cpuEnd = nowUs();
+  slot.scopes.push_back(scope);
+}
+
+void ProfilerOpenGL::resolve(FrameSlot& slot) {
+  FrameProfile& profile = slot.profile;
+
+  // Timestamps complete in order, so the frame's last query answers for all of them
+  GLint available = GL_FALSE;
+  glGetQueryObjectiv(slot.frameEndQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+  profile.gpuValid = available == GL_TRUE;
+
+  auto gpuUs = [&](uint32_t query) {
+    GLuint64 time = 0;
+    glGetQueryObjectui64v(query, GL_QUERY_RESULT, &time);
+    return (static_cast<double>(time) / 1000.0) + m_gpuOffsetUs;
+  };
+
+  if (profile.gpuValid) {
+    profile.gpuMs = (gpuUs(slot.frameEndQuery) - gpuUs(slot.frameBeginQuery)) / 1000.0;
+  }
+  for (const PendingScope& scope : slot.scopes) {
+    ProfileEvent event{scope.pass, scope.cpuBegin, scope.cpuEnd, 0.0, 0.0};
+    if (profile.gpuValid) {
+      event.gpuBegin = gpuUs(scope.beginQuery);
+      event.gpuEnd = gpuUs(scope.endQuery);
+      profile.passes[static_cast<size_t>(scope.pass)].gpuMs += (event.gpuEnd - event.gpuBegin) / 1000.0;
+    }
+    profile.events.push_back(event);
+  }
+
+  record(std::move(profile));
+  resetProfile(profile);
+  slot.pending = false;
+}
+
+void ProfilerOpenGL::record(FrameProfile&& profile) {
+  size_t index = 0;
+  if (m_historyCount < HISTORY_SIZE) {
+    index = (m_historyStart + m_historyCount) % HISTORY_SIZE;
+    ++m_historyCount;
+  } else {
+    index = m_historyStart;
+    m_historyStart = (m_historyStart + 1) % HISTORY_SIZE;
+  }
+  // Swap so the replaced entry's storage is recycled by the caller
+  std::swap(m_history[index], profile);
+}
+
+const FrameProfile& ProfilerOpenGL::getFrame(size_t index) const {
+  return m_history[(m_historyStart + index) % HISTORY_SIZE];
+}
+
+const FrameProfile* ProfilerOpenGL::getLatestFrame() const {
+  return m_historyCount > 0 ? &getFrame(m_historyCount - 1) : nullptr;
+}
+
+void ProfilerOpenGL::drawPanel() {
+  ImGui::Begin("Profiler");
+
+  bool enabled = m_enabled;
+  if (ImGui::Checkbox("Enabled", &enabled)) {
+    setEnabled(enabled);
+  }
+
+  const FrameProfile* latest = getLatestFrame();
+  if (latest == nullptr) {
+    ImGui::Text("No frames recorded yet");
+    ImGui::End();
+    return;
+  }
+
+  // Bottleneck of the latest frame: whichever side fills the frame interval
+  const double busy = gpuBusyMs(*latest);
+  const char* bound = "vsync / idle";
+  if (latest->gpuValid && busy > BOUND_THRESHOLD * latest->intervalMs) {
+    bound = "GPU";
+  } else if (latest->cpuMs > BOUND_THRESHOLD * latest->intervalMs) {
+    bound = "CPU";
+  }
+  ImGui::Text("Frame %.2f ms  CPU %.2f ms  GPU %.2f ms%s", latest->intervalMs, latest->cpuMs, busy,
+              latest->gpuValid ? "" : " (late)");
+  ImGui::Text("Bound: %s", bound);
+  ImGui::Text("Draw calls %u  vertices %llu  uploaded %.1f KB", latest->drawCalls,
+              static_cast<unsigned long long>(latest->vertices), static_cast<double>(latest->bytesUploaded) / 1024.0);
+
+  // Frame-time plots over the history
+  m_plotValues.resize(m_historyCount);
+  for (size_t i = 0; i < m_historyCount; ++i) {
+    m_plotValues[i] = static_cast<float>(getFrame(i).intervalMs);
+  }
+  const auto count = static_cast<int>(m_historyCount);
+  ImGui::PlotHistogram("Frame ms", m_plotValues.data(), count, 0, nullptr, 0.0f, 50.0f, ImVec2(0.0f, 60.0f));
+  for (size_t i = 0; i < m_historyCount; ++i) {
+    m_plotValues[i] = static_cast<float>(getFrame(i).cpuMs);
+  }
+  ImGui::PlotLines("CPU ms", m_plotValues.data(), count, 0, nullptr, 0.0f, 50.0f, ImVec2(0.0f, 40.0f));
+  for (size_t i = 0; i < m_historyCount; ++i) {
+    m_plotValues[i] = static_cast<float>(gpuBusyMs(getFrame(i)));
+  }
+  ImGui::PlotLines("GPU ms", m_plotValues.data(), count, 0, nullptr, 0.0f, 50.0f, ImVec2(0.0f, 40.0f));
+
+  if (ImGui::BeginTable("passes", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+    ImGui::TableSetupColumn("Pass");
+    ImGui::TableSetupColumn("CPU ms");
+    ImGui::TableSetupColumn("GPU ms");
+    ImGui::TableSetupColumn("Scopes");
+    ImGui::TableHeadersRow();
+    for (size_t p = 0; p < latest->passes.size(); ++p) {
+      const PassTiming& timing = latest->passes[p];
+      if (timing.scopes == 0) {
+        continue;
+      }
+      ImGui::TableNextRow();
+      ImGui::TableNextColumn();
+      ImGui::TextUnformatted(PASS_NAMES[p]);
+      ImGui::TableNextColumn();
+      ImGui::Text("%.3f", timing.cpuMs);
+      ImGui::TableNextColumn();
+      ImGui::Text("%.3f", timing.gpuMs);
+      ImGui::TableNextColumn();
+      ImGui::Text("%u", timing.scopes);
+    }
+    ImGui::EndTable();
+  }
+
+  if (ImGui::Button("Export Chrome trace")) {
+    exportChromeTrace("graph_lab_trace.json");
+  }
+
+  ImGui::End();
+}
+
+bool ProfilerOpenGL::exportChromeTrace(const std::string& path) const {
+  std::ofstream file(path, std::ios::trunc);
+  if (!file) {
+    return false;
+  }
+
+  // Complete ("X") events in microseconds, CPU on tid 1 and GPU on tid 2
+  file << "{\"traceEvents\":[\n";
+  file << R"({"name":"thread_name","ph":"M","pid":1,"tid":1,"args":{"name":"CPU"}},)" << '\n';
+  file << R"({"name":"thread_name","ph":"M","pid":1,"tid":2,"args":{"name":"GPU"}})";
+
+  auto event = [&](const char* name, int tid, double begin, double end) {
+    file << ",\n{\"name\":\"" << name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid << ",\"ts\":" << begin
+         << ",\"dur\":" << std::max(0.0, end - begin) << '}';
+  };
+
+  file.precision(3);
+  file << std::fixed;
+  for (size_t i = 0; i < m_historyCount; ++i) {
+    const FrameProfile& frame = getFrame(i);
+    event("Frame", 1, frame.beginUs, frame.beginUs + (frame.cpuMs * 1000.0));
+    for (const ProfileEvent& pass : frame.events) {
+      event(getPassName(pass.pass), 1, pass.cpuBegin, pass.cpuEnd);
+      if (frame.gpuValid) {
+        event(getPassName(pass.pass), 2, pass.gpuBegin, pass.gpuEnd);
+      }
+    }
+    file << ",\n{\"name\":\"Counters\",\"ph\":\"C\",\"pid\":1,\"ts\":" << frame.beginUs
+         << ",\"args\":{\"drawCalls\":" << frame.drawCalls << ",\"vertices\":" << frame.vertices
+         << ",\"bytesUploaded\":" << frame.bytesUploaded << "}}";
+  }
+  file << "\n]}\n";
+  return static_cast<bool>(file.flush());
+}
+
+}  // namespace gfx
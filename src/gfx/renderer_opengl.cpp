@@ -1,15 +1,19 @@
-#include <cmath>
+#include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
-#include <numbers>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <span>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
 #include <glm/glm.hpp>
-#include <glm/gtc/type_ptr.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/ext/matrix_clip_space.hpp>
 #include <glm/ext/matrix_float4x4.hpp>
@@ -18,9 +22,16 @@
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_opengl3.h>
 
+#include <gfx/framebuffer_opengl.hpp>
 #include <gfx/renderer_opengl.hpp>
+#include <gfx/shader_program_opengl.hpp>
+#include <gfx/vertex_layout_opengl.hpp>
 #include <gfx/window.hpp>
+#include <util/circle_geometry.hpp>
+#include <util/image.hpp>
 #include <util/types.hpp>
+#include <util/vertex_layout.hpp>
+#include <util/vertex_pack.hpp>
 
 namespace gfx {
 
@@ -75,22 +86,99 @@ void main() {
 }
 )";
 
+// Unit circle scaled and offset by a uniform, the geometry is static
+const std::string CIRCLE_VERTEX_SHADER = R"(
+#version 330 core
+layout (location = 0) in vec2 aUnit;
+
+uniform mat4 uProjection;
+uniform vec4 uCircle;
+
+void main() {
+    gl_Position = uProjection * vec4(uCircle.xy + aUnit * uCircle.z, 0.0, 1.0);
+}
+)";
+
+const std::string CIRCLE_FRAGMENT_SHADER = R"(
+#version 330 core
+out vec4 FragColor;
+
+uniform vec4 uTint;
+
+void main() {
+    FragColor = uTint;
+}
+)";
+
+// Instanced SDF circles: one quad per circle, the fragment shader evaluates the exact coverage
+const std::string SDF_CIRCLE_VERTEX_SHADER = R"(
+#version 330 core
+)" + AA_FRINGE_GLSL + R"(
+layout (location = 0) in vec2 aCorner;
+layout (location = 1) in vec4 aCircle;
+layout (location = 2) in vec4 aColor;
+
+uniform mat4 uProjection;
+
+out vec2 localPos;
+out vec4 vertexColor;
+flat out float radius;
+flat out float ringWidth;
+
+void main() {
+    radius = aCircle.z;
+    ringWidth = aCircle.w;
+
+    localPos = aCorner * (radius + AA_FRINGE);
+    gl_Position = uProjection * vec4(aCircle.xy + localPos, 0.0, 1.0);
+    vertexColor = aColor;
+}
+)";
+
+const std::string SDF_CIRCLE_FRAGMENT_SHADER = R"(
+#version 330 core
+in vec2 localPos;
+in vec4 vertexColor;
+flat in float radius;
+flat in float ringWidth;
+out vec4 FragColor;
+
+void main() {
+    // Signed distance in pixels to the disc, or to the band of ringWidth inside the radius
+    float dist = length(localPos) - radius;
+    if (ringWidth > 0.0) {
+        dist = abs(dist + 0.5 * ringWidth) - 0.5 * ringWidth;
+    }
+
+    float alpha = clamp(0.5 - dist, 0.0, 1.0);
+    if (alpha <= 0.0) {
+        discard;
+    }
+    FragColor = vec4(vertexColor.rgb, vertexColor.a * alpha);
+}
+)";
+
 RendererOpenGL::RendererOpenGL()
     : m_width(0),
       m_height(0),
       m_initialized(false),
       m_currentColor(1.0f, 1.0f, 1.0f, 1.0f),
       m_blendingEnabled(false),
-      m_basicShaderProgram(0),
-      m_lineShaderProgram(0),
-      m_quadVAO(0),
-      m_quadVBO(0),
-      m_lineVAO(0),
-      m_lineVBO(0),
-      m_triangleVAO(0),
-      m_triangleVBO(0),
+      m_circleLocation(-1),
+      m_circleVBO(0),
       m_circleVAO(0),
-      m_circleVBO(0) {}
+      m_circleFirsts{},
+      m_sdfQuadVBO(0),
+      m_sdfCircleVAO(0),
+      m_projection(1.0f),
+      m_projectionVersion(0),
+      m_streamVAO(0),
+      m_streamGeneration(0),
+      m_vertexFormat(VertexFormat::Float32),
+      m_onDemand(false),
+      m_redrawFrames(1),
+      m_idleTimeout(1.0),
+      m_batchingEnabled(false) {}
 
 RendererOpenGL::~RendererOpenGL() { cleanup(); }
 
@@ -106,16 +194,28 @@ bool RendererOpenGL::initialize(const Window& window, uint32_t width, uint32_t h
 
   m_width = width;
   m_height = height;
+  m_renderThread = std::this_thread::get_id();
+  updateProjection();
+
+  // The context starts in a known state, but derived code may have touched it already
+  m_state.invalidate();
+
+  // Let the driver compile on its own threads; begun programs then build concurrently
+  if (GLAD_GL_KHR_parallel_shader_compile) {
+    glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+  }
+  m_shaderCache.initialize(m_shaderCacheDirectory);
 
   // Load shaders
   if (!loadShaders()) {
     return false;
   }
 
-  // Setup geometry
-  setupQuadGeometry();
-  setupLineGeometry();
-  setupTriangleGeometry();
+  // Setup the streaming ring that all dynamic 2D paths write into
+  if (!m_streamBuffer.initialize(STREAM_REGION_SIZE)) {
+    return false;
+  }
+  setupStreamGeometry();
   setupCircleGeometry();
 
   // Enable blending by default
@@ -137,12 +237,23 @@ bool RendererOpenGL::initialize(const Window& window, uint32_t width, uint32_t h
 }
 
 void RendererOpenGL::setViewport(uint32_t width, uint32_t height) {
+  if (width != m_width || height != m_height) {
+    requestRedraw();
+  }
   m_width = width;
   m_height = height;
+  updateProjection();
   glViewport(0, 0, static_cast<int>(width), static_cast<int>(height));
 }
 
+void RendererOpenGL::updateProjection() {
+  // Bottom-left is (0,0), top-right is (width, height) - standard OpenGL convention
+  m_projection = glm::ortho(0.0f, static_cast<float>(m_width), 0.0f, static_cast<float>(m_height), -1.0f, 1.0f);
+  ++m_projectionVersion;
+}
+
 void RendererOpenGL::clear(const Color& color) {
+  ProfileScope scope(m_profiler, ProfilePass::Clear);
   glClearColor(color.r, color.g, color.b, color.a);
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
@@ -152,404 +263,534 @@ float RendererOpenGL::getFramerate() {
   return io.Framerate;
 }
 
+void RendererOpenGL::finish() { glFinish(); }
+
+void RendererOpenGL::setOnDemand(bool enabled) {
+  m_onDemand = enabled;
+  requestRedraw();
+}
+
+bool RendererOpenGL::waitForFrame(Window& window) {
+  if (!m_onDemand) {
+    window.pollEvents();
+    window.takeInput();
+    return true;
+  }
+
+  // Nothing changed: sleep until an event wakes the loop (or the timeout passes)
+  if (m_redrawFrames == 0) {
+    window.waitEvents(m_idleTimeout);
+  } else {
+    window.pollEvents();
+  }
+  if (window.takeInput()) {
+    requestRedraw(INPUT_REDRAW_FRAMES);
+  }
+  return m_redrawFrames > 0;
+}
+
+void RendererOpenGL::requestRedraw(uint32_t frames) { m_redrawFrames = std::max(m_redrawFrames, frames); }
+
 void RendererOpenGL::beginFrame() {
-  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+  // This frame draws the pending changes; changes made while it is built request the next one
+  if (m_redrawFrames > 0) {
+    --m_redrawFrames;
+  }
+  m_profiler.beginFrame();
+
+  // Make sure the GPU is done with the ring region this frame writes into
+  m_streamBuffer.beginFrame();
+
+  {
+    ProfileScope scope(m_profiler, ProfilePass::Clear);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+  }
   ImGui_ImplOpenGL3_NewFrame();
   ImGui_ImplGlfw_NewFrame();
   ImGui::NewFrame();
 }
 
 void RendererOpenGL::endFrame() {
+  // Submit deferred 2D primitives before the UI so ImGui stays on top
+  flushBatches();
+
+  // Hand landed reads to the capture worker, then record this frame without the UI
+  m_capture.poll();
+  if (m_capture.isRecording()) {
+    m_capture.captureFrame(m_width, m_height);
+  }
+
   // Render ImGui
-  ImGui::Render();
-  ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+  {
+    ProfileScope scope(m_profiler, ProfilePass::ImGui);
+    ImGui::Render();
+    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+  }
+
+  // The ImGui backend restores most of its state, but not through the cache
+  m_state.invalidate();
+
+  m_streamBuffer.endFrame();
+  m_profiler.endFrame();
+}
+
+bool RendererOpenGL::captureStill(const std::string& path, uint32_t width, uint32_t height,
+                                  const std::function<void(const glm::mat4&)>& draw) {
+  // Tiles as large as both renderbuffers and viewports allow
+  GLint maxRenderbufferSize = 0;
+  std::array<GLint, 2> maxViewport = {};
+  glGetIntegerv(GL_MAX_RENDERBUFFER_SIZE, &maxRenderbufferSize);
+  glGetIntegerv(GL_MAX_VIEWPORT_DIMS, maxViewport.data());
+  const auto tileSize = static_cast<uint32_t>(
+      std::clamp(std::min({maxRenderbufferSize, maxViewport[0], maxViewport[1]}), 1,
+                 static_cast<GLint>(MAX_STILL_TILE_SIZE)));
+
+  FramebufferOpenGL target;
+  if (!target.initialize(std::min(width, tileSize), std::min(height, tileSize)) ||
+      !m_capture.beginStill(path, width, height)) {
+    return false;
+  }
+
+  // Primitives of the current frame belong to the window, not the still
+  flushBatches();
+
+  const uint32_t viewportWidth = m_width;
+  const uint32_t viewportHeight = m_height;
+  const glm::mat4 projection =
+      glm::ortho(0.0f, static_cast<float>(width), 0.0f, static_cast<float>(height), -1.0f, 1.0f);
+  for (const ImageTile& tile : tileImage(width, height, tileSize)) {
+    target.bind();
+    m_width = tile.width;
+    m_height = tile.height;
+    glViewport(0, 0, static_cast<GLsizei>(tile.width), static_cast<GLsizei>(tile.height));
+    const glm::mat4 transform = tileTransform(width, height, tile);
+    m_projection = transform * projection;
+    ++m_projectionVersion;
+
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    draw(transform);
+    flushBatches();
+    m_capture.readTile(tile);
+  }
+
+  FramebufferOpenGL::unbind();
+  setViewport(viewportWidth, viewportHeight);
+  return true;
 }
 
 void RendererOpenGL::drawLine(float x1, float y1, float x2, float y2, const Color& color) {
+  if (m_batchingEnabled) {
+    m_batchLines.emplace_back(x1, y1, color);
+    m_batchLines.emplace_back(x2, y2, color);
+    return;
+  }
+
   useShader(m_lineShaderProgram);
   setUniformColor(m_lineShaderProgram, color);
   updateProjectionMatrix(m_lineShaderProgram);
 
   // Create line vertices
-  float vertices[] = {x1, y1, color.r, color.g, color.b, color.a, x2, y2, color.r, color.g, color.b, color.a};
-
-  glBindVertexArray(m_lineVAO);
-  glBindBuffer(GL_ARRAY_BUFFER, m_lineVBO);
-  glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
+  const Vertex2D vertices[] = {{x1, y1, color}, {x2, y2, color}};
 
-  glDrawArrays(GL_LINES, 0, 2);
-  glBindVertexArray(0);
+  drawStreamed(GL_LINES, vertices);
 }
 
 void RendererOpenGL::drawRectangle(float x, float y, float width, float height, const Color& color, bool filled) {
-  useShader(m_basicShaderProgram);
-  setUniformColor(m_basicShaderProgram, color);
-  updateProjectionMatrix(m_basicShaderProgram);
-
   // Create quad vertices (two triangles)
-  float vertices[] = {
-      x,         y,          color.r, color.g, color.b, color.a,  // bottom-left
-      x + width, y,          color.r, color.g, color.b, color.a,  // bottom-right
-      x,         y + height, color.r, color.g, color.b, color.a,  // top-left
-      x + width, y + height, color.r, color.g, color.b, color.a,  // top-right
-      x + width, y,          color.r, color.g, color.b, color.a,  // bottom-right
-      x,         y + height, color.r, color.g, color.b, color.a   // top-left
+  const Vertex2D vertices[] = {
+      {x, y, color},                   // bottom-left
+      {x + width, y, color},           // bottom-right
+      {x, y + height, color},          // top-left
+      {x + width, y + height, color},  // top-right
+      {x + width, y, color},           // bottom-right
+      {x, y + height, color}           // top-left
   };
 
-  glBindVertexArray(m_quadVAO);
-  glBindBuffer(GL_ARRAY_BUFFER, m_quadVBO);
-  glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
+  // Outline corners
+  const Vertex2D lineVertices[] = {
+      {x, y, color},                   // bottom-left
+      {x + width, y, color},           // bottom-right
+      {x + width, y + height, color},  // top-right
+      {x, y + height, color}           // top-left
+  };
 
-  if (filled) {
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-  } else {
-    // Draw as line loop for outline
-    float lineVertices[] = {
-        x,         y,          color.r, color.g, color.b, color.a,  // bottom-left
-        x + width, y,          color.r, color.g, color.b, color.a,  // bottom-right
-        x + width, y + height, color.r, color.g, color.b, color.a,  // top-right
-        x,         y + height, color.r, color.g, color.b, color.a   // top-left
-    };
-    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(lineVertices), lineVertices);
-    glDrawArrays(GL_LINE_LOOP, 0, 4);
+  if (m_batchingEnabled) {
+    if (filled) {
+      m_batchTriangles.insert(m_batchTriangles.end(), std::begin(vertices), std::end(vertices));
+    } else {
+      // Outline as four independent segments so it merges with other lines
+      for (int i = 0; i < 4; ++i) {
+        m_batchLines.push_back(lineVertices[i]);
+        m_batchLines.push_back(lineVertices[(i + 1) % 4]);
+      }
+    }
+    return;
   }
-  glBindVertexArray(0);
-}
 
-void RendererOpenGL::drawCircle(float centerX, float centerY, float radius, const Color& color, bool filled) {
   useShader(m_basicShaderProgram);
   setUniformColor(m_basicShaderProgram, color);
   updateProjectionMatrix(m_basicShaderProgram);
 
-  const int segments = 32;
-  std::vector<float> vertices;
-
   if (filled) {
-    // Center vertex
-    vertices.insert(vertices.end(), {centerX, centerY, color.r, color.g, color.b, color.a});
-
-    // Circle vertices
-    for (int i = 0; i <= segments; ++i) {
-      float angle = 2.0f * std::numbers::pi_v<float> * static_cast<float>(i) / static_cast<float>(segments);
-      float x = centerX + (radius * cosf(angle));
-      float y = centerY + (radius * sinf(angle));
-      vertices.insert(vertices.end(), {x, y, color.r, color.g, color.b, color.a});
-    }
+    drawStreamed(GL_TRIANGLES, vertices);
   } else {
-    // Line loop for outline
-    for (int i = 0; i <= segments; ++i) {
-      float angle = 2.0f * std::numbers::pi_v<float> * static_cast<float>(i) / static_cast<float>(segments);
-      float x = centerX + (radius * cosf(angle));
-      float y = centerY + (radius * sinf(angle));
-      vertices.insert(vertices.end(), {x, y, color.r, color.g, color.b, color.a});
+    // Draw as line loop for outline
+    drawStreamed(GL_LINE_LOOP, lineVertices);
+  }
+}
+
+void RendererOpenGL::drawCircle(float centerX, float centerY, float radius, const Color& color, bool filled) {
+  const uint32_t level = circleLevel(radius);
+
+  if (m_batchingEnabled) {
+    // Fans and loops cannot be merged, so emit independent triangles / segments
+    const std::span<const glm::vec2> unit = unitCircle(level);
+    const glm::vec2 center(centerX, centerY);
+    for (size_t i = 1; i < unit.size(); ++i) {
+      const glm::vec2 prev = center + (radius * unit[i - 1]);
+      const glm::vec2 next = center + (radius * unit[i]);
+      if (filled) {
+        m_batchTriangles.emplace_back(centerX, centerY, color);
+        m_batchTriangles.emplace_back(prev.x, prev.y, color);
+        m_batchTriangles.emplace_back(next.x, next.y, color);
+      } else {
+        m_batchLines.emplace_back(prev.x, prev.y, color);
+        m_batchLines.emplace_back(next.x, next.y, color);
+      }
     }
+    return;
   }
+  ProfileScope scope(m_profiler, ProfilePass::Primitives2D);
 
-  glBindVertexArray(m_circleVAO);
-  glBindBuffer(GL_ARRAY_BUFFER, m_circleVBO);
-  glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertices.size() * sizeof(float)), vertices.data(),
-               GL_DYNAMIC_DRAW);
+  useShader(m_circleShaderProgram);
+  setUniformColor(m_circleShaderProgram, color);
+  updateProjectionMatrix(m_circleShaderProgram);
+  ShaderProgramOpenGL::setUniform(m_circleLocation, glm::vec4(centerX, centerY, radius, 0.0f));
 
+  m_state.setEnabled(Capability::DepthTest, false);
+  m_state.setEnabled(Capability::CullFace, false);
+  m_state.setPolygonMode(GL_FILL);
+  applyBlending();
+
+  // Nothing is uploaded: the fan starts at the level's center vertex, the loop skips it (and the closing point)
+  const auto segments = static_cast<GLsizei>(circleSegments(level));
+  m_state.bindVertexArray(m_circleVAO);
   if (filled) {
-    glDrawArrays(GL_TRIANGLE_FAN, 0, segments + 2);
+    glDrawArrays(GL_TRIANGLE_FAN, m_circleFirsts[level], segments + 2);
   } else {
-    glDrawArrays(GL_LINE_LOOP, 0, segments + 1);
+    glDrawArrays(GL_LINE_LOOP, m_circleFirsts[level] + 1, segments);
+  }
+  m_profiler.countDraw(static_cast<uint64_t>(segments) + 2);
+}
+
+void RendererOpenGL::drawCircleSDF(float centerX, float centerY, float radius, const Color& color, float ringWidth) {
+  const CircleInstance circle{glm::vec2(centerX, centerY), radius, ringWidth, color};
+  if (m_batchingEnabled) {
+    m_batchCircles.push_back(circle);
+    return;
   }
-  glBindVertexArray(0);
+  drawCirclesStreamed(std::span<const CircleInstance>(&circle, 1));
 }
 
 void RendererOpenGL::drawTriangle(float x1, float y1, float x2, float y2, float x3, float y3, const Color& color,
                                   bool filled) {
+  const Vertex2D vertices[] = {{x1, y1, color}, {x2, y2, color}, {x3, y3, color}};
+
+  if (m_batchingEnabled) {
+    if (filled) {
+      m_batchTriangles.insert(m_batchTriangles.end(), std::begin(vertices), std::end(vertices));
+    } else {
+      for (int i = 0; i < 3; ++i) {
+        m_batchLines.push_back(vertices[i]);
+        m_batchLines.push_back(vertices[(i + 1) % 3]);
+      }
+    }
+    return;
+  }
+
   useShader(m_basicShaderProgram);
   setUniformColor(m_basicShaderProgram, color);
   updateProjectionMatrix(m_basicShaderProgram);
 
-  float vertices[] = {x1,      y1,      color.r, color.g, color.b, color.a, x2,      y2,      color.r,
-                      color.g, color.b, color.a, x3,      y3,      color.r, color.g, color.b, color.a};
-
-  glBindVertexArray(m_triangleVAO);
-  glBindBuffer(GL_ARRAY_BUFFER, m_triangleVBO);
-  glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-
-  if (filled) {
-    glDrawArrays(GL_TRIANGLES, 0, 3);
-  } else {
-    glDrawArrays(GL_LINE_LOOP, 0, 3);
-  }
-  glBindVertexArray(0);
+  drawStreamed(filled ? GL_TRIANGLES : GL_LINE_LOOP, vertices);
 }
 
 void RendererOpenGL::drawTriangles(const std::vector<Vertex2D>& vertices) {
+  if (m_batchingEnabled) {
+    m_batchTriangles.insert(m_batchTriangles.end(), vertices.begin(), vertices.end());
+    return;
+  }
+
   useShader(m_basicShaderProgram);
   setUniformColor(m_basicShaderProgram, m_currentColor);
   updateProjectionMatrix(m_basicShaderProgram);
 
-  std::vector<float> vertexData;
-  for (const auto& vertex : vertices) {
-    vertexData.insert(vertexData.end(), {vertex.position.x, vertex.position.y, vertex.color.r, vertex.color.g,
-                                         vertex.color.b, vertex.color.a});
-  }
-
-  glBindVertexArray(m_triangleVAO);
-  glBindBuffer(GL_ARRAY_BUFFER, m_triangleVBO);
-  glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertexData.size() * sizeof(float)), vertexData.data(),
-               GL_DYNAMIC_DRAW);
-
-  glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertices.size()));
-  glBindVertexArray(0);
+  drawStreamed(GL_TRIANGLES, vertices);
 }
 
 void RendererOpenGL::drawLines(const std::vector<Vertex2D>& vertices) {
+  if (m_batchingEnabled) {
+    m_batchLines.insert(m_batchLines.end(), vertices.begin(), vertices.end());
+    return;
+  }
+
   useShader(m_lineShaderProgram);
   setUniformColor(m_lineShaderProgram, m_currentColor);
   updateProjectionMatrix(m_lineShaderProgram);
 
-  std::vector<float> vertexData;
-  for (const auto& vertex : vertices) {
-    vertexData.insert(vertexData.end(), {vertex.position.x, vertex.position.y, vertex.color.r, vertex.color.g,
-                                         vertex.color.b, vertex.color.a});
-  }
-
-  glBindVertexArray(m_lineVAO);
-  glBindBuffer(GL_ARRAY_BUFFER, m_lineVBO);
-  glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertexData.size() * sizeof(float)), vertexData.data(),
-               GL_DYNAMIC_DRAW);
-
-  glDrawArrays(GL_LINES, 0, static_cast<GLsizei>(vertices.size()));
-  glBindVertexArray(0);
+  drawStreamed(GL_LINES, vertices);
 }
 
-void RendererOpenGL::setColor(const Color& color) { m_currentColor = color; }
-
-void RendererOpenGL::setBlending(bool enabled) {
-  m_blendingEnabled = enabled;
-  if (enabled) {
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-  } else {
-    glDisable(GL_BLEND);
+void RendererOpenGL::setColor(const Color& color) {
+  if (color != m_currentColor) {
+    requestRedraw();
   }
+  m_currentColor = color;
 }
 
-void RendererOpenGL::cleanup() {
-  if (!m_initialized) {
-    return;
+void RendererOpenGL::setBatching(bool enabled) {
+  if (m_batchingEnabled && !enabled) {
+    flushBatches();
   }
+  m_batchingEnabled = enabled;
+}
 
-  // Cleanup VAOs and VBOs
-  if (m_quadVAO) {
-    glDeleteVertexArrays(1, &m_quadVAO);
-  }
-  if (m_quadVBO) {
-    glDeleteBuffers(1, &m_quadVBO);
-  }
-  if (m_lineVAO) {
-    glDeleteVertexArrays(1, &m_lineVAO);
-  }
-  if (m_lineVBO) {
-    glDeleteBuffers(1, &m_lineVBO);
-  }
-  if (m_triangleVAO) {
-    glDeleteVertexArrays(1, &m_triangleVAO);
-  }
-  if (m_triangleVBO) {
-    glDeleteBuffers(1, &m_triangleVBO);
-  }
-  if (m_circleVAO) {
-    glDeleteVertexArrays(1, &m_circleVAO);
-  }
-  if (m_circleVBO) {
-    glDeleteBuffers(1, &m_circleVBO);
+void RendererOpenGL::setVertexFormat(VertexFormat format) {
+  if (format == m_vertexFormat) {
+    return;
   }
 
-  // Cleanup shaders
-  if (m_basicShaderProgram) {
-    glDeleteProgram(m_basicShaderProgram);
-  }
-  if (m_lineShaderProgram) {
-    glDeleteProgram(m_lineShaderProgram);
-  }
+  // Pending batches are packed at flush time, so submit them with the old layout first
+  flushBatches();
+  requestRedraw();
+  m_vertexFormat = format;
+  setupStreamGeometry();
+}
 
-  // Cleanup ImGui
-  ImGui_ImplOpenGL3_Shutdown();
-  ImGui_ImplGlfw_Shutdown();
-  ImGui::DestroyContext();
+void RendererOpenGL::flushBatches() {
+  // Filled primitives first, outlines and lines on top
+  submitBatch(m_basicShaderProgram, GL_TRIANGLES, m_batchTriangles);
+  drawCirclesStreamed(m_batchCircles);
+  submitBatch(m_lineShaderProgram, GL_LINES, m_batchLines);
 
-  m_initialized = false;
+  // clear() keeps capacity, so steady-state frames do not allocate
+  m_batchTriangles.clear();
+  m_batchLines.clear();
+  m_batchCircles.clear();
 }
 
-bool RendererOpenGL::loadShaders() {
-  // Load basic shader program
-  if (!createShaderProgram(BASIC_VERTEX_SHADER, BASIC_FRAGMENT_SHADER, m_basicShaderProgram)) {
-    return false;
+void RendererOpenGL::submitBatch(ShaderProgramOpenGL& program, uint32_t mode, const std::vector<Vertex2D>& vertices) {
+  if (vertices.empty()) {
+    return;
   }
 
-  // Load line shader program
-  if (!createShaderProgram(LINE_VERTEX_SHADER, LINE_FRAGMENT_SHADER, m_lineShaderProgram)) {
-    return false;
-  }
+  useShader(program);
+  setUniformColor(program, m_currentColor);
+  updateProjectionMatrix(program);
 
-  return true;
+  drawStreamed(mode, vertices);
 }
 
-bool RendererOpenGL::createShaderProgram(const std::string& vertexSource, const std::string& fragmentSource,
-                                         uint32_t& program) {
-  uint32_t vertexShader = 0;
-  uint32_t fragmentShader = 0;
-
-  // Compile vertex shader
-  if (!compileShader(vertexSource, GL_VERTEX_SHADER, vertexShader)) {
-    return false;
+void RendererOpenGL::drawStreamed(uint32_t mode, std::span<const Vertex2D> vertices) {
+  if (vertices.empty()) {
+    return;
   }
+  ProfileScope scope(m_profiler, ProfilePass::Primitives2D);
 
-  // Compile fragment shader
-  if (!compileShader(fragmentSource, GL_FRAGMENT_SHADER, fragmentShader)) {
-    glDeleteShader(vertexShader);
-    return false;
+  // Pack straight into the stream buffer in the selected vertex format
+  const size_t stride = vertexSize2D(m_vertexFormat);
+  StreamAllocation allocation = m_streamBuffer.allocate(vertices.size() * stride, stride);
+  if (!allocation.isValid()) {
+    return;
   }
+  packVertices2D(m_vertexFormat, vertices, allocation.data);
+  m_streamBuffer.commit();
 
-  // Create shader program
-  program = glCreateProgram();
-  glAttachShader(program, vertexShader);
-  glAttachShader(program, fragmentShader);
-  glLinkProgram(program);
-
-  // Check linking status
-  int success = 0;
-  glGetProgramiv(program, GL_LINK_STATUS, &success);
-  if (!success) {
-    char infoLog[512];
-    glGetProgramInfoLog(program, 512, nullptr, infoLog);
-    glDeleteProgram(program);
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-    return false;
+  // The ring may have been recreated with larger regions since the VAO was set up
+  if (m_streamGeneration != m_streamBuffer.getGeneration()) {
+    setupStreamGeometry();
   }
 
-  // Clean up individual shaders
-  glDeleteShader(vertexShader);
-  glDeleteShader(fragmentShader);
+  // 2D state; the mesh paths declare their own, so nothing is reset after a draw
+  m_state.setEnabled(Capability::DepthTest, false);
+  m_state.setEnabled(Capability::CullFace, false);
+  m_state.setPolygonMode(GL_FILL);
+  applyBlending();
 
-  return true;
+  m_state.bindVertexArray(m_streamVAO);
+  glDrawArrays(mode, static_cast<GLint>(allocation.offset / stride), static_cast<GLsizei>(vertices.size()));
+  m_profiler.countDraw(vertices.size());
+  m_profiler.countUpload(vertices.size() * stride);
 }
 
-bool RendererOpenGL::compileShader(const std::string& source, uint32_t type, uint32_t& shader) {
-  shader = glCreateShader(type);
-  const char* src = source.c_str();
-  glShaderSource(shader, 1, &src, nullptr);
-  glCompileShader(shader);
+void RendererOpenGL::drawCirclesStreamed(std::span<const CircleInstance> circles) {
+  if (circles.empty()) {
+    return;
+  }
+  ProfileScope scope(m_profiler, ProfilePass::Primitives2D);
 
-  // Check compilation status
-  int success = 0;
-  glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-  if (!success) {
-    char infoLog[512];
-    glGetShaderInfoLog(shader, 512, nullptr, infoLog);
-    glDeleteShader(shader);
-    return false;
+  const size_t offset = m_streamBuffer.write(circles.data(), circles.size_bytes(), sizeof(CircleInstance));
+  if (offset == SIZE_MAX) {
+    return;
   }
 
-  return true;
+  useShader(m_sdfCircleShaderProgram);
+  updateProjectionMatrix(m_sdfCircleShaderProgram);
+
+  // Blending is required for the antialiased edge
+  m_state.setEnabled(Capability::DepthTest, false);
+  m_state.setEnabled(Capability::CullFace, false);
+  m_state.setEnabled(Capability::Blend, true);
+  m_state.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  m_state.setPolygonMode(GL_FILL);
+
+  // GL 3.3 has no base instance, so the instance attributes are pointed at this allocation
+  m_state.bindVertexArray(m_sdfCircleVAO);
+  glBindBuffer(GL_ARRAY_BUFFER, m_streamBuffer.getBuffer());
+  pointVertexAttributes(CIRCLE_INSTANCE_ATTRIBUTES, sizeof(CircleInstance), offset);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(circles.size()));
+  m_profiler.countDraw(4 * static_cast<uint64_t>(circles.size()));
+  m_profiler.countUpload(circles.size_bytes());
 }
 
-void RendererOpenGL::setupQuadGeometry() {
-  glGenVertexArrays(1, &m_quadVAO);
-  glGenBuffers(1, &m_quadVBO);
+void RendererOpenGL::setBlending(bool enabled) {
+  if (enabled != m_blendingEnabled) {
+    requestRedraw();
+  }
+  m_blendingEnabled = enabled;
+  m_state.setEnabled(Capability::Blend, enabled);
+  if (enabled) {
+    m_state.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  }
+}
 
-  glBindVertexArray(m_quadVAO);
-  glBindBuffer(GL_ARRAY_BUFFER, m_quadVBO);
-  glBufferData(GL_ARRAY_BUFFER, 6 * 6 * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+void RendererOpenGL::cleanup() {
+  if (!m_initialized) {
+    return;
+  }
 
-  // Position attribute
-  glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 6 * sizeof(float), nullptr);
-  glEnableVertexAttribArray(0);
+  // Cleanup VAO and the streaming ring
+  if (m_streamVAO) {
+    m_state.forgetVertexArray(m_streamVAO);
+    glDeleteVertexArrays(1, &m_streamVAO);
+  }
+  m_streamBuffer.cleanup();
 
-  // Color attribute
-  glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, 6 * sizeof(float), reinterpret_cast<void*>(2 * sizeof(float)));
-  glEnableVertexAttribArray(1);
+  for (uint32_t* vao : {&m_circleVAO, &m_sdfCircleVAO}) {
+    if (*vao) {
+      m_state.forgetVertexArray(*vao);
+      glDeleteVertexArrays(1, vao);
+      *vao = 0;
+    }
+  }
+  for (uint32_t* buffer : {&m_circleVBO, &m_sdfQuadVBO}) {
+    if (*buffer) {
+      glDeleteBuffers(1, buffer);
+      *buffer = 0;
+    }
+  }
 
-  glBindVertexArray(0);
-}
+  // Cleanup shaders
+  for (ShaderProgramOpenGL* program :
+       {&m_basicShaderProgram, &m_lineShaderProgram, &m_circleShaderProgram, &m_sdfCircleShaderProgram}) {
+    m_state.forgetProgram(program->getId());
+    program->destroy();
+  }
 
-void RendererOpenGL::setupLineGeometry() {
-  glGenVertexArrays(1, &m_lineVAO);
-  glGenBuffers(1, &m_lineVBO);
+  m_capture.cleanup();
+  m_profiler.cleanup();
 
-  glBindVertexArray(m_lineVAO);
-  glBindBuffer(GL_ARRAY_BUFFER, m_lineVBO);
-  glBufferData(GL_ARRAY_BUFFER, 2 * 6 * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+  // Cleanup ImGui
+  ImGui_ImplOpenGL3_Shutdown();
+  ImGui_ImplGlfw_Shutdown();
+  ImGui::DestroyContext();
 
-  // Position attribute
-  glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 6 * sizeof(float), nullptr);
-  glEnableVertexAttribArray(0);
+  m_initialized = false;
+}
 
-  // Color attribute
-  constexpr size_t colorOffset = 2 * sizeof(float);
-  glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, 6 * sizeof(float), reinterpret_cast<const void*>(colorOffset));
-  glEnableVertexAttribArray(1);
+bool RendererOpenGL::loadShaders() {
+  // Basic, line and circle programs (static unit circles and instanced SDF quads), all begun before the
+  // first one is waited for
+  m_basicShaderProgram.beginCreate({BASIC_VERTEX_SHADER, BASIC_FRAGMENT_SHADER}, &m_shaderCache);
+  m_lineShaderProgram.beginCreate({LINE_VERTEX_SHADER, LINE_FRAGMENT_SHADER}, &m_shaderCache);
+  m_circleShaderProgram.beginCreate({CIRCLE_VERTEX_SHADER, CIRCLE_FRAGMENT_SHADER}, &m_shaderCache);
+  m_sdfCircleShaderProgram.beginCreate({SDF_CIRCLE_VERTEX_SHADER, SDF_CIRCLE_FRAGMENT_SHADER}, &m_shaderCache);
+
+  bool success = true;
+  for (ShaderProgramOpenGL* program :
+       {&m_basicShaderProgram, &m_lineShaderProgram, &m_circleShaderProgram, &m_sdfCircleShaderProgram}) {
+    success = program->finishCreate() && success;
+  }
+  if (!success) {
+    return false;
+  }
+  m_circleLocation = m_circleShaderProgram.getUniformLocation("uCircle");
 
-  glBindVertexArray(0);
+  return true;
 }
 
-void RendererOpenGL::setupTriangleGeometry() {
-  glGenVertexArrays(1, &m_triangleVAO);
-  glGenBuffers(1, &m_triangleVBO);
+void RendererOpenGL::setupStreamGeometry() {
+  if (m_streamVAO == 0) {
+    glGenVertexArrays(1, &m_streamVAO);
+  }
 
-  glBindVertexArray(m_triangleVAO);
-  glBindBuffer(GL_ARRAY_BUFFER, m_triangleVBO);
-  glBufferData(GL_ARRAY_BUFFER, 3 * 6 * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+  m_state.bindVertexArray(m_streamVAO);
+  glBindBuffer(GL_ARRAY_BUFFER, m_streamBuffer.getBuffer());
 
-  // Position attribute
-  glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 6 * sizeof(float), nullptr);
-  glEnableVertexAttribArray(0);
+  // Interleaved position and color (Float32 matches Vertex2D, so those vertices stream as they are)
+  applyVertexLayout(streamLayout2D(m_vertexFormat));
 
-  // Color attribute
-  constexpr size_t colorOffset = 2 * sizeof(float);
-  glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, 6 * sizeof(float), reinterpret_cast<const void*>(colorOffset));
-  glEnableVertexAttribArray(1);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-  glBindVertexArray(0);
+  m_streamGeneration = m_streamBuffer.getGeneration();
 }
 
 void RendererOpenGL::setupCircleGeometry() {
-  glGenVertexArrays(1, &m_circleVAO);
-  glGenBuffers(1, &m_circleVBO);
+  // Every level as (center, closed ring), built once from the shared unit circle tables
+  std::vector<glm::vec2> points;
+  for (uint32_t level = 0; level < CIRCLE_LEVEL_COUNT; ++level) {
+    const std::span<const glm::vec2> unit = unitCircle(level);
+    m_circleFirsts[level] = static_cast<int32_t>(points.size());
+    points.emplace_back(0.0f, 0.0f);
+    points.insert(points.end(), unit.begin(), unit.end());
+  }
 
-  glBindVertexArray(m_circleVAO);
+  glGenBuffers(1, &m_circleVBO);
   glBindBuffer(GL_ARRAY_BUFFER, m_circleVBO);
+  glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(points.size() * sizeof(glm::vec2)), points.data(),
+               GL_STATIC_DRAW);
 
-  // Position attribute
-  glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 6 * sizeof(float), nullptr);
-  glEnableVertexAttribArray(0);
-
-  // Color attribute
-  constexpr size_t colorOffset = 2 * sizeof(float);
-  glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, 6 * sizeof(float), reinterpret_cast<const void*>(colorOffset));
-  glEnableVertexAttribArray(1);
-
-  glBindVertexArray(0);
+  glGenVertexArrays(1, &m_circleVAO);
+  m_state.bindVertexArray(m_circleVAO);
+  applyVertexLayout(blockLayout<glm::vec2>(points.size()));
+
+  // SDF quad (triangle strip); the instance attributes are pointed at the stream ring per draw
+  const float corners[] = {-1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f};
+  glGenBuffers(1, &m_sdfQuadVBO);
+  glBindBuffer(GL_ARRAY_BUFFER, m_sdfQuadVBO);
+  glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+
+  glGenVertexArrays(1, &m_sdfCircleVAO);
+  m_state.bindVertexArray(m_sdfCircleVAO);
+  applyVertexLayout(blockLayout<glm::vec2>(4));
+  enableVertexAttributes(CIRCLE_INSTANCE_ATTRIBUTES, 1);
+
+  m_state.bindVertexArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
-void RendererOpenGL::useShader(uint32_t program) { glUseProgram(program); }
+void RendererOpenGL::useShader(const ShaderProgramOpenGL& program) { m_state.useProgram(program.getId()); }
 
-void RendererOpenGL::setUniformColor(uint32_t program, const Color& color) {
-  // Set the uniform tint color in the shader
-  int location = glGetUniformLocation(program, "uTint");
-  if (location != -1) {
-    glUniform4f(location, color.r, color.g, color.b, color.a);
-  }
+void RendererOpenGL::setUniformColor(ShaderProgramOpenGL& program, const Color& color) {
+  // Set the uniform tint color in the shader (skipped if unchanged)
+  program.setTint(color);
 }
 
-void RendererOpenGL::updateProjectionMatrix(uint32_t program) const {
-  // Create orthographic projection matrix using GLM
-  // Bottom-left is (0,0), top-right is (width, height) - standard OpenGL convention
-  glm::mat4 projection =
-      glm::ortho(0.0f, static_cast<float>(getWidth()), 0.0f, static_cast<float>(getHeight()), -1.0f, 1.0f);
-
-  int location = glGetUniformLocation(program, "uProjection");
-  if (location != -1) {
-    glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(projection));
-  }
+void RendererOpenGL::updateProjectionMatrix(ShaderProgramOpenGL& program) const {
+  // Only uploaded when the viewport changed since this program last saw it
+  program.setProjection(m_projection, m_projectionVersion);
 }
 
 }  // namespace gfx
@@ -0,0 +1,134 @@
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <gfx/shader_cache_opengl.hpp>
+#include <gfx/shader_program_opengl.hpp>
+
+namespace gfx {
+
+namespace {
+
+constexpr uint32_t SHADER_CACHE_VERSION = 1;
+
+struct ShaderCacheHeader {
+  char magic[8];  // "GLABPROG"
+  uint32_t version;
+  uint32_t binaryFormat;  // Driver format enum passed back to glProgramBinary
+  uint64_t key;           // Guards against renamed or truncated files
+  uint64_t size;          // Bytes of the binary after the header
+};
+
+constexpr char SHADER_CACHE_MAGIC[8] = {'G', 'L', 'A', 'B', 'P', 'R', 'O', 'G'};
+
+// FNV-1a, chained over the key parts; a zero byte after each part keeps ("ab", "c") apart from ("a", "bc")
+uint64_t hashBytes(uint64_t hash, std::string_view bytes) {
+  for (const char byte : bytes) {
+    hash = (hash ^ static_cast<uint8_t>(byte)) * 0x100000001B3ull;
+  }
+  return hash * 0x100000001B3ull;
+}
+
+std::string glString(GLenum name) {
+  const auto* value = reinterpret_cast<const char*>(glGetString(name));
+  return value != nullptr ? std::string(value) : std::string();
+}
+
+}  // namespace
+
+ShaderCacheOpenGL::ShaderCacheOpenGL() : m_enabled(false) {}
+
+bool ShaderCacheOpenGL::initialize(const std::string& directory) {
+  m_enabled = false;
+  if (directory.empty() || !GLAD_GL_ARB_get_program_binary) {
+    return false;
+  }
+
+  // Some drivers expose the entry points but no format that can be stored
+  GLint formats = 0;
+  glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+  if (formats <= 0) {
+    return false;
+  }
+
+  m_directory = directory;
+  m_driver = glString(GL_VENDOR) + '\n' + glString(GL_RENDERER) + '\n' + glString(GL_VERSION);
+  m_enabled = true;
+  return true;
+}
+
+uint64_t ShaderCacheOpenGL::getKey(const ShaderSources& sources) const {
+  uint64_t hash = hashBytes(0xCBF29CE484222325ull, m_driver);
+  hash = hashBytes(hash, sources.vertex);
+  hash = hashBytes(hash, sources.geometry);
+  hash = hashBytes(hash, sources.fragment);
+  for (const char* varying : sources.feedbackVaryings) {
+    hash = hashBytes(hash, varying);
+  }
+  return hash;
+}
+
+bool ShaderCacheOpenGL::load(uint64_t key, uint32_t program) const {
+  if (!m_enabled) {
+    return false;
+  }
+  std::ifstream file(getPath(key), std::ios::binary);
+  ShaderCacheHeader header{};
+  if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+      std::memcmp(header.magic, SHADER_CACHE_MAGIC, sizeof(header.magic)) != 0 ||
+      header.version != SHADER_CACHE_VERSION || header.key != key || header.size == 0) {
+    return false;
+  }
+  std::vector<char> binary(header.size);
+  if (!file.read(binary.data(), static_cast<std::streamsize>(binary.size()))) {
+    return false;
+  }
+
+  glProgramBinary(program, header.binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+  GLint success = GL_FALSE;
+  glGetProgramiv(program, GL_LINK_STATUS, &success);
+  return success == GL_TRUE;
+}
+
+void ShaderCacheOpenGL::store(uint64_t key, uint32_t program) const {
+  if (!m_enabled) {
+    return;
+  }
+  GLint length = 0;
+  glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0) {
+    return;
+  }
+  std::vector<char> binary(static_cast<size_t>(length));
+  GLenum binaryFormat = 0;
+  glGetProgramBinary(program, length, &length, &binaryFormat, binary.data());
+
+  // A failed write only costs the next start a compile
+  std::error_code error;
+  std::filesystem::create_directories(m_directory, error);
+  std::ofstream file(getPath(key), std::ios::binary | std::ios::trunc);
+  ShaderCacheHeader header{};
+  std::memcpy(header.magic, SHADER_CACHE_MAGIC, sizeof(header.magic));
+  header.version = SHADER_CACHE_VERSION;
+  header.binaryFormat = binaryFormat;
+  header.key = key;
+  header.size = static_cast<uint64_t>(length);
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(binary.data(), length);
+}
+
+std::string ShaderCacheOpenGL::getPath(uint64_t key) const {
+  char name[24] = {};
+  std::to_chars(name, name + sizeof(name), key, 16);
+  return (std::filesystem::path(m_directory) / (std::string(name) + ".bin")).string();
+}
+
+}  // namespace gfx
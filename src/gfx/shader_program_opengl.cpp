@@ -0,0 +1,252 @@
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <gfx/shader_cache_opengl.hpp>
+#include <gfx/shader_program_opengl.hpp>
+
+#include <util/glm.hpp>
+#include <util/types.hpp>
+
+namespace gfx {
+
+ShaderProgramOpenGL::ShaderProgramOpenGL()
+    : m_program(0),
+      m_tintLocation(-1),
+      m_mvpLocation(-1),
+      m_projectionLocation(-1),
+      m_tint(0.0f),
+      m_mvp(1.0f),
+      m_tintValid(false),
+      m_mvpValid(false),
+      m_projectionVersion(0),
+      m_cache(nullptr),
+      m_cacheKey(0),
+      m_pending(false),
+      m_cached(false) {}
+
+ShaderProgramOpenGL::~ShaderProgramOpenGL() { destroy(); }
+
+bool ShaderProgramOpenGL::create(const std::string& vertexSource, const std::string& fragmentSource,
+                                 std::span<const char* const> feedbackVaryings) {
+  beginCreate(ShaderSources{vertexSource, fragmentSource, {}, feedbackVaryings});
+  return finishCreate();
+}
+
+bool ShaderProgramOpenGL::create(const std::string& vertexSource, const std::string& geometrySource,
+                                 const std::string& fragmentSource) {
+  beginCreate(ShaderSources{vertexSource, fragmentSource, geometrySource, {}});
+  return finishCreate();
+}
+
+void ShaderProgramOpenGL::beginCreate(const ShaderSources& sources, const ShaderCacheOpenGL* cache) {
+  destroy();
+  m_program = glCreateProgram();
+  m_pending = true;
+  m_cache = cache != nullptr && cache->isEnabled() ? cache : nullptr;
+  m_cacheKey = m_cache != nullptr ? m_cache->getKey(sources) : 0;
+
+  // A cached binary replaces compile and link; the driver rejects binaries it can no longer load
+  m_cached = m_cache != nullptr && m_cache->load(m_cacheKey, m_program);
+  if (m_cached) {
+    return;
+  }
+
+  // Compile results are not queried here: that would wait for the compiler, failures show up at link time
+  const uint32_t shaders[] = {
+      compileShader(sources.vertex, GL_VERTEX_SHADER),
+      compileShader(sources.geometry, GL_GEOMETRY_SHADER),
+      compileShader(sources.fragment, GL_FRAGMENT_SHADER),
+  };
+  for (const uint32_t shader : shaders) {
+    if (shader != 0) {
+      glAttachShader(m_program, shader);
+    }
+  }
+  if (!sources.feedbackVaryings.empty()) {
+    glTransformFeedbackVaryings(m_program, static_cast<GLsizei>(sources.feedbackVaryings.size()),
+                                sources.feedbackVaryings.data(), GL_INTERLEAVED_ATTRIBS);
+  }
+  if (m_cache != nullptr) {
+    glProgramParameteri(m_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
+  glLinkProgram(m_program);
+
+  // Attached shaders are flagged for deletion and go away with the program
+  for (const uint32_t shader : shaders) {
+    if (shader != 0) {
+      glDeleteShader(shader);
+    }
+  }
+}
+
+bool ShaderProgramOpenGL::isCreateComplete() const {
+  if (!m_pending || m_cached || !GLAD_GL_KHR_parallel_shader_compile) {
+    return true;
+  }
+  int complete = GL_FALSE;
+  glGetProgramiv(m_program, GL_COMPLETION_STATUS_KHR, &complete);
+  return complete == GL_TRUE;
+}
+
+bool ShaderProgramOpenGL::finishCreate() {
+  if (!m_pending) {
+    return isValid();
+  }
+  m_pending = false;
+
+  // Check linking status (waits for the compiler if the program is still building)
+  int success = 0;
+  glGetProgramiv(m_program, GL_LINK_STATUS, &success);
+  if (!success) {
+    char infoLog[512];
+    glGetProgramInfoLog(m_program, 512, nullptr, infoLog);
+    glDeleteProgram(m_program);
+    m_program = 0;
+    return false;
+  }
+
+  if (m_cache != nullptr && !m_cached) {
+    m_cache->store(m_cacheKey, m_program);
+  }
+  resolveUniforms();
+  return true;
+}
+
+void ShaderProgramOpenGL::destroy() {
+  if (m_program) {
+    glDeleteProgram(m_program);
+    m_program = 0;
+  }
+  m_uniforms.clear();
+  m_tintLocation = -1;
+  m_mvpLocation = -1;
+  m_projectionLocation = -1;
+  m_tintValid = false;
+  m_mvpValid = false;
+  m_projectionVersion = 0;
+  m_cache = nullptr;
+  m_pending = false;
+  m_cached = false;
+}
+
+uint32_t ShaderProgramOpenGL::compileShader(std::string_view source, uint32_t type) {
+  if (source.empty()) {
+    return 0;
+  }
+  const uint32_t shader = glCreateShader(type);
+  const char* src = source.data();
+  const auto length = static_cast<GLint>(source.size());
+  glShaderSource(shader, 1, &src, &length);
+  glCompileShader(shader);
+  return shader;
+}
+
+void ShaderProgramOpenGL::resolveUniforms() {
+  int count = 0;
+  int maxLength = 0;
+  glGetProgramiv(m_program, GL_ACTIVE_UNIFORMS, &count);
+  glGetProgramiv(m_program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+  std::string name(static_cast<size_t>(maxLength), '\0');
+  for (int i = 0; i < count; ++i) {
+    GLsizei length = 0;
+    GLint size = 0;
+    GLenum type = 0;
+    glGetActiveUniform(m_program, static_cast<GLuint>(i), maxLength, &length, &size, &type, name.data());
+
+    // Arrays are reported as "name[0]", look them up by their base name
+    std::string uniformName = name.substr(0, static_cast<size_t>(length));
+    if (uniformName.ends_with("[0]")) {
+      uniformName.resize(uniformName.size() - 3);
+    }
+
+    const int location = glGetUniformLocation(m_program, uniformName.c_str());
+    if (location != -1) {
+      m_uniforms.emplace_back(std::move(uniformName), location);
+    }
+  }
+
+  m_tintLocation = getUniformLocation("uTint");
+  m_mvpLocation = getUniformLocation("uMVP");
+  m_projectionLocation = getUniformLocation("uProjection");
+}
+
+int ShaderProgramOpenGL::getUniformLocation(std::string_view name) const {
+  for (const auto& [uniformName, location] : m_uniforms) {
+    if (uniformName == name) {
+      return location;
+    }
+  }
+  return -1;
+}
+
+void ShaderProgramOpenGL::setUniform(int location, int value) {
+  if (location != -1) {
+    glUniform1i(location, value);
+  }
+}
+
+void ShaderProgramOpenGL::setUniform(int location, uint32_t value) {
+  if (location != -1) {
+    glUniform1ui(location, value);
+  }
+}
+
+void ShaderProgramOpenGL::setUniform(int location, float value) {
+  if (location != -1) {
+    glUniform1f(location, value);
+  }
+}
+
+void ShaderProgramOpenGL::setUniform(int location, const glm::vec2& value) {
+  if (location != -1) {
+    glUniform2f(location, value.x, value.y);
+  }
+}
+
+void ShaderProgramOpenGL::setUniform(int location, const glm::vec4& value) {
+  if (location != -1) {
+    glUniform4f(location, value.x, value.y, value.z, value.w);
+  }
+}
+
+void ShaderProgramOpenGL::setUniform(int location, const glm::mat4& value) {
+  if (location != -1) {
+    glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+  }
+}
+
+void ShaderProgramOpenGL::setTint(const util::Color& color) {
+  if (m_tintValid && m_tint == color) {
+    return;
+  }
+  setUniform(m_tintLocation, color);
+  m_tint = color;
+  m_tintValid = true;
+}
+
+void ShaderProgramOpenGL::setMVP(const glm::mat4& mvp) {
+  if (m_mvpValid && m_mvp == mvp) {
+    return;
+  }
+  setUniform(m_mvpLocation, mvp);
+  m_mvp = mvp;
+  m_mvpValid = true;
+}
+
+void ShaderProgramOpenGL::setProjection(const glm::mat4& projection, uint64_t version) {
+  if (m_projectionVersion == version) {
+    return;
+  }
+  setUniform(m_projectionLocation, projection);
+  m_projectionVersion = version;
+}
+
+}  // namespace gfx
@@ -0,0 +1,124 @@
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+#include <glad/glad.h>
+
+#include <gfx/state_cache_opengl.hpp>
+
+namespace gfx {
+
+namespace {
+
+constexpr GLenum CAPABILITIES[] = {GL_BLEND, GL_DEPTH_TEST, GL_CULL_FACE, GL_PROGRAM_POINT_SIZE};
+static_assert(std::size(CAPABILITIES) == static_cast<size_t>(Capability::Count));
+
+}  // namespace
+
+StateCacheOpenGL::StateCacheOpenGL() : m_issued(0), m_skipped(0) { invalidate(); }
+
+void StateCacheOpenGL::invalidate() {
+  m_program = UNKNOWN;
+  m_vao = UNKNOWN;
+  m_enabled.fill(-1);
+  m_blendSource = UNKNOWN;
+  m_blendDestination = UNKNOWN;
+  m_polygonMode = UNKNOWN;
+  m_lineWidth = -1.0f;
+  m_depthFunc = UNKNOWN;
+}
+
+bool StateCacheOpenGL::skip(bool redundant) {
+  if (redundant) {
+    ++m_skipped;
+  } else {
+    ++m_issued;
+  }
+  return redundant;
+}
+
+void StateCacheOpenGL::useProgram(uint32_t program) {
+  if (skip(m_program == program)) {
+    return;
+  }
+  glUseProgram(program);
+  m_program = program;
+}
+
+void StateCacheOpenGL::bindVertexArray(uint32_t vao) {
+  if (skip(m_vao == vao)) {
+    return;
+  }
+  glBindVertexArray(vao);
+  m_vao = vao;
+}
+
+void StateCacheOpenGL::forgetProgram(uint32_t program) {
+  // A deleted program stays in use until another one is installed, so just stop trusting it
+  if (m_program == program) {
+    m_program = UNKNOWN;
+  }
+}
+
+void StateCacheOpenGL::forgetVertexArray(uint32_t vao) {
+  if (m_vao == vao) {
+    m_vao = 0;
+  }
+}
+
+void StateCacheOpenGL::setEnabled(Capability capability, bool enabled) {
+  const auto index = static_cast<size_t>(capability);
+  if (skip(m_enabled[index] == static_cast<int8_t>(enabled))) {
+    return;
+  }
+  if (enabled) {
+    glEnable(CAPABILITIES[index]);
+  } else {
+    glDisable(CAPABILITIES[index]);
+  }
+  m_enabled[index] = static_cast<int8_t>(enabled);
+}
+
+void StateCacheOpenGL::setBlendFunc(uint32_t source, uint32_t destination) {
+  if (skip(m_blendSource == source && m_blendDestination == destination)) {
+    return;
+  }
+  glBlendFunc(source, destination);
+  m_blendSource = source;
+  m_blendDestination = destination;
+}
+
+void StateCacheOpenGL::setPolygonMode(uint32_t mode) {
+  if (skip(m_polygonMode == mode)) {
+    return;
+  }
+  glPolygonMode(GL_FRONT_AND_BACK, mode);
+  m_polygonMode = mode;
+}
+
+void StateCacheOpenGL::setLineWidth(float width) {
+  if (skip(m_lineWidth == width)) {
+    return;
+  }
+  glLineWidth(width);
+  m_lineWidth = width;
+}
+
+void StateCacheOpenGL::setDepthFunc(uint32_t func) {
+  if (skip(m_depthFunc == func)) {
+    return;
+  }
+  glDepthFunc(func);
+  m_depthFunc = func;
+}
+
+uint32_t StateCacheOpenGL::getDepthFunc() {
+  if (m_depthFunc == UNKNOWN) {
+    GLint func = GL_LESS;
+    glGetIntegerv(GL_DEPTH_FUNC, &func);
+    m_depthFunc = static_cast<uint32_t>(func);
+  }
+  return m_depthFunc;
+}
+
+}  // namespace gfx
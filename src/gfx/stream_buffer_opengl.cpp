@@ -0,0 +1,219 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <glad/glad.h>
+
+#include <gfx/stream_buffer_opengl.hpp>
+
+namespace gfx {
+
+namespace {
+
+inline size_t alignUp(size_t value, size_t alignment) { return ((value + alignment - 1) / alignment) * alignment; }
+
+}  // namespace
+
+StreamBufferOpenGL::StreamBufferOpenGL()
+    : m_buffer(0),
+      m_generation(0),
+      m_regionSize(0),
+      m_region(0),
+      m_head(0),
+      m_mapped(false),
+      m_persistentData(nullptr),
+      m_fences{} {}
+
+StreamBufferOpenGL::~StreamBufferOpenGL() { cleanup(); }
+
+bool StreamBufferOpenGL::initialize(size_t regionSize) {
+  if (m_buffer != 0) {
+    return false;
+  }
+  return createBuffer(regionSize);
+}
+
+void StreamBufferOpenGL::cleanup() { destroyBuffer(); }
+
+bool StreamBufferOpenGL::createBuffer(size_t regionSize) {
+  m_regionSize = regionSize;
+  m_region = 0;
+  m_head = 0;
+
+  const auto totalSize = static_cast<GLsizeiptr>(regionSize * REGION_COUNT);
+
+  glGenBuffers(1, &m_buffer);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+
+  // Immutable storage that stays mapped for the lifetime of the buffer
+  if (GLAD_GL_ARB_buffer_storage) {
+    constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glBufferStorage(GL_COPY_WRITE_BUFFER, totalSize, nullptr, flags);
+    m_persistentData = glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, totalSize, flags);
+
+    if (m_persistentData == nullptr) {
+      // Immutable storage cannot be respecified, start over with a mutable buffer
+      glDeleteBuffers(1, &m_buffer);
+      glGenBuffers(1, &m_buffer);
+      glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+    }
+  }
+
+  if (m_persistentData == nullptr) {
+    glBufferData(GL_COPY_WRITE_BUFFER, totalSize, nullptr, GL_STREAM_DRAW);
+  }
+
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+  ++m_generation;
+
+  return m_buffer != 0;
+}
+
+void StreamBufferOpenGL::destroyBuffer() {
+  if (m_buffer == 0) {
+    return;
+  }
+
+  for (uint32_t region = 0; region < REGION_COUNT; ++region) {
+    if (m_fences[region] != nullptr) {
+      glDeleteSync(static_cast<GLsync>(m_fences[region]));
+      m_fences[region] = nullptr;
+    }
+  }
+
+  if (m_persistentData != nullptr || m_mapped) {
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+    glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    m_persistentData = nullptr;
+    m_mapped = false;
+  }
+
+  glDeleteBuffers(1, &m_buffer);
+  m_buffer = 0;
+}
+
+void StreamBufferOpenGL::beginFrame() {
+  if (m_buffer == 0) {
+    return;
+  }
+  waitRegion(m_region);
+}
+
+void StreamBufferOpenGL::endFrame() {
+  if (m_buffer == 0) {
+    return;
+  }
+
+  commit();
+  fenceRegion();
+  m_region = (m_region + 1) % REGION_COUNT;
+  m_head = 0;
+
+  m_lastStats = m_stats;
+  m_stats = StreamStats();
+}
+
+StreamAllocation StreamBufferOpenGL::allocate(size_t bytes, size_t alignment) {
+  StreamAllocation allocation;
+  if (m_buffer == 0 || bytes == 0) {
+    return allocation;
+  }
+
+  commit();
+  alignment = alignment == 0 ? 1 : alignment;
+
+  // A single request larger than a region: recreate the ring with bigger regions
+  if (bytes + alignment > m_regionSize) {
+    for (uint32_t region = 0; region < REGION_COUNT; ++region) {
+      waitRegion(region);
+    }
+    const size_t regionSize = alignUp(std::max(bytes + alignment, m_regionSize * 2), 256);
+    destroyBuffer();
+    if (!createBuffer(regionSize)) {
+      return allocation;
+    }
+  }
+
+  size_t regionStart = m_region * m_regionSize;
+  size_t offset = alignUp(regionStart + m_head, alignment);
+
+  // Region exhausted mid-frame: fence it and continue in the next one
+  if (offset + bytes > regionStart + m_regionSize) {
+    fenceRegion();
+    m_region = (m_region + 1) % REGION_COUNT;
+    waitRegion(m_region);
+    regionStart = m_region * m_regionSize;
+    offset = alignUp(regionStart, alignment);
+  }
+
+  m_head = offset + bytes - regionStart;
+
+  if (m_persistentData != nullptr) {
+    allocation.data = static_cast<uint8_t*>(m_persistentData) + offset;
+  } else {
+    // The fence already guarantees the GPU is done with this range
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+    allocation.data = glMapBufferRange(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(offset),
+                                       static_cast<GLsizeiptr>(bytes),
+                                       GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    m_mapped = allocation.data != nullptr;
+  }
+  allocation.offset = offset;
+
+  m_stats.bytesStreamed += bytes;
+  ++m_stats.allocations;
+
+  return allocation;
+}
+
+void StreamBufferOpenGL::commit() {
+  if (!m_mapped) {
+    return;
+  }
+  glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+  glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+  m_mapped = false;
+}
+
+size_t StreamBufferOpenGL::write(const void* data, size_t bytes, size_t alignment) {
+  StreamAllocation allocation = allocate(bytes, alignment);
+  if (!allocation.isValid()) {
+    return SIZE_MAX;
+  }
+  std::memcpy(allocation.data, data, bytes);
+  commit();
+  return allocation.offset;
+}
+
+void StreamBufferOpenGL::fenceRegion() {
+  if (m_fences[m_region] != nullptr) {
+    glDeleteSync(static_cast<GLsync>(m_fences[m_region]));
+  }
+  m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void StreamBufferOpenGL::waitRegion(uint32_t region) {
+  auto fence = static_cast<GLsync>(m_fences[region]);
+  if (fence == nullptr) {
+    return;
+  }
+
+  // Poll first so that only real stalls are counted
+  GLenum result = glClientWaitSync(fence, 0, 0);
+  if (result == GL_TIMEOUT_EXPIRED) {
+    ++m_stats.fenceWaits;
+    constexpr GLuint64 timeoutNs = 1'000'000'000;
+    do {
+      result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeoutNs);
+    } while (result == GL_TIMEOUT_EXPIRED);
+  }
+
+  glDeleteSync(fence);
+  m_fences[region] = nullptr;
+}
+
+}  // namespace gfx
@@ -0,0 +1,52 @@
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <glad/glad.h>
+
+#include <gfx/vertex_layout_opengl.hpp>
+
+namespace gfx {
+
+using util::AttributeType;
+using util::VertexAttribute;
+
+namespace {
+
+GLenum glType(AttributeType type) {
+  switch (type) {
+    case AttributeType::Float16:
+      return GL_HALF_FLOAT;
+    case AttributeType::UNorm8:
+      return GL_UNSIGNED_BYTE;
+    case AttributeType::UInt32:
+      return GL_UNSIGNED_INT;
+    default:
+      return GL_FLOAT;
+  }
+}
+
+}  // namespace
+
+void pointVertexAttributes(std::span<const VertexAttribute> attributes, size_t elementStride, size_t baseOffset) {
+  for (const VertexAttribute& attribute : attributes) {
+    const auto stride = static_cast<GLsizei>(attribute.stride != 0 ? attribute.stride : elementStride);
+    const auto* offset = reinterpret_cast<const void*>(baseOffset + attribute.offset);
+    const auto components = static_cast<GLint>(attribute.components);
+    if (attribute.isInteger()) {
+      glVertexAttribIPointer(attribute.location, components, glType(attribute.type), stride, offset);
+    } else {
+      const GLboolean normalized = attribute.type == AttributeType::UNorm8 ? GL_TRUE : GL_FALSE;
+      glVertexAttribPointer(attribute.location, components, glType(attribute.type), normalized, stride, offset);
+    }
+  }
+}
+
+void enableVertexAttributes(std::span<const VertexAttribute> attributes, uint32_t divisor) {
+  for (const VertexAttribute& attribute : attributes) {
+    glEnableVertexAttribArray(attribute.location);
+    glVertexAttribDivisor(attribute.location, divisor);
+  }
+}
+
+}  // namespace gfx
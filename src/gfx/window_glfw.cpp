@@ -7,7 +7,14 @@
 
 namespace gfx {
 
-WindowGLFW::WindowGLFW() : m_window(nullptr), m_width(0), m_height(0), m_fullscreen(false), m_initialized(false) {}
+WindowGLFW::WindowGLFW()
+    : m_window(nullptr),
+      m_width(0),
+      m_height(0),
+      m_fullscreen(false),
+      m_initialized(false),
+      m_swapInterval(1),
+      m_inputPending(true) {}
 
 WindowGLFW::~WindowGLFW() { cleanup(); }
 
@@ -33,10 +40,11 @@ auto WindowGLFW::initialize(uint32_t width, uint32_t height, const std::string&
 
   glfwMakeContextCurrent(m_window);
 
-  // Enable V-Sync (not working in WSL2)
-  glfwSwapInterval(1);
+  // V-Sync by default, or the interval requested before initialization (not working in WSL2)
+  applySwapInterval();
 
   glfwSetWindowUserPointer(m_window, this);
+  installCallbacks();
 
   m_width = width;
   m_height = height;
@@ -53,6 +61,37 @@ void WindowGLFW::pollEvents() {
   }
 }
 
+void WindowGLFW::waitEvents(double timeoutSeconds) {
+  if (m_window != nullptr) {
+    glfwWaitEventsTimeout(timeoutSeconds);
+  }
+}
+
+void WindowGLFW::postEmptyEvent() { glfwPostEmptyEvent(); }
+
+bool WindowGLFW::takeInput() {
+  const bool input = m_inputPending;
+  m_inputPending = false;
+  return input;
+}
+
+void WindowGLFW::markInput(GLFWwindow* window) {
+  static_cast<WindowGLFW*>(glfwGetWindowUserPointer(window))->m_inputPending = true;
+}
+
+void WindowGLFW::installCallbacks() {
+  // Installed before the ImGui backend, which chains to them, so both see every event
+  glfwSetCursorPosCallback(m_window, [](GLFWwindow* window, double, double) { markInput(window); });
+  glfwSetCursorEnterCallback(m_window, [](GLFWwindow* window, int) { markInput(window); });
+  glfwSetMouseButtonCallback(m_window, [](GLFWwindow* window, int, int, int) { markInput(window); });
+  glfwSetScrollCallback(m_window, [](GLFWwindow* window, double, double) { markInput(window); });
+  glfwSetKeyCallback(m_window, [](GLFWwindow* window, int, int, int, int) { markInput(window); });
+  glfwSetCharCallback(m_window, [](GLFWwindow* window, unsigned int) { markInput(window); });
+  glfwSetWindowFocusCallback(m_window, [](GLFWwindow* window, int) { markInput(window); });
+  glfwSetWindowRefreshCallback(m_window, [](GLFWwindow* window) { markInput(window); });
+  glfwSetFramebufferSizeCallback(m_window, [](GLFWwindow* window, int, int) { markInput(window); });
+}
+
 void WindowGLFW::swapBuffers() {
   if (m_window != nullptr) {
     glfwSwapBuffers(m_window);
@@ -93,6 +132,27 @@ void WindowGLFW::setFullscreen(bool fullscreen) {
   }
 }
 
+bool WindowGLFW::setSwapInterval(int interval) {
+  m_swapInterval = interval;
+  return m_window == nullptr || applySwapInterval();
+}
+
+int WindowGLFW::getSwapInterval() const { return m_swapInterval; }
+
+bool WindowGLFW::applySwapInterval() {
+  glfwMakeContextCurrent(m_window);
+
+  // Negative intervals need the swap_control_tear extension of the platform
+  if (m_swapInterval < 0 && glfwExtensionSupported("WGL_EXT_swap_control_tear") == GLFW_FALSE &&
+      glfwExtensionSupported("GLX_EXT_swap_control_tear") == GLFW_FALSE) {
+    m_swapInterval = 1;
+    glfwSwapInterval(m_swapInterval);
+    return false;
+  }
+  glfwSwapInterval(m_swapInterval);
+  return true;
+}
+
 GLFWwindow* WindowGLFW::getNativeWindow() const { return m_window; }
 
 void WindowGLFW::cleanup() {
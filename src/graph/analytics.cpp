@@ -0,0 +1,444 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <graph/analytics.hpp>
+
+#include <util/glm.hpp>
+#include <util/graph.hpp>
+#include <util/thread_pool.hpp>
+
+namespace graph {
+
+namespace {
+
+constexpr size_t NODE_GRAIN = 1 << 12;
+constexpr size_t EDGE_GRAIN = 1 << 16;
+constexpr size_t FRONTIER_GRAIN = 256;  // Top-down BFS steps: frontier nodes per chunk
+
+// Direction switching (Beamer et al.): go bottom-up once the frontier's edges exceed 1 / ALPHA of the edges
+// still unexplored, back top-down once a shrinking frontier holds fewer than 1 / BETA of the nodes
+constexpr uint64_t BFS_ALPHA = 14;
+constexpr uint64_t BFS_BETA = 24;
+
+// Reduce body(chunkBegin, chunkEnd) over grain-sized chunks, combined in chunk order so the result does not
+// depend on the thread count or on which thread ran which chunk
+template <typename T, typename Body, typename Combine>
+T parallelReduce(util::ThreadPool& pool, size_t count, size_t grain, T init, const Body& body,
+                 const Combine& combine) {
+  std::vector<T> partials((count + grain - 1) / grain, init);
+  pool.parallelFor(0, count, grain, [&](size_t begin, size_t end) { partials[begin / grain] = body(begin, end); });
+  return std::accumulate(partials.begin(), partials.end(), init, combine);
+}
+
+// Adjacency of the reversed edges: in-neighbors of a directed graph
+util::Graph transposed(const util::Graph& graph, util::ThreadPool& pool) {
+  std::vector<util::Edge> reversed(graph.edges.size());
+  pool.parallelFor(0, reversed.size(), EDGE_GRAIN, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      reversed[i] = util::Edge(graph.edges[i].target, graph.edges[i].source);
+    }
+  });
+
+  util::GraphBuildOptions options;
+  options.directed = true;
+  options.removeSelfLoops = false;
+  options.sortNeighbors = false;
+  return util::Graph::fromValidEdges(graph.nodeCount(), std::move(reversed), {}, options, pool);
+}
+
+// Nodes at the given BFS depth in ascending order (stable compaction: count per chunk, prefix sum, copy)
+std::vector<uint32_t> collectLevel(const std::vector<uint32_t>& distances, uint32_t depth, util::ThreadPool& pool) {
+  std::vector<size_t> chunkOffsets(((distances.size() + NODE_GRAIN - 1) / NODE_GRAIN) + 1, 0);
+  pool.parallelFor(0, distances.size(), NODE_GRAIN, [&](size_t begin, size_t end) {
+    chunkOffsets[(begin / NODE_GRAIN) + 1] = static_cast<size_t>(
+        std::count(distances.begin() + static_cast<ptrdiff_t>(begin), distances.begin() + static_cast<ptrdiff_t>(end),
+                   depth));
+  });
+  std::partial_sum(chunkOffsets.begin(), chunkOffsets.end(), chunkOffsets.begin());
+
+  std::vector<uint32_t> level(chunkOffsets.back());
+  pool.parallelFor(0, distances.size(), NODE_GRAIN, [&](size_t begin, size_t end) {
+    size_t out = chunkOffsets[begin / NODE_GRAIN];
+    for (size_t i = begin; i < end; ++i) {
+      if (distances[i] == depth) {
+        level[out++] = static_cast<uint32_t>(i);
+      }
+    }
+  });
+  return level;
+}
+
+// Union-find root with path halving. Links only ever point from a larger to a smaller index, so every root
+// is the smallest node of its set and concurrent halving can only shorten chains; relaxed atomics suffice
+// because the values are plain indices and the loop's join publishes the final array.
+uint32_t findRoot(std::vector<uint32_t>& parents, uint32_t node) {
+  while (true) {
+    std::atomic_ref<uint32_t> link(parents[node]);
+    uint32_t parent = link.load(std::memory_order_relaxed);
+    const uint32_t grandparent = std::atomic_ref<uint32_t>(parents[parent]).load(std::memory_order_relaxed);
+    if (parent == grandparent) {
+      return parent;
+    }
+    link.compare_exchange_weak(parent, grandparent, std::memory_order_relaxed);
+    node = grandparent;
+  }
+}
+
+void unite(std::vector<uint32_t>& parents, uint32_t a, uint32_t b) {
+  while (true) {
+    a = findRoot(parents, a);
+    b = findRoot(parents, b);
+    if (a == b) {
+      return;
+    }
+    if (a < b) {
+      std::swap(a, b);
+    }
+    // Fails when another thread linked root a first, then retry from the new roots
+    uint32_t expected = a;
+    if (std::atomic_ref<uint32_t>(parents[a]).compare_exchange_strong(expected, b, std::memory_order_relaxed)) {
+      return;
+    }
+  }
+}
+
+// Range of the values for rescaling into [0, 1]
+std::pair<float, float> valueRange(std::span<const float> values, util::ThreadPool& pool) {
+  if (values.empty()) {
+    return {0.0f, 0.0f};
+  }
+  return parallelReduce(
+      pool, values.size(), NODE_GRAIN, std::pair<float, float>(values[0], values[0]),
+      [&](size_t begin, size_t end) {
+        const auto [low, high] = std::minmax_element(values.begin() + static_cast<ptrdiff_t>(begin),
+                                                     values.begin() + static_cast<ptrdiff_t>(end));
+        return std::pair<float, float>(*low, *high);
+      },
+      [](const std::pair<float, float>& a, const std::pair<float, float>& b) {
+        return std::pair<float, float>(std::min(a.first, b.first), std::max(a.second, b.second));
+      });
+}
+
+}  // namespace
+
+std::vector<float> degreeCentrality(const util::Graph& graph, util::ThreadPool& pool) {
+  const uint32_t nodeCount = graph.nodeCount();
+  std::vector<float> centrality(nodeCount, 0.0f);
+
+  const uint32_t maxDegree = parallelReduce(
+      pool, nodeCount, NODE_GRAIN, 0u,
+      [&](size_t begin, size_t end) {
+        uint32_t chunkMax = 0;
+        for (size_t v = begin; v < end; ++v) {
+          chunkMax = std::max(chunkMax, graph.degree(static_cast<uint32_t>(v)));
+        }
+        return chunkMax;
+      },
+      [](uint32_t a, uint32_t b) { return std::max(a, b); });
+  if (maxDegree == 0) {
+    return centrality;
+  }
+
+  const float scale = 1.0f / static_cast<float>(maxDegree);
+  pool.parallelFor(0, nodeCount, NODE_GRAIN, [&](size_t begin, size_t end) {
+    for (size_t v = begin; v < end; ++v) {
+      centrality[v] = static_cast<float>(graph.degree(static_cast<uint32_t>(v))) * scale;
+    }
+  });
+  return centrality;
+}
+
+std::vector<uint32_t> bfsDistances(const util::Graph& graph, uint32_t source, util::ThreadPool& pool) {
+  const uint32_t nodeCount = graph.nodeCount();
+  std::vector<uint32_t> distances(nodeCount, UNREACHED);
+  if (source >= nodeCount) {
+    return distances;
+  }
+
+  // Bottom-up steps look for parents among the in-neighbors, built on first use for directed graphs
+  util::Graph reverse;
+  const util::Graph* incoming = graph.directed ? nullptr : &graph;
+
+  distances[source] = 0;
+  std::vector<uint32_t> frontier = {source};
+  size_t frontierSize = 1;
+  size_t previousSize = 0;
+  uint64_t frontierEdges = graph.degree(source);
+  uint64_t unexploredEdges = graph.neighbors.size() - frontierEdges;
+  bool bottomUp = false;
+
+  for (uint32_t depth = 0; frontierSize > 0; ++depth) {
+    if (!bottomUp && frontierEdges > unexploredEdges / BFS_ALPHA) {
+      bottomUp = true;
+    } else if (bottomUp && frontierSize < previousSize && frontierSize < nodeCount / BFS_BETA) {
+      bottomUp = false;
+      frontier = collectLevel(distances, depth, pool);
+    }
+
+    using Counts = std::pair<size_t, uint64_t>;  // Nodes and edges of the next frontier
+    const auto add = [](const Counts& a, const Counts& b) { return Counts(a.first + b.first, a.second + b.second); };
+    Counts next;
+
+    if (bottomUp) {
+      if (incoming == nullptr) {
+        reverse = transposed(graph, pool);
+        incoming = &reverse;
+      }
+
+      // Every unvisited node claims itself, only nodes of the current depth are read, so no CAS is needed
+      next = parallelReduce(
+          pool, nodeCount, NODE_GRAIN, Counts(),
+          [&](size_t begin, size_t end) {
+            Counts counts;
+            for (size_t v = begin; v < end; ++v) {
+              std::atomic_ref<uint32_t> distance(distances[v]);
+              if (distance.load(std::memory_order_relaxed) != UNREACHED) {
+                continue;
+              }
+              for (const uint32_t u : incoming->neighborsOf(static_cast<uint32_t>(v))) {
+                if (std::atomic_ref<uint32_t>(distances[u]).load(std::memory_order_relaxed) == depth) {
+                  distance.store(depth + 1, std::memory_order_relaxed);
+                  counts.first += 1;
+                  counts.second += graph.degree(static_cast<uint32_t>(v));
+                  break;
+                }
+              }
+            }
+            return counts;
+          },
+          add);
+    } else {
+      // Each newly reached node is claimed by exactly one CAS, the claiming chunk lists it
+      std::vector<std::vector<uint32_t>> parts((frontier.size() + FRONTIER_GRAIN - 1) / FRONTIER_GRAIN);
+      next = parallelReduce(
+          pool, frontier.size(), FRONTIER_GRAIN, Counts(),
+          [&](size_t begin, size_t end) {
+            Counts counts;
+            std::vector<uint32_t>& part = parts[begin / FRONTIER_GRAIN];
+            for (size_t i = begin; i < end; ++i) {
+              for (const uint32_t w : graph.neighborsOf(frontier[i])) {
+                std::atomic_ref<uint32_t> distance(distances[w]);
+                uint32_t expected = UNREACHED;
+                if (distance.load(std::memory_order_relaxed) == UNREACHED &&
+                    distance.compare_exchange_strong(expected, depth + 1, std::memory_order_relaxed)) {
+                  part.push_back(w);
+                  counts.second += graph.degree(w);
+                }
+              }
+            }
+            counts.first = part.size();
+            return counts;
+          },
+          add);
+
+      frontier.clear();
+      frontier.reserve(next.first);
+      for (const std::vector<uint32_t>& part : parts) {
+        frontier.insert(frontier.end(), part.begin(), part.end());
+      }
+    }
+
+    previousSize = frontierSize;
+    frontierSize = next.first;
+    frontierEdges = next.second;
+    unexploredEdges -= std::min(unexploredEdges, frontierEdges);
+  }
+  return distances;
+}
+
+Components connectedComponents(const util::Graph& graph, util::ThreadPool& pool) {
+  const uint32_t nodeCount = graph.nodeCount();
+  Components components;
+  components.labels.resize(nodeCount);
+  if (nodeCount == 0) {
+    return components;
+  }
+
+  std::vector<uint32_t> parents(nodeCount);
+  std::iota(parents.begin(), parents.end(), 0u);
+  pool.parallelFor(0, graph.edges.size(), EDGE_GRAIN, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      unite(parents, graph.edges[i].source, graph.edges[i].target);
+    }
+  });
+
+  std::vector<uint32_t>& labels = components.labels;
+  pool.parallelFor(0, nodeCount, NODE_GRAIN, [&](size_t begin, size_t end) {
+    for (size_t v = begin; v < end; ++v) {
+      labels[v] = findRoot(parents, static_cast<uint32_t>(v));
+    }
+  });
+
+  // Dense ids in order of the roots (the smallest node of each component), stored at the roots
+  std::vector<uint32_t> chunkOffsets(((nodeCount + NODE_GRAIN - 1) / NODE_GRAIN) + 1, 0);
+  pool.parallelFor(0, nodeCount, NODE_GRAIN, [&](size_t begin, size_t end) {
+    uint32_t roots = 0;
+    for (size_t v = begin; v < end; ++v) {
+      roots += labels[v] == v ? 1 : 0;
+    }
+    chunkOffsets[(begin / NODE_GRAIN) + 1] = roots;
+  });
+  std::partial_sum(chunkOffsets.begin(), chunkOffsets.end(), chunkOffsets.begin());
+  components.count = chunkOffsets.back();
+
+  pool.parallelFor(0, nodeCount, NODE_GRAIN, [&](size_t begin, size_t end) {
+    uint32_t id = chunkOffsets[begin / NODE_GRAIN];
+    for (size_t v = begin; v < end; ++v) {
+      if (labels[v] == v) {
+        parents[v] = id++;
+      }
+    }
+  });
+  pool.parallelFor(0, nodeCount, NODE_GRAIN, [&](size_t begin, size_t end) {
+    for (size_t v = begin; v < end; ++v) {
+      labels[v] = parents[labels[v]];
+    }
+  });
+  return components;
+}
+
+std::vector<float> pageRank(const util::Graph& graph, const PageRankParams& params, util::ThreadPool& pool) {
+  const uint32_t nodeCount = graph.nodeCount();
+  if (nodeCount == 0) {
+    return {};
+  }
+
+  // Pull from in-neighbors: no atomics, every node writes only its own rank
+  util::Graph reverse;
+  if (graph.directed) {
+    reverse = transposed(graph, pool);
+  }
+  const util::Graph& incoming = graph.directed ? reverse : graph;
+
+  const auto n = static_cast<double>(nodeCount);
+  std::vector<float> ranks(nodeCount, static_cast<float>(1.0 / n));
+  std::vector<float> nextRanks(nodeCount, 0.0f);
+  std::vector<float> contributions(nodeCount, 0.0f);
+
+  for (uint32_t iteration = 0; iteration < params.maxIterations; ++iteration) {
+    const double dangling = parallelReduce(
+        pool, nodeCount, NODE_GRAIN, 0.0,
+        [&](size_t begin, size_t end) {
+          double sum = 0.0;
+          for (size_t u = begin; u < end; ++u) {
+            const uint32_t degree = graph.degree(static_cast<uint32_t>(u));
+            contributions[u] = degree > 0 ? ranks[u] / static_cast<float>(degree) : 0.0f;
+            sum += degree > 0 ? 0.0 : ranks[u];
+          }
+          return sum;
+        },
+        std::plus<>());
+
+    const double base = ((1.0 - params.damping) / n) + (params.damping * dangling / n);
+    const double change = parallelReduce(
+        pool, nodeCount, NODE_GRAIN, 0.0,
+        [&](size_t begin, size_t end) {
+          double sum = 0.0;
+          for (size_t v = begin; v < end; ++v) {
+            double pulled = 0.0;
+            for (const uint32_t u : incoming.neighborsOf(static_cast<uint32_t>(v))) {
+              pulled += contributions[u];
+            }
+            nextRanks[v] = static_cast<float>(base + (params.damping * pulled));
+            sum += std::abs(nextRanks[v] - ranks[v]);
+          }
+          return sum;
+        },
+        std::plus<>());
+
+    ranks.swap(nextRanks);
+    if (change < params.tolerance) {
+      break;
+    }
+  }
+  return ranks;
+}
+
+void colorByValue(std::span<const float> values, std::span<util::Color> colors, util::ThreadPool& pool) {
+  const size_t count = std::min(values.size(), colors.size());
+  const auto [low, high] = valueRange(values.first(count), pool);
+  const float scale = high > low ? 1.0f / (high - low) : 0.0f;
+
+  pool.parallelFor(0, count, NODE_GRAIN, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      colors[i] = rampColor((values[i] - low) * scale);
+    }
+  });
+}
+
+void colorByDistance(std::span<const uint32_t> distances, std::span<util::Color> colors,
+                     const util::Color& unreached, util::ThreadPool& pool) {
+  const size_t count = std::min(distances.size(), colors.size());
+  const uint32_t maxDistance = parallelReduce(
+      pool, count, NODE_GRAIN, 0u,
+      [&](size_t begin, size_t end) {
+        uint32_t chunkMax = 0;
+        for (size_t i = begin; i < end; ++i) {
+          chunkMax = distances[i] == UNREACHED ? chunkMax : std::max(chunkMax, distances[i]);
+        }
+        return chunkMax;
+      },
+      [](uint32_t a, uint32_t b) { return std::max(a, b); });
+  const float scale = maxDistance > 0 ? 1.0f / static_cast<float>(maxDistance) : 0.0f;
+
+  pool.parallelFor(0, count, NODE_GRAIN, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      colors[i] = distances[i] == UNREACHED ? unreached : rampColor(static_cast<float>(distances[i]) * scale);
+    }
+  });
+}
+
+void colorByCategory(std::span<const uint32_t> labels, std::span<util::Color> colors, util::ThreadPool& pool) {
+  const size_t count = std::min(labels.size(), colors.size());
+  pool.parallelFor(0, count, NODE_GRAIN, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      colors[i] = categoryColor(labels[i]);
+    }
+  });
+}
+
+void sizeByValue(std::span<const float> values, std::span<float> sizes, float minSize, float maxSize,
+                 util::ThreadPool& pool) {
+  const size_t count = std::min(values.size(), sizes.size());
+  const auto [low, high] = valueRange(values.first(count), pool);
+  const float scale = high > low ? (maxSize - minSize) / (high - low) : 0.0f;
+
+  pool.parallelFor(0, count, NODE_GRAIN, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      sizes[i] = minSize + ((values[i] - low) * scale);
+    }
+  });
+}
+
+util::Color rampColor(float t) {
+  // Samples of the viridis map
+  static const std::array<glm::vec3, 5> STOPS = {
+      glm::vec3(0.267f, 0.005f, 0.329f), glm::vec3(0.229f, 0.322f, 0.546f), glm::vec3(0.128f, 0.567f, 0.551f),
+      glm::vec3(0.369f, 0.789f, 0.383f), glm::vec3(0.993f, 0.906f, 0.144f)};
+
+  const float position = std::clamp(t, 0.0f, 1.0f) * static_cast<float>(STOPS.size() - 1);
+  const auto index = std::min(static_cast<size_t>(position), STOPS.size() - 2);
+  return util::Color(glm::mix(STOPS[index], STOPS[index + 1], position - static_cast<float>(index)), 1.0f);
+}
+
+util::Color categoryColor(uint32_t category) {
+  // Golden-ratio hue steps keep neighboring ids far apart on the color wheel, pastel enough for dark backgrounds
+  const double hue = std::fmod(static_cast<double>(category) * 0.6180339887498949, 1.0);
+  glm::vec3 rgb;
+  for (int channel = 0; channel < 3; ++channel) {
+    const double phase = std::fmod(hue + (1.0 - (channel / 3.0)), 1.0);
+    rgb[channel] = static_cast<float>(std::clamp(std::abs((phase * 6.0) - 3.0) - 1.0, 0.0, 1.0));
+  }
+  return util::Color(glm::mix(glm::vec3(1.0f), rgb, 0.65f) * 0.95f, 1.0f);
+}
+
+}  // namespace graph
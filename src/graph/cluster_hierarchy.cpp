@@ -0,0 +1,324 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <graph/cluster_hierarchy.hpp>
+
+#include <util/glm.hpp>
+#include <util/graph.hpp>
+#include <util/spatial_index.hpp>
+#include <util/thread_pool.hpp>
+
+namespace graph {
+
+namespace {
+
+constexpr uint32_t UNASSIGNED = 0xFFFFFFFFu;
+
+float slotWeight(const util::Graph& graph, uint32_t slot) {
+  return graph.weights.size() == graph.edges.size() ? graph.weights[graph.edgeIds[slot]] : 1.0f;
+}
+
+uint32_t membersOf(std::span<const uint32_t> members, uint32_t node) { return members.empty() ? 1 : members[node]; }
+
+// Member-weighted centroids of the super-nodes
+void aggregatePositions(const util::Graph& fine, std::span<const uint32_t> fineMembers, const ClusterLevel& level,
+                        std::vector<glm::vec3>& positions) {
+  positions.assign(level.memberCounts.size(), glm::vec3(0.0f));
+  for (uint32_t v = 0; v < fine.nodeCount(); ++v) {
+    positions[level.parents[v]] += fine.positions[v] * static_cast<float>(membersOf(fineMembers, v));
+  }
+  for (size_t c = 0; c < positions.size(); ++c) {
+    positions[c] /= static_cast<float>(level.memberCounts[c]);
+  }
+}
+
+}  // namespace
+
+ClusterHierarchy::ClusterHierarchy() : m_readyLevels(0), m_building(false), m_cancel(false) {}
+
+ClusterHierarchy::~ClusterHierarchy() { cancel(); }
+
+void ClusterHierarchy::build(const util::Graph& graph, const ClusterParams& params) {
+  start(graph, params);
+  buildLevels(params);
+}
+
+void ClusterHierarchy::buildAsync(const util::Graph& graph, const ClusterParams& params) {
+  start(graph, params);
+  m_thread = std::thread(&ClusterHierarchy::buildLevels, this, params);
+}
+
+void ClusterHierarchy::cancel() {
+  m_cancel.store(true, std::memory_order_relaxed);
+  if (m_thread.joinable()) {
+    m_thread.join();
+  }
+  m_cancel.store(false, std::memory_order_relaxed);
+}
+
+void ClusterHierarchy::start(const util::Graph& graph, const ClusterParams& params) {
+  cancel();
+
+  m_readyLevels.store(0, std::memory_order_relaxed);
+  m_levels.clear();
+  m_levels.resize(params.maxLevels);
+
+  // Matching needs both directions of every edge
+  if (graph.directed) {
+    util::GraphBuildOptions options;
+    options.directed = false;
+    m_base = util::Graph::fromEdges(graph.nodeCount(), graph.edges, graph.weights, options);
+  } else {
+    m_base = graph;
+  }
+
+  const uint32_t nodeCount = m_base.nodeCount();
+  m_base.positions = graph.positions;
+  m_base.colors = graph.colors;
+  m_base.sizes = graph.sizes;
+  m_base.positions.resize(nodeCount, glm::vec3(0.0f));
+  m_base.colors.resize(nodeCount, util::Color(1.0f, 1.0f, 1.0f, 1.0f));
+  m_base.sizes.resize(nodeCount, 1.0f);
+  m_bounds = util::computeBounds(m_base.positions);
+
+  m_building.store(true, std::memory_order_release);
+}
+
+void ClusterHierarchy::buildLevels(ClusterParams params) {
+  const util::Graph* fine = &m_base;
+  std::span<const uint32_t> fineMembers;
+
+  for (uint32_t level = 1; level <= params.maxLevels; ++level) {
+    if (m_cancel.load(std::memory_order_relaxed) || fine->nodeCount() <= params.minNodes) {
+      break;
+    }
+
+    std::unique_ptr<ClusterLevel> next = coarsen(*fine, fineMembers, params, level);
+    if (!next) {
+      break;
+    }
+
+    // Publish; readers only look at levels below the ready count
+    const ClusterLevel* published = next.get();
+    m_levels[level - 1] = std::move(next);
+    m_readyLevels.store(level, std::memory_order_release);
+
+    fine = &published->graph;
+    fineMembers = published->memberCounts;
+  }
+
+  m_building.store(false, std::memory_order_release);
+}
+
+std::unique_ptr<ClusterLevel> ClusterHierarchy::coarsen(const util::Graph& fine, std::span<const uint32_t> fineMembers,
+                                                        const ClusterParams& params, uint32_t level) {
+  const uint32_t n = fine.nodeCount();
+
+  std::vector<uint32_t> order(n);
+  std::iota(order.begin(), order.end(), 0u);
+  std::mt19937 rng(params.seed + level);
+  std::shuffle(order.begin(), order.end(), rng);
+
+  auto result = std::make_unique<ClusterLevel>();
+  std::vector<uint32_t>& cluster = result->parents;
+  std::vector<uint32_t>& members = result->memberCounts;
+  cluster.assign(n, UNASSIGNED);
+
+  // Heavy-edge matching: strongest connection relative to the size of both ends
+  for (uint32_t v : order) {
+    if (cluster[v] != UNASSIGNED) {
+      continue;
+    }
+    uint32_t best = UNASSIGNED;
+    float bestScore = 0.0f;
+    const auto neighbors = fine.neighborsOf(v);
+    for (uint32_t i = 0; i < neighbors.size(); ++i) {
+      const uint32_t u = neighbors[i];
+      if (u == v || cluster[u] != UNASSIGNED) {
+        continue;
+      }
+      const float score = slotWeight(fine, fine.offsets[v] + i) /
+                          static_cast<float>(membersOf(fineMembers, v) * membersOf(fineMembers, u));
+      if (score > bestScore) {
+        bestScore = score;
+        best = u;
+      }
+    }
+    if (best != UNASSIGNED) {
+      cluster[v] = cluster[best] = static_cast<uint32_t>(members.size());
+      members.push_back(membersOf(fineMembers, v) + membersOf(fineMembers, best));
+    }
+  }
+
+  // Unmatched nodes only have matched neighbors: join the strongest neighboring cluster
+  for (uint32_t v : order) {
+    if (cluster[v] != UNASSIGNED) {
+      continue;
+    }
+    uint32_t best = UNASSIGNED;
+    float bestScore = 0.0f;
+    const auto neighbors = fine.neighborsOf(v);
+    for (uint32_t i = 0; i < neighbors.size(); ++i) {
+      const uint32_t c = cluster[neighbors[i]];
+      if (c == UNASSIGNED) {
+        continue;
+      }
+      const float score = slotWeight(fine, fine.offsets[v] + i) / static_cast<float>(members[c]);
+      if (score > bestScore) {
+        bestScore = score;
+        best = c;
+      }
+    }
+    if (best != UNASSIGNED) {
+      cluster[v] = best;
+      members[best] += membersOf(fineMembers, v);
+    } else {
+      // Isolated node stays on its own
+      cluster[v] = static_cast<uint32_t>(members.size());
+      members.push_back(membersOf(fineMembers, v));
+    }
+  }
+
+  const auto clusterCount = static_cast<uint32_t>(members.size());
+  if (static_cast<float>(clusterCount) > (1.0f - params.minReduction) * static_cast<float>(n)) {
+    return nullptr;
+  }
+
+  // Bundle the edges between each pair of clusters, weights summed
+  const bool weighted = fine.weights.size() == fine.edges.size();
+  std::vector<std::pair<uint64_t, float>> keyed;
+  keyed.reserve(fine.edges.size());
+  for (size_t e = 0; e < fine.edges.size(); ++e) {
+    const uint32_t a = cluster[fine.edges[e].source];
+    const uint32_t b = cluster[fine.edges[e].target];
+    if (a == b) {
+      continue;
+    }
+    const uint64_t key = (static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+    keyed.emplace_back(key, weighted ? fine.weights[e] : 1.0f);
+  }
+  std::sort(keyed.begin(), keyed.end(), [](const auto& x, const auto& y) { return x.first < y.first; });
+
+  std::vector<util::Edge> edges;
+  std::vector<float> weights;
+  for (const auto& [key, weight] : keyed) {
+    if (!edges.empty() && ((static_cast<uint64_t>(edges.back().source) << 32) | edges.back().target) == key) {
+      weights.back() += weight;
+    } else {
+      edges.emplace_back(static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key));
+      weights.push_back(weight);
+    }
+  }
+
+  // Serial build, the background thread must not compete with the frame for the shared pool
+  util::ThreadPool serial(1);
+  result->graph = util::Graph::fromEdges(clusterCount, edges, weights, util::GraphBuildOptions(), serial);
+  util::Graph& coarse = result->graph;
+
+  // Member-weighted mean colors, sizes preserve the summed node area
+  coarse.colors.assign(clusterCount, util::Color(0.0f));
+  coarse.sizes.assign(clusterCount, 0.0f);
+  for (uint32_t v = 0; v < n; ++v) {
+    const auto weight = static_cast<float>(membersOf(fineMembers, v));
+    coarse.colors[cluster[v]] += fine.colors[v] * weight;
+    coarse.sizes[cluster[v]] += fine.sizes[v] * fine.sizes[v];
+  }
+  for (uint32_t c = 0; c < clusterCount; ++c) {
+    coarse.colors[c] /= static_cast<float>(members[c]);
+    coarse.sizes[c] = std::sqrt(coarse.sizes[c]);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_positionMutex);
+    aggregatePositions(fine, fineMembers, *result, coarse.positions);
+  }
+
+  return result;
+}
+
+uint32_t ClusterHierarchy::getNodeCount(uint32_t level) const {
+  return level == 0 ? m_base.nodeCount() : getLevel(level).graph.nodeCount();
+}
+
+uint32_t ClusterHierarchy::getEdgeCount(uint32_t level) const {
+  return level == 0 ? m_base.edgeCount() : getLevel(level).graph.edgeCount();
+}
+
+void ClusterHierarchy::updatePositions(std::span<const glm::vec3> positions) {
+  if (positions.size() != m_base.nodeCount()) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(m_positionMutex);
+  std::copy(positions.begin(), positions.end(), m_base.positions.begin());
+  m_bounds = util::computeBounds(positions);
+
+  // Bottom-up, every level from the one below
+  const util::Graph* fine = &m_base;
+  std::span<const uint32_t> fineMembers;
+  const uint32_t ready = getLevelCount();
+  for (uint32_t level = 1; level <= ready; ++level) {
+    ClusterLevel& coarse = *m_levels[level - 1];
+    aggregatePositions(*fine, fineMembers, coarse, coarse.graph.positions);
+    fine = &coarse.graph;
+    fineMembers = coarse.memberCounts;
+  }
+}
+
+uint32_t ClusterHierarchy::selectLevel(const glm::mat4& mvp, const glm::vec2& viewport, const LodParams& params) const {
+  const uint32_t ready = getLevelCount();
+  if (ready == 0 || !m_bounds.isValid()) {
+    return 0;
+  }
+
+  // Screen rectangle of the projected bounds (NDC), a corner behind the camera counts as full screen
+  glm::vec2 ndcMin(std::numeric_limits<float>::max());
+  glm::vec2 ndcMax(std::numeric_limits<float>::lowest());
+  bool behind = false;
+  for (uint32_t corner = 0; corner < 8; ++corner) {
+    const glm::vec3 p((corner & 1) ? m_bounds.max.x : m_bounds.min.x, (corner & 2) ? m_bounds.max.y : m_bounds.min.y,
+                      (corner & 4) ? m_bounds.max.z : m_bounds.min.z);
+    const glm::vec4 clip = mvp * glm::vec4(p, 1.0f);
+    if (clip.w <= 1e-6f) {
+      behind = true;
+      break;
+    }
+    const glm::vec2 ndc(clip.x / clip.w, clip.y / clip.w);
+    ndcMin = glm::min(ndcMin, ndc);
+    ndcMax = glm::max(ndcMax, ndc);
+  }
+  if (behind) {
+    ndcMin = glm::vec2(-1.0f);
+    ndcMax = glm::vec2(1.0f);
+  }
+
+  // Pixel areas of the whole projection and of its visible part
+  const glm::vec2 pixelsPerNdc = 0.5f * viewport;
+  const glm::vec2 size = (ndcMax - ndcMin) * pixelsPerNdc;
+  const glm::vec2 visible =
+      (glm::min(ndcMax, glm::vec2(1.0f)) - glm::max(ndcMin, glm::vec2(-1.0f))) * pixelsPerNdc;
+  const float area = std::max(size.x, 1.0f) * std::max(size.y, 1.0f);
+  const float visibleArea = std::max(visible.x, 0.0f) * std::max(visible.y, 0.0f);
+  const float visibleFraction = std::min(visibleArea / area, 1.0f);
+
+  for (uint32_t level = 0; level <= ready; ++level) {
+    const auto edges = static_cast<float>(getEdgeCount(level));
+    if (edges / area <= params.maxEdgesPerPixel && edges * visibleFraction <= static_cast<float>(params.edgeBudget)) {
+      return level;
+    }
+  }
+  return ready;
+}
+
+}  // namespace graph
@@ -0,0 +1,407 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <graph/force_layout.hpp>
+
+#include <util/glm.hpp>
+#include <util/graph.hpp>
+#include <util/thread_pool.hpp>
+
+namespace graph {
+
+namespace {
+
+constexpr size_t NODE_GRAIN = 1024;
+
+// Squared distance below which two nodes count as coincident
+constexpr float MIN_DISTANCE_SQUARED = 1e-12f;
+
+}  // namespace
+
+std::vector<glm::vec3> initialPositions(const util::Graph& graph, const LayoutParams& params) {
+  const uint32_t nodeCount = graph.nodeCount();
+  const bool planar = params.dimensions != 3;
+  std::vector<glm::vec3> positions(nodeCount, glm::vec3(0.0f));
+
+  bool placed = false;
+  if (graph.positions.size() == nodeCount) {
+    for (uint32_t i = 0; i < nodeCount; ++i) {
+      positions[i] = glm::vec3(graph.positions[i].x, graph.positions[i].y, planar ? 0.0f : graph.positions[i].z);
+      placed = placed || positions[i] != glm::vec3(0.0f);
+    }
+  }
+  if (placed) {
+    return positions;
+  }
+
+  // Random start with roughly one springLength between neighbors
+  const auto n = static_cast<float>(nodeCount);
+  const float extent = params.springLength * (planar ? std::sqrt(n) : std::cbrt(n));
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> dist(-0.5f * extent, 0.5f * extent);
+  for (uint32_t i = 0; i < nodeCount; ++i) {
+    positions[i].x = dist(rng);
+    positions[i].y = dist(rng);
+    positions[i].z = planar ? 0.0f : dist(rng);
+  }
+  return positions;
+}
+
+float initialTemperature(const LayoutParams& params, uint32_t nodeCount) {
+  return 0.1f * params.springLength * std::sqrt(static_cast<float>(nodeCount));
+}
+
+ForceLayout::ForceLayout() : m_graph(nullptr), m_pool(nullptr), m_iteration(0), m_temperature(0.0f) {}
+
+bool ForceLayout::initialize(const util::Graph& graph, const LayoutParams& params, util::ThreadPool& pool) {
+  const uint32_t nodeCount = graph.nodeCount();
+  if (nodeCount == 0) {
+    return false;
+  }
+
+  m_graph = &graph;
+  m_pool = &pool;
+  m_params = params;
+  m_params.dimensions = params.dimensions == 3 ? 3 : 2;
+
+  // Forces act on both endpoints, a directed graph needs the reverse slots too
+  if (graph.directed) {
+    util::GraphBuildOptions options;
+    options.directed = false;
+    m_undirected = util::Graph::fromEdges(nodeCount, graph.edges, graph.weights, options, pool);
+  } else {
+    m_undirected = util::Graph();
+  }
+
+  m_x.assign(nodeCount, 0.0f);
+  m_y.assign(nodeCount, 0.0f);
+  m_z.assign(nodeCount, 0.0f);
+  m_dx.assign(nodeCount, 0.0f);
+  m_dy.assign(nodeCount, 0.0f);
+  m_dz.assign(nodeCount, 0.0f);
+  m_sortedX.resize(nodeCount);
+  m_sortedY.resize(nodeCount);
+  m_sortedZ.resize(nodeCount);
+  m_order.resize(nodeCount);
+  m_scratch.resize(nodeCount);
+  m_positions.resize(nodeCount);
+
+  const std::vector<glm::vec3> start = initialPositions(graph, m_params);
+  for (uint32_t i = 0; i < nodeCount; ++i) {
+    m_x[i] = start[i].x;
+    m_y[i] = start[i].y;
+    m_z[i] = start[i].z;
+    m_positions[i] = start[i];
+  }
+
+  m_iteration = 0;
+  reheat();
+  return true;
+}
+
+void ForceLayout::reheat() { m_temperature = initialTemperature(m_params, getNodeCount()); }
+
+void ForceLayout::writePositions(util::Graph& graph) const {
+  if (graph.positions.size() == m_positions.size()) {
+    std::copy(m_positions.begin(), m_positions.end(), graph.positions.begin());
+  }
+}
+
+const util::Graph& ForceLayout::adjacency() const { return m_graph->directed ? m_undirected : *m_graph; }
+
+void ForceLayout::step(uint32_t iterations) {
+  if (m_graph == nullptr) {
+    return;
+  }
+  for (uint32_t i = 0; i < iterations; ++i) {
+    iterate();
+  }
+}
+
+void ForceLayout::iterate() {
+  const size_t nodeCount = m_x.size();
+
+  buildTree();
+
+  // Forces for all nodes from the current positions, then move everyone at once
+  m_pool->parallelFor(0, nodeCount, NODE_GRAIN, [this](size_t begin, size_t end) { accumulateRepulsion(begin, end); });
+  m_pool->parallelFor(0, nodeCount, NODE_GRAIN, [this](size_t begin, size_t end) { accumulateAttraction(begin, end); });
+  m_pool->parallelFor(0, nodeCount, NODE_GRAIN, [this](size_t begin, size_t end) { integrate(begin, end); });
+
+  m_temperature = std::max(m_temperature * m_params.cooling, m_params.minTemperature * m_params.springLength);
+  ++m_iteration;
+}
+
+void ForceLayout::buildTree() {
+  const auto nodeCount = static_cast<uint32_t>(m_x.size());
+
+  float minX = m_x[0];
+  float maxX = m_x[0];
+  float minY = m_y[0];
+  float maxY = m_y[0];
+  float minZ = m_z[0];
+  float maxZ = m_z[0];
+  for (uint32_t i = 1; i < nodeCount; ++i) {
+    minX = std::min(minX, m_x[i]);
+    maxX = std::max(maxX, m_x[i]);
+    minY = std::min(minY, m_y[i]);
+    maxY = std::max(maxY, m_y[i]);
+    minZ = std::min(minZ, m_z[i]);
+    maxZ = std::max(maxZ, m_z[i]);
+  }
+
+  const float halfSize = 0.5f * std::max({maxX - minX, maxY - minY, maxZ - minZ, 1e-6f}) * 1.0001f;
+
+  std::iota(m_order.begin(), m_order.end(), 0u);
+  m_cells.clear();
+  m_cells.reserve((nodeCount / LEAF_SIZE) * 2 + 1);
+
+  Cell root;
+  root.begin = 0;
+  root.end = nodeCount;
+  m_cells.push_back(root);
+  buildCell(0, 0.5f * (minX + maxX), 0.5f * (minY + maxY), 0.5f * (minZ + maxZ), halfSize, 0);
+
+  // Copy positions into tree order so leaf loops read contiguous memory
+  m_pool->parallelFor(0, nodeCount, NODE_GRAIN * 8, [this](size_t begin, size_t end) {
+    for (size_t k = begin; k < end; ++k) {
+      m_sortedX[k] = m_x[m_order[k]];
+      m_sortedY[k] = m_y[m_order[k]];
+      m_sortedZ[k] = m_z[m_order[k]];
+    }
+  });
+}
+
+void ForceLayout::buildCell(uint32_t cellIndex, float cx, float cy, float cz, float halfSize, uint32_t depth) {
+  const uint32_t begin = m_cells[cellIndex].begin;
+  const uint32_t end = m_cells[cellIndex].end;
+  m_cells[cellIndex].size = 2.0f * halfSize;
+
+  // Leaf: center of mass of its points
+  if (end - begin <= LEAF_SIZE || depth >= MAX_DEPTH) {
+    float sumX = 0.0f;
+    float sumY = 0.0f;
+    float sumZ = 0.0f;
+    for (uint32_t k = begin; k < end; ++k) {
+      sumX += m_x[m_order[k]];
+      sumY += m_y[m_order[k]];
+      sumZ += m_z[m_order[k]];
+    }
+    Cell& cell = m_cells[cellIndex];
+    cell.mass = static_cast<float>(end - begin);
+    cell.comX = sumX / cell.mass;
+    cell.comY = sumY / cell.mass;
+    cell.comZ = sumZ / cell.mass;
+    return;
+  }
+
+  const bool octree = m_params.dimensions == 3;
+  const uint32_t quadrantCount = octree ? 8 : 4;
+
+  auto quadrant = [&](uint32_t i) {
+    return (m_x[i] >= cx ? 1u : 0u) | (m_y[i] >= cy ? 2u : 0u) | (octree && m_z[i] >= cz ? 4u : 0u);
+  };
+
+  // Counting sort of the cell's points by quadrant
+  uint32_t counts[8] = {};
+  for (uint32_t k = begin; k < end; ++k) {
+    ++counts[quadrant(m_order[k])];
+  }
+
+  uint32_t starts[8] = {};
+  for (uint32_t q = 1; q < quadrantCount; ++q) {
+    starts[q] = starts[q - 1] + counts[q - 1];
+  }
+
+  uint32_t cursor[8];
+  std::copy(std::begin(starts), std::end(starts), std::begin(cursor));
+  for (uint32_t k = begin; k < end; ++k) {
+    const uint32_t i = m_order[k];
+    m_scratch[begin + cursor[quadrant(i)]++] = i;
+  }
+  std::copy(m_scratch.begin() + begin, m_scratch.begin() + end, m_order.begin() + begin);
+
+  // Children for the non-empty quadrants, stored contiguously
+  const auto firstChild = static_cast<uint32_t>(m_cells.size());
+  uint32_t childQuadrants[8];
+  uint32_t childCount = 0;
+  for (uint32_t q = 0; q < quadrantCount; ++q) {
+    if (counts[q] == 0) {
+      continue;
+    }
+    Cell child;
+    child.begin = begin + starts[q];
+    child.end = child.begin + counts[q];
+    m_cells.push_back(child);
+    childQuadrants[childCount++] = q;
+  }
+  m_cells[cellIndex].firstChild = firstChild;
+  m_cells[cellIndex].childCount = childCount;
+
+  const float childHalf = 0.5f * halfSize;
+  float sumX = 0.0f;
+  float sumY = 0.0f;
+  float sumZ = 0.0f;
+  for (uint32_t c = 0; c < childCount; ++c) {
+    const uint32_t q = childQuadrants[c];
+    const float childX = cx + ((q & 1u) != 0 ? childHalf : -childHalf);
+    const float childY = cy + ((q & 2u) != 0 ? childHalf : -childHalf);
+    const float childZ = octree ? cz + ((q & 4u) != 0 ? childHalf : -childHalf) : cz;
+    buildCell(firstChild + c, childX, childY, childZ, childHalf, depth + 1);
+
+    const Cell& child = m_cells[firstChild + c];
+    sumX += child.comX * child.mass;
+    sumY += child.comY * child.mass;
+    sumZ += child.comZ * child.mass;
+  }
+
+  Cell& cell = m_cells[cellIndex];
+  cell.mass = static_cast<float>(end - begin);
+  cell.comX = sumX / cell.mass;
+  cell.comY = sumY / cell.mass;
+  cell.comZ = sumZ / cell.mass;
+}
+
+void ForceLayout::accumulateRepulsion(size_t begin, size_t end) {
+  const float k = m_params.springLength;
+  const float scale = m_params.repulsion * k * k;
+  const float theta2 = m_params.theta * m_params.theta;
+
+  // Pending cells: at most 7 siblings per level plus the current children
+  constexpr uint32_t STACK_SIZE = (MAX_DEPTH + 1) * 8;
+  uint32_t stack[STACK_SIZE];
+
+  // Iterate in tree order, neighboring nodes walk nearly the same cells
+  for (size_t k0 = begin; k0 < end; ++k0) {
+    const float px = m_sortedX[k0];
+    const float py = m_sortedY[k0];
+    const float pz = m_sortedZ[k0];
+    const uint32_t node = m_order[k0];
+
+    float fx = 0.0f;
+    float fy = 0.0f;
+    float fz = 0.0f;
+
+    uint32_t top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+      const Cell& cell = m_cells[stack[--top]];
+
+      if (cell.childCount == 0) {
+        // Leaf: exact pairwise forces over contiguous SoA ranges
+        for (uint32_t m = cell.begin; m < cell.end; ++m) {
+          if (m == k0) {
+            continue;
+          }
+          float dx = px - m_sortedX[m];
+          const float dy = py - m_sortedY[m];
+          const float dz = pz - m_sortedZ[m];
+          float d2 = (dx * dx) + (dy * dy) + (dz * dz);
+          if (d2 < MIN_DISTANCE_SQUARED) {
+            // Coincident nodes: separate along x, direction decided by node id
+            dx = node < m_order[m] ? -1e-3f * k : 1e-3f * k;
+            d2 = dx * dx;
+          }
+          const float inv = 1.0f / d2;
+          fx += dx * inv;
+          fy += dy * inv;
+          fz += dz * inv;
+        }
+        continue;
+      }
+
+      const float dx = px - cell.comX;
+      const float dy = py - cell.comY;
+      const float dz = pz - cell.comZ;
+      const float d2 = (dx * dx) + (dy * dy) + (dz * dz);
+
+      // Far enough away: treat the whole cell as one body at its center of mass. Cells holding the node
+      // itself are always opened, their center of mass includes the node and would push it off itself.
+      const bool containsNode = k0 >= cell.begin && k0 < cell.end;
+      if (!containsNode && cell.size * cell.size < theta2 * d2) {
+        const float inv = cell.mass / d2;
+        fx += dx * inv;
+        fy += dy * inv;
+        fz += dz * inv;
+        continue;
+      }
+
+      for (uint32_t c = 0; c < cell.childCount; ++c) {
+        stack[top++] = cell.firstChild + c;
+      }
+    }
+
+    m_dx[node] = fx * scale;
+    m_dy[node] = fy * scale;
+    m_dz[node] = fz * scale;
+  }
+}
+
+void ForceLayout::accumulateAttraction(size_t begin, size_t end) {
+  const util::Graph& graph = adjacency();
+  const float scale = m_params.attraction / m_params.springLength;
+  const float gravity = m_params.gravity;
+  const bool weighted = graph.weights.size() == graph.edges.size();
+
+  for (size_t i = begin; i < end; ++i) {
+    const float px = m_x[i];
+    const float py = m_y[i];
+    const float pz = m_z[i];
+
+    float fx = -gravity * px;
+    float fy = -gravity * py;
+    float fz = -gravity * pz;
+
+    const uint32_t first = graph.offsets[i];
+    const uint32_t last = graph.offsets[i + 1];
+    for (uint32_t slot = first; slot < last; ++slot) {
+      const uint32_t j = graph.neighbors[slot];
+      const float dx = m_x[j] - px;
+      const float dy = m_y[j] - py;
+      const float dz = m_z[j] - pz;
+
+      // d^2 / k along the unit direction = d * (dx, dy, dz) / k
+      const float d = std::sqrt((dx * dx) + (dy * dy) + (dz * dz));
+      const float f = scale * d * (weighted ? graph.weights[graph.edgeIds[slot]] : 1.0f);
+      fx += dx * f;
+      fy += dy * f;
+      fz += dz * f;
+    }
+
+    m_dx[i] += fx;
+    m_dy[i] += fy;
+    m_dz[i] += fz;
+  }
+}
+
+void ForceLayout::integrate(size_t begin, size_t end) {
+  const float temperature = m_temperature;
+  const bool planar = m_params.dimensions != 3;
+
+  for (size_t i = begin; i < end; ++i) {
+    float dx = m_dx[i];
+    float dy = m_dy[i];
+    float dz = planar ? 0.0f : m_dz[i];
+
+    // Displacement is capped by the temperature
+    const float length = std::sqrt((dx * dx) + (dy * dy) + (dz * dz));
+    if (length > temperature) {
+      const float s = temperature / length;
+      dx *= s;
+      dy *= s;
+      dz *= s;
+    }
+
+    m_x[i] += dx;
+    m_y[i] += dy;
+    m_z[i] += dz;
+    m_positions[i] = glm::vec3(m_x[i], m_y[i], m_z[i]);
+  }
+}
+
+}  // namespace graph
@@ -0,0 +1,66 @@
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include <util/background_worker.hpp>
+
+namespace util {
+
+BackgroundWorker::BackgroundWorker() : m_running(0), m_stop(false) {
+  m_thread = std::thread([this] { run(); });
+}
+
+BackgroundWorker::~BackgroundWorker() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_wake.notify_one();
+  m_thread.join();
+}
+
+void BackgroundWorker::submit(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_tasks.push_back(std::move(task));
+  }
+  m_wake.notify_one();
+}
+
+void BackgroundWorker::waitIdle() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_idle.wait(lock, [this] { return m_tasks.empty() && m_running == 0; });
+}
+
+size_t BackgroundWorker::getPendingCount() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_tasks.size() + m_running;
+}
+
+void BackgroundWorker::run() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_wake.wait(lock, [this] { return m_stop || !m_tasks.empty(); });
+    if (m_tasks.empty()) {
+      // Stopping with nothing left to do
+      return;
+    }
+
+    std::function<void()> task = std::move(m_tasks.front());
+    m_tasks.pop_front();
+    ++m_running;
+
+    lock.unlock();
+    task();
+    lock.lock();
+
+    --m_running;
+    if (m_tasks.empty() && m_running == 0) {
+      m_idle.notify_all();
+    }
+  }
+}
+
+}  // namespace util
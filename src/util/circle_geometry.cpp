@@ -0,0 +1,58 @@
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <span>
+#include <vector>
+
+#include <util/circle_geometry.hpp>
+#include <util/glm.hpp>
+
+namespace util {
+
+namespace {
+
+struct CircleTables {
+  std::array<std::vector<glm::vec2>, CIRCLE_LEVEL_COUNT> points;
+  std::array<float, CIRCLE_LEVEL_COUNT> maxRadius{};  // Largest radius each level is accurate enough for
+
+  CircleTables() {
+    for (uint32_t level = 0; level < CIRCLE_LEVEL_COUNT; ++level) {
+      const uint32_t segments = circleSegments(level);
+      const double step = 2.0 * std::numbers::pi / static_cast<double>(segments);
+
+      std::vector<glm::vec2>& circle = points[level];
+      circle.resize(segments + 1);
+      for (uint32_t i = 0; i < segments; ++i) {
+        const double angle = step * static_cast<double>(i);
+        circle[i] = glm::vec2(static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle)));
+      }
+      circle[segments] = circle[0];
+
+      // The chord of a segment stays within r * (1 - cos(step / 2)) of the arc
+      maxRadius[level] = CIRCLE_MAX_ERROR / static_cast<float>(1.0 - std::cos(step / 2.0));
+    }
+  }
+};
+
+const CircleTables& getTables() {
+  static const CircleTables tables;
+  return tables;
+}
+
+}  // namespace
+
+uint32_t circleLevel(float radiusPixels) {
+  const CircleTables& tables = getTables();
+  uint32_t level = 0;
+  while (level + 1 < CIRCLE_LEVEL_COUNT && std::abs(radiusPixels) > tables.maxRadius[level]) {
+    ++level;
+  }
+  return level;
+}
+
+std::span<const glm::vec2> unitCircle(uint32_t level) {
+  return getTables().points[level < CIRCLE_LEVEL_COUNT ? level : CIRCLE_LEVEL_COUNT - 1];
+}
+
+}  // namespace util
@@ -0,0 +1,296 @@
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <util/edge_import.hpp>
+#include <util/graph.hpp>
+#include <util/mapped_file.hpp>
+#include <util/thread_pool.hpp>
+
+namespace util {
+
+namespace {
+
+// Where the edge lines start and how to read them, from the header lines
+struct EdgeFileLayout {
+  EdgeFileFormat format = EdgeFileFormat::Snap;
+  size_t dataBegin = 0;
+  uint64_t nodeCount = 0;  // Matrix Market size line, 0 = derive from the ids
+  uint64_t idBase = 0;
+  bool undirected = false;  // Matrix Market symmetric storage
+};
+
+// Per chunk results of the counting pass
+struct ChunkInfo {
+  size_t edgeCount = 0;
+  uint64_t maxId = 0;
+  bool hasIds = false;  // Any edge line, including dropped self loops
+  bool weighted = false;
+  bool malformed = false;
+};
+
+enum class LineKind : uint8_t { Skip, Edge, Malformed };
+
+constexpr uint64_t MAX_NODE_COUNT = std::numeric_limits<uint32_t>::max();
+
+bool isSeparator(char c) { return c == ' ' || c == '\t' || c == ',' || c == ';' || c == '\r'; }
+
+std::string_view lineAt(std::string_view text, size_t& pos) {
+  const size_t end = std::min(text.find('\n', pos), text.size());
+  const std::string_view line = text.substr(pos, end - pos);
+  pos = end < text.size() ? end + 1 : end;
+  return line;
+}
+
+std::string_view trimFront(std::string_view line) {
+  size_t i = 0;
+  while (i < line.size() && isSeparator(line[i])) {
+    ++i;
+  }
+  return line.substr(i);
+}
+
+bool isSkipped(std::string_view line) {
+  line = trimFront(line);
+  return line.empty() || line.front() == '#' || line.front() == '%';
+}
+
+std::string lowercase(std::string_view text) {
+  std::string result(text);
+  std::transform(result.begin(), result.end(), result.begin(),
+                 [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+  return result;
+}
+
+// "source target [weight] [ignored columns...]"
+LineKind parseLine(std::string_view line, uint64_t& source, uint64_t& target, float& weight, bool& weighted) {
+  line = trimFront(line);
+  if (line.empty() || line.front() == '#' || line.front() == '%') {
+    return LineKind::Skip;
+  }
+
+  const char* cursor = line.data();
+  const char* end = line.data() + line.size();
+  auto skipSeparators = [&] {
+    while (cursor < end && isSeparator(*cursor)) {
+      ++cursor;
+    }
+  };
+
+  auto [afterSource, sourceError] = std::from_chars(cursor, end, source);
+  if (sourceError != std::errc() || afterSource == end || !isSeparator(*afterSource)) {
+    return LineKind::Malformed;
+  }
+  cursor = afterSource;
+  skipSeparators();
+
+  auto [afterTarget, targetError] = std::from_chars(cursor, end, target);
+  if (targetError != std::errc() || (afterTarget != end && !isSeparator(*afterTarget))) {
+    return LineKind::Malformed;
+  }
+  cursor = afterTarget;
+  skipSeparators();
+
+  weighted = false;
+  if (cursor < end) {
+    auto [afterWeight, weightError] = std::from_chars(cursor, end, weight);
+    if (weightError != std::errc() || (afterWeight != end && !isSeparator(*afterWeight))) {
+      return LineKind::Malformed;
+    }
+    weighted = true;
+  }
+  return LineKind::Edge;
+}
+
+bool readLayout(std::string_view text, EdgeFileFormat format, EdgeFileLayout& layout) {
+  constexpr std::string_view MM_BANNER = "%%matrixmarket";
+  const bool detect = format == EdgeFileFormat::Auto;
+  if (detect) {
+    format = lowercase(text.substr(0, MM_BANNER.size())) == MM_BANNER ? EdgeFileFormat::MatrixMarket
+                                                                     : EdgeFileFormat::Snap;
+  }
+
+  size_t pos = 0;
+  if (format == EdgeFileFormat::MatrixMarket) {
+    // %%MatrixMarket matrix coordinate <real | integer | pattern> <general | symmetric | ...>
+    const std::string banner = lowercase(lineAt(text, pos));
+    if (!banner.starts_with(MM_BANNER) || banner.find("coordinate") == std::string::npos ||
+        banner.find("complex") != std::string::npos) {
+      return false;
+    }
+    layout.undirected = banner.find("symmetric") != std::string::npos || banner.find("hermitian") != std::string::npos;
+
+    // Size line "rows cols entries" after the comments
+    std::string_view line;
+    do {
+      if (pos >= text.size()) {
+        return false;
+      }
+      line = lineAt(text, pos);
+    } while (isSkipped(line));
+
+    uint64_t rows = 0;
+    uint64_t cols = 0;
+    float entries = 0.0f;
+    bool hasEntries = false;
+    if (parseLine(line, rows, cols, entries, hasEntries) != LineKind::Edge || !hasEntries) {
+      return false;
+    }
+    layout.format = format;
+    layout.dataBegin = pos;
+    layout.nodeCount = std::max(rows, cols);
+    layout.idBase = 1;
+    return layout.nodeCount <= MAX_NODE_COUNT;
+  }
+
+  // First data line: decides CSV for Auto and may be a CSV header row (an explicit format is kept)
+  size_t lineBegin = 0;
+  std::string_view line;
+  while (pos < text.size()) {
+    lineBegin = pos;
+    line = lineAt(text, pos);
+    if (!isSkipped(line)) {
+      break;
+    }
+  }
+  if (detect) {
+    format = line.find(',') != std::string_view::npos ? EdgeFileFormat::Csv : EdgeFileFormat::Snap;
+  }
+
+  const std::string_view first = trimFront(line);
+  const bool header = format == EdgeFileFormat::Csv && !first.empty() &&
+                      std::isdigit(static_cast<unsigned char>(first.front())) == 0;
+  layout.format = format;
+  layout.dataBegin = header ? pos : lineBegin;
+  return true;
+}
+
+// Chunk starts at line boundaries, last entry is the end of the text
+std::vector<size_t> splitLines(std::string_view text, size_t begin, size_t chunkBytes) {
+  std::vector<size_t> bounds = {begin};
+  chunkBytes = std::max<size_t>(chunkBytes, 1);
+  while (bounds.back() < text.size()) {
+    size_t next = bounds.back() + chunkBytes;
+    if (next >= text.size()) {
+      next = text.size();
+    } else {
+      next = std::min(text.find('\n', next), text.size());
+      next = next < text.size() ? next + 1 : next;
+    }
+    bounds.push_back(next);
+  }
+  return bounds;
+}
+
+}  // namespace
+
+bool importEdgeList(std::string_view text, Graph& graph, const EdgeImportOptions& options, ThreadPool& pool) {
+  EdgeFileLayout layout;
+  if (!readLayout(text, options.format, layout)) {
+    return false;
+  }
+
+  const std::vector<size_t> bounds = splitLines(text, layout.dataBegin, options.chunkBytes);
+  const size_t chunkCount = bounds.size() - 1;
+  const bool removeSelfLoops = options.build.removeSelfLoops;
+
+  // Visit the edges of one chunk: ids zero-based and range checked, self loops dropped if requested
+  auto forEachEdge = [&](size_t chunk, ChunkInfo& info, auto&& emit) {
+    size_t pos = bounds[chunk];
+    const size_t end = bounds[chunk + 1];
+    while (pos < end) {
+      uint64_t source = 0;
+      uint64_t target = 0;
+      float weight = 1.0f;
+      bool weighted = false;
+      const LineKind kind = parseLine(lineAt(text, pos), source, target, weight, weighted);
+      if (kind == LineKind::Skip) {
+        continue;
+      }
+      if (kind == LineKind::Malformed || source < layout.idBase || target < layout.idBase) {
+        info.malformed = true;
+        return;
+      }
+      source -= layout.idBase;
+      target -= layout.idBase;
+      if (std::max(source, target) >= (layout.nodeCount != 0 ? layout.nodeCount : MAX_NODE_COUNT)) {
+        info.malformed = true;
+        return;
+      }
+      info.maxId = std::max({info.maxId, source, target});
+      info.hasIds = true;
+      if (removeSelfLoops && source == target) {
+        continue;
+      }
+      info.weighted = info.weighted || weighted;
+      emit(Edge(static_cast<uint32_t>(source), static_cast<uint32_t>(target)), weighted ? weight : 1.0f);
+      ++info.edgeCount;
+    }
+  };
+
+  // Pass 1: count the edges of every chunk
+  std::vector<ChunkInfo> chunks(chunkCount);
+  pool.parallelFor(0, chunkCount, 1, [&](size_t begin, size_t end) {
+    for (size_t chunk = begin; chunk < end; ++chunk) {
+      forEachEdge(chunk, chunks[chunk], [](const Edge&, float) {});
+    }
+  });
+
+  std::vector<size_t> firstEdge(chunkCount + 1, 0);
+  uint64_t maxId = 0;
+  bool weighted = false;
+  bool any = false;
+  for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+    if (chunks[chunk].malformed) {
+      return false;
+    }
+    firstEdge[chunk + 1] = firstEdge[chunk] + chunks[chunk].edgeCount;
+    maxId = std::max(maxId, chunks[chunk].maxId);
+    weighted = weighted || chunks[chunk].weighted;
+    any = any || chunks[chunk].hasIds;
+  }
+  const uint64_t nodeCount = layout.nodeCount != 0 ? layout.nodeCount : (any ? maxId + 1 : 0);
+
+  // Pass 2: parse again straight into the final arrays
+  std::vector<Edge> edges(firstEdge[chunkCount]);
+  std::vector<float> weights(weighted ? edges.size() : 0);
+  pool.parallelFor(0, chunkCount, 1, [&](size_t begin, size_t end) {
+    for (size_t chunk = begin; chunk < end; ++chunk) {
+      ChunkInfo info;
+      size_t out = firstEdge[chunk];
+      forEachEdge(chunk, info, [&](const Edge& edge, float weight) {
+        edges[out] = edge;
+        if (weighted) {
+          weights[out] = weight;
+        }
+        ++out;
+      });
+    }
+  });
+
+  GraphBuildOptions build = options.build;
+  if (layout.format == EdgeFileFormat::MatrixMarket) {
+    build.directed = !layout.undirected;
+  }
+  graph = Graph::fromValidEdges(static_cast<uint32_t>(nodeCount), std::move(edges), std::move(weights), build, pool);
+  return true;
+}
+
+bool importEdgeListFile(const std::string& path, Graph& graph, const EdgeImportOptions& options, ThreadPool& pool) {
+  MappedFile file;
+  if (!file.open(path)) {
+    return false;
+  }
+  const std::string_view text(reinterpret_cast<const char*>(file.data()), file.size());
+  return importEdgeList(text, graph, options, pool);
+}
+
+}  // namespace util
@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <util/graph.hpp>
+#include <util/thread_pool.hpp>
+
+namespace util {
+
+namespace {
+
+constexpr size_t EDGE_GRAIN = 1 << 16;
+constexpr size_t NODE_GRAIN = 1 << 12;
+
+}  // namespace
+
+Graph Graph::fromEdges(uint32_t nodeCount, std::span<const Edge> edgeList, std::span<const float> edgeWeights,
+                       const GraphBuildOptions& options, ThreadPool& pool) {
+  Graph graph;
+  const bool hasWeights = !edgeWeights.empty() && edgeWeights.size() == edgeList.size();
+
+  auto isKept = [&](const Edge& edge) {
+    return edge.source < nodeCount && edge.target < nodeCount &&
+           !(options.removeSelfLoops && edge.source == edge.target);
+  };
+
+  // Stable compaction of the valid edges: count per chunk, prefix sum, then copy
+  const size_t chunkCount = (edgeList.size() + EDGE_GRAIN - 1) / EDGE_GRAIN;
+  std::vector<size_t> chunkOffsets(chunkCount + 1, 0);
+
+  pool.parallelFor(0, edgeList.size(), EDGE_GRAIN, [&](size_t begin, size_t end) {
+    size_t kept = 0;
+    for (size_t i = begin; i < end; ++i) {
+      kept += isKept(edgeList[i]) ? 1 : 0;
+    }
+    chunkOffsets[(begin / EDGE_GRAIN) + 1] = kept;
+  });
+  for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+    chunkOffsets[chunk + 1] += chunkOffsets[chunk];
+  }
+
+  const size_t edgeCount = chunkOffsets[chunkCount];
+  graph.edges.resize(edgeCount);
+  graph.weights.resize(edgeCount, 1.0f);
+
+  pool.parallelFor(0, edgeList.size(), EDGE_GRAIN, [&](size_t begin, size_t end) {
+    size_t out = chunkOffsets[begin / EDGE_GRAIN];
+    for (size_t i = begin; i < end; ++i) {
+      if (isKept(edgeList[i])) {
+        graph.edges[out] = edgeList[i];
+        if (hasWeights) {
+          graph.weights[out] = edgeWeights[i];
+        }
+        ++out;
+      }
+    }
+  });
+
+  graph.buildAdjacency(nodeCount, options, pool);
+  return graph;
+}
+
+Graph Graph::fromValidEdges(uint32_t nodeCount, std::vector<Edge> edgeList, std::vector<float> edgeWeights,
+                            const GraphBuildOptions& options, ThreadPool& pool) {
+  Graph graph;
+  graph.edges = std::move(edgeList);
+  graph.weights = std::move(edgeWeights);
+  if (graph.weights.size() != graph.edges.size()) {
+    graph.weights.assign(graph.edges.size(), 1.0f);
+  }
+
+  graph.buildAdjacency(nodeCount, options, pool);
+  return graph;
+}
+
+void Graph::buildAdjacency(uint32_t nodeCount, const GraphBuildOptions& options, ThreadPool& pool) {
+  Graph& graph = *this;
+  graph.directed = options.directed;
+  graph.positions.assign(nodeCount, glm::vec3(0.0f));
+  graph.colors.assign(nodeCount, Color(1.0f, 1.0f, 1.0f, 1.0f));
+  graph.sizes.assign(nodeCount, 1.0f);
+  const size_t edgeCount = graph.edges.size();
+
+  // Degrees (undirected edges count for both endpoints)
+  std::vector<std::atomic<uint32_t>> cursors(nodeCount);
+
+  pool.parallelFor(0, edgeCount, EDGE_GRAIN, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      cursors[graph.edges[i].source].fetch_add(1, std::memory_order_relaxed);
+      if (!options.directed) {
+        cursors[graph.edges[i].target].fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  });
+
+  // Exclusive prefix sum into offsets, cursors become the per-node write positions
+  graph.offsets.resize(static_cast<size_t>(nodeCount) + 1);
+  uint32_t total = 0;
+  for (uint32_t node = 0; node < nodeCount; ++node) {
+    graph.offsets[node] = total;
+    total += cursors[node].load(std::memory_order_relaxed);
+    cursors[node].store(graph.offsets[node], std::memory_order_relaxed);
+  }
+  graph.offsets[nodeCount] = total;
+
+  // Scatter adjacency slots
+  graph.neighbors.resize(total);
+  graph.edgeIds.resize(total);
+
+  pool.parallelFor(0, edgeCount, EDGE_GRAIN, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      const Edge& edge = graph.edges[i];
+      const uint32_t slot = cursors[edge.source].fetch_add(1, std::memory_order_relaxed);
+      graph.neighbors[slot] = edge.target;
+      graph.edgeIds[slot] = static_cast<uint32_t>(i);
+
+      if (!options.directed) {
+        const uint32_t reverseSlot = cursors[edge.target].fetch_add(1, std::memory_order_relaxed);
+        graph.neighbors[reverseSlot] = edge.source;
+        graph.edgeIds[reverseSlot] = static_cast<uint32_t>(i);
+      }
+    }
+  });
+
+  if (!options.sortNeighbors) {
+    return;
+  }
+
+  // Scatter order depends on thread timing, sort each list by (neighbor, edge id)
+  pool.parallelFor(0, nodeCount, NODE_GRAIN, [&](size_t begin, size_t end) {
+    std::vector<std::pair<uint32_t, uint32_t>> slots;
+    for (size_t node = begin; node < end; ++node) {
+      const uint32_t first = graph.offsets[node];
+      const uint32_t last = graph.offsets[node + 1];
+      if (last - first < 2) {
+        continue;
+      }
+
+      slots.clear();
+      for (uint32_t slot = first; slot < last; ++slot) {
+        slots.emplace_back(graph.neighbors[slot], graph.edgeIds[slot]);
+      }
+      std::sort(slots.begin(), slots.end());
+      for (uint32_t slot = first; slot < last; ++slot) {
+        graph.neighbors[slot] = slots[slot - first].first;
+        graph.edgeIds[slot] = slots[slot - first].second;
+      }
+    }
+  });
+}
+
+}  // namespace util
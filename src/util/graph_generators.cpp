@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <util/glm.hpp>
+#include <util/graph.hpp>
+#include <util/graph_generators.hpp>
+
+namespace util {
+
+namespace {
+
+// Uniform positions over the sqrt(nodeCount) square
+void scatterNodes(Graph& graph, std::mt19937& rng) {
+  const float side = std::sqrt(static_cast<float>(graph.nodeCount()));
+  std::uniform_real_distribution<float> coordinate(0.0f, side);
+  for (glm::vec3& position : graph.positions) {
+    const float x = coordinate(rng);
+    position = glm::vec3(x, coordinate(rng), 0.0f);
+  }
+}
+
+}  // namespace
+
+Graph randomGraph(uint32_t nodeCount, uint32_t averageDegree, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::vector<Edge> edges;
+  if (nodeCount >= 2) {
+    std::uniform_int_distribution<uint32_t> node(0, nodeCount - 1);
+    const size_t edgeCount = static_cast<size_t>(nodeCount) * averageDegree / 2;
+    edges.reserve(edgeCount);
+    while (edges.size() < edgeCount) {
+      const uint32_t source = node(rng);
+      const uint32_t target = node(rng);
+      if (source != target) {
+        edges.emplace_back(source, target);
+      }
+    }
+  }
+
+  Graph graph = Graph::fromValidEdges(nodeCount, std::move(edges));
+  scatterNodes(graph, rng);
+  return graph;
+}
+
+Graph gridGraph(uint32_t width, uint32_t height) {
+  std::vector<Edge> edges;
+  edges.reserve(static_cast<size_t>(width) * height * 2);
+  for (uint32_t y = 0; y < height; ++y) {
+    for (uint32_t x = 0; x < width; ++x) {
+      const uint32_t v = (y * width) + x;
+      if (x + 1 < width) {
+        edges.emplace_back(v, v + 1);
+      }
+      if (y + 1 < height) {
+        edges.emplace_back(v, v + width);
+      }
+    }
+  }
+
+  Graph graph = Graph::fromValidEdges(width * height, std::move(edges));
+  for (uint32_t v = 0; v < graph.nodeCount(); ++v) {
+    graph.positions[v] = glm::vec3(static_cast<float>(v % width), static_cast<float>(v / width), 0.0f);
+  }
+  return graph;
+}
+
+Graph scaleFreeGraph(uint32_t nodeCount, uint32_t edgesPerNode, uint32_t seed) {
+  std::mt19937 rng(seed);
+  const uint32_t m = nodeCount > 1 ? std::clamp(edgesPerNode, 1u, nodeCount - 1) : 0;
+
+  std::vector<Edge> edges;
+  if (m > 0) {
+    edges.reserve(static_cast<size_t>(nodeCount - m) * m);
+
+    // Every edge appends both endpoints, so a uniform pick from this list is a pick proportional to degree
+    std::vector<uint32_t> endpoints;
+    endpoints.reserve(edges.capacity() * 2);
+
+    // The first new node links to all seed nodes
+    for (uint32_t target = 0; target < m; ++target) {
+      edges.emplace_back(m, target);
+      endpoints.push_back(m);
+      endpoints.push_back(target);
+    }
+
+    std::vector<uint32_t> targets;
+    for (uint32_t v = m + 1; v < nodeCount; ++v) {
+      targets.clear();
+      std::uniform_int_distribution<size_t> pick(0, endpoints.size() - 1);
+      // A few retries keep the targets distinct, a rare duplicate is kept rather than looping on hubs
+      for (uint32_t attempt = 0; targets.size() < m && attempt < m * 4; ++attempt) {
+        const uint32_t target = endpoints[pick(rng)];
+        if (std::ranges::find(targets, target) == targets.end()) {
+          targets.push_back(target);
+        }
+      }
+      while (targets.size() < m) {
+        targets.push_back(endpoints[pick(rng)]);
+      }
+
+      for (const uint32_t target : targets) {
+        edges.emplace_back(v, target);
+        endpoints.push_back(v);
+        endpoints.push_back(target);
+      }
+    }
+  }
+
+  Graph graph = Graph::fromValidEdges(nodeCount, std::move(edges));
+  scatterNodes(graph, rng);
+  return graph;
+}
+
+}  // namespace util
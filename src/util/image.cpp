@@ -0,0 +1,185 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <util/glm.hpp>
+#include <util/image.hpp>
+
+namespace util {
+
+namespace {
+
+constexpr size_t BYTES_PER_PIXEL = 4;
+constexpr size_t STORED_BLOCK_SIZE = 65535;  // Largest stored deflate block
+constexpr size_t IDAT_CHUNK_SIZE = 1 << 20;  // Keeps every chunk far below the 2^31 PNG limit
+
+constexpr std::array<uint32_t, 256> CRC_TABLE = [] {
+  std::array<uint32_t, 256> table{};
+  for (uint32_t i = 0; i < 256; ++i) {
+    uint32_t crc = i;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc & 1) != 0 ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+    }
+    table[i] = crc;
+  }
+  return table;
+}();
+
+uint32_t crc32(uint32_t crc, std::span<const uint8_t> bytes) {
+  for (const uint8_t byte : bytes) {
+    crc = CRC_TABLE[(crc ^ byte) & 0xFF] ^ (crc >> 8);
+  }
+  return crc;
+}
+
+void appendBigEndian(std::vector<uint8_t>& out, uint32_t value) {
+  out.push_back(static_cast<uint8_t>(value >> 24));
+  out.push_back(static_cast<uint8_t>(value >> 16));
+  out.push_back(static_cast<uint8_t>(value >> 8));
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+// Length, type, data, CRC over type and data
+void appendChunk(std::vector<uint8_t>& out, const char (&type)[5], std::span<const uint8_t> data) {
+  appendBigEndian(out, static_cast<uint32_t>(data.size()));
+  const size_t typeOffset = out.size();
+  out.insert(out.end(), type, type + 4);
+  out.insert(out.end(), data.begin(), data.end());
+  const uint32_t crc = crc32(0xFFFFFFFFu, std::span(out).subspan(typeOffset)) ^ 0xFFFFFFFFu;
+  appendBigEndian(out, crc);
+}
+
+}  // namespace
+
+std::vector<uint8_t> encodePng(uint32_t width, uint32_t height, std::span<const uint8_t> rgba) {
+  const size_t rowBytes = static_cast<size_t>(width) * BYTES_PER_PIXEL;
+  if (width == 0 || height == 0 || rgba.size() != rowBytes * height) {
+    return {};
+  }
+
+  // Scanlines: filter type 0 (none) followed by the row
+  std::vector<uint8_t> scanlines;
+  scanlines.reserve((rowBytes + 1) * height);
+  for (uint32_t row = 0; row < height; ++row) {
+    scanlines.push_back(0);
+    const auto source = rgba.subspan(row * rowBytes, rowBytes);
+    scanlines.insert(scanlines.end(), source.begin(), source.end());
+  }
+
+  // zlib stream of stored blocks: header, blocks (final flag, LEN, NLEN, bytes), Adler-32 of the scanlines
+  std::vector<uint8_t> zlib = {0x78, 0x01};
+  zlib.reserve(scanlines.size() + ((scanlines.size() / STORED_BLOCK_SIZE) + 1) * 5 + 6);
+  uint32_t adlerA = 1;
+  uint32_t adlerB = 0;
+  for (size_t offset = 0; offset < scanlines.size(); offset += STORED_BLOCK_SIZE) {
+    const size_t length = std::min(STORED_BLOCK_SIZE, scanlines.size() - offset);
+    const auto nlength = static_cast<uint16_t>(~length);
+    zlib.push_back(offset + length == scanlines.size() ? 1 : 0);
+    zlib.push_back(static_cast<uint8_t>(length));
+    zlib.push_back(static_cast<uint8_t>(length >> 8));
+    zlib.push_back(static_cast<uint8_t>(nlength));
+    zlib.push_back(static_cast<uint8_t>(nlength >> 8));
+    zlib.insert(zlib.end(), scanlines.begin() + static_cast<ptrdiff_t>(offset),
+                scanlines.begin() + static_cast<ptrdiff_t>(offset + length));
+    for (size_t i = offset; i < offset + length; ++i) {
+      adlerA = (adlerA + scanlines[i]) % 65521;
+      adlerB = (adlerB + adlerA) % 65521;
+    }
+  }
+  appendBigEndian(zlib, (adlerB << 16) | adlerA);
+
+  std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+  png.reserve(zlib.size() + ((zlib.size() / IDAT_CHUNK_SIZE) + 1) * 12 + 64);
+
+  // Size, 8-bit RGBA, deflate, adaptive filtering, no interlace
+  std::vector<uint8_t> header;
+  appendBigEndian(header, width);
+  appendBigEndian(header, height);
+  header.insert(header.end(), {8, 6, 0, 0, 0});
+  appendChunk(png, "IHDR", header);
+
+  for (size_t offset = 0; offset < zlib.size(); offset += IDAT_CHUNK_SIZE) {
+    appendChunk(png, "IDAT", std::span(zlib).subspan(offset, std::min(IDAT_CHUNK_SIZE, zlib.size() - offset)));
+  }
+  appendChunk(png, "IEND", {});
+  return png;
+}
+
+bool writePng(const std::string& path, uint32_t width, uint32_t height, std::span<const uint8_t> rgba) {
+  const std::vector<uint8_t> png = encodePng(width, height, rgba);
+  if (png.empty()) {
+    return false;
+  }
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    return false;
+  }
+  file.write(reinterpret_cast<const char*>(png.data()), static_cast<std::streamsize>(png.size()));
+  return static_cast<bool>(file.flush());
+}
+
+void flipRows(std::span<uint8_t> pixels, size_t rowBytes) {
+  if (rowBytes == 0) {
+    return;
+  }
+  const size_t rows = pixels.size() / rowBytes;
+  for (size_t top = 0, bottom = rows - 1; top < rows / 2; ++top, --bottom) {
+    std::swap_ranges(pixels.begin() + static_cast<ptrdiff_t>(top * rowBytes),
+                     pixels.begin() + static_cast<ptrdiff_t>((top + 1) * rowBytes),
+                     pixels.begin() + static_cast<ptrdiff_t>(bottom * rowBytes));
+  }
+}
+
+std::vector<ImageTile> tileImage(uint32_t width, uint32_t height, uint32_t maxTileSize) {
+  std::vector<ImageTile> tiles;
+  if (width == 0 || height == 0 || maxTileSize == 0) {
+    return tiles;
+  }
+  for (uint32_t y = 0; y < height; y += maxTileSize) {
+    for (uint32_t x = 0; x < width; x += maxTileSize) {
+      tiles.push_back(ImageTile{x, y, std::min(maxTileSize, width - x), std::min(maxTileSize, height - y)});
+    }
+  }
+  return tiles;
+}
+
+glm::mat4 tileTransform(uint32_t width, uint32_t height, const ImageTile& tile) {
+  // Scale the tile's clip-space extent up to [-1, 1] and move its center to the origin (scaled by w, so
+  // the shift survives the perspective divide)
+  const auto imageWidth = static_cast<float>(width);
+  const auto imageHeight = static_cast<float>(height);
+  const auto tileWidth = static_cast<float>(tile.width);
+  const auto tileHeight = static_cast<float>(tile.height);
+  const float scaleX = imageWidth / tileWidth;
+  const float scaleY = imageHeight / tileHeight;
+  const float centerX = (((2.0f * static_cast<float>(tile.x)) + tileWidth) / imageWidth) - 1.0f;
+  const float centerY = (((2.0f * static_cast<float>(tile.y)) + tileHeight) / imageHeight) - 1.0f;
+
+  glm::mat4 transform(1.0f);
+  transform[0][0] = scaleX;
+  transform[1][1] = scaleY;
+  transform[3][0] = -centerX * scaleX;
+  transform[3][1] = -centerY * scaleY;
+  return transform;
+}
+
+void copyTile(std::span<uint8_t> image, uint32_t imageWidth, std::span<const uint8_t> pixels, const ImageTile& tile) {
+  const size_t tileRow = static_cast<size_t>(tile.width) * BYTES_PER_PIXEL;
+  const size_t imageRow = static_cast<size_t>(imageWidth) * BYTES_PER_PIXEL;
+  if (tile.x + tile.width > imageWidth || pixels.size() < tileRow * tile.height ||
+      image.size() < (static_cast<size_t>(tile.y) + tile.height) * imageRow) {
+    return;
+  }
+  for (uint32_t row = 0; row < tile.height; ++row) {
+    const size_t target = ((static_cast<size_t>(tile.y) + row) * imageRow) + (tile.x * BYTES_PER_PIXEL);
+    std::memcpy(image.data() + target, pixels.data() + (row * tileRow), tileRow);
+  }
+}
+
+}  // namespace util
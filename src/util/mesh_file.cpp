@@ -0,0 +1,275 @@
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <util/graph.hpp>
+#include <util/mesh_file.hpp>
+#include <util/mesh_prepare.hpp>
+#include <util/spatial_index.hpp>
+#include <util/types.hpp>
+#include <util/vertex_pack.hpp>
+
+namespace util {
+
+// Sections are the in-memory arrays byte for byte
+static_assert(std::endian::native == std::endian::little);
+static_assert(std::is_trivially_copyable_v<IndexChunk> && sizeof(IndexChunk) == 32);
+static_assert(std::is_trivially_copyable_v<Edge> && std::is_trivially_copyable_v<AABB>);
+static_assert(sizeof(MeshFileHeader) == 56 && sizeof(MeshFileSection) == 24);
+
+namespace {
+
+constexpr char MESH_FILE_MAGIC[8] = {'G', 'L', 'A', 'B', 'M', 'E', 'S', 'H'};
+
+constexpr size_t alignUp(size_t value) { return (value + MESH_FILE_ALIGNMENT - 1) & ~(MESH_FILE_ALIGNMENT - 1); }
+
+// Element size each section type must be stored with
+constexpr uint32_t elementSize(SectionType type) {
+  switch (type) {
+    case SectionType::Vertices:
+      return 1;
+    case SectionType::FaceChunks:
+    case SectionType::EdgeChunks:
+    case SectionType::PointChunks:
+      return sizeof(IndexChunk);
+    case SectionType::EdgeList:
+      return sizeof(Edge);
+    default:
+      return sizeof(uint32_t);
+  }
+}
+
+struct PendingSection {
+  SectionType type;
+  std::span<const std::byte> data;
+};
+
+template <typename T>
+std::span<const T> sectionAs(std::span<const std::byte> bytes) {
+  return {reinterpret_cast<const T*>(bytes.data()), bytes.size() / sizeof(T)};
+}
+
+}  // namespace
+
+MeshView makeMeshView(const PreparedMesh& prepared) {
+  MeshView view;
+  view.format = prepared.format;
+  view.dimensions = prepared.dimensions;
+  view.vertexCount = prepared.vertexCount;
+  view.vertexData = std::as_bytes(std::span(prepared.vertexData));
+  view.faces = prepared.faces;
+  view.edges = prepared.edges;
+  view.points = prepared.points;
+  view.bounds = prepared.bounds;
+  view.faceChunks = prepared.faceChunks;
+  view.edgeChunks = prepared.edgeChunks;
+  view.pointChunks = prepared.pointChunks;
+  return view;
+}
+
+MeshView makeMeshView(const PreparedMesh& prepared, const Graph& graph) {
+  MeshView view = makeMeshView(prepared);
+  view.offsets = graph.offsets;
+  view.neighbors = graph.neighbors;
+  view.edgeIds = graph.edgeIds;
+  view.edgeList = graph.edges;
+  view.sizes = graph.sizes;
+  view.weights = graph.weights;
+  view.directed = graph.directed;
+  return view;
+}
+
+bool writeMeshFile(const std::string& path, const MeshView& view) {
+  // Readers assume three-component positions, a flat vertex section would be misread
+  if (view.dimensions != 3) {
+    return false;
+  }
+  if (!view.isValid() || view.vertexData.size() != vertexBufferSize(view.format, view.vertexCount)) {
+    return false;
+  }
+
+  const PendingSection candidates[] = {
+      {SectionType::Vertices, view.vertexData},
+      {SectionType::Faces, std::as_bytes(view.faces)},
+      {SectionType::Edges, std::as_bytes(view.edges)},
+      {SectionType::Points, std::as_bytes(view.points)},
+      {SectionType::FaceChunks, std::as_bytes(view.faceChunks)},
+      {SectionType::EdgeChunks, std::as_bytes(view.edgeChunks)},
+      {SectionType::PointChunks, std::as_bytes(view.pointChunks)},
+      {SectionType::Offsets, std::as_bytes(view.offsets)},
+      {SectionType::Neighbors, std::as_bytes(view.neighbors)},
+      {SectionType::EdgeIds, std::as_bytes(view.edgeIds)},
+      {SectionType::EdgeList, std::as_bytes(view.edgeList)},
+      {SectionType::Sizes, std::as_bytes(view.sizes)},
+      {SectionType::Weights, std::as_bytes(view.weights)},
+  };
+
+  // Empty arrays are left out of the table
+  std::vector<PendingSection> sections;
+  for (const PendingSection& section : candidates) {
+    if (!section.data.empty()) {
+      sections.push_back(section);
+    }
+  }
+
+  MeshFileHeader header{};
+  std::memcpy(header.magic, MESH_FILE_MAGIC, sizeof(header.magic));
+  header.version = MESH_FILE_VERSION;
+  header.sectionCount = static_cast<uint32_t>(sections.size());
+  header.vertexFormat = static_cast<uint32_t>(view.format);
+  header.vertexCount = view.vertexCount;
+  header.flags = view.directed ? MESH_FILE_DIRECTED : 0;
+  header.bounds = view.bounds;
+
+  std::vector<MeshFileSection> table(sections.size());
+  size_t offset = alignUp(sizeof(MeshFileHeader) + (sections.size() * sizeof(MeshFileSection)));
+  for (size_t i = 0; i < sections.size(); ++i) {
+    const uint32_t size = elementSize(sections[i].type);
+    table[i] = MeshFileSection{static_cast<uint32_t>(sections[i].type), size, offset, sections[i].data.size() / size};
+    offset = alignUp(offset + sections[i].data.size());
+  }
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    return false;
+  }
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char*>(table.data()),
+             static_cast<std::streamsize>(table.size() * sizeof(MeshFileSection)));
+
+  // Zero padding up to each aligned section start
+  const char padding[MESH_FILE_ALIGNMENT] = {};
+  size_t written = sizeof(header) + (table.size() * sizeof(MeshFileSection));
+  for (size_t i = 0; i < sections.size(); ++i) {
+    file.write(padding, static_cast<std::streamsize>(table[i].offset - written));
+    file.write(reinterpret_cast<const char*>(sections[i].data.data()),
+               static_cast<std::streamsize>(sections[i].data.size()));
+    written = table[i].offset + sections[i].data.size();
+  }
+  return static_cast<bool>(file.flush());
+}
+
+bool MeshFile::open(const std::string& path) {
+  close();
+  if (!m_file.open(path)) {
+    return false;
+  }
+
+  const std::span<const std::byte> bytes = m_file.bytes();
+  MeshFileHeader header{};
+  if (bytes.size() < sizeof(header)) {
+    close();
+    return false;
+  }
+  std::memcpy(&header, bytes.data(), sizeof(header));
+
+  const auto format = static_cast<VertexFormat>(header.vertexFormat);
+  const bool formatValid = header.vertexFormat <= static_cast<uint32_t>(VertexFormat::HalfPosition);
+  const size_t tableEnd = sizeof(header) + (static_cast<size_t>(header.sectionCount) * sizeof(MeshFileSection));
+  if (std::memcmp(header.magic, MESH_FILE_MAGIC, sizeof(header.magic)) != 0 || header.version != MESH_FILE_VERSION ||
+      !formatValid || header.vertexCount == 0 || tableEnd > bytes.size()) {
+    close();
+    return false;
+  }
+
+  MeshView view;
+  view.format = format;
+  view.vertexCount = header.vertexCount;
+  view.bounds = header.bounds;
+  view.directed = (header.flags & MESH_FILE_DIRECTED) != 0;
+
+  for (uint32_t i = 0; i < header.sectionCount; ++i) {
+    MeshFileSection section{};
+    std::memcpy(&section, bytes.data() + sizeof(header) + (i * sizeof(MeshFileSection)), sizeof(section));
+
+    // Unknown sections from newer writers are skipped, whatever their element size
+    const auto type = static_cast<SectionType>(section.type);
+    if (section.type < static_cast<uint32_t>(SectionType::Vertices) ||
+        section.type > static_cast<uint32_t>(SectionType::Weights)) {
+      continue;
+    }
+
+    // Count checked by division, a product of count and element size could wrap
+    if (section.elementSize != elementSize(type) || section.offset % MESH_FILE_ALIGNMENT != 0 ||
+        section.offset > bytes.size() || section.count > (bytes.size() - section.offset) / section.elementSize) {
+      close();
+      return false;
+    }
+
+    const std::span<const std::byte> data = bytes.subspan(section.offset, section.count * section.elementSize);
+    switch (type) {
+      case SectionType::Vertices:
+        view.vertexData = data;
+        break;
+      case SectionType::Faces:
+        view.faces = sectionAs<uint32_t>(data);
+        break;
+      case SectionType::Edges:
+        view.edges = sectionAs<uint32_t>(data);
+        break;
+      case SectionType::Points:
+        view.points = sectionAs<uint32_t>(data);
+        break;
+      case SectionType::FaceChunks:
+        view.faceChunks = sectionAs<IndexChunk>(data);
+        break;
+      case SectionType::EdgeChunks:
+        view.edgeChunks = sectionAs<IndexChunk>(data);
+        break;
+      case SectionType::PointChunks:
+        view.pointChunks = sectionAs<IndexChunk>(data);
+        break;
+      case SectionType::Offsets:
+        view.offsets = sectionAs<uint32_t>(data);
+        break;
+      case SectionType::Neighbors:
+        view.neighbors = sectionAs<uint32_t>(data);
+        break;
+      case SectionType::EdgeIds:
+        view.edgeIds = sectionAs<uint32_t>(data);
+        break;
+      case SectionType::EdgeList:
+        view.edgeList = sectionAs<Edge>(data);
+        break;
+      case SectionType::Sizes:
+        view.sizes = sectionAs<float>(data);
+        break;
+      case SectionType::Weights:
+        view.weights = sectionAs<float>(data);
+        break;
+      default:
+        break;
+    }
+  }
+
+  // Cheap consistency checks, the arrays themselves are trusted
+  auto chunksFit = [](std::span<const IndexChunk> chunks, size_t indexCount) {
+    return chunks.empty() || static_cast<size_t>(chunks.back().firstIndex) + chunks.back().indexCount <= indexCount;
+  };
+  const bool consistent =
+      view.vertexData.size() == vertexBufferSize(format, view.vertexCount) && view.faces.size() % 3 == 0 &&
+      view.edges.size() % 2 == 0 && (view.points.empty() || view.points.size() == view.vertexCount) &&
+      chunksFit(view.faceChunks, view.faces.size()) && chunksFit(view.edgeChunks, view.edges.size()) &&
+      chunksFit(view.pointChunks, view.points.empty() ? view.vertexCount : view.points.size()) &&
+      (view.offsets.empty() || view.offsets.size() == static_cast<size_t>(view.vertexCount) + 1);
+  if (!consistent) {
+    close();
+    return false;
+  }
+
+  m_view = view;
+  return true;
+}
+
+void MeshFile::close() {
+  m_file.close();
+  m_view = MeshView();
+}
+
+}  // namespace util
@@ -0,0 +1,120 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#include <util/glm.hpp>
+#include <util/graph.hpp>
+#include <util/mesh_prepare.hpp>
+#include <util/spatial_index.hpp>
+#include <util/types.hpp>
+#include <util/vertex_pack.hpp>
+
+namespace util {
+
+namespace {
+
+// Point order and chunks, the index array is only kept when there is more than one chunk
+void preparePoints(PreparedMesh& prepared, std::span<const glm::vec3> positions) {
+  prepared.points.resize(prepared.vertexCount);
+  std::iota(prepared.points.begin(), prepared.points.end(), 0u);
+  prepared.pointChunks = buildIndexChunks(positions, prepared.points, 1);
+  if (prepared.pointChunks.size() <= 1) {
+    prepared.points = std::vector<uint32_t>();
+  }
+}
+
+// Spatial index positions of a vertex (flat vertices lie in z = 0)
+glm::vec3 indexPosition(const Vertex2D& vertex) { return glm::vec3(vertex.position.x, vertex.position.y, 0.0f); }
+glm::vec3 indexPosition(const Vertex3D& vertex) { return vertex.position; }
+
+template <typename VertexType>
+PreparedMesh prepareVertices(const Mesh<VertexType>& mesh, VertexFormat format) {
+  PreparedMesh prepared;
+  if (mesh.vertices.empty()) {
+    return prepared;
+  }
+
+  const size_t vertexCount = mesh.vertices.size();
+  const uint32_t dimensions = VertexType::DIMENSIONS;
+  prepared.format = format;
+  prepared.dimensions = dimensions;
+  prepared.vertexCount = static_cast<uint32_t>(vertexCount);
+  prepared.vertexData.resize(vertexBufferSize(format, vertexCount, dimensions));
+  packPositions(format, std::span<const VertexType>(mesh.vertices), prepared.vertexData.data());
+  packColors(format, std::span<const VertexType>(mesh.vertices),
+             prepared.vertexData.data() + colorBlockOffset(format, vertexCount, dimensions));
+
+  std::vector<glm::vec3> positions(vertexCount);
+  std::transform(mesh.vertices.begin(), mesh.vertices.end(), positions.begin(),
+                 [](const VertexType& vertex) { return indexPosition(vertex); });
+  prepared.bounds = computeBounds(positions);
+
+  prepared.faces = collectPrimitives(mesh.faces, vertexCount, 3);
+  if (!prepared.faces.empty()) {
+    prepared.faceChunks = buildIndexChunks(positions, prepared.faces, 3);
+  }
+  prepared.edges = collectPrimitives(mesh.edges, vertexCount, 2);
+  if (!prepared.edges.empty()) {
+    prepared.edgeChunks = buildIndexChunks(positions, prepared.edges, 2);
+  }
+  preparePoints(prepared, positions);
+
+  return prepared;
+}
+
+}  // namespace
+
+std::vector<uint32_t> collectPrimitives(std::span<const uint32_t> indices, size_t vertexCount,
+                                        uint32_t primitiveSize) {
+  indices = indices.first(indices.size() - (indices.size() % primitiveSize));
+  if (indicesInRange(indices, vertexCount)) {
+    return std::vector<uint32_t>(indices.begin(), indices.end());
+  }
+
+  // Drop primitives that reference missing vertices
+  std::vector<uint32_t> result;
+  result.reserve(indices.size());
+  for (size_t i = 0; i < indices.size(); i += primitiveSize) {
+    const auto primitive = indices.subspan(i, primitiveSize);
+    if (indicesInRange(primitive, vertexCount)) {
+      result.insert(result.end(), primitive.begin(), primitive.end());
+    }
+  }
+  return result;
+}
+
+PreparedMesh prepareMesh(const Mesh2D& mesh, VertexFormat format) { return prepareVertices(mesh, format); }
+
+PreparedMesh prepareMesh(const Mesh3D& mesh, VertexFormat format) { return prepareVertices(mesh, format); }
+
+PreparedMesh prepareGraph(const Graph& graph, VertexFormat format) {
+  PreparedMesh prepared;
+  const size_t vertexCount = graph.nodeCount();
+  if (vertexCount == 0 || graph.positions.size() != vertexCount || graph.colors.size() != vertexCount) {
+    return prepared;
+  }
+
+  prepared.format = format;
+  prepared.vertexCount = static_cast<uint32_t>(vertexCount);
+  prepared.vertexData.resize(vertexBufferSize(format, vertexCount));
+  packPositions(format, std::span<const glm::vec3>(graph.positions), prepared.vertexData.data());
+  packColors(format, std::span<const Color>(graph.colors),
+             prepared.vertexData.data() + colorBlockOffset(format, vertexCount));
+  prepared.bounds = computeBounds(graph.positions);
+
+  // Edge endpoints are validated when the graph is built
+  if (!graph.edges.empty()) {
+    prepared.edges.resize(graph.edges.size() * 2);
+    std::memcpy(prepared.edges.data(), graph.edges.data(), graph.edges.size() * sizeof(Edge));
+    prepared.edgeChunks = buildIndexChunks(graph.positions, prepared.edges, 2);
+  }
+  preparePoints(prepared, graph.positions);
+
+  return prepared;
+}
+
+}  // namespace util
@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <map>
+
+#include <util/range_allocator.hpp>
+
+namespace util {
+
+RangeAllocator::RangeAllocator(uint32_t capacity) : m_capacity(0), m_used(0) { reset(capacity); }
+
+uint32_t RangeAllocator::allocate(uint32_t count) {
+  if (count == 0) {
+    return INVALID_OFFSET;
+  }
+
+  const auto range = std::ranges::find_if(m_free, [count](const auto& entry) { return entry.second >= count; });
+  if (range == m_free.end()) {
+    return INVALID_OFFSET;
+  }
+
+  // Take the front of the range, the rest stays free
+  const uint32_t offset = range->first;
+  const uint32_t remaining = range->second - count;
+  m_free.erase(range);
+  if (remaining > 0) {
+    m_free.emplace(offset + count, remaining);
+  }
+  m_used += count;
+  return offset;
+}
+
+void RangeAllocator::release(uint32_t offset, uint32_t count) {
+  if (count == 0 || offset == INVALID_OFFSET) {
+    return;
+  }
+  m_used -= count;
+
+  // Merge with the free range that ends here and the one that starts right after
+  auto next = m_free.lower_bound(offset);
+  if (next != m_free.begin()) {
+    const auto previous = std::prev(next);
+    if (previous->first + previous->second == offset) {
+      offset = previous->first;
+      count += previous->second;
+      m_free.erase(previous);
+    }
+  }
+  if (next != m_free.end() && offset + count == next->first) {
+    count += next->second;
+    m_free.erase(next);
+  }
+  m_free.emplace(offset, count);
+}
+
+void RangeAllocator::reset(uint32_t capacity) {
+  m_capacity = capacity;
+  m_used = 0;
+  m_free.clear();
+  if (capacity > 0) {
+    m_free.emplace(0, capacity);
+  }
+}
+
+uint32_t RangeAllocator::getLargestFree() const {
+  uint32_t largest = 0;
+  for (const auto& [offset, count] : m_free) {
+    largest = std::max(largest, count);
+  }
+  return largest;
+}
+
+}  // namespace util
@@ -0,0 +1,61 @@
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+#include <util/scene_snapshot.hpp>
+
+namespace util {
+
+SnapshotProducer::SnapshotProducer() : m_stop(false), m_paused(false), m_published(0) {}
+
+SnapshotProducer::~SnapshotProducer() { stop(); }
+
+bool SnapshotProducer::start(StepFunction step) {
+  if (m_thread.joinable()) {
+    return false;
+  }
+  m_stop.store(false, std::memory_order_relaxed);
+  m_thread = std::thread([this, step = std::move(step)] { run(step); });
+  return true;
+}
+
+void SnapshotProducer::stop() {
+  if (!m_thread.joinable()) {
+    return;
+  }
+  m_stop.store(true, std::memory_order_relaxed);
+
+  // Wake a paused producer so it can see the stop request
+  m_paused.store(false, std::memory_order_relaxed);
+  m_paused.notify_all();
+  m_thread.join();
+}
+
+void SnapshotProducer::setPaused(bool paused) {
+  m_paused.store(paused, std::memory_order_relaxed);
+  m_paused.notify_all();
+}
+
+const SceneSnapshot* SnapshotProducer::acquire() { return m_buffer.update() ? &m_buffer.read() : nullptr; }
+
+void SnapshotProducer::run(const StepFunction& step) {
+  uint64_t sequence = m_published.load(std::memory_order_relaxed);
+  while (!m_stop.load(std::memory_order_relaxed)) {
+    if (m_paused.load(std::memory_order_relaxed)) {
+      m_paused.wait(true, std::memory_order_relaxed);
+      continue;
+    }
+
+    SceneSnapshot& snapshot = m_buffer.write();
+    if (step(snapshot)) {
+      snapshot.sequence = ++sequence;
+      m_buffer.publish();
+      m_published.store(sequence, std::memory_order_relaxed);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+}  // namespace util
@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <util/glm.hpp>
+#include <util/spatial_index.hpp>
+
+namespace util {
+
+namespace {
+
+// Spread the low 10 bits of v so there are two zero bits between each
+uint32_t expandBits(uint32_t v) {
+  v = (v * 0x00010001u) & 0xFF0000FFu;
+  v = (v * 0x00000101u) & 0x0F00F00Fu;
+  v = (v * 0x00000011u) & 0xC30C30C3u;
+  v = (v * 0x00000005u) & 0x49249249u;
+  return v;
+}
+
+uint32_t mortonCode(const glm::vec3& normalized) {
+  const glm::vec3 q = glm::clamp(normalized * 1023.0f, 0.0f, 1023.0f);
+  return (expandBits(static_cast<uint32_t>(q.x)) << 2) | (expandBits(static_cast<uint32_t>(q.y)) << 1) |
+         expandBits(static_cast<uint32_t>(q.z));
+}
+
+}  // namespace
+
+AABB computeBounds(std::span<const glm::vec3> positions) {
+  AABB bounds;
+  for (const glm::vec3& p : positions) {
+    bounds.expand(p);
+  }
+  return bounds;
+}
+
+Frustum Frustum::fromMatrix(const glm::mat4& mvp) {
+  // Rows of the matrix (glm is column-major), planes after Gribb / Hartmann
+  const glm::vec4 row0(mvp[0][0], mvp[1][0], mvp[2][0], mvp[3][0]);
+  const glm::vec4 row1(mvp[0][1], mvp[1][1], mvp[2][1], mvp[3][1]);
+  const glm::vec4 row2(mvp[0][2], mvp[1][2], mvp[2][2], mvp[3][2]);
+  const glm::vec4 row3(mvp[0][3], mvp[1][3], mvp[2][3], mvp[3][3]);
+
+  Frustum frustum;
+  frustum.planes = {row3 + row0, row3 - row0, row3 + row1, row3 - row1, row3 + row2, row3 - row2};
+  return frustum;
+}
+
+bool Frustum::intersects(const AABB& box) const {
+  for (const glm::vec4& plane : planes) {
+    // Corner furthest along the plane normal
+    const glm::vec3 corner(plane.x >= 0.0f ? box.max.x : box.min.x, plane.y >= 0.0f ? box.max.y : box.min.y,
+                           plane.z >= 0.0f ? box.max.z : box.min.z);
+    if ((plane.x * corner.x) + (plane.y * corner.y) + (plane.z * corner.z) + plane.w < 0.0f) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<IndexChunk> buildIndexChunks(std::span<const glm::vec3> positions, std::vector<uint32_t>& indices,
+                                         uint32_t primitiveSize, uint32_t primitivesPerChunk) {
+  std::vector<IndexChunk> chunks;
+  if (primitiveSize == 0) {
+    return chunks;
+  }
+
+  const size_t primitiveCount = indices.size() / primitiveSize;
+  const size_t perChunk = std::max<uint32_t>(primitivesPerChunk, 1);
+  if (primitiveCount == 0) {
+    return chunks;
+  }
+
+  // Sort along the Morton curve only when there is more than one chunk to split into
+  if (primitiveCount > perChunk) {
+    std::vector<glm::vec3> centroids(primitiveCount);
+    AABB centroidBounds;
+    const float invSize = 1.0f / static_cast<float>(primitiveSize);
+    for (size_t i = 0; i < primitiveCount; ++i) {
+      glm::vec3 sum(0.0f);
+      for (uint32_t k = 0; k < primitiveSize; ++k) {
+        sum += positions[indices[(i * primitiveSize) + k]];
+      }
+      centroids[i] = sum * invSize;
+      centroidBounds.expand(centroids[i]);
+    }
+
+    // Flat axes (e.g. z of a 2D graph) map to 0
+    const glm::vec3 extent = centroidBounds.extent();
+    const glm::vec3 scale(extent.x > 0.0f ? 1.0f / extent.x : 0.0f, extent.y > 0.0f ? 1.0f / extent.y : 0.0f,
+                          extent.z > 0.0f ? 1.0f / extent.z : 0.0f);
+
+    // (code, primitive) pairs, ties broken by the original order
+    std::vector<std::pair<uint32_t, uint32_t>> keys(primitiveCount);
+    for (size_t i = 0; i < primitiveCount; ++i) {
+      keys[i] = {mortonCode((centroids[i] - centroidBounds.min) * scale), static_cast<uint32_t>(i)};
+    }
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<uint32_t> sorted(primitiveCount * primitiveSize);
+    for (size_t i = 0; i < primitiveCount; ++i) {
+      const size_t source = static_cast<size_t>(keys[i].second) * primitiveSize;
+      std::copy_n(indices.begin() + static_cast<std::ptrdiff_t>(source), primitiveSize,
+                  sorted.begin() + static_cast<std::ptrdiff_t>(i * primitiveSize));
+    }
+    indices = std::move(sorted);
+  } else {
+    indices.resize(primitiveCount * primitiveSize);
+  }
+
+  chunks.reserve((primitiveCount + perChunk - 1) / perChunk);
+  for (size_t first = 0; first < primitiveCount; first += perChunk) {
+    const size_t count = std::min(perChunk, primitiveCount - first);
+
+    IndexChunk chunk;
+    chunk.firstIndex = static_cast<uint32_t>(first * primitiveSize);
+    chunk.indexCount = static_cast<uint32_t>(count * primitiveSize);
+    for (uint32_t i = 0; i < chunk.indexCount; ++i) {
+      chunk.bounds.expand(positions[indices[chunk.firstIndex + i]]);
+    }
+    chunks.push_back(chunk);
+  }
+  return chunks;
+}
+
+}  // namespace util
@@ -0,0 +1,198 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <util/thread_pool.hpp>
+
+namespace util {
+
+namespace {
+
+// Set while a thread executes loop chunks, nested loops then run inline
+thread_local bool t_insideParallelFor = false;
+
+constexpr uint64_t packRange(uint64_t begin, uint64_t end) { return (end << 32) | begin; }
+constexpr uint32_t rangeBegin(uint64_t bounds) { return static_cast<uint32_t>(bounds); }
+constexpr uint32_t rangeEnd(uint64_t bounds) { return static_cast<uint32_t>(bounds >> 32); }
+
+}  // namespace
+
+ThreadPool::ThreadPool(uint32_t threadCount)
+    : m_generation(0),
+      m_activeWorkers(0),
+      m_stop(false),
+      m_body(nullptr),
+      m_begin(0),
+      m_end(0),
+      m_grainSize(1),
+      m_chunkCount(0),
+      m_completedChunks(0) {
+  if (threadCount == 0) {
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  m_ranges = std::make_unique<ChunkRange[]>(threadCount);
+  m_workers.reserve(threadCount - 1);
+  for (uint32_t i = 1; i < threadCount; ++i) {
+    m_workers.emplace_back([this, i] { workerLoop(i); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_wake.notify_all();
+  for (auto& worker : m_workers) {
+    worker.join();
+  }
+}
+
+ThreadPool& ThreadPool::global() {
+  static ThreadPool pool;
+  return pool;
+}
+
+void ThreadPool::parallelFor(size_t begin, size_t end, size_t grainSize,
+                             const std::function<void(size_t, size_t)>& body) {
+  if (begin >= end) {
+    return;
+  }
+
+  // Chunk indices are packed into 32 bits
+  grainSize = std::max({grainSize, size_t{1}, ((end - begin) / UINT32_MAX) + 1});
+  const size_t chunkCount = (end - begin + grainSize - 1) / grainSize;
+
+  // Nothing to share: run inline
+  if (m_workers.empty() || chunkCount == 1 || t_insideParallelFor) {
+    for (size_t chunkBegin = begin; chunkBegin < end; chunkBegin += grainSize) {
+      body(chunkBegin, std::min(end, chunkBegin + grainSize));
+    }
+    return;
+  }
+
+  std::lock_guard<std::mutex> submitLock(m_submitMutex);
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_body = &body;
+    m_begin = begin;
+    m_end = end;
+    m_grainSize = grainSize;
+    m_chunkCount = chunkCount;
+
+    // Even contiguous shares; threads that wake late find theirs stolen and help elsewhere
+    const uint32_t threadCount = getThreadCount();
+    for (uint32_t slot = 0; slot < threadCount; ++slot) {
+      m_ranges[slot].bounds.store(packRange(chunkCount * slot / threadCount, chunkCount * (slot + 1) / threadCount),
+                                  std::memory_order_relaxed);
+    }
+    m_completedChunks.store(0, std::memory_order_relaxed);
+    ++m_generation;
+  }
+  m_wake.notify_all();
+
+  t_insideParallelFor = true;
+  runChunks(0);
+  t_insideParallelFor = false;
+
+  // Wait for the last chunk and for every worker to leave this loop before the next one reuses the state
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_done.wait(lock, [this] { return m_activeWorkers == 0 && m_completedChunks.load() == m_chunkCount; });
+  m_body = nullptr;
+}
+
+void ThreadPool::workerLoop(uint32_t slot) {
+  t_insideParallelFor = true;
+  uint64_t seenGeneration = 0;
+
+  while (true) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_wake.wait(lock, [&] { return m_stop || m_generation != seenGeneration; });
+    if (m_stop) {
+      return;
+    }
+    seenGeneration = m_generation;
+    if (m_body == nullptr) {
+      continue;
+    }
+    ++m_activeWorkers;
+    lock.unlock();
+
+    runChunks(slot);
+
+    lock.lock();
+    if (--m_activeWorkers == 0) {
+      m_done.notify_all();
+    }
+  }
+}
+
+void ThreadPool::runChunks(uint32_t slot) {
+  uint32_t chunk = 0;
+  while (popChunk(slot, chunk) || stealChunk(slot, chunk)) {
+    const size_t chunkBegin = m_begin + (chunk * m_grainSize);
+    (*m_body)(chunkBegin, std::min(m_end, chunkBegin + m_grainSize));
+
+    if (m_completedChunks.fetch_add(1, std::memory_order_acq_rel) + 1 == m_chunkCount) {
+      // Take the lock so the waiting caller cannot miss the notification
+      { std::lock_guard<std::mutex> lock(m_mutex); }
+      m_done.notify_all();
+    }
+  }
+}
+
+bool ThreadPool::popChunk(uint32_t slot, uint32_t& chunk) {
+  // The owner takes from the front, thieves from the back
+  std::atomic<uint64_t>& bounds = m_ranges[slot].bounds;
+  uint64_t current = bounds.load(std::memory_order_acquire);
+  while (rangeBegin(current) < rangeEnd(current)) {
+    if (bounds.compare_exchange_weak(current, packRange(rangeBegin(current) + 1, rangeEnd(current)),
+                                     std::memory_order_acq_rel)) {
+      chunk = rangeBegin(current);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ThreadPool::stealChunk(uint32_t slot, uint32_t& chunk) {
+  const uint32_t threadCount = getThreadCount();
+  while (true) {
+    // Largest remaining share; a chunk can only ever leave a share, so an empty scan means the loop is drained
+    uint32_t victim = slot;
+    uint32_t largest = 0;
+    for (uint32_t offset = 1; offset < threadCount; ++offset) {
+      const uint32_t other = (slot + offset) % threadCount;
+      const uint64_t bounds = m_ranges[other].bounds.load(std::memory_order_relaxed);
+      const uint32_t remaining = rangeEnd(bounds) - std::min(rangeBegin(bounds), rangeEnd(bounds));
+      if (remaining > largest) {
+        victim = other;
+        largest = remaining;
+      }
+    }
+    if (victim == slot) {
+      return false;
+    }
+
+    // Take the back half (rounded up), run its first chunk and keep the rest as the new own share
+    std::atomic<uint64_t>& bounds = m_ranges[victim].bounds;
+    uint64_t current = bounds.load(std::memory_order_acquire);
+    while (rangeBegin(current) < rangeEnd(current)) {
+      const uint32_t begin = rangeBegin(current);
+      const uint32_t end = rangeEnd(current);
+      const uint32_t split = end - ((end - begin + 1) / 2);
+      if (bounds.compare_exchange_weak(current, packRange(begin, split), std::memory_order_acq_rel)) {
+        m_ranges[slot].bounds.store(packRange(split + 1, end), std::memory_order_release);
+        chunk = split;
+        return true;
+      }
+    }
+  }
+}
+
+}  // namespace util
@@ -0,0 +1,146 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <graph/analytics.hpp>
+#include <util/graph.hpp>
+#include <util/graph_generators.hpp>
+#include <util/thread_pool.hpp>
+
+using util::Edge;
+using util::Graph;
+
+namespace {
+
+// Serial queue BFS as the reference
+std::vector<uint32_t> referenceDistances(const Graph& graph, uint32_t source) {
+  std::vector<uint32_t> distances(graph.nodeCount(), graph::UNREACHED);
+  std::vector<uint32_t> queue = {source};
+  distances[source] = 0;
+  for (size_t head = 0; head < queue.size(); ++head) {
+    for (const uint32_t w : graph.neighborsOf(queue[head])) {
+      if (distances[w] == graph::UNREACHED) {
+        distances[w] = distances[queue[head]] + 1;
+        queue.push_back(w);
+      }
+    }
+  }
+  return distances;
+}
+
+}  // namespace
+
+TEST_CASE("direction-optimizing BFS matches a serial BFS") {
+  util::ThreadPool pool(4);
+
+  // Long-diameter grid: small frontiers, top-down throughout
+  const Graph grid = util::gridGraph(200, 150);
+  const uint32_t source = (70 * 200) + 90;
+  const std::vector<uint32_t> gridDistances = graph::bfsDistances(grid, source, pool);
+  CHECK(gridDistances[0] == 90 + 70);
+  CHECK(gridDistances == referenceDistances(grid, source));
+
+  // Random graph: the frontier explodes within a few levels, so the middle levels go bottom-up
+  std::mt19937 rng(7);
+  std::vector<Edge> edges;
+  for (uint32_t i = 0; i < 200'000; ++i) {
+    edges.emplace_back(static_cast<uint32_t>(rng() % 40'000), static_cast<uint32_t>(rng() % 40'000));
+  }
+  const Graph random = Graph::fromEdges(40'000, edges);
+  CHECK(graph::bfsDistances(random, 0, pool) == referenceDistances(random, 0));
+
+  // Directed version: bottom-up steps need the transposed adjacency
+  util::GraphBuildOptions options;
+  options.directed = true;
+  const Graph directed = Graph::fromEdges(40'000, edges, {}, options);
+  CHECK(graph::bfsDistances(directed, 0, pool) == referenceDistances(directed, 0));
+}
+
+TEST_CASE("BFS follows out-edges of directed graphs and marks unreachable nodes") {
+  util::GraphBuildOptions options;
+  options.directed = true;
+  const std::vector<Edge> edges = {{0, 1}, {1, 2}, {2, 3}, {4, 0}};
+  const Graph chain = Graph::fromEdges(6, edges, {}, options);
+
+  const std::vector<uint32_t> distances = graph::bfsDistances(chain, 0);
+  CHECK(distances == std::vector<uint32_t>{0, 1, 2, 3, graph::UNREACHED, graph::UNREACHED});
+  CHECK(graph::bfsDistances(chain, 99) == std::vector<uint32_t>(6, graph::UNREACHED));
+}
+
+TEST_CASE("components are numbered by their smallest node") {
+  const std::vector<Edge> edges = {{5, 3}, {3, 7}, {1, 2}, {8, 1}};
+  const Graph graph = Graph::fromEdges(9, edges);
+  util::ThreadPool pool(4);
+
+  const graph::Components components = graph::connectedComponents(graph, pool);
+  CHECK(components.count == 5);
+  CHECK(components.labels == std::vector<uint32_t>{0, 1, 1, 2, 3, 2, 4, 2, 1});
+
+  // A long random-order chain merges into one component regardless of the linking order
+  std::vector<Edge> chain;
+  for (uint32_t i = 0; i + 1 < 50'000; ++i) {
+    chain.emplace_back((i * 7919) % 50'000, ((i + 1) * 7919) % 50'000);
+  }
+  const graph::Components single = graph::connectedComponents(Graph::fromEdges(50'000, chain), pool);
+  CHECK(single.count == 1);
+}
+
+TEST_CASE("PageRank sums to one and ranks the hub of a star highest") {
+  std::vector<Edge> edges;
+  for (uint32_t i = 1; i < 50; ++i) {
+    edges.emplace_back(0, i);
+  }
+  const Graph star = Graph::fromEdges(50, edges);
+
+  const std::vector<float> ranks = graph::pageRank(star);
+  REQUIRE(ranks.size() == 50);
+  CHECK(std::accumulate(ranks.begin(), ranks.end(), 0.0) == doctest::Approx(1.0).epsilon(1e-4));
+  CHECK(ranks[0] > 10.0f * ranks[1]);
+  CHECK(ranks[1] == doctest::Approx(ranks[49]));
+
+  // Symmetric ring: uniform, and the directed ring with a dangling end still sums to one
+  std::vector<Edge> ring;
+  for (uint32_t i = 0; i < 10; ++i) {
+    ring.emplace_back(i, (i + 1) % 10);
+  }
+  for (const float rank : graph::pageRank(Graph::fromEdges(10, ring))) {
+    CHECK(rank == doctest::Approx(0.1f));
+  }
+  util::GraphBuildOptions options;
+  options.directed = true;
+  ring.pop_back();
+  const std::vector<float> directed = graph::pageRank(Graph::fromEdges(10, ring, {}, options));
+  CHECK(std::accumulate(directed.begin(), directed.end(), 0.0) == doctest::Approx(1.0).epsilon(1e-4));
+  CHECK(directed[9] > directed[0]);
+}
+
+TEST_CASE("degree centrality and encodings rescale to the value range") {
+  const std::vector<Edge> edges = {{0, 1}, {0, 2}, {0, 3}, {1, 2}};
+  Graph graph = Graph::fromEdges(5, edges);
+
+  const std::vector<float> centrality = graph::degreeCentrality(graph);
+  CHECK(centrality == std::vector<float>{1.0f, 2.0f / 3.0f, 2.0f / 3.0f, 1.0f / 3.0f, 0.0f});
+
+  graph::sizeByValue(centrality, graph.sizes, 2.0f, 10.0f);
+  CHECK(graph.sizes[0] == doctest::Approx(10.0f));
+  CHECK(graph.sizes[3] == doctest::Approx(2.0f + (8.0f / 3.0f)));
+  CHECK(graph.sizes[4] == doctest::Approx(2.0f));
+
+  graph::colorByValue(centrality, graph.colors);
+  CHECK(graph.colors[0] == graph::rampColor(1.0f));
+  CHECK(graph.colors[4] == graph::rampColor(0.0f));
+
+  const util::Color unreached(0.0f, 0.0f, 0.0f, 1.0f);
+  graph::colorByDistance(std::vector<uint32_t>{0, 2, graph::UNREACHED, 4, 1}, graph.colors, unreached);
+  CHECK(graph.colors[1] == graph::rampColor(0.5f));
+  CHECK(graph.colors[2] == unreached);
+
+  graph::colorByCategory(std::vector<uint32_t>{0, 1, 0, 2, 1}, graph.colors);
+  CHECK(graph.colors[0] == graph.colors[2]);
+  CHECK(graph.colors[0] != graph.colors[1]);
+  CHECK(graph.colors[1] != graph.colors[3]);
+}
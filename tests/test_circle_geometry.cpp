@@ -0,0 +1,49 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <span>
+
+#include <util/circle_geometry.hpp>
+#include <util/glm.hpp>
+
+TEST_CASE("unit circles are closed loops on the unit circle") {
+  for (uint32_t level = 0; level < util::CIRCLE_LEVEL_COUNT; ++level) {
+    const std::span<const glm::vec2> circle = util::unitCircle(level);
+    REQUIRE(circle.size() == util::circleSegments(level) + 1);
+    CHECK(circle.front() == circle.back());
+    CHECK(circle[0].x == doctest::Approx(1.0f));
+    CHECK(circle[0].y == doctest::Approx(0.0f));
+    for (const glm::vec2& point : circle) {
+      CHECK(glm::length(point) == doctest::Approx(1.0f));
+    }
+
+    // Counter-clockwise, a quarter turn after a quarter of the segments
+    CHECK(circle[circle.size() / 4].y == doctest::Approx(1.0f));
+  }
+}
+
+TEST_CASE("circle level grows with the radius and bounds the chord error") {
+  CHECK(util::circleLevel(0.0f) == 0);
+  CHECK(util::circleLevel(1.0f) == 0);
+  CHECK(util::circleLevel(1e6f) == util::CIRCLE_LEVEL_COUNT - 1);
+
+  uint32_t previous = 0;
+  for (float radius = 0.5f; radius < 2000.0f; radius *= 1.5f) {
+    const uint32_t level = util::circleLevel(radius);
+    CHECK(level >= previous);
+    previous = level;
+
+    // Midpoint of a chord is the point of the polygon farthest from the circle
+    if (level + 1 < util::CIRCLE_LEVEL_COUNT) {
+      const std::span<const glm::vec2> circle = util::unitCircle(level);
+      const float error = radius * (1.0f - glm::length(0.5f * (circle[0] + circle[1])));
+      CHECK(error <= util::CIRCLE_MAX_ERROR + 1e-4f);
+    }
+  }
+}
+
+TEST_CASE("out of range levels clamp to the finest circle") {
+  CHECK(util::unitCircle(100).size() == util::unitCircle(util::CIRCLE_LEVEL_COUNT - 1).size());
+}
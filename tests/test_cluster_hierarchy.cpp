@@ -0,0 +1,131 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include <glm/ext/matrix_clip_space.hpp>
+
+#include <graph/cluster_hierarchy.hpp>
+
+#include <util/glm.hpp>
+#include <util/graph.hpp>
+
+using graph::ClusterHierarchy;
+using graph::ClusterParams;
+using util::Edge;
+using util::Graph;
+
+namespace {
+
+// side x side grid graph with unit spacing
+Graph gridGraph(uint32_t side) {
+  std::vector<Edge> edges;
+  for (uint32_t y = 0; y < side; ++y) {
+    for (uint32_t x = 0; x < side; ++x) {
+      const uint32_t v = (y * side) + x;
+      if (x + 1 < side) {
+        edges.emplace_back(v, v + 1);
+      }
+      if (y + 1 < side) {
+        edges.emplace_back(v, v + side);
+      }
+    }
+  }
+  Graph graph = Graph::fromEdges(side * side, edges);
+  for (uint32_t v = 0; v < side * side; ++v) {
+    graph.positions[v] = glm::vec3(static_cast<float>(v % side), static_cast<float>(v / side), 0.0f);
+  }
+  return graph;
+}
+
+}  // namespace
+
+TEST_CASE("every level partitions the input and bundles the crossing edges") {
+  const Graph graph = gridGraph(32);
+  ClusterHierarchy hierarchy;
+  hierarchy.build(graph);
+
+  REQUIRE(hierarchy.getLevelCount() >= 3);
+  CHECK_FALSE(hierarchy.isBuilding());
+
+  // Input node -> super-node of the current level
+  std::vector<uint32_t> top(graph.nodeCount());
+  std::iota(top.begin(), top.end(), 0u);
+
+  for (uint32_t level = 1; level <= hierarchy.getLevelCount(); ++level) {
+    const graph::ClusterLevel& coarse = hierarchy.getLevel(level);
+    CHECK(coarse.graph.nodeCount() < hierarchy.getNodeCount(level - 1));
+    CHECK(coarse.parents.size() == hierarchy.getNodeCount(level - 1));
+    CHECK(std::accumulate(coarse.memberCounts.begin(), coarse.memberCounts.end(), 0u) == graph.nodeCount());
+
+    for (uint32_t& node : top) {
+      node = coarse.parents[node];
+    }
+
+    // Super-edge weights add up to the input edges between different clusters
+    float crossing = 0.0f;
+    for (const Edge& edge : graph.edges) {
+      crossing += top[edge.source] != top[edge.target] ? 1.0f : 0.0f;
+    }
+    CHECK(std::accumulate(coarse.graph.weights.begin(), coarse.graph.weights.end(), 0.0f) ==
+          doctest::Approx(crossing));
+  }
+}
+
+TEST_CASE("super-nodes sit at the centroid of their members") {
+  Graph graph = gridGraph(16);
+  ClusterHierarchy hierarchy;
+  hierarchy.build(graph);
+  REQUIRE(hierarchy.getLevelCount() >= 1);
+
+  // Shift everything, the aggregated positions follow
+  for (glm::vec3& p : graph.positions) {
+    p += glm::vec3(100.0f, 0.0f, 0.0f);
+  }
+  hierarchy.updatePositions(graph.positions);
+
+  const graph::ClusterLevel& level = hierarchy.getLevel(1);
+  std::vector<glm::vec3> sums(level.graph.nodeCount(), glm::vec3(0.0f));
+  for (uint32_t v = 0; v < graph.nodeCount(); ++v) {
+    sums[level.parents[v]] += graph.positions[v];
+  }
+  for (uint32_t c = 0; c < level.graph.nodeCount(); ++c) {
+    const glm::vec3 expected = sums[c] / static_cast<float>(level.memberCounts[c]);
+    CHECK(level.graph.positions[c].x == doctest::Approx(expected.x));
+    CHECK(level.graph.positions[c].y == doctest::Approx(expected.y));
+  }
+}
+
+TEST_CASE("background build publishes the same levels and zooming out selects coarser ones") {
+  const Graph graph = gridGraph(64);
+
+  ClusterHierarchy reference;
+  reference.build(graph);
+
+  ClusterHierarchy hierarchy;
+  hierarchy.buildAsync(graph);
+  while (hierarchy.isBuilding()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  REQUIRE(hierarchy.getLevelCount() == reference.getLevelCount());
+  for (uint32_t level = 1; level <= hierarchy.getLevelCount(); ++level) {
+    CHECK(hierarchy.getNodeCount(level) == reference.getNodeCount(level));
+  }
+
+  // 8064 edges: a tight density limit needs a coarse level when the whole grid covers 64 x 64 pixels
+  graph::LodParams params;
+  params.maxEdgesPerPixel = 0.25f;
+  const glm::vec2 viewport(640.0f, 640.0f);
+  const glm::mat4 far = glm::ortho(-288.0f, 352.0f, -288.0f, 352.0f, -1.0f, 1.0f);
+  const glm::mat4 near = glm::ortho(0.0f, 16.0f, 0.0f, 16.0f, -1.0f, 1.0f);
+
+  const uint32_t farLevel = hierarchy.selectLevel(far, viewport, params);
+  const uint32_t nearLevel = hierarchy.selectLevel(near, viewport, params);
+  CHECK(nearLevel == 0);
+  CHECK(farLevel > nearLevel);
+  CHECK(static_cast<float>(hierarchy.getEdgeCount(farLevel)) / (63.0f * 63.0f) <= 0.25f);
+}
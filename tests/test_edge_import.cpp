@@ -0,0 +1,117 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <util/edge_import.hpp>
+#include <util/graph.hpp>
+#include <util/thread_pool.hpp>
+
+using util::EdgeFileFormat;
+using util::EdgeImportOptions;
+using util::Graph;
+
+TEST_CASE("CSV with a header row and weights") {
+  const std::string text = "source,target,weight\n0,1,0.5\n1,2,2\n\n# comment\n2,0,1.25\r\n3,3,9\n";
+  Graph graph;
+  REQUIRE(util::importEdgeList(text, graph));
+
+  // The self loop on 3 is dropped but still defines the node
+  CHECK(graph.nodeCount() == 4);
+  REQUIRE(graph.edgeCount() == 3);
+  CHECK(graph.edges[2].source == 2);
+  CHECK(graph.edges[2].target == 0);
+  CHECK(graph.weights == std::vector<float>{0.5f, 2.0f, 1.25f});
+  CHECK(graph.degree(0) == 2);
+}
+
+TEST_CASE("SNAP comments and Matrix Market symmetric storage") {
+  const std::string snap = "# Directed graph\n# FromNodeId\tToNodeId\n0\t5\n5\t2\n2\t0\n";
+  EdgeImportOptions options;
+  options.build.directed = true;
+  Graph directed;
+  REQUIRE(util::importEdgeList(snap, directed, options));
+  CHECK(directed.nodeCount() == 6);
+  CHECK(directed.edgeCount() == 3);
+  CHECK(directed.directed);
+  CHECK(directed.weights == std::vector<float>{1.0f, 1.0f, 1.0f});
+
+  const std::string mm =
+      "%%MatrixMarket matrix coordinate pattern symmetric\n% lower triangle\n5 5 3\n2 1\n3 1\n5 4\n";
+  Graph symmetric;
+  REQUIRE(util::importEdgeList(mm, symmetric, options));
+  CHECK(symmetric.nodeCount() == 5);
+  CHECK_FALSE(symmetric.directed);
+  REQUIRE(symmetric.edgeCount() == 3);
+  CHECK(symmetric.edges[0].source == 1);
+  CHECK(symmetric.edges[0].target == 0);
+  CHECK(symmetric.degree(0) == 2);
+  CHECK(symmetric.degree(4) == 1);
+}
+
+TEST_CASE("an explicit format is not overridden by the first line") {
+  EdgeImportOptions options;
+  options.format = EdgeFileFormat::Snap;
+  Graph snap;
+  REQUIRE(util::importEdgeList("# FromNodeId\tToNodeId\n0\t1\n1\t2\n", snap, options));
+  CHECK(snap.nodeCount() == 3);
+  CHECK(snap.edgeCount() == 2);
+
+  // A comma does not turn Snap into CSV, so there is no header row to skip
+  const std::string headed = "source,target\n0,1\n";
+  Graph detected;
+  CHECK(util::importEdgeList(headed, detected));
+  Graph strict;
+  CHECK_FALSE(util::importEdgeList(headed, strict, options));
+}
+
+TEST_CASE("malformed lines and out of range ids fail the import") {
+  Graph graph;
+  CHECK_FALSE(util::importEdgeList("0 1\n1 x\n", graph));
+  CHECK_FALSE(util::importEdgeList("0 -1\n", graph));
+  CHECK_FALSE(util::importEdgeList("%%MatrixMarket matrix coordinate real general\n3 3 1\n4 1 1.0\n", graph));
+  CHECK_FALSE(util::importEdgeList("%%MatrixMarket matrix coordinate real general\n3 3 1\n0 1 1.0\n", graph));
+  CHECK_FALSE(util::importEdgeList("%%MatrixMarket matrix array real general\n3 3\n1.0\n", graph));
+}
+
+TEST_CASE("tiny chunks and threads parse like a single chunk, also from a file") {
+  std::string text;
+  for (uint32_t v = 0; v < 20000; ++v) {
+    text += std::to_string(v) + " " + std::to_string((v * 7919u) % 20000u) + "\n";
+  }
+
+  util::ThreadPool serial(1);
+  EdgeImportOptions whole;
+  whole.chunkBytes = text.size();
+  Graph reference;
+  REQUIRE(util::importEdgeList(text, reference, whole, serial));
+
+  util::ThreadPool pool(4);
+  EdgeImportOptions chunked;
+  chunked.chunkBytes = 100;
+  Graph graph;
+  REQUIRE(util::importEdgeList(text, graph, chunked, pool));
+
+  CHECK(graph.nodeCount() == reference.nodeCount());
+  REQUIRE(graph.edgeCount() == reference.edgeCount());
+  for (uint32_t e = 0; e < graph.edgeCount(); ++e) {
+    CHECK(graph.edges[e].source == reference.edges[e].source);
+    CHECK(graph.edges[e].target == reference.edges[e].target);
+  }
+  CHECK(graph.offsets == reference.offsets);
+  CHECK(graph.neighbors == reference.neighbors);
+
+  const std::string path = (std::filesystem::temp_directory_path() / "graph_lab_edges.txt").string();
+  {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << text;
+  }
+  Graph loaded;
+  REQUIRE(util::importEdgeListFile(path, loaded, chunked, pool));
+  CHECK(loaded.neighbors == reference.neighbors);
+  std::filesystem::remove(path);
+}
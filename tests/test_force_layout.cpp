@@ -0,0 +1,138 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <graph/force_layout.hpp>
+#include <util/glm.hpp>
+#include <util/graph.hpp>
+#include <util/thread_pool.hpp>
+
+using util::Edge;
+
+namespace {
+
+// Two 20-node rings joined by a single bridge edge
+util::Graph makeTwoRings() {
+  std::vector<Edge> edges;
+  for (uint32_t i = 0; i < 20; ++i) {
+    edges.emplace_back(i, (i + 1) % 20);
+    edges.emplace_back(20 + i, 20 + ((i + 1) % 20));
+  }
+  edges.emplace_back(0, 20);
+  return util::Graph::fromEdges(40, edges);
+}
+
+float distance(const glm::vec3& a, const glm::vec3& b) {
+  const glm::vec3 d = a - b;
+  return std::sqrt(glm::dot(d, d));
+}
+
+}  // namespace
+
+TEST_CASE("layout pulls neighbors together and pushes the rings apart") {
+  util::Graph graph = makeTwoRings();
+  util::ThreadPool pool(4);
+
+  graph::ForceLayout layout;
+  REQUIRE(layout.initialize(graph, graph::LayoutParams(), pool));
+  layout.step(300);
+
+  const auto& p = layout.getPositions();
+  REQUIRE(p.size() == 40);
+
+  float edgeLength = 0.0f;
+  for (uint32_t i = 0; i < 20; ++i) {
+    edgeLength += distance(p[i], p[(i + 1) % 20]) / 20.0f;
+  }
+
+  // Centers of the two rings
+  glm::vec3 a(0.0f);
+  glm::vec3 b(0.0f);
+  for (uint32_t i = 0; i < 20; ++i) {
+    a += p[i] / 20.0f;
+    b += p[20 + i] / 20.0f;
+  }
+
+  CHECK(edgeLength < distance(a, b));
+  CHECK(layout.getIteration() == 300);
+
+  // 2D layouts stay in the z = 0 plane
+  for (const auto& position : p) {
+    CHECK(position.z == 0.0f);
+  }
+}
+
+TEST_CASE("Barnes-Hut repulsion stays close to the exact sum") {
+  util::Graph graph = makeTwoRings();
+  util::ThreadPool pool(1);
+
+  graph::LayoutParams exact;
+  exact.theta = 0.0f;
+  graph::LayoutParams approx;
+  approx.theta = 0.5f;
+
+  graph::ForceLayout a;
+  graph::ForceLayout b;
+  REQUIRE(a.initialize(graph, exact, pool));
+  REQUIRE(b.initialize(graph, approx, pool));
+  a.step(1);
+  b.step(1);
+
+  for (uint32_t i = 0; i < 40; ++i) {
+    CHECK(distance(a.getPositions()[i], b.getPositions()[i]) < 0.05f);
+  }
+}
+
+TEST_CASE("cells containing the node are never approximated") {
+  // Two small rings far apart: with a huge opening angle the root would be approximated for every node,
+  // replacing the repulsion within each ring by a push away from the midpoint
+  const uint32_t ringSize = 20;
+  util::Graph graph = util::Graph::fromEdges(2 * ringSize, {});
+  for (uint32_t i = 0; i < ringSize; ++i) {
+    const float angle = 6.2831853f * static_cast<float>(i) / static_cast<float>(ringSize);
+    const glm::vec3 offset(0.5f * std::cos(angle), 0.5f * std::sin(angle), 0.0f);
+    graph.positions[i] = glm::vec3(-50.0f, 0.0f, 0.0f) + offset;
+    graph.positions[ringSize + i] = glm::vec3(50.0f, 0.0f, 0.0f) + offset;
+  }
+  util::ThreadPool pool(1);
+
+  graph::LayoutParams exact;
+  exact.theta = 0.0f;
+  graph::LayoutParams wide;
+  wide.theta = 100.0f;
+
+  graph::ForceLayout a;
+  graph::ForceLayout b;
+  REQUIRE(a.initialize(graph, exact, pool));
+  REQUIRE(b.initialize(graph, wide, pool));
+  a.step(1);
+  b.step(1);
+
+  for (uint32_t i = 0; i < 2 * ringSize; ++i) {
+    CHECK(distance(a.getPositions()[i], b.getPositions()[i]) < 0.05f);
+  }
+}
+
+TEST_CASE("thread count does not change the result") {
+  util::Graph graph = makeTwoRings();
+  util::ThreadPool serial(1);
+  util::ThreadPool parallel(4);
+
+  graph::LayoutParams params;
+  params.dimensions = 3;
+
+  graph::ForceLayout a;
+  graph::ForceLayout b;
+  REQUIRE(a.initialize(graph, params, serial));
+  REQUIRE(b.initialize(graph, params, parallel));
+  a.step(20);
+  b.step(20);
+
+  CHECK(a.getPositions() == b.getPositions());
+
+  a.writePositions(graph);
+  CHECK(graph.positions == a.getPositions());
+}
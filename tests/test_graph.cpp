@@ -0,0 +1,100 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <util/graph.hpp>
+#include <util/thread_pool.hpp>
+
+using util::Edge;
+using util::Graph;
+
+TEST_CASE("parallelFor visits every index exactly once") {
+  util::ThreadPool pool(4);
+  std::vector<std::atomic<uint32_t>> visits(10'000);
+
+  pool.parallelFor(0, visits.size(), 97, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      visits[i].fetch_add(1);
+    }
+  });
+
+  for (const auto& v : visits) {
+    CHECK(v.load() == 1);
+  }
+}
+
+TEST_CASE("parallelFor steals from threads stuck on expensive chunks") {
+  util::ThreadPool pool(4);
+
+  // All the work sits in the first thread's share; back-to-back loops reuse the per-thread ranges
+  for (uint32_t loop = 0; loop < 20; ++loop) {
+    std::vector<std::atomic<uint32_t>> visits(4'000);
+    pool.parallelFor(0, visits.size(), 1, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        if (i < 1'000) {
+          volatile uint32_t spin = 0;
+          while (spin < 2'000) {
+            spin = spin + 1;
+          }
+        }
+        visits[i].fetch_add(1);
+      }
+    });
+    CHECK(std::ranges::all_of(visits, [](const std::atomic<uint32_t>& v) { return v.load() == 1; }));
+  }
+}
+
+TEST_CASE("undirected CSR lists both endpoints with sorted neighbors") {
+  const std::vector<Edge> edges = {{0, 2}, {0, 1}, {2, 1}, {3, 0}};
+  Graph graph = Graph::fromEdges(4, edges);
+
+  REQUIRE(graph.nodeCount() == 4);
+  REQUIRE(graph.edgeCount() == 4);
+  CHECK(graph.offsets == std::vector<uint32_t>{0, 3, 5, 7, 8});
+  CHECK(graph.neighbors == std::vector<uint32_t>{1, 2, 3, 0, 2, 0, 1, 0});
+
+  // Adjacency slots point back at the original edge
+  CHECK(graph.edgeIdsOf(0)[0] == 1);
+  CHECK(graph.edgeIdsOf(0)[2] == 3);
+  CHECK(graph.degree(3) == 1);
+
+  // Default node attributes
+  CHECK(graph.positions.size() == 4);
+  CHECK(graph.colors.size() == 4);
+  CHECK(graph.sizes.size() == 4);
+}
+
+TEST_CASE("directed build drops invalid edges and self loops, keeping weights aligned") {
+  const std::vector<Edge> edges = {{0, 1}, {1, 1}, {1, 7}, {1, 2}};
+  const std::vector<float> weights = {0.5f, 1.5f, 2.5f, 3.5f};
+
+  util::GraphBuildOptions options;
+  options.directed = true;
+  Graph graph = Graph::fromEdges(3, edges, weights, options);
+
+  REQUIRE(graph.edgeCount() == 2);
+  CHECK(graph.edges[1].source == 1);
+  CHECK(graph.edges[1].target == 2);
+  CHECK(graph.weights == std::vector<float>{0.5f, 3.5f});
+  CHECK(graph.offsets == std::vector<uint32_t>{0, 1, 2, 2});
+}
+
+TEST_CASE("parallel build matches a single-threaded build") {
+  std::vector<Edge> edges;
+  for (uint32_t i = 0; i < 200'000; ++i) {
+    edges.emplace_back((i * 7919u) % 5000u, (i * 104729u) % 5000u);
+  }
+
+  util::ThreadPool serial(1);
+  util::ThreadPool parallel(4);
+  Graph a = Graph::fromEdges(5000, edges, {}, util::GraphBuildOptions(), serial);
+  Graph b = Graph::fromEdges(5000, edges, {}, util::GraphBuildOptions(), parallel);
+
+  CHECK(a.offsets == b.offsets);
+  CHECK(a.neighbors == b.neighbors);
+  CHECK(a.edgeIds == b.edgeIds);
+}
@@ -0,0 +1,54 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <cstdint>
+
+#include <util/graph.hpp>
+#include <util/graph_generators.hpp>
+
+using util::Edge;
+using util::Graph;
+
+namespace {
+
+bool hasSelfLoops(const Graph& graph) {
+  return std::ranges::any_of(graph.edges, [](const Edge& edge) { return edge.source == edge.target; });
+}
+
+}  // namespace
+
+TEST_CASE("grid graph links every node to its lattice neighbors") {
+  const Graph grid = util::gridGraph(30, 20);
+  CHECK(grid.nodeCount() == 600);
+  CHECK(grid.edgeCount() == (29 * 20) + (30 * 19));
+  CHECK(grid.degree(0) == 2);
+  CHECK(grid.degree((5 * 30) + 7) == 4);
+  CHECK(grid.positions[(5 * 30) + 7].x == doctest::Approx(7.0f));
+  CHECK(grid.positions[(5 * 30) + 7].y == doctest::Approx(5.0f));
+}
+
+TEST_CASE("random graph has the requested average degree and no self loops") {
+  const Graph graph = util::randomGraph(10'000, 8, 3);
+  CHECK(graph.nodeCount() == 10'000);
+  CHECK(graph.edgeCount() == 40'000);
+  CHECK_FALSE(hasSelfLoops(graph));
+
+  // Same seed, same graph
+  const Graph again = util::randomGraph(10'000, 8, 3);
+  CHECK(std::ranges::equal(graph.neighbors, again.neighbors));
+}
+
+TEST_CASE("scale-free graph grows hubs far above the average degree") {
+  const Graph graph = util::scaleFreeGraph(20'000, 3, 5);
+  CHECK(graph.nodeCount() == 20'000);
+  CHECK(graph.edgeCount() == (20'000 - 3) * 3);
+  CHECK_FALSE(hasSelfLoops(graph));
+
+  uint32_t maxDegree = 0;
+  for (uint32_t v = 0; v < graph.nodeCount(); ++v) {
+    maxDegree = std::max(maxDegree, graph.degree(v));
+  }
+  // Average degree is about 6, preferential attachment produces hubs with hundreds of links
+  CHECK(maxDegree > 100);
+}
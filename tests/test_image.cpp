@@ -0,0 +1,143 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <util/glm.hpp>
+#include <util/image.hpp>
+
+namespace {
+
+uint32_t readBigEndian(const std::vector<uint8_t>& bytes, size_t offset) {
+  return (uint32_t{bytes[offset]} << 24) | (uint32_t{bytes[offset + 1]} << 16) | (uint32_t{bytes[offset + 2]} << 8) |
+         uint32_t{bytes[offset + 3]};
+}
+
+// Chunk types in order plus the concatenated IDAT payload
+struct PngChunks {
+  std::vector<std::string> types;
+  std::vector<uint8_t> data;
+};
+
+PngChunks readChunks(const std::vector<uint8_t>& png) {
+  PngChunks chunks;
+  size_t offset = 8;
+  while (offset + 12 <= png.size()) {
+    const uint32_t length = readBigEndian(png, offset);
+    const std::string type(png.begin() + static_cast<ptrdiff_t>(offset + 4),
+                           png.begin() + static_cast<ptrdiff_t>(offset + 8));
+    chunks.types.push_back(type);
+    if (type == "IDAT") {
+      chunks.data.insert(chunks.data.end(), png.begin() + static_cast<ptrdiff_t>(offset + 8),
+                         png.begin() + static_cast<ptrdiff_t>(offset + 8 + length));
+    }
+    offset += 12 + length;
+  }
+  return chunks;
+}
+
+// Inflate a zlib stream made of stored blocks only
+std::vector<uint8_t> inflateStored(const std::vector<uint8_t>& zlib) {
+  std::vector<uint8_t> out;
+  size_t offset = 2;
+  bool last = false;
+  while (!last && offset + 5 <= zlib.size()) {
+    last = (zlib[offset] & 1) != 0;
+    const size_t length = zlib[offset + 1] | (size_t{zlib[offset + 2]} << 8);
+    const size_t nlength = zlib[offset + 3] | (size_t{zlib[offset + 4]} << 8);
+    CHECK((length ^ nlength) == 0xFFFF);
+    out.insert(out.end(), zlib.begin() + static_cast<ptrdiff_t>(offset + 5),
+               zlib.begin() + static_cast<ptrdiff_t>(offset + 5 + length));
+    offset += 5 + length;
+  }
+  CHECK(last);
+  return out;
+}
+
+}  // namespace
+
+TEST_CASE("encodePng writes a valid stored-block RGBA image") {
+  // Wide enough that the scanlines span several stored blocks
+  const uint32_t width = 300;
+  const uint32_t height = 70;
+  std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+  for (size_t i = 0; i < rgba.size(); ++i) {
+    rgba[i] = static_cast<uint8_t>(i * 7);
+  }
+
+  const std::vector<uint8_t> png = util::encodePng(width, height, rgba);
+  REQUIRE(png.size() > 8);
+  CHECK(png[0] == 0x89);
+  CHECK(png[1] == 'P');
+
+  const PngChunks chunks = readChunks(png);
+  REQUIRE(chunks.types.size() >= 3);
+  CHECK(chunks.types.front() == "IHDR");
+  CHECK(chunks.types.back() == "IEND");
+  CHECK(readBigEndian(png, 16) == width);
+  CHECK(readBigEndian(png, 20) == height);
+  CHECK(png[24] == 8);
+  CHECK(png[25] == 6);
+
+  // IEND carries the well-known CRC of its type alone
+  CHECK(readBigEndian(png, png.size() - 4) == 0xAE426082u);
+
+  // Every scanline is the filter byte 0 followed by the source row
+  const std::vector<uint8_t> scanlines = inflateStored(chunks.data);
+  REQUIRE(scanlines.size() == (static_cast<size_t>(width) * 4 + 1) * height);
+  for (uint32_t row = 0; row < height; ++row) {
+    const size_t start = row * (static_cast<size_t>(width) * 4 + 1);
+    CHECK(scanlines[start] == 0);
+    CHECK(scanlines[start + 1] == rgba[row * static_cast<size_t>(width) * 4]);
+  }
+
+  CHECK(util::encodePng(width, height, std::vector<uint8_t>(10)).empty());
+}
+
+TEST_CASE("flipRows reverses the row order") {
+  std::vector<uint8_t> pixels = {1, 1, 2, 2, 3, 3};
+  util::flipRows(pixels, 2);
+  CHECK(pixels == std::vector<uint8_t>{3, 3, 2, 2, 1, 1});
+}
+
+TEST_CASE("tiles cover the image and reassemble it") {
+  const std::vector<util::ImageTile> tiles = util::tileImage(10, 7, 4);
+  REQUIRE(tiles.size() == 6);
+  CHECK(tiles[2].x == 8);
+  CHECK(tiles[2].width == 2);
+  CHECK(tiles[3].y == 4);
+  CHECK(tiles[3].height == 3);
+
+  uint64_t area = 0;
+  std::vector<uint8_t> image(10 * 7 * 4, 0);
+  for (size_t i = 0; i < tiles.size(); ++i) {
+    const util::ImageTile& tile = tiles[i];
+    area += static_cast<uint64_t>(tile.width) * tile.height;
+    const std::vector<uint8_t> pixels(static_cast<size_t>(tile.width) * tile.height * 4, static_cast<uint8_t>(i + 1));
+    util::copyTile(image, 10, pixels, tile);
+  }
+  CHECK(area == 70);
+  CHECK(image[0] == 1);
+  CHECK(image[((6 * 10) + 9) * 4] == 6);
+}
+
+TEST_CASE("tileTransform maps the tile corners to the clip-space corners") {
+  const util::ImageTile tile{200, 100, 100, 50};
+  const glm::mat4 transform = util::tileTransform(400, 200, tile);
+
+  // Full-image clip coordinates of the tile corners: x in [0, 0.5], y in [0, 0.5]
+  const glm::vec4 lower = transform * glm::vec4(0.0f, 0.0f, 0.3f, 1.0f);
+  const glm::vec4 upper = transform * glm::vec4(0.5f, 0.5f, 0.3f, 1.0f);
+  CHECK(lower.x == doctest::Approx(-1.0f));
+  CHECK(lower.y == doctest::Approx(-1.0f));
+  CHECK(upper.x == doctest::Approx(1.0f));
+  CHECK(upper.y == doctest::Approx(1.0f));
+  CHECK(upper.z == doctest::Approx(0.3f));
+
+  // Homogeneous points keep mapping after the divide
+  const glm::vec4 scaled = transform * glm::vec4(1.0f, 1.0f, 0.6f, 2.0f);
+  CHECK(scaled.x / scaled.w == doctest::Approx(1.0f));
+}
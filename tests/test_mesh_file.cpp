@@ -0,0 +1,173 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <util/graph.hpp>
+#include <util/mesh_file.hpp>
+#include <util/mesh_prepare.hpp>
+#include <util/types.hpp>
+
+using util::MeshFile;
+using util::MeshView;
+
+namespace {
+
+std::string tempPath(const char* name) { return (std::filesystem::temp_directory_path() / name).string(); }
+
+// Ring of n nodes with chords, positions on a line
+util::Graph ringGraph(uint32_t n) {
+  std::vector<util::Edge> edges;
+  for (uint32_t v = 0; v < n; ++v) {
+    edges.emplace_back(v, (v + 1) % n);
+    edges.emplace_back(v, (v + 7) % n);
+  }
+  util::Graph graph = util::Graph::fromEdges(n, edges);
+  for (uint32_t v = 0; v < n; ++v) {
+    graph.positions[v] = glm::vec3(static_cast<float>(v), 0.0f, 0.0f);
+    graph.sizes[v] = static_cast<float>(v % 5);
+  }
+  return graph;
+}
+
+template <typename T>
+bool sameContents(std::span<const T> a, std::span<const T> b) {
+  return std::ranges::equal(std::as_bytes(a), std::as_bytes(b));
+}
+
+// Rewrite the table entry of the first section of the given type in place
+template <typename Patch>
+bool patchSection(const std::string& path, util::SectionType type, Patch patch) {
+  std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+  util::MeshFileHeader header{};
+  file.read(reinterpret_cast<char*>(&header), sizeof(header));
+  for (uint32_t i = 0; file && i < header.sectionCount; ++i) {
+    const auto position = static_cast<std::streamoff>(sizeof(header) + (i * sizeof(util::MeshFileSection)));
+    util::MeshFileSection section{};
+    file.seekg(position);
+    file.read(reinterpret_cast<char*>(&section), sizeof(section));
+    if (section.type == static_cast<uint32_t>(type)) {
+      patch(section);
+      file.seekp(position);
+      file.write(reinterpret_cast<const char*>(&section), sizeof(section));
+      return static_cast<bool>(file.flush());
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+TEST_CASE("mapped sections match the written arrays byte for byte") {
+  const util::Graph graph = ringGraph(10000);
+  const util::PreparedMesh prepared = util::prepareGraph(graph, util::VertexFormat::PackedColor);
+  const MeshView written = util::makeMeshView(prepared, graph);
+  const std::string path = tempPath("graph_lab_test.glab");
+  REQUIRE(util::writeMeshFile(path, written));
+
+  MeshFile file;
+  REQUIRE(file.open(path));
+  const MeshView& view = file.getView();
+
+  CHECK(view.format == util::VertexFormat::PackedColor);
+  CHECK(view.vertexCount == 10000);
+  CHECK(view.hasGraph());
+  CHECK_FALSE(view.directed);
+  CHECK(view.bounds.max.x == doctest::Approx(9999.0f));
+  CHECK(sameContents(view.vertexData, written.vertexData));
+  CHECK(view.faces.empty());
+  CHECK(sameContents(view.edges, written.edges));
+  CHECK(sameContents(view.points, written.points));
+  CHECK(sameContents(view.edgeChunks, written.edgeChunks));
+  CHECK(sameContents(view.pointChunks, written.pointChunks));
+  CHECK(sameContents(view.offsets, written.offsets));
+  CHECK(sameContents(view.neighbors, written.neighbors));
+  CHECK(sameContents(view.edgeIds, written.edgeIds));
+  CHECK(sameContents(view.edgeList, written.edgeList));
+  CHECK(sameContents(view.sizes, written.sizes));
+  CHECK(sameContents(view.weights, written.weights));
+
+  // Sections are aligned for direct use as buffer sources
+  CHECK(reinterpret_cast<uintptr_t>(view.vertexData.data()) % util::MESH_FILE_ALIGNMENT == 0);
+  CHECK(reinterpret_cast<uintptr_t>(view.edges.data()) % util::MESH_FILE_ALIGNMENT == 0);
+
+  file.close();
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("truncated or foreign files are rejected") {
+  util::Mesh3D mesh;
+  for (int i = 0; i < 3; ++i) {
+    mesh.vertices.emplace_back(static_cast<float>(i), 0.0f, 0.0f);
+  }
+  mesh.addFace(0, 1, 2);
+  const util::PreparedMesh prepared = util::prepareMesh(mesh);
+  const std::string path = tempPath("graph_lab_test_small.glab");
+  REQUIRE(util::writeMeshFile(path, util::makeMeshView(prepared)));
+
+  // Flat meshes are refused outright, the format has no field for their dimensions yet
+  util::Mesh2D flat;
+  for (int i = 0; i < 3; ++i) {
+    flat.vertices.emplace_back(static_cast<float>(i), 0.0f);
+  }
+  flat.addFace(0, 1, 2);
+  const util::PreparedMesh flatPrepared = util::prepareMesh(flat);
+  const util::MeshView flatView = util::makeMeshView(flatPrepared);
+  CHECK(flatView.dimensions == 2);
+  CHECK_FALSE(util::writeMeshFile(tempPath("graph_lab_test_flat.glab"), flatView));
+
+  MeshFile file;
+  REQUIRE(file.open(path));
+  CHECK_FALSE(file.getView().hasGraph());
+  CHECK(file.getView().faces.size() == 3);
+  file.close();
+
+  // Cut into the last section
+  const auto size = std::filesystem::file_size(path);
+  std::filesystem::resize_file(path, size - 4);
+  CHECK_FALSE(file.open(path));
+  CHECK_FALSE(file.isOpen());
+
+  {
+    std::ofstream other(path, std::ios::binary | std::ios::trunc);
+    other << "definitely not a mesh file, but long enough to hold a header......";
+  }
+  CHECK_FALSE(file.open(path));
+  CHECK_FALSE(file.open(tempPath("graph_lab_missing.glab")));
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("unknown sections are skipped and oversized counts rejected") {
+  const util::Graph graph = ringGraph(100);
+  const util::PreparedMesh prepared = util::prepareGraph(graph);
+  const MeshView written = util::makeMeshView(prepared, graph);
+  const std::string path = tempPath("graph_lab_test_sections.glab");
+
+  // A newer writer's section with 8-byte elements in place of the sizes
+  REQUIRE(util::writeMeshFile(path, written));
+  REQUIRE(patchSection(path, util::SectionType::Sizes, [](util::MeshFileSection& section) {
+    section.type = 1000;
+    section.elementSize = 8;
+    section.count /= 2;
+  }));
+  MeshFile file;
+  REQUIRE(file.open(path));
+  CHECK(file.getView().sizes.empty());
+  CHECK(sameContents(file.getView().weights, written.weights));
+  file.close();
+
+  // count * elementSize wraps to a small size
+  REQUIRE(util::writeMeshFile(path, written));
+  REQUIRE(patchSection(path, util::SectionType::Edges,
+                       [](util::MeshFileSection& section) { section.count = uint64_t{1} << 62; }));
+  CHECK_FALSE(file.open(path));
+
+  std::filesystem::remove(path);
+}
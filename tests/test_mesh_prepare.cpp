@@ -0,0 +1,107 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <util/background_worker.hpp>
+#include <util/mesh_prepare.hpp>
+#include <util/types.hpp>
+#include <util/vertex_pack.hpp>
+
+using util::Mesh3D;
+using util::PreparedMesh;
+using util::VertexFormat;
+
+namespace {
+
+// n x n grid of vertices, two triangles and two edges per cell
+Mesh3D gridMesh(uint32_t n) {
+  Mesh3D mesh;
+  for (uint32_t y = 0; y < n; ++y) {
+    for (uint32_t x = 0; x < n; ++x) {
+      mesh.vertices.emplace_back(static_cast<float>(x), static_cast<float>(y), 0.0f);
+    }
+  }
+  for (uint32_t y = 0; y + 1 < n; ++y) {
+    for (uint32_t x = 0; x + 1 < n; ++x) {
+      const uint32_t v = (y * n) + x;
+      mesh.addFace(v, v + 1, v + n);
+      mesh.addFace(v + 1, v + n + 1, v + n);
+      mesh.addEdge(v, v + 1);
+      mesh.addEdge(v, v + n);
+    }
+  }
+  return mesh;
+}
+
+}  // namespace
+
+TEST_CASE("primitives with missing vertices and trailing partial primitives are dropped") {
+  const std::vector<uint32_t> indices = {0, 1, 2, 1, 7, 2, 2, 3, 0, 1};
+  CHECK(util::collectPrimitives(indices, 4, 3) == std::vector<uint32_t>{0, 1, 2, 2, 3, 0});
+  CHECK(util::collectPrimitives(indices, 8, 2) == indices);
+}
+
+TEST_CASE("prepared meshes hold the packed blocks and chunked views") {
+  const Mesh3D mesh = gridMesh(128);
+  const PreparedMesh prepared = util::prepareMesh(mesh, VertexFormat::PackedColor);
+
+  REQUIRE(prepared.isValid());
+  CHECK(prepared.vertexCount == mesh.vertices.size());
+  CHECK(prepared.vertexData.size() == util::vertexBufferSize(VertexFormat::PackedColor, mesh.vertices.size()));
+  CHECK(prepared.faces.size() == mesh.faces.size());
+  CHECK(prepared.edges.size() == mesh.edges.size());
+  CHECK(prepared.bounds.max.x == doctest::Approx(127.0f));
+
+  // 16384 points need several chunks, so the point order is kept
+  CHECK(prepared.pointChunks.size() > 1);
+  CHECK(prepared.points.size() == prepared.vertexCount);
+
+  uint32_t faceIndices = 0;
+  for (const util::IndexChunk& chunk : prepared.faceChunks) {
+    faceIndices += chunk.indexCount;
+  }
+  CHECK(faceIndices == prepared.faces.size());
+
+  const PreparedMesh small = util::prepareMesh(gridMesh(4));
+  CHECK(small.pointChunks.size() == 1);
+  CHECK(small.points.empty());
+  CHECK_FALSE(util::prepareMesh(Mesh3D()).isValid());
+}
+
+TEST_CASE("2D meshes are prepared without a 3D copy and keep their edges") {
+  util::Mesh2D mesh;
+  mesh.vertices.emplace_back(0.0f, 0.0f);
+  mesh.vertices.emplace_back(4.0f, 0.0f);
+  mesh.vertices.emplace_back(0.0f, 3.0f);
+  mesh.addFace(0, 1, 2);
+  mesh.addEdge(0, 1);
+  mesh.addEdge(1, 2);
+
+  const PreparedMesh prepared = util::prepareMesh(mesh, VertexFormat::HalfPosition);
+  REQUIRE(prepared.isValid());
+  CHECK(prepared.dimensions == 2);
+  CHECK(prepared.vertexData.size() == util::vertexBufferSize(VertexFormat::HalfPosition, 3, 2));
+  CHECK(prepared.faces.size() == 3);
+  CHECK(prepared.edges.size() == 4);
+  CHECK(prepared.bounds.max.x == doctest::Approx(4.0f));
+  CHECK(prepared.bounds.max.z == 0.0f);
+  CHECK(util::prepareMesh(gridMesh(4)).dimensions == 3);
+}
+
+TEST_CASE("background worker runs tasks in submission order") {
+  std::vector<int> order;
+  PreparedMesh prepared;
+  {
+    util::BackgroundWorker worker;
+    for (int i = 0; i < 8; ++i) {
+      worker.submit([&order, i] { order.push_back(i); });
+    }
+    worker.submit([&prepared] { prepared = util::prepareMesh(gridMesh(32)); });
+    worker.waitIdle();
+    CHECK(worker.getPendingCount() == 0);
+  }
+  CHECK(order == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7});
+  CHECK(prepared.vertexCount == 32 * 32);
+}
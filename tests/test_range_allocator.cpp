@@ -0,0 +1,82 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <util/range_allocator.hpp>
+
+using util::RangeAllocator;
+
+TEST_CASE("allocations are first fit and fail once the capacity is used up") {
+  RangeAllocator allocator(100);
+  CHECK(allocator.allocate(40) == 0);
+  CHECK(allocator.allocate(40) == 40);
+  CHECK(allocator.allocate(30) == RangeAllocator::INVALID_OFFSET);
+  CHECK(allocator.allocate(20) == 80);
+  CHECK(allocator.allocate(0) == RangeAllocator::INVALID_OFFSET);
+  CHECK(allocator.getUsed() == 100);
+  CHECK(allocator.getLargestFree() == 0);
+}
+
+TEST_CASE("released ranges coalesce with both neighbors") {
+  RangeAllocator allocator(100);
+  const uint32_t a = allocator.allocate(10);
+  const uint32_t b = allocator.allocate(10);
+  const uint32_t c = allocator.allocate(10);
+
+  allocator.release(a, 10);
+  allocator.release(c, 10);
+  CHECK(allocator.getFreeRangeCount() == 2);  // [0, 10) and [20, 100)
+
+  // A hole is reused before the tail
+  CHECK(allocator.allocate(5) == 0);
+  allocator.release(0, 5);
+
+  allocator.release(b, 10);
+  CHECK(allocator.getFreeRangeCount() == 1);
+  CHECK(allocator.getLargestFree() == 100);
+  CHECK(allocator.getUsed() == 0);
+}
+
+TEST_CASE("random allocate / release never hands out overlapping ranges") {
+  RangeAllocator allocator(10'000);
+  std::vector<uint8_t> owned(10'000, 0);
+  std::vector<std::pair<uint32_t, uint32_t>> live;
+  std::mt19937 rng(3);
+
+  bool disjoint = true;
+  for (uint32_t step = 0; step < 5'000; ++step) {
+    if (!live.empty() && rng() % 2 == 0) {
+      const size_t index = rng() % live.size();
+      const auto [offset, count] = live[index];
+      for (uint32_t i = offset; i < offset + count; ++i) {
+        owned[i] = 0;
+      }
+      allocator.release(offset, count);
+      live[index] = live.back();
+      live.pop_back();
+      continue;
+    }
+
+    const uint32_t count = 1 + (rng() % 200);
+    const uint32_t offset = allocator.allocate(count);
+    if (offset == RangeAllocator::INVALID_OFFSET) {
+      continue;
+    }
+    for (uint32_t i = offset; i < offset + count; ++i) {
+      disjoint = disjoint && owned[i] == 0;
+      owned[i] = 1;
+    }
+    live.emplace_back(offset, count);
+  }
+  CHECK(disjoint);
+
+  for (const auto& [offset, count] : live) {
+    allocator.release(offset, count);
+  }
+  CHECK(allocator.getUsed() == 0);
+  CHECK(allocator.getFreeRangeCount() == 1);
+}
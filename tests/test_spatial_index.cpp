@@ -0,0 +1,108 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include <glm/ext/matrix_clip_space.hpp>
+
+#include <util/glm.hpp>
+#include <util/spatial_index.hpp>
+
+using util::AABB;
+using util::Frustum;
+using util::IndexChunk;
+
+namespace {
+
+// n x n grid of points in [0, n)^2
+std::vector<glm::vec3> gridPositions(uint32_t n) {
+  std::vector<glm::vec3> positions;
+  for (uint32_t y = 0; y < n; ++y) {
+    for (uint32_t x = 0; x < n; ++x) {
+      positions.emplace_back(static_cast<float>(x), static_cast<float>(y), 0.0f);
+    }
+  }
+  return positions;
+}
+
+}  // namespace
+
+TEST_CASE("orthographic frustum keeps boxes inside the viewport") {
+  const Frustum frustum = Frustum::fromMatrix(glm::ortho(0.0f, 10.0f, 0.0f, 10.0f, -1.0f, 1.0f));
+
+  AABB inside;
+  inside.expand(glm::vec3(2.0f, 2.0f, 0.0f));
+  inside.expand(glm::vec3(3.0f, 3.0f, 0.0f));
+  CHECK(frustum.intersects(inside));
+
+  AABB straddling;
+  straddling.expand(glm::vec3(-5.0f, 4.0f, 0.0f));
+  straddling.expand(glm::vec3(1.0f, 5.0f, 0.0f));
+  CHECK(frustum.intersects(straddling));
+
+  AABB outside;
+  outside.expand(glm::vec3(11.0f, 2.0f, 0.0f));
+  outside.expand(glm::vec3(12.0f, 3.0f, 0.0f));
+  CHECK_FALSE(frustum.intersects(outside));
+}
+
+TEST_CASE("chunks keep every primitive intact and bound their vertices") {
+  const std::vector<glm::vec3> positions = gridPositions(64);
+
+  // Horizontal line segments between grid neighbors
+  std::vector<uint32_t> indices;
+  for (uint32_t y = 0; y < 64; ++y) {
+    for (uint32_t x = 0; x + 1 < 64; ++x) {
+      indices.push_back((y * 64) + x);
+      indices.push_back((y * 64) + x + 1);
+    }
+  }
+  std::vector<uint32_t> original = indices;
+
+  const std::vector<IndexChunk> chunks = util::buildIndexChunks(positions, indices, 2, 256);
+  REQUIRE(chunks.size() == (original.size() / 2 + 255) / 256);
+
+  // Same set of segments, only reordered
+  auto segments = [](const std::vector<uint32_t>& v) {
+    std::vector<uint64_t> s;
+    for (size_t i = 0; i < v.size(); i += 2) {
+      s.push_back((static_cast<uint64_t>(v[i]) << 32) | v[i + 1]);
+    }
+    std::sort(s.begin(), s.end());
+    return s;
+  };
+  CHECK(segments(indices) == segments(original));
+
+  uint32_t next = 0;
+  for (const IndexChunk& chunk : chunks) {
+    CHECK(chunk.firstIndex == next);
+    next += chunk.indexCount;
+    for (uint32_t i = chunk.firstIndex; i < chunk.firstIndex + chunk.indexCount; ++i) {
+      const glm::vec3& p = positions[indices[i]];
+      CHECK(p.x >= chunk.bounds.min.x);
+      CHECK(p.x <= chunk.bounds.max.x);
+      CHECK(p.y >= chunk.bounds.min.y);
+      CHECK(p.y <= chunk.bounds.max.y);
+    }
+  }
+  CHECK(next == indices.size());
+}
+
+TEST_CASE("a small viewport only touches a few chunks") {
+  const std::vector<glm::vec3> positions = gridPositions(256);
+  std::vector<uint32_t> indices(positions.size());
+  std::iota(indices.begin(), indices.end(), 0u);
+
+  const std::vector<IndexChunk> chunks = util::buildIndexChunks(positions, indices, 1, 1024);
+  REQUIRE(chunks.size() == 64);
+
+  // 16 x 16 window in the corner of the 256 x 256 grid
+  const Frustum frustum = Frustum::fromMatrix(glm::ortho(0.0f, 15.0f, 0.0f, 15.0f, -1.0f, 1.0f));
+  const auto visible = std::count_if(chunks.begin(), chunks.end(),
+                                     [&](const IndexChunk& chunk) { return frustum.intersects(chunk.bounds); });
+  CHECK(visible >= 1);
+  CHECK(visible <= 4);
+}
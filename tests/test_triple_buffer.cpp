@@ -0,0 +1,100 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <util/glm.hpp>
+#include <util/scene_snapshot.hpp>
+#include <util/triple_buffer.hpp>
+
+TEST_CASE("triple buffer hands over the newest published value") {
+  util::TripleBuffer<int> buffer;
+  CHECK_FALSE(buffer.update());
+
+  buffer.write() = 1;
+  buffer.publish();
+  buffer.write() = 2;
+  buffer.publish();
+
+  // Intermediate values are dropped, the newest one wins
+  REQUIRE(buffer.update());
+  CHECK(buffer.read() == 2);
+  CHECK_FALSE(buffer.update());
+  CHECK(buffer.read() == 2);
+
+  buffer.write() = 3;
+  buffer.publish();
+  REQUIRE(buffer.update());
+  CHECK(buffer.read() == 3);
+}
+
+TEST_CASE("triple buffer never hands out a slot the other side is using") {
+  util::TripleBuffer<std::vector<uint32_t>> buffer;
+  constexpr uint32_t ROUNDS = 20'000;
+  constexpr uint32_t SIZE = 64;
+
+  std::thread producer([&] {
+    for (uint32_t round = 1; round <= ROUNDS; ++round) {
+      std::vector<uint32_t>& values = buffer.write();
+      values.assign(SIZE, round);
+      buffer.publish();
+    }
+  });
+
+  // Every value read is complete (all entries from the same round) and rounds never go backwards
+  uint32_t last = 0;
+  while (last < ROUNDS) {
+    if (!buffer.update()) {
+      std::this_thread::yield();
+      continue;
+    }
+    const std::vector<uint32_t>& values = buffer.read();
+    REQUIRE(values.size() == SIZE);
+    CHECK(values.front() > last);
+    for (uint32_t value : values) {
+      REQUIRE(value == values.front());
+    }
+    last = values.front();
+  }
+  producer.join();
+}
+
+TEST_CASE("snapshot producer publishes recycled snapshots") {
+  util::SnapshotProducer producer;
+  std::atomic<uint32_t> steps{0};
+
+  REQUIRE(producer.start([&](util::SceneSnapshot& snapshot) {
+    const uint32_t step = steps.fetch_add(1) + 1;
+    snapshot.positions.assign(100, glm::vec3(static_cast<float>(step)));
+    return true;
+  }));
+  CHECK_FALSE(producer.start([](util::SceneSnapshot&) { return false; }));
+
+  // The vectors of the three slots are reused, so only three distinct buffers ever show up
+  std::set<const glm::vec3*> storage;
+  uint64_t lastSequence = 0;
+  while (lastSequence < 1000) {
+    const util::SceneSnapshot* snapshot = producer.acquire();
+    if (snapshot == nullptr) {
+      std::this_thread::yield();
+      continue;
+    }
+    CHECK(snapshot->sequence > lastSequence);
+    REQUIRE(snapshot->positions.size() == 100);
+    CHECK(snapshot->positions.front() == snapshot->positions.back());
+    lastSequence = snapshot->sequence;
+    storage.insert(snapshot->positions.data());
+  }
+  CHECK(storage.size() <= 3);
+  CHECK(producer.getPublishedCount() >= lastSequence);
+
+  producer.setPaused(true);
+  CHECK(producer.isPaused());
+  producer.stop();
+  CHECK_FALSE(producer.isRunning());
+  CHECK(producer.latest().sequence == lastSequence);
+}
@@ -0,0 +1,118 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <util/glm.hpp>
+#include <util/types.hpp>
+#include <util/vertex_layout.hpp>
+#include <util/vertex_pack.hpp>
+
+using util::AttributeType;
+using util::VertexAttribute;
+using util::VertexFormat;
+
+namespace {
+
+// Custom per-vertex data opting in like the renderer's own element types
+struct WeightedVertex {
+  glm::vec2 position{0.0f, 0.0f};
+  uint32_t id = 0;
+  float weight = 0.0f;
+};
+
+}  // namespace
+
+template <>
+struct util::VertexLayout<WeightedVertex> {
+  static constexpr std::array ATTRIBUTES = {
+      util::attribute<glm::vec2>(0, offsetof(WeightedVertex, position)),
+      util::attribute<uint32_t>(1, offsetof(WeightedVertex, id)),
+      util::attribute<float>(2, offsetof(WeightedVertex, weight)),
+  };
+};
+
+TEST_CASE("attribute formats follow the member types") {
+  constexpr VertexAttribute position = util::attribute<glm::vec3>(0, 8);
+  CHECK(position.components == 3);
+  CHECK(position.type == AttributeType::Float32);
+  CHECK(position.offset == 8);
+  CHECK(position.size() == 12);
+
+  constexpr VertexAttribute shape = util::attribute<util::NodeShape>(3, 0);
+  CHECK(shape.components == 1);
+  CHECK(shape.isInteger());
+
+  constexpr VertexAttribute color = util::attribute(1, 4, 4, AttributeType::UNorm8);
+  CHECK(color.size() == 4);
+  CHECK_FALSE(color.isInteger());
+}
+
+TEST_CASE("instance layouts match the instance structs") {
+  constexpr auto& nodes = util::VertexLayout<util::NodeInstance>::ATTRIBUTES;
+  REQUIRE(nodes.size() == 4);
+  CHECK(nodes[0].location == 1);
+  CHECK(nodes[0].components == 4);
+  CHECK(nodes[0].offset == offsetof(util::NodeInstance, position));
+  CHECK(nodes[1].offset == offsetof(util::NodeInstance, color));
+  CHECK(nodes[2].type == AttributeType::UInt32);
+  CHECK(nodes[3].offset == offsetof(util::NodeInstance, outlineWidth));
+
+  constexpr auto& edges = util::VertexLayout<util::EdgeInstance>::ATTRIBUTES;
+  REQUIRE(edges.size() == 3);
+  CHECK(edges[0].components == 2);
+  CHECK(edges[0].isInteger());
+  CHECK(edges[2].type == AttributeType::UNorm8);
+  CHECK(edges[2].offset == offsetof(util::EdgeInstance, color));
+
+  static_assert(util::layoutFits<WeightedVertex>());
+  constexpr auto& custom = util::VertexLayout<WeightedVertex>::ATTRIBUTES;
+  CHECK(custom[1].isInteger());
+  CHECK(custom[2].offset == offsetof(WeightedVertex, weight));
+}
+
+TEST_CASE("block layouts place tightly packed blocks back to back") {
+  constexpr auto blocks = util::blockLayout<glm::vec3, uint32_t, float>(5, 2);
+  CHECK(blocks[0].location == 2);
+  CHECK(blocks[0].offset == 0);
+  CHECK(blocks[0].stride == sizeof(glm::vec3));
+  CHECK(blocks[1].location == 3);
+  CHECK(blocks[1].offset == 5 * sizeof(glm::vec3));
+  CHECK(blocks[2].offset == (5 * sizeof(glm::vec3)) + (5 * sizeof(uint32_t)));
+  CHECK(util::blockLayoutSize<glm::vec3, uint32_t, float>(5) == 5 * 20);
+}
+
+TEST_CASE("runtime layouts match the packed vertex buffers") {
+  for (const VertexFormat format : {VertexFormat::Float32, VertexFormat::PackedColor, VertexFormat::HalfPosition}) {
+    for (const uint32_t dimensions : {2u, 3u}) {
+      const auto mesh = util::meshLayout(format, 10, dimensions);
+      CHECK(mesh[0].components == dimensions);
+      CHECK(mesh[0].stride == util::positionSize(format, dimensions));
+      CHECK(mesh[1].offset == util::colorBlockOffset(format, 10, dimensions));
+      CHECK(mesh[1].offset + (10 * mesh[1].stride) == util::vertexBufferSize(format, 10, dimensions));
+    }
+
+    const auto stream = util::streamLayout2D(format);
+    CHECK(stream[0].stride == util::vertexSize2D(format));
+    CHECK(stream[1].offset + stream[1].size() == util::vertexSize2D(format));
+  }
+}
+
+TEST_CASE("Float32 2D vertices are packed as they are") {
+  const std::vector<util::Vertex2D> vertices = {
+      {1.0f, 2.0f, util::Color(0.1f, 0.2f, 0.3f, 0.4f)},
+      {3.0f, 4.0f, util::Color(0.5f, 0.6f, 0.7f, 0.8f)},
+  };
+  std::vector<uint8_t> packed(vertices.size() * util::vertexSize2D(VertexFormat::Float32));
+  util::packVertices2D(VertexFormat::Float32, vertices, packed.data());
+  CHECK(std::memcmp(packed.data(), vertices.data(), packed.size()) == 0);
+
+  const auto& layout = util::VertexLayout<util::Vertex2D>::ATTRIBUTES;
+  const auto stream = util::streamLayout2D(VertexFormat::Float32);
+  CHECK(layout[1].offset == stream[1].offset);
+  CHECK(layout[1].type == stream[1].type);
+}
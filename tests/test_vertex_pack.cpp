@@ -0,0 +1,117 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <util/glm.hpp>
+#include <util/types.hpp>
+#include <util/vertex_pack.hpp>
+
+using util::VertexFormat;
+
+TEST_CASE("vertex buffer is split into a positions block followed by a colors block") {
+  CHECK(util::colorBlockOffset(VertexFormat::Float32, 10) == 10 * 3 * sizeof(float));
+  CHECK(util::vertexBufferSize(VertexFormat::Float32, 10) == 10 * 7 * sizeof(float));
+}
+
+TEST_CASE("compact vertex formats shrink the per-vertex size") {
+  CHECK(util::vertexBufferSize(VertexFormat::Float32, 1) == 28);
+  CHECK(util::vertexBufferSize(VertexFormat::PackedColor, 1) == 16);
+  CHECK(util::vertexBufferSize(VertexFormat::HalfPosition, 1) == 12);
+
+  CHECK(util::vertexSize2D(VertexFormat::Float32) == 24);
+  CHECK(util::vertexSize2D(VertexFormat::PackedColor) == 12);
+  CHECK(util::vertexSize2D(VertexFormat::HalfPosition) == 8);
+}
+
+TEST_CASE("packPositions and packColors write tightly packed floats") {
+  std::vector<util::Vertex3D> vertices;
+  vertices.emplace_back(1.0f, 2.0f, 3.0f, util::Color(0.1f, 0.2f, 0.3f, 0.4f));
+  vertices.emplace_back(4.0f, 5.0f, 6.0f, util::Color(0.5f, 0.6f, 0.7f, 0.8f));
+
+  std::vector<float> buffer(util::vertexBufferSize(VertexFormat::Float32, vertices.size()) / sizeof(float));
+  util::packPositions(VertexFormat::Float32, vertices, buffer.data());
+  util::packColors(VertexFormat::Float32, vertices,
+                   buffer.data() + util::colorBlockOffset(VertexFormat::Float32, vertices.size()) / sizeof(float));
+
+  const std::vector<float> expected = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f, 0.7f, 0.8f};
+  REQUIRE(buffer.size() == expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    CHECK(buffer[i] == doctest::Approx(expected[i]));
+  }
+}
+
+TEST_CASE("flat meshes store two-component positions") {
+  CHECK(util::positionSize(VertexFormat::Float32, 2) == 8);
+  CHECK(util::positionSize(VertexFormat::HalfPosition, 2) == 4);
+  CHECK(util::vertexBufferSize(VertexFormat::PackedColor, 10, 2) == 10 * 12);
+  CHECK(util::colorBlockOffset(VertexFormat::HalfPosition, 10, 2) == 10 * 4);
+
+  std::vector<util::Vertex2D> vertices;
+  vertices.emplace_back(1.0f, 2.0f, util::Color(0.1f, 0.2f, 0.3f, 0.4f));
+  vertices.emplace_back(3.0f, 4.0f, util::Color(0.5f, 0.6f, 0.7f, 0.8f));
+
+  std::vector<float> buffer(util::vertexBufferSize(VertexFormat::Float32, vertices.size(), 2) / sizeof(float));
+  util::packPositions(VertexFormat::Float32, vertices, buffer.data());
+  util::packColors(VertexFormat::Float32, vertices,
+                   buffer.data() + util::colorBlockOffset(VertexFormat::Float32, vertices.size(), 2) / sizeof(float));
+
+  const std::vector<float> expected = {1.0f, 2.0f, 3.0f, 4.0f, 0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f, 0.7f, 0.8f};
+  REQUIRE(buffer.size() == expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    CHECK(buffer[i] == doctest::Approx(expected[i]));
+  }
+}
+
+TEST_CASE("packed colors are normalized RGBA8 in memory order") {
+  std::vector<util::Vertex3D> vertices;
+  vertices.emplace_back(0.0f, 0.0f, 0.0f, util::Color(1.0f, 0.0f, 0.5f, 1.0f));
+
+  uint8_t rgba[4] = {};
+  util::packColors(VertexFormat::PackedColor, vertices, rgba);
+  CHECK(rgba[0] == 255);
+  CHECK(rgba[1] == 0);
+  CHECK(rgba[2] == 128);
+  CHECK(rgba[3] == 255);
+}
+
+TEST_CASE("vectorized color packing matches the scalar loop") {
+  // Odd count exercises the scalar tail, values outside [0, 1] the clamping
+  std::vector<util::Vertex3D> vertices;
+  for (int i = 0; i < 1027; ++i) {
+    const float t = (static_cast<float>(i) / 1000.0f) - 0.01f;
+    vertices.emplace_back(0.0f, 0.0f, 0.0f, util::Color(t, 1.0f - t, t * 0.37f, 0.5f + t));
+  }
+
+  std::vector<uint32_t> scalar(vertices.size());
+  std::vector<uint32_t> fast(vertices.size());
+  util::packColorsScalar(&vertices[0].color, sizeof(util::Vertex3D), vertices.size(), scalar.data());
+  util::packColorsRGBA8(&vertices[0].color, sizeof(util::Vertex3D), vertices.size(), fast.data());
+  CHECK(scalar == fast);
+}
+
+TEST_CASE("half positions round-trip small coordinates exactly") {
+  std::vector<util::Vertex2D> vertices;
+  vertices.emplace_back(100.0f, -2.5f, util::Color(0.0f, 0.0f, 0.0f, 1.0f));
+
+  uint8_t packed[8] = {};
+  util::packVertices2D(VertexFormat::HalfPosition, vertices, packed);
+
+  uint16_t halves[2] = {};
+  std::memcpy(halves, packed, sizeof(halves));
+  // Known IEEE half bit patterns, independent of the encoder under test
+  CHECK(halves[0] == 0x5640);
+  CHECK(halves[1] == 0xC100);
+  CHECK(glm::unpackHalf1x16(halves[0]) == 100.0f);
+  CHECK(glm::unpackHalf1x16(halves[1]) == -2.5f);
+  CHECK(packed[7] == 255);
+}
+
+TEST_CASE("indicesInRange detects references to missing vertices") {
+  const std::vector<uint32_t> valid = {0, 1, 2};
+  const std::vector<uint32_t> invalid = {0, 1, 3};
+  CHECK(util::indicesInRange(valid, 3));
+  CHECK_FALSE(util::indicesInRange(invalid, 3));
+}